@@ -13,6 +13,10 @@ DEMO_debug_CFLAGS_GL = -g $(LIBRARY_BUILD_WARN_FLAGS) $(LIBRARY_BUILD_INCLUDES_C
 DEMO_release_CFLAGS_GLES = $(LIBRARY_BUILD_WARN_FLAGS) $(LIBRARY_BUILD_INCLUDES_CFLAGS) $(LIBRARY_GLES_release_CFLAGS) $(shell sdl2-config --cflags) -Idemos/common
 DEMO_debug_CFLAGS_GLES = -g $(LIBRARY_BUILD_WARN_FLAGS) $(LIBRARY_BUILD_INCLUDES_CFLAGS) $(LIBRARY_GLES_debug_CFLAGS) $(shell sdl2-config --cflags) -Idemos/common
 
+# headless demos use neither SDL nor a GL backend and link only to libFastUIDraw
+DEMO_release_CFLAGS_HEADLESS = $(LIBRARY_BUILD_WARN_FLAGS) $(LIBRARY_BUILD_INCLUDES_CFLAGS) $(LIBRARY_BASE_release_CFLAGS) -Idemos/common
+DEMO_debug_CFLAGS_HEADLESS = -g $(LIBRARY_BUILD_WARN_FLAGS) $(LIBRARY_BUILD_INCLUDES_CFLAGS) $(LIBRARY_BASE_debug_CFLAGS) -Idemos/common
+
 MAKEDEPEND = ./makedepend.sh
 
 # how to build each demo:
@@ -84,3 +88,52 @@ endef
 
 $(call demosapi,GL,$(BUILD_GL))
 $(call demosapi,GLES,$(BUILD_GLES))
+
+# how to build each headless demo:
+# $1 --> Demo name
+# $2 --> release or debug
+define headlessdemorule
+$(eval $(2)/headless/demos/%.o: demos/%.cpp
+	@mkdir -p $$(dir $$@)
+	$(CXX) $$(DEMO_$(2)_CFLAGS_HEADLESS) -c $$< -o $$@
+$(2)/headless/demos/%.dd: demos/%.cpp
+	@mkdir -p $$(dir $$@)
+	@echo Generating $$@
+	@$(MAKEDEPEND) "$$(CXX)" "$$(DEMO_$(2)_CFLAGS_HEADLESS)" $(2)/headless/demos "$$*" "$$<" "$$@"
+THISDEMO_$(1)_$(2)_DEPS_RAW = $$(patsubst %.cpp, %.dd, $$($(1)_SOURCES))
+THISDEMO_$(1)_$(2)_OBJS_RAW = $$(patsubst %.cpp, %.o, $$($(1)_SOURCES))
+THISDEMO_$(1)_$(2)_DEPS = $$(addprefix $(2)/headless/, $$(THISDEMO_$(1)_$(2)_DEPS_RAW))
+THISDEMO_$(1)_$(2)_OBJS = $$(addprefix $(2)/headless/, $$(THISDEMO_$(1)_$(2)_OBJS_RAW))
+THISDEMO_$(1)_$(2)_EXE = $(1)-$(2)
+CLEAN_FILES += $$(THISDEMO_$(1)_$(2)_OBJS) $$(THISDEMO_$(1)_$(2)_EXE) $$(THISDEMO_$(1)_$(2)_EXE).exe
+SUPER_CLEAN_FILES += $$(THISDEMO_$(1)_$(2)_DEPS)
+ifneq ($(MAKECMDGOALS),clean)
+ifneq ($(MAKECMDGOALS),clean-all)
+ifneq ($(MAKECMDGOALS),targets)
+ifneq ($(MAKECMDGOALS),docs)
+-include $$(THISDEMO_$(1)_$(2)_DEPS)
+endif
+endif
+endif
+endif
+demos-headless-$(2)-exes += $$(THISDEMO_$(1)_$(2)_EXE)
+DEMO_TARGETLIST += $$(THISDEMO_$(1)_$(2)_EXE)
+$$(THISDEMO_$(1)_$(2)_EXE): libFastUIDraw_$(2) $$(THISDEMO_$(1)_$(2)_OBJS) $$(THISDEMO_$(1)_$(2)_DEPS)
+	$$(CXX) -o $$@ $$(THISDEMO_$(1)_$(2)_OBJS) -L. -lFastUIDraw_$(2) $(LIBRARY_LIBS)
+)
+endef
+
+# $1 --> release or debug
+define headlessdemoset
+$(eval $(foreach demoname,$(HEADLESS_DEMOS),$(call headlessdemorule,$(demoname),$(1)))
+demos-headless-$(1): $$(demos-headless-$(1)-exes)
+.PHONY: demos-headless-$(1)
+TARGETLIST += demos-headless-$(1)
+)
+endef
+
+$(call headlessdemoset,release)
+$(call headlessdemoset,debug)
+demos-headless: demos-headless-release demos-headless-debug
+.PHONY: demos-headless
+TARGETLIST += demos-headless
@@ -1,5 +1,9 @@
 # The Rules.mk file for each demo needs to do:
-#  1. add its name to DEMOS. Lets say the name of the demo is foo
+#  1. add its name to DEMOS. Lets say the name of the demo is foo.
+#     A demo that uses neither SDL nor a GL backend adds its name to
+#     HEADLESS_DEMOS instead; it is built by the demos-headless targets
+#     and links only to libFastUIDraw, so foo_SOURCES must also list
+#     the sources from demos/common that it uses.
 #  2. add to foo_SOURCES the sources the demo has
 #  3. add to foo_RESOURCE_STRING the string resources of the demo
 #
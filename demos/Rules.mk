@@ -28,6 +28,21 @@ include $(dir)/Rules.mk
 dir := $(d)/painter_cells
 include $(dir)/Rules.mk
 
+dir := $(d)/filled_path_benchmark
+include $(dir)/Rules.mk
+
+dir := $(d)/bake_paths
+include $(dir)/Rules.mk
+
+dir := $(d)/baked_path_benchmark
+include $(dir)/Rules.mk
+
+dir := $(d)/painter_headless_benchmark
+include $(dir)/Rules.mk
+
+dir := $(d)/distance_field_benchmark
+include $(dir)/Rules.mk
+
 
 
 # Begin standard footer
@@ -827,6 +827,9 @@ compute_glyphs_and_positions(fastuidraw::GlyphRender renderer, float pixel_size_
         case curve_pair_glyph:
           div_scale_factor = m_font->render_params().curve_pair_pixel_size();
           break;
+        case msdf_glyph:
+          div_scale_factor = m_font->render_params().msdf_pixel_size();
+          break;
 
         default:
           div_scale_factor = renderer.m_pixel_size;
@@ -0,0 +1,150 @@
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/data_buffer.hpp>
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/tessellated_path.hpp>
+
+#include "generic_command_line.hpp"
+#include "simple_time.hpp"
+#include "read_path.hpp"
+
+/* Tool to pre-bake path files (for example those of
+   demo_data/paths): for each path file passed on the
+   command line, the TessellatedPath, StrokedPath and
+   FilledPath of the path are built and written with
+   TessellatedPath::bake() to a file whose name is the
+   name of the path file with a suffix added. The baked
+   files are loaded by baked-path-benchmark.
+ */
+
+class bake_paths:public command_line_register
+{
+public:
+  bake_paths(void);
+
+  int
+  main(int argc, char **argv);
+
+private:
+  void
+  bake_file(const std::string &filename);
+
+  command_line_argument_value<std::string> m_suffix;
+  command_line_argument_value<bool> m_bake_stroked;
+  command_line_argument_value<bool> m_bake_filled;
+  command_line_argument_value<float> m_curve_tessellation;
+  command_line_argument_value<unsigned int> m_max_segments;
+};
+
+bake_paths::
+bake_paths(void):
+  m_suffix(".baked", "suffix",
+           "Suffix added to the name of each path file to give the "
+           "name of the file to which its baked data is written", *this),
+  m_bake_stroked(true, "bake_stroked",
+                 "If true, also bake the StrokedPath of each path", *this),
+  m_bake_filled(true, "bake_filled",
+                "If true, also bake the FilledPath of each path", *this),
+  m_curve_tessellation(fastuidraw::TessellatedPath::TessellationParams().m_curve_tessellation,
+                       "curve_tessellation",
+                       "Value for TessellationParams::m_curve_tessellation", *this),
+  m_max_segments(fastuidraw::TessellatedPath::TessellationParams().m_max_segments,
+                 "max_segments",
+                 "Value for TessellationParams::m_max_segments", *this)
+{}
+
+void
+bake_paths::
+bake_file(const std::string &filename)
+{
+  fastuidraw::Path path;
+  std::ifstream path_file(filename.c_str());
+
+  if(!path_file)
+    {
+      std::cout << "Unable to open \"" << filename << "\"\n";
+      return;
+    }
+
+  std::stringstream buffer;
+  buffer << path_file.rdbuf();
+  read_path(path, buffer.str());
+
+  fastuidraw::TessellatedPath::TessellationParams params;
+  uint32_t what(0);
+  simple_time timer;
+
+  params.m_curve_tessellation = m_curve_tessellation.m_value;
+  params.m_max_segments = m_max_segments.m_value;
+  path.tessellation_params(params);
+
+  if(m_bake_stroked.m_value)
+    {
+      what |= fastuidraw::TessellatedPath::bake_stroked_path;
+    }
+
+  if(m_bake_filled.m_value)
+    {
+      what |= fastuidraw::TessellatedPath::bake_filled_path;
+    }
+
+  fastuidraw::BakedDataWriter writer;
+  std::string out_filename(filename + m_suffix.m_value);
+
+  path.tessellation()->bake(writer, what);
+  if(!writer.save(out_filename.c_str()))
+    {
+      std::cout << "Unable to write \"" << out_filename << "\"\n";
+      return;
+    }
+
+  std::cout << filename << " --> " << out_filename << ": "
+            << writer.data().size() << " bytes in "
+            << timer.elapsed_us() << " us\n";
+}
+
+int
+bake_paths::
+main(int argc, char **argv)
+{
+  std::vector<std::string> files;
+
+  if(argc == 1 || (argc == 2 && std::string(argv[1]) == "--help"))
+    {
+      std::cout << "Usage: " << argv[0] << " [options] file0 file1 ...\n"
+                << "where each file is a path file as read by painter-path-test";
+      print_help(std::cout);
+      print_detailed_help(std::cout);
+      return 0;
+    }
+
+  /* arguments that are not options are path files */
+  for(int i = 1; i < argc; ++i)
+    {
+      if(std::string(argv[i]).find('=') == std::string::npos)
+        {
+          files.push_back(argv[i]);
+        }
+    }
+  parse_command_line(argc, argv);
+  std::cout << "\n";
+
+  for(unsigned int i = 0; i < files.size(); ++i)
+    {
+      bake_file(files[i]);
+    }
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  bake_paths B;
+  return B.main(argc, argv);
+}
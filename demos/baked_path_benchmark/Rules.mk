@@ -0,0 +1,15 @@
+# Begin standard header
+sp 		:= $(sp).x
+dirstack_$(sp)	:= $(d)
+d		:= $(dir)
+# End standard header
+
+
+HEADLESS_DEMOS += baked-path-benchmark
+baked-path-benchmark_SOURCES := $(call filelist, main.cpp) \
+	$(addprefix demos/common/, generic_command_line.cpp read_path.cpp)
+
+# Begin standard footer
+d		:= $(dirstack_$(sp))
+sp		:= $(basename $(sp))
+# End standard footer
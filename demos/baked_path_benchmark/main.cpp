@@ -0,0 +1,202 @@
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/data_buffer.hpp>
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/tessellated_path.hpp>
+#include <fastuidraw/stroked_path.hpp>
+#include <fastuidraw/filled_path.hpp>
+#include <fastuidraw/painter/painter_attribute_data.hpp>
+
+#include "generic_command_line.hpp"
+#include "simple_time.hpp"
+#include "read_path.hpp"
+
+/* Startup benchmark for baked paths: for each path file
+   passed on the command line, compares the time to go from
+   the file to the data needed to stroke and fill the path
+   (the PainterAttributeData of the StrokedPath and of the
+   leaf Subset objects of the FilledPath) when
+    - constructing it live from the path file
+    - loading it with TessellatedPath::load_baked() from
+      the baked file made by bake-paths.
+ */
+
+class baked_path_benchmark:public command_line_register
+{
+public:
+  baked_path_benchmark(void);
+
+  int
+  main(int argc, char **argv);
+
+private:
+  void
+  run_benchmark(const std::string &filename);
+
+  fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+  load_live(const std::string &filename);
+
+  fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+  load_baked(const std::string &filename);
+
+  /* fetches the data a Painter needs to stroke
+     and fill the path, returns the number of
+     attributes of that data.
+   */
+  unsigned int
+  ready_for_drawing(const fastuidraw::TessellatedPath &path);
+
+  command_line_argument_value<std::string> m_suffix;
+  command_line_argument_value<unsigned int> m_num_runs;
+};
+
+baked_path_benchmark::
+baked_path_benchmark(void):
+  m_suffix(".baked", "suffix",
+           "Suffix added to the name of each path file to give the "
+           "name of its baked file as made by bake-paths", *this),
+  m_num_runs(100, "num_runs",
+             "Number of times to load each path", *this)
+{}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+baked_path_benchmark::
+load_live(const std::string &filename)
+{
+  fastuidraw::Path path;
+  std::ifstream path_file(filename.c_str());
+  std::stringstream buffer;
+
+  buffer << path_file.rdbuf();
+  read_path(path, buffer.str());
+  return path.tessellation();
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+baked_path_benchmark::
+load_baked(const std::string &filename)
+{
+  fastuidraw::reference_counted_ptr<const fastuidraw::DataBuffer> buffer;
+
+  buffer = FASTUIDRAWnew fastuidraw::DataBuffer(filename.c_str());
+
+  fastuidraw::BakedDataReader reader(buffer);
+  return fastuidraw::TessellatedPath::load_baked(reader);
+}
+
+unsigned int
+baked_path_benchmark::
+ready_for_drawing(const fastuidraw::TessellatedPath &path)
+{
+  unsigned int return_value(0);
+  const fastuidraw::FilledPath &filled(*path.filled());
+
+  for(unsigned int i = 0, endi = filled.number_subsets(); i < endi; ++i)
+    {
+      fastuidraw::FilledPath::Subset S(filled.subset(i));
+      if(S.is_leaf())
+        {
+          return_value += S.painter_data().attribute_data_chunk(0).size();
+        }
+    }
+  return_value += path.stroked()->painter_data().attribute_data_chunk(0).size();
+  return return_value;
+}
+
+void
+baked_path_benchmark::
+run_benchmark(const std::string &filename)
+{
+  std::string baked_filename(filename + m_suffix.m_value);
+  unsigned int num_runs(fastuidraw::t_max(m_num_runs.m_value, 1u));
+  unsigned int live_count(0), baked_count(0);
+  int64_t live_us, baked_us;
+
+  {
+    std::ifstream path_file(filename.c_str());
+    if(!path_file)
+      {
+        std::cout << "Unable to open \"" << filename << "\"\n";
+        return;
+      }
+  }
+
+  if(!load_baked(baked_filename))
+    {
+      std::cout << "Unable to load \"" << baked_filename
+                << "\", make it with bake-paths\n";
+      return;
+    }
+
+  simple_time live_timer;
+  for(unsigned int run = 0; run < num_runs; ++run)
+    {
+      live_count = ready_for_drawing(*load_live(filename));
+    }
+  live_us = live_timer.elapsed_us();
+
+  simple_time baked_timer;
+  for(unsigned int run = 0; run < num_runs; ++run)
+    {
+      baked_count = ready_for_drawing(*load_baked(baked_filename));
+    }
+  baked_us = baked_timer.elapsed_us();
+
+  std::cout << filename << ":\n"
+            << "\tattributes: " << live_count << " live, "
+            << baked_count << " baked\n"
+            << "\ttime live: "
+            << static_cast<double>(live_us) / static_cast<double>(num_runs) << " us\n"
+            << "\ttime baked: "
+            << static_cast<double>(baked_us) / static_cast<double>(num_runs) << " us\n"
+            << "\tspeedup: "
+            << static_cast<double>(live_us) / static_cast<double>(fastuidraw::t_max(baked_us, int64_t(1)))
+            << "\n";
+}
+
+int
+baked_path_benchmark::
+main(int argc, char **argv)
+{
+  std::vector<std::string> files;
+
+  if(argc == 1 || (argc == 2 && std::string(argv[1]) == "--help"))
+    {
+      std::cout << "Usage: " << argv[0] << " [options] file0 file1 ...\n"
+                << "where each file is a path file as read by painter-path-test "
+                << "that has been baked by bake-paths";
+      print_help(std::cout);
+      print_detailed_help(std::cout);
+      return 0;
+    }
+
+  /* arguments that are not options are path files */
+  for(int i = 1; i < argc; ++i)
+    {
+      if(std::string(argv[i]).find('=') == std::string::npos)
+        {
+          files.push_back(argv[i]);
+        }
+    }
+  parse_command_line(argc, argv);
+  std::cout << "\n";
+
+  for(unsigned int i = 0; i < files.size(); ++i)
+    {
+      run_benchmark(files[i]);
+    }
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  baked_path_benchmark B;
+  return B.main(argc, argv);
+}
@@ -0,0 +1,257 @@
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/text/freetype_font.hpp>
+#include <fastuidraw/text/glyph_layout_data.hpp>
+#include <fastuidraw/text/glyph_render_data_distance_field.hpp>
+
+#include "generic_command_line.hpp"
+#include "simple_time.hpp"
+
+/* Benchmark and quality comparison of the generators of
+   distance field glyph data of FontFreeType: generates the
+   distance field of a range of glyphs with each of the
+   generators of FontFreeType::RenderParams and reports the
+   time per glyph of each and the difference between the
+   texel values they produce. Does not need a window or a
+   GL context.
+ */
+
+class distance_field_benchmark:public command_line_register
+{
+public:
+  distance_field_benchmark(void);
+
+  int
+  main(int argc, char **argv);
+
+private:
+  typedef fastuidraw::GlyphRenderDataDistanceField distance_field;
+
+  int64_t
+  generate(fastuidraw::FontFreeType::RenderParams::distance_field_generator_t generator,
+           std::vector<distance_field*> &out_data);
+
+  void
+  compare(void);
+
+  command_line_argument_value<std::string> m_font;
+  command_line_argument_value<int> m_face_index;
+  command_line_argument_value<unsigned int> m_pixel_size;
+  command_line_argument_value<float> m_max_distance;
+  command_line_argument_value<int> m_first_glyph, m_num_glyphs;
+  command_line_argument_value<int> m_num_runs;
+
+  fastuidraw::reference_counted_ptr<fastuidraw::FreetypeLib> m_ft_lib;
+  std::vector<uint32_t> m_glyph_codes;
+  std::vector<distance_field*> m_solver_data, m_sweep_data;
+};
+
+distance_field_benchmark::
+distance_field_benchmark(void):
+  m_font("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", "font",
+         "File from which to take font", *this),
+  m_face_index(0, "face_index", "Face index of the font in the file", *this),
+  m_pixel_size(48, "pixel_size",
+               "Pixel size at which to generate distance fields, "
+               "as in FontFreeType::RenderParams::distance_field_pixel_size()", *this),
+  m_max_distance(96.0f, "max_distance",
+                 "Maximum distance recorded in 1/64'th of a pixel, "
+                 "as in FontFreeType::RenderParams::distance_field_max_distance()", *this),
+  m_first_glyph(0, "first_glyph", "Glyph code of the first glyph to generate", *this),
+  m_num_glyphs(-1, "num_glyphs",
+               "Number of glyphs to generate, a negative value means "
+               "all the glyphs of the font from first_glyph", *this),
+  m_num_runs(1, "num_runs",
+             "Number of times to generate the glyphs with each generator", *this)
+{}
+
+int64_t
+distance_field_benchmark::
+generate(fastuidraw::FontFreeType::RenderParams::distance_field_generator_t generator,
+         std::vector<distance_field*> &out_data)
+{
+  using namespace fastuidraw;
+
+  FontFreeType::RenderParams params;
+  reference_counted_ptr<FontFreeType> font;
+  simple_time timer;
+  int64_t return_value;
+
+  params
+    .distance_field_pixel_size(m_pixel_size.m_value)
+    .distance_field_max_distance(m_max_distance.m_value)
+    .distance_field_generator(generator);
+  font = FontFreeType::create(m_font.m_value.c_str(), m_ft_lib, params, m_face_index.m_value);
+  if(!font)
+    {
+      return -1;
+    }
+
+  timer.restart_us();
+  for(int run = 0; run < m_num_runs.m_value; ++run)
+    {
+      for(unsigned int i = 0; i < m_glyph_codes.size(); ++i)
+        {
+          GlyphRenderData *data;
+          GlyphLayoutData layout;
+          Path path;
+
+          data = font->compute_rendering_data(GlyphRender(distance_field_glyph),
+                                              m_glyph_codes[i], layout, path);
+          if(run + 1 == m_num_runs.m_value)
+            {
+              out_data.push_back(dynamic_cast<distance_field*>(data));
+            }
+          else
+            {
+              FASTUIDRAWdelete(data);
+            }
+        }
+    }
+  return_value = timer.elapsed_us();
+  return return_value;
+}
+
+void
+distance_field_benchmark::
+compare(void)
+{
+  /* the texel values are 8-bit values where 127.5 is on
+     the outline and the distance is normalized to the
+     range [0, 127.5] on each side of the outline.
+   */
+  uint64_t num_texels(0), num_near_texels(0);
+  uint64_t num_sign_mismatches(0), num_size_mismatches(0);
+  uint64_t sum_diff(0), sum_near_diff(0);
+  int max_diff(0), max_near_diff(0);
+
+  for(unsigned int i = 0; i < m_glyph_codes.size(); ++i)
+    {
+      fastuidraw::const_c_array<uint8_t> a, b;
+
+      if(m_solver_data[i]->resolution() != m_sweep_data[i]->resolution())
+        {
+          ++num_size_mismatches;
+          continue;
+        }
+
+      a = m_solver_data[i]->distance_values();
+      b = m_sweep_data[i]->distance_values();
+      for(unsigned int t = 0; t < a.size(); ++t)
+        {
+          int diff;
+
+          diff = std::abs(static_cast<int>(a[t]) - static_cast<int>(b[t]));
+          ++num_texels;
+          sum_diff += diff;
+          max_diff = std::max(max_diff, diff);
+          if((a[t] >= 128) != (b[t] >= 128))
+            {
+              ++num_sign_mismatches;
+            }
+
+          /* texels within a third of max_distance of the outline,
+             i.e. those that determine the anti-aliased edge
+           */
+          if(std::abs(static_cast<int>(a[t]) - 128) < 43)
+            {
+              ++num_near_texels;
+              sum_near_diff += diff;
+              max_near_diff = std::max(max_near_diff, diff);
+            }
+        }
+    }
+
+  std::cout << "Quality (sweep against solver, texel values in [0, 255]):\n"
+            << "\ttexels compared: " << num_texels << "\n"
+            << "\tglyphs with different resolution: " << num_size_mismatches << "\n"
+            << "\tinside/outside mismatches: " << num_sign_mismatches << "\n"
+            << "\tmean difference: " << static_cast<double>(sum_diff) / std::max(uint64_t(1), num_texels) << "\n"
+            << "\tmax difference: " << max_diff << "\n"
+            << "\tmean difference near outline: "
+            << static_cast<double>(sum_near_diff) / std::max(uint64_t(1), num_near_texels) << "\n"
+            << "\tmax difference near outline: " << max_near_diff << "\n"
+            << "Note: the solver computes the L1 distance and the sweep the Euclidean\n"
+            << "distance, so differences grow away from the outline along diagonals.\n";
+}
+
+int
+distance_field_benchmark::
+main(int argc, char **argv)
+{
+  using namespace fastuidraw;
+
+  int64_t solver_us, sweep_us;
+  reference_counted_ptr<FontFreeType> font;
+  double num_generated;
+  int end_glyph;
+
+  if(argc == 2 && std::string(argv[1]) == "--help")
+    {
+      std::cout << "Usage: " << argv[0] << " [options]\n";
+      print_help(std::cout);
+      print_detailed_help(std::cout);
+      return 0;
+    }
+  parse_command_line(argc, argv);
+  std::cout << "\n";
+
+  m_ft_lib = FASTUIDRAWnew FreetypeLib();
+  font = FontFreeType::create(m_font.m_value.c_str(), m_ft_lib,
+                              FontFreeType::RenderParams(), m_face_index.m_value);
+  if(!font)
+    {
+      std::cout << "Unable to load font \"" << m_font.m_value << "\"\n";
+      return -1;
+    }
+
+  end_glyph = font->face()->num_glyphs;
+  if(m_num_glyphs.m_value >= 0)
+    {
+      end_glyph = std::min(end_glyph, m_first_glyph.m_value + m_num_glyphs.m_value);
+    }
+  for(int g = std::max(0, m_first_glyph.m_value); g < end_glyph; ++g)
+    {
+      m_glyph_codes.push_back(g);
+    }
+  font.clear();
+
+  if(m_glyph_codes.empty() || m_num_runs.m_value <= 0)
+    {
+      std::cout << "No glyphs to generate\n";
+      return -1;
+    }
+
+  solver_us = generate(FontFreeType::RenderParams::distance_field_solver, m_solver_data);
+  sweep_us = generate(FontFreeType::RenderParams::distance_field_sweep, m_sweep_data);
+
+  num_generated = static_cast<double>(m_glyph_codes.size() * m_num_runs.m_value);
+  std::cout << "Generated " << m_glyph_codes.size() << " glyphs " << m_num_runs.m_value
+            << " times with each generator:\n"
+            << "\tsolver: " << static_cast<double>(solver_us) / num_generated << " us/glyph\n"
+            << "\tsweep: " << static_cast<double>(sweep_us) / num_generated << " us/glyph\n"
+            << "\tspeedup: " << static_cast<double>(solver_us) / static_cast<double>(std::max(int64_t(1), sweep_us))
+            << "\n";
+  compare();
+
+  for(unsigned int i = 0; i < m_glyph_codes.size(); ++i)
+    {
+      FASTUIDRAWdelete(m_solver_data[i]);
+      FASTUIDRAWdelete(m_sweep_data[i]);
+    }
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  distance_field_benchmark B;
+  return B.main(argc, argv);
+}
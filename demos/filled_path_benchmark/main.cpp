@@ -0,0 +1,212 @@
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <new>
+#include <stdlib.h>
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/tessellated_path.hpp>
+#include <fastuidraw/filled_path.hpp>
+
+#include "generic_command_line.hpp"
+#include "simple_time.hpp"
+#include "read_path.hpp"
+
+/* Micro-benchmark for the construction of FilledPath
+   objects: for each path file passed on the command
+   line, the FilledPath of its TessellatedPath is built
+   repeatedly and the wall time and the number of heap
+   allocations made per FilledPath are reported. The
+   allocations are counted by replacing the global
+   operator new/delete, so allocations made directly
+   with malloc are not counted.
+ */
+
+namespace
+{
+  uint64_t number_allocations = 0;
+  uint64_t number_bytes_allocated = 0;
+}
+
+void*
+operator new(std::size_t n)
+{
+  void *return_value;
+
+  ++number_allocations;
+  number_bytes_allocated += n;
+  return_value = malloc(n);
+  if(return_value == NULL)
+    {
+      throw std::bad_alloc();
+    }
+  return return_value;
+}
+
+void*
+operator new[](std::size_t n)
+{
+  return operator new(n);
+}
+
+void
+operator delete(void *ptr) throw()
+{
+  free(ptr);
+}
+
+void
+operator delete[](void *ptr) throw()
+{
+  free(ptr);
+}
+
+void
+operator delete(void *ptr, std::size_t) throw()
+{
+  free(ptr);
+}
+
+void
+operator delete[](void *ptr, std::size_t) throw()
+{
+  free(ptr);
+}
+
+class filled_path_benchmark:public command_line_register
+{
+public:
+  filled_path_benchmark(void);
+
+  int
+  main(int argc, char **argv);
+
+private:
+  void
+  run_benchmark(const std::string &filename);
+
+  command_line_argument_value<unsigned int> m_num_runs;
+  command_line_argument_value<bool> m_whole_path;
+};
+
+filled_path_benchmark::
+filled_path_benchmark(void):
+  m_num_runs(100, "num_runs",
+             "Number of times to construct the FilledPath of each path", *this),
+  m_whole_path(true, "whole_path",
+               "If true, each run also builds the data of the entire "
+               "FilledPath (i.e. FilledPath::points()), if false only "
+               "the leaf FilledPath::Subset objects are built", *this)
+{}
+
+void
+filled_path_benchmark::
+run_benchmark(const std::string &filename)
+{
+  fastuidraw::Path path;
+  std::ifstream path_file(filename.c_str());
+
+  if(!path_file)
+    {
+      std::cout << "Unable to open \"" << filename << "\"\n";
+      return;
+    }
+
+  std::stringstream buffer;
+  buffer << path_file.rdbuf();
+  read_path(path, buffer.str());
+
+  const fastuidraw::TessellatedPath &tess(*path.tessellation());
+  unsigned int num_runs(fastuidraw::t_max(m_num_runs.m_value, 1u));
+  unsigned int num_points(0), num_indices(0);
+  uint64_t start_allocations, start_bytes, total_us;
+  simple_time timer;
+
+  start_allocations = number_allocations;
+  start_bytes = number_bytes_allocated;
+  for(unsigned int run = 0; run < num_runs; ++run)
+    {
+      fastuidraw::FilledPath *filled;
+
+      filled = FASTUIDRAWnew fastuidraw::FilledPath(tess);
+      for(unsigned int i = 0, endi = filled->number_subsets(); i < endi; ++i)
+        {
+          fastuidraw::FilledPath::Subset S(filled->subset(i));
+          if(S.is_leaf())
+            {
+              S.winding_numbers();
+            }
+        }
+
+      if(m_whole_path.m_value)
+        {
+          fastuidraw::const_c_array<int> windings(filled->winding_numbers());
+
+          num_points = filled->points().size();
+          num_indices = 0;
+          for(unsigned int w = 0; w < windings.size(); ++w)
+            {
+              num_indices += filled->indices(windings[w]).size();
+            }
+        }
+      FASTUIDRAWdelete(filled);
+    }
+  total_us = timer.elapsed_us();
+
+  std::cout << filename << ":\n"
+            << "\tpoints in TessellatedPath: " << tess.point_data().size() << "\n";
+  if(m_whole_path.m_value)
+    {
+      std::cout << "\tpoints in FilledPath: " << num_points << "\n"
+                << "\tindices in FilledPath: " << num_indices << "\n";
+    }
+  std::cout << "\ttime per FilledPath: "
+            << static_cast<double>(total_us) / static_cast<double>(num_runs) << " us\n"
+            << "\tallocations per FilledPath: "
+            << static_cast<double>(number_allocations - start_allocations) / static_cast<double>(num_runs) << "\n"
+            << "\tbytes allocated per FilledPath: "
+            << static_cast<double>(number_bytes_allocated - start_bytes) / static_cast<double>(num_runs) << "\n";
+}
+
+int
+filled_path_benchmark::
+main(int argc, char **argv)
+{
+  std::vector<std::string> files;
+
+  if(argc == 1 || (argc == 2 && std::string(argv[1]) == "--help"))
+    {
+      std::cout << "Usage: " << argv[0] << " [options] file0 file1 ...\n"
+                << "where each file is a path file as read by painter-path-test";
+      print_help(std::cout);
+      print_detailed_help(std::cout);
+      return 0;
+    }
+
+  /* arguments that are not options are path files */
+  for(int i = 1; i < argc; ++i)
+    {
+      if(std::string(argv[i]).find('=') == std::string::npos)
+        {
+          files.push_back(argv[i]);
+        }
+    }
+  parse_command_line(argc, argv);
+  std::cout << "\n";
+
+  for(unsigned int i = 0; i < files.size(); ++i)
+    {
+      run_benchmark(files[i]);
+    }
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  filled_path_benchmark B;
+  return B.main(argc, argv);
+}
@@ -165,7 +165,8 @@ painter_cells(void):
                   enumerated_string_type<enum fastuidraw::glyph_type>()
                   .add_entry("coverage", fastuidraw::coverage_glyph, "coverage glyphs (i.e. alpha masks)")
                   .add_entry("distance_field", fastuidraw::distance_field_glyph, "distance field glyphs")
-                  .add_entry("curve_pair", fastuidraw::curve_pair_glyph, "curve-pair glyphs"),
+                  .add_entry("curve_pair", fastuidraw::curve_pair_glyph, "curve-pair glyphs")
+                  .add_entry("msdf", fastuidraw::msdf_glyph, "multi-channel distance field glyphs"),
                   "text_renderer",
                   "Specifies how to render text", *this),
   m_text_renderer_realized_pixel_size(24,
@@ -329,7 +330,7 @@ derived_init(int w, int h)
   m_table_params.m_cell_count = ivec2(m_num_cells_x.m_value, m_num_cells_y.m_value);
   m_table_params.m_line_color = vec4(1.0f, 1.0f, 1.0f, 1.0f);
   m_table_params.m_cell_state = &m_cell_shared_state;
-  m_table_params.m_zoomer = &m_zoomer;
+  m_table_params.m_zoomer = &m_zoomer.transformation();
   m_table_params.m_draw_image_name = m_draw_image_name.m_value;
   m_table_params.m_table_rotate_degrees_per_s = m_table_rotate_degrees_per_s.m_value;
   m_table_params.m_timer_based_animation = (m_num_frames.m_value <= 0);
@@ -266,8 +266,8 @@ void
 Table::
 pre_paint()
 {
-  m_bb_min = m_params.m_zoomer->transformation().apply_inverse_to_point(m_bb_min);
-  m_bb_max = m_params.m_zoomer->transformation().apply_inverse_to_point(m_bb_max);
+  m_bb_min = m_params.m_zoomer->apply_inverse_to_point(m_bb_min);
+  m_bb_max = m_params.m_zoomer->apply_inverse_to_point(m_bb_max);
 
   if(m_rotating)
     {
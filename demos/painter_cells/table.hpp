@@ -9,7 +9,7 @@
 #include "PainterWidget.hpp"
 #include "cell_group.hpp"
 #include "simple_time.hpp"
-#include "PanZoomTracker.hpp"
+#include "ScaleTranslate.hpp"
 
 using namespace fastuidraw;
 
@@ -38,7 +38,7 @@ public:
   vec2 m_min_speed, m_max_speed;
   float m_min_degrees_per_s, m_max_degrees_per_s;
   CellSharedState *m_cell_state;
-  const PanZoomTracker *m_zoomer;
+  const ScaleTranslate<float> *m_zoomer;
 };
 
 class Table:public CellGroup
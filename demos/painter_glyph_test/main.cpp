@@ -60,6 +60,7 @@ private:
       draw_glyph_coverage,
       draw_glyph_curvepair,
       draw_glyph_distance,
+      draw_glyph_msdf,
 
       number_draw_modes
     };
@@ -71,6 +72,7 @@ private:
   command_line_argument_value<int> m_distance_pixel_size;
   command_line_argument_value<float> m_max_distance;
   command_line_argument_value<int> m_curve_pair_pixel_size;
+  command_line_argument_value<int> m_msdf_pixel_size;
   command_line_argument_value<std::string> m_text;
   command_line_argument_value<bool> m_use_file;
   command_line_argument_value<bool> m_draw_glyph_set;
@@ -109,6 +111,7 @@ painter_glyph_test(void):
                  "value to use for max distance in 64'ths of a pixel "
                  "when generating distance field glyphs", *this),
   m_curve_pair_pixel_size(48, "curvepair_pixel_size", "Pixel size at which to create distance curve pair glyphs", *this),
+  m_msdf_pixel_size(24, "msdf_pixel_size", "Pixel size at which to create multi-channel distance field glyphs", *this),
   m_text("Hello World!", "text", "text to draw to the screen", *this),
   m_use_file(false, "use_file", "if true the value for text gives a filename to display", *this),
   m_draw_glyph_set(false, "draw_glyph_set", "if true, display all glyphs of font instead of text", *this),
@@ -123,7 +126,8 @@ painter_glyph_test(void):
   m_current_drawer(draw_glyph_curvepair)
 {
   std::cout << "Controls:\n"
-            << "\td:cycle drawing mode: draw coverage glyph, draw distance glyphs "
+            << "\td:cycle drawing mode: draw coverage glyph, draw distance glyphs, "
+            << "draw curve pair glyphs, draw multi-channel distance glyphs "
             << "[hold shift, control or mode to reverse cycle]\n"
             << "\ta:Toggle using anistropic anti-alias glyph rendering\n"
             << "\td:Cycle though text renderer\n"
@@ -155,7 +159,8 @@ create_and_add_font(void)
                       FontFreeType::RenderParams()
                       .distance_field_max_distance(m_max_distance.m_value)
                       .distance_field_pixel_size(m_distance_pixel_size.m_value)
-                      .curve_pair_pixel_size(m_curve_pair_pixel_size.m_value));
+                      .curve_pair_pixel_size(m_curve_pair_pixel_size.m_value)
+                      .msdf_pixel_size(m_msdf_pixel_size.m_value));
 
   reference_counted_ptr<const FontBase> font;
 
@@ -232,6 +237,9 @@ compute_glyphs_and_positions(fastuidraw::GlyphRender renderer,
         case curve_pair_glyph:
           div_scale_factor = m_font->render_params().curve_pair_pixel_size();
           break;
+        case msdf_glyph:
+          div_scale_factor = m_font->render_params().msdf_pixel_size();
+          break;
 
         default:
           div_scale_factor = renderer.m_pixel_size;
@@ -370,6 +378,18 @@ ready_glyph_attribute_data(void)
                                                                             m_render_pixel_size.m_value));
     m_draw_labels[draw_glyph_curvepair] = "draw_glyph_curvepair";
   }
+
+  {
+    GlyphRender renderer(msdf_glyph);
+    change_glyph_renderer(renderer,
+                          cast_c_array(m_glyphs[draw_glyph_coverage]),
+                          m_glyphs[draw_glyph_msdf],
+                          cast_c_array(character_codes));
+    m_draws[draw_glyph_msdf].set_data(PainterAttributeDataFillerGlyphs(cast_c_array(m_glyph_positions),
+                                                                       cast_c_array(m_glyphs[draw_glyph_msdf]),
+                                                                       m_render_pixel_size.m_value));
+    m_draw_labels[draw_glyph_msdf] = "draw_glyph_msdf";
+  }
 }
 
 void
@@ -0,0 +1,17 @@
+# Begin standard header
+sp 		:= $(sp).x
+dirstack_$(sp)	:= $(d)
+d		:= $(dir)
+# End standard header
+
+
+HEADLESS_DEMOS += painter-headless-benchmark
+painter-headless-benchmark_SOURCES := $(call filelist, main.cpp) \
+	$(addprefix demos/painter_cells/, cell.cpp table.cpp cell_group.cpp) \
+	$(addprefix demos/common/, generic_command_line.cpp read_path.cpp \
+	text_helper.cpp random.cpp PainterWidget.cpp)
+
+# Begin standard footer
+d		:= $(dirstack_$(sp))
+sp		:= $(basename $(sp))
+# End standard footer
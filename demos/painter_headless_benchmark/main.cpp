@@ -0,0 +1,465 @@
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <stdint.h>
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/math.hpp>
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/painter/painter.hpp>
+#include <fastuidraw/glsl/painter_backend_null.hpp>
+#include <fastuidraw/glsl/painter_backend_recorder.hpp>
+#include <fastuidraw/text/glyph_cache.hpp>
+#include <fastuidraw/text/glyph_selector.hpp>
+#include <fastuidraw/text/freetype_font.hpp>
+
+#include "generic_command_line.hpp"
+#include "simple_time.hpp"
+#include "read_path.hpp"
+#include "ScaleTranslate.hpp"
+#include "../painter_cells/cell.hpp"
+#include "../painter_cells/table.hpp"
+
+/* Headless benchmark of the CPU side of drawing: drives the
+   workloads of painter-cells and painter-path-test through a
+   Painter whose backend is a PainterBackendNull (or, when
+   a trace file is given, a PainterBackendRecorder) so that
+   neither a window nor a GL context is needed. Reports the
+   time per frame and the packing throughput as given by the
+   statistics of the PainterPacker.
+ */
+
+enum workload_t
+  {
+    cells_workload,
+    path_workload,
+  };
+
+class painter_headless_benchmark:public command_line_register
+{
+public:
+  painter_headless_benchmark(void);
+
+  ~painter_headless_benchmark();
+
+  int
+  main(int argc, char **argv);
+
+private:
+  void
+  init_painter(void);
+
+  void
+  init_cells(void);
+
+  void
+  init_path(void);
+
+  void
+  draw_cells(void);
+
+  void
+  draw_path(int frame);
+
+  command_line_argument_value<std::string> m_workload_name;
+  command_line_argument_value<int> m_width, m_height;
+  command_line_argument_value<int> m_num_frames, m_skip_frames;
+  command_line_argument_value<unsigned int> m_reorder_window;
+  command_line_argument_value<bool> m_intern_values;
+  command_line_argument_value<std::string> m_trace_file;
+  command_line_argument_value<bool> m_trace_record_data;
+
+  command_line_argument_value<float> m_table_width, m_table_height;
+  command_line_argument_value<int> m_num_cells_x, m_num_cells_y;
+  command_line_argument_value<int> m_cell_group_size;
+  command_line_argument_value<std::string> m_font;
+  command_line_argument_value<float> m_pixel_size;
+  command_line_argument_value<bool> m_draw_text;
+  command_line_argument_value<bool> m_cell_rotating;
+  command_line_argument_value<bool> m_table_rotating;
+
+  command_line_argument_value<std::string> m_path_file;
+  command_line_argument_value<int> m_num_paths_x, m_num_paths_y;
+  command_line_argument_value<float> m_stroke_width;
+
+  enum workload_t m_workload;
+  fastuidraw::reference_counted_ptr<fastuidraw::glsl::PainterBackendNull> m_backend;
+  fastuidraw::reference_counted_ptr<fastuidraw::glsl::PainterBackendRecorder> m_recorder;
+  fastuidraw::reference_counted_ptr<fastuidraw::Painter> m_painter;
+  fastuidraw::reference_counted_ptr<fastuidraw::GlyphCache> m_glyph_cache;
+  fastuidraw::reference_counted_ptr<fastuidraw::GlyphSelector> m_glyph_selector;
+  fastuidraw::reference_counted_ptr<fastuidraw::FreetypeLib> m_ft_lib;
+
+  CellSharedState m_cell_shared_state;
+  TableParams m_table_params;
+  ScaleTranslate<float> m_view;
+  Table *m_table;
+
+  fastuidraw::Path m_path;
+  fastuidraw::PainterPackedValue<fastuidraw::PainterBrush> m_fill_brush, m_stroke_brush;
+  fastuidraw::PainterPackedValue<fastuidraw::PainterItemShaderData> m_stroke_params;
+};
+
+painter_headless_benchmark::
+painter_headless_benchmark(void):
+  m_workload_name("cells", "workload",
+                  "Workload to run, one of: cells (the workload of painter-cells) "
+                  "or path (the workload of painter-path-test)", *this),
+  m_width(800, "width", "Width of the (virtual) render target", *this),
+  m_height(600, "height", "Height of the (virtual) render target", *this),
+  m_num_frames(100, "num_frames", "Number of frames to benchmark", *this),
+  m_skip_frames(1, "num_skip_frames",
+                "Number of frames to run before benchmarking", *this),
+  m_reorder_window(0, "reorder_window",
+                   "If non-zero, the reorder window of the PainterPacker", *this),
+  m_intern_values(false, "intern_values",
+                  "If true, the PainterPacker interns the data of values", *this),
+  m_trace_file("", "trace_file",
+               "If non-empty, draw with a PainterBackendRecorder and write the "
+               "trace of the benchmarked frames to the named file", *this),
+  m_trace_record_data(false, "trace_record_data",
+                      "If true, the trace has the attribute, index and data store "
+                      "values in full instead of hashes of them", *this),
+  m_table_width(800, "table_width", "cells workload: Table Width", *this),
+  m_table_height(600, "table_height", "cells workload: Table Height", *this),
+  m_num_cells_x(10, "num_cells_x", "cells workload: Number of cells across", *this),
+  m_num_cells_y(10, "num_cells_y", "cells workload: Number of cells down", *this),
+  m_cell_group_size(1, "cell_group_size",
+                    "cells workload: width and height in number of cells for cell group size",
+                    *this),
+  m_font("/usr/share/fonts/truetype/dejavu/DejaVuSans.ttf", "font",
+         "cells workload: File from which to take font", *this),
+  m_pixel_size(24.0f, "font_pixel_size", "cells workload: Render size for text rendering", *this),
+  m_draw_text(true, "draw_text", "cells workload: If true, draw text in cells", *this),
+  m_cell_rotating(false, "cell_rotating", "cells workload: If true, cells rotate", *this),
+  m_table_rotating(false, "table_rotating", "cells workload: If true, table rotates", *this),
+  m_path_file("", "path_file",
+              "path workload: if non-empty, file from which to read the path "
+              "(as read by painter-path-test)", *this),
+  m_num_paths_x(4, "num_paths_x", "path workload: Number of copies of the path across", *this),
+  m_num_paths_y(4, "num_paths_y", "path workload: Number of copies of the path down", *this),
+  m_stroke_width(8.0f, "stroke_width", "path workload: width with which to stroke", *this),
+  m_workload(cells_workload),
+  m_table(NULL)
+{}
+
+painter_headless_benchmark::
+~painter_headless_benchmark()
+{
+  if(m_table != NULL)
+    {
+      FASTUIDRAWdelete(m_table);
+    }
+}
+
+void
+painter_headless_benchmark::
+init_painter(void)
+{
+  if(!m_trace_file.m_value.empty())
+    {
+      m_recorder = FASTUIDRAWnew fastuidraw::glsl::PainterBackendRecorder(m_trace_record_data.m_value);
+      m_backend = m_recorder;
+    }
+  else
+    {
+      m_backend = FASTUIDRAWnew fastuidraw::glsl::PainterBackendNull();
+    }
+
+  m_painter = FASTUIDRAWnew fastuidraw::Painter(m_backend);
+  m_painter->target_resolution(m_width.m_value, m_height.m_value);
+  m_painter->packer_reorder_window(m_reorder_window.m_value);
+  m_painter->packer_intern_values(m_intern_values.m_value);
+
+  m_glyph_cache = FASTUIDRAWnew fastuidraw::GlyphCache(m_painter->glyph_atlas());
+  m_glyph_selector = FASTUIDRAWnew fastuidraw::GlyphSelector(m_glyph_cache);
+  m_ft_lib = FASTUIDRAWnew fastuidraw::FreetypeLib();
+}
+
+void
+painter_headless_benchmark::
+init_cells(void)
+{
+  using namespace fastuidraw;
+
+  m_table_params.m_wh = vec2(m_table_width.m_value, m_table_height.m_value);
+  m_table_params.m_cell_count = ivec2(m_num_cells_x.m_value, m_num_cells_y.m_value);
+  m_table_params.m_line_color = vec4(1.0f, 1.0f, 1.0f, 1.0f);
+  m_table_params.m_cell_state = &m_cell_shared_state;
+  m_table_params.m_zoomer = &m_view;
+  m_table_params.m_draw_image_name = false;
+  m_table_params.m_table_rotate_degrees_per_s = 20;
+  /* animation advances by a fixed amount each frame
+     so that each run draws the same frames.
+   */
+  m_table_params.m_timer_based_animation = false;
+  m_table_params.m_glyph_selector = m_glyph_selector;
+  m_table_params.m_font = FontFreeType::create(m_font.m_value.c_str(), m_ft_lib, FontFreeType::RenderParams());
+  m_table_params.m_text_render = GlyphRender(curve_pair_glyph);
+  m_table_params.m_pixel_size = m_pixel_size.m_value;
+  m_table_params.m_background_colors.push_back(vec4(0.0f, 0.0f, 1.0f, 0.5f));
+  m_table_params.m_text_colors.push_back(vec4(1.0f, 1.0f, 1.0f, 0.8f));
+  m_table_params.m_min_speed = vec2(-10.0f, -10.0f);
+  m_table_params.m_max_speed = vec2(10.0f, 10.0f);
+  m_table_params.m_min_degrees_per_s = 60;
+  m_table_params.m_max_degrees_per_s = 60;
+
+  if(m_cell_group_size.m_value > 0)
+    {
+      m_table_params.m_max_cell_group_size = m_cell_group_size.m_value;
+    }
+  else
+    {
+      m_table_params.m_max_cell_group_size = 2 * std::max(m_num_cells_x.m_value, m_num_cells_y.m_value);
+    }
+
+  if(!m_table_params.m_font)
+    {
+      std::cout << "Unable to load font \"" << m_font.m_value << "\", text not drawn\n";
+    }
+
+  m_table = FASTUIDRAWnew Table(m_table_params);
+  m_table->m_rotating = m_table_rotating.m_value;
+  m_cell_shared_state.m_draw_text = m_draw_text.m_value && m_table_params.m_font;
+  m_cell_shared_state.m_draw_image = false;
+  m_cell_shared_state.m_rotating = m_cell_rotating.m_value;
+
+  /* show the entire table */
+  vec2 wh(m_width.m_value, m_height.m_value), twh;
+  ScaleTranslate<float> sc, tr1, tr2;
+
+  twh = m_table_params.m_wh / wh;
+  tr1.translation(-0.5f * m_table_params.m_wh);
+  tr2.translation(0.5f * wh);
+  sc.scale(1.0f / std::max(twh.x(), twh.y()));
+  m_view = tr2 * sc * tr1;
+}
+
+void
+painter_headless_benchmark::
+init_path(void)
+{
+  using namespace fastuidraw;
+
+  if(!m_path_file.m_value.empty())
+    {
+      std::ifstream path_file(m_path_file.m_value.c_str());
+      if(path_file)
+        {
+          std::stringstream buffer;
+          buffer << path_file.rdbuf();
+          read_path(m_path, buffer.str());
+        }
+      else
+        {
+          std::cout << "Unable to open \"" << m_path_file.m_value
+                    << "\", using default path\n";
+        }
+    }
+
+  if(m_path.number_contours() == 0)
+    {
+      m_path << vec2(300.0f, 300.0f)
+             << Path::contour_end()
+             << vec2(50.0f, 35.0f)
+             << Path::control_point(60.0f, 50.0f)
+             << vec2(70.0f, 35.0f)
+             << Path::arc_degrees(180.0, vec2(70.0f, -100.0f))
+             << Path::control_point(60.0f, -150.0f)
+             << Path::control_point(30.0f, -50.0f)
+             << vec2(0.0f, -100.0f)
+             << Path::contour_end_arc_degrees(90.0f)
+             << vec2(200.0f, 200.0f)
+             << vec2(400.0f, 200.0f)
+             << vec2(400.0f, 400.0f)
+             << vec2(200.0f, 400.0f)
+             << Path::contour_end()
+             << vec2(-50.0f, 100.0f)
+             << vec2(0.0f, 200.0f)
+             << vec2(100.0f, 300.0f)
+             << vec2(150.0f, 325.0f)
+             << vec2(150.0f, 100.0f)
+             << Path::contour_end();
+    }
+
+  PainterBrush fill_brush, stroke_brush;
+  PainterStrokeParams st;
+
+  fill_brush.pen(1.0f, 0.5f, 0.0f, 0.8f);
+  stroke_brush.pen(0.0f, 1.0f, 1.0f, 0.8f);
+  st.miter_limit(5.0f);
+  st.width(m_stroke_width.m_value);
+
+  m_fill_brush = m_painter->packed_value_pool().create_packed_value(fill_brush);
+  m_stroke_brush = m_painter->packed_value_pool().create_packed_value(stroke_brush);
+  m_stroke_params = m_painter->packed_value_pool().create_packed_value(st);
+}
+
+void
+painter_headless_benchmark::
+draw_cells(void)
+{
+  m_painter->save();
+  m_painter->translate(m_view.translation());
+  m_painter->scale(m_view.scale());
+  m_table->m_bb_min = fastuidraw::vec2(0.0f, 0.0f);
+  m_table->m_bb_max = fastuidraw::vec2(m_width.m_value, m_height.m_value);
+  m_table->paint(m_painter);
+  m_painter->restore();
+}
+
+void
+painter_headless_benchmark::
+draw_path(int frame)
+{
+  using namespace fastuidraw;
+
+  vec2 cell_size, path_size;
+  float angle;
+
+  cell_size = vec2(m_width.m_value, m_height.m_value)
+    / vec2(std::max(1, m_num_paths_x.m_value), std::max(1, m_num_paths_y.m_value));
+  path_size = vec2(450.0f, 550.0f);
+  angle = static_cast<float>(frame % 360) * static_cast<float>(M_PI) / 180.0f;
+
+  for(int y = 0; y < m_num_paths_y.m_value; ++y)
+    {
+      for(int x = 0; x < m_num_paths_x.m_value; ++x)
+        {
+          m_painter->save();
+          m_painter->translate((vec2(x, y) + vec2(0.5f, 0.5f)) * cell_size);
+          m_painter->rotate(angle);
+          m_painter->scale(std::min(cell_size.x() / path_size.x(), cell_size.y() / path_size.y()));
+          m_painter->translate(vec2(-225.0f, -250.0f));
+          m_painter->fill_path(PainterData(m_fill_brush), m_path,
+                               PainterEnums::nonzero_fill_rule);
+          m_painter->stroke_path(PainterData(m_stroke_brush, m_stroke_params), m_path,
+                                 PainterEnums::rounded_caps, PainterEnums::rounded_joins,
+                                 true);
+          m_painter->restore();
+        }
+    }
+}
+
+int
+painter_headless_benchmark::
+main(int argc, char **argv)
+{
+  using namespace fastuidraw;
+
+  if(argc == 2 && std::string(argv[1]) == "--help")
+    {
+      std::cout << "Usage: " << argv[0] << " [options]\n";
+      print_help(std::cout);
+      print_detailed_help(std::cout);
+      return 0;
+    }
+  parse_command_line(argc, argv);
+  std::cout << "\n";
+
+  if(m_workload_name.m_value == "cells")
+    {
+      m_workload = cells_workload;
+    }
+  else if(m_workload_name.m_value == "path")
+    {
+      m_workload = path_workload;
+    }
+  else
+    {
+      std::cout << "Unknown workload \"" << m_workload_name.m_value << "\"\n";
+      return -1;
+    }
+
+  init_painter();
+  if(m_workload == cells_workload)
+    {
+      init_cells();
+    }
+  else
+    {
+      init_path();
+    }
+
+  float3x3 proj(float_orthogonal_projection_params(0, m_width.m_value, m_height.m_value, 0));
+  vecN<uint64_t, PainterPacker::num_stats> totals(0);
+  int num_frames(std::max(1, m_num_frames.m_value));
+  simple_time timer;
+
+  for(int frame = -m_skip_frames.m_value; frame < num_frames; ++frame)
+    {
+      if(frame == 0)
+        {
+          timer.restart();
+          if(m_recorder)
+            {
+              m_recorder->clear_trace();
+            }
+        }
+
+      m_painter->begin();
+      m_painter->transformation(proj);
+      if(m_workload == cells_workload)
+        {
+          m_cell_shared_state.m_cells_drawn = 0;
+          draw_cells();
+        }
+      else
+        {
+          draw_path(frame);
+        }
+      m_painter->end();
+
+      if(frame >= 0)
+        {
+          for(unsigned int i = 0; i < PainterPacker::num_stats; ++i)
+            {
+              totals[i] += m_painter->query_packer_stat(static_cast<enum PainterPacker::stats_t>(i));
+            }
+        }
+    }
+
+  uint64_t total_us(timer.elapsed_us());
+  double per_frame(1.0 / static_cast<double>(num_frames));
+  double packing_s(static_cast<double>(t_max(totals[PainterPacker::packing_time_us], uint64_t(1))) * 1e-6);
+
+  std::cout << "Did " << num_frames << " frames in " << total_us << " us, average time = "
+            << static_cast<double>(total_us) * per_frame << " us\n"
+            << "Per frame:\n"
+            << "\tdraws: " << static_cast<double>(totals[PainterPacker::num_draws]) * per_frame << "\n"
+            << "\tdraw breaks: " << static_cast<double>(totals[PainterPacker::num_draw_breaks]) * per_frame << "\n"
+            << "\theaders: " << static_cast<double>(totals[PainterPacker::num_headers]) * per_frame << "\n"
+            << "\tattributes: " << static_cast<double>(totals[PainterPacker::num_attributes]) * per_frame << "\n"
+            << "\tindices: " << static_cast<double>(totals[PainterPacker::num_indices]) * per_frame << "\n"
+            << "\tstore blocks: " << static_cast<double>(totals[PainterPacker::num_store_blocks]) * per_frame << "\n"
+            << "\tpacking time: " << static_cast<double>(totals[PainterPacker::packing_time_us]) * per_frame << " us\n"
+            << "\tbackend time: " << static_cast<double>(totals[PainterPacker::backend_time_us]) * per_frame << " us\n"
+            << "Packing throughput:\n"
+            << "\t" << static_cast<double>(totals[PainterPacker::num_attributes]) / packing_s << " attributes/s\n"
+            << "\t" << static_cast<double>(totals[PainterPacker::num_indices]) / packing_s << " indices/s\n"
+            << "\t" << static_cast<double>(totals[PainterPacker::num_headers]) / packing_s << " headers/s\n";
+
+  if(m_recorder)
+    {
+      if(m_recorder->save_trace(m_trace_file.m_value.c_str()))
+        {
+          std::cout << "Trace of " << m_recorder->trace().size() << " bytes written to \""
+                    << m_trace_file.m_value << "\"\n";
+        }
+      else
+        {
+          std::cout << "Unable to write trace to \"" << m_trace_file.m_value << "\"\n";
+        }
+    }
+
+  return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+  painter_headless_benchmark B;
+  return B.main(argc, argv);
+}
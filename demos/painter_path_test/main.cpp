@@ -6,6 +6,7 @@
 #include <math.h>
 
 #include <fastuidraw/util/util.hpp>
+#include <fastuidraw/path_preparer.hpp>
 
 #include "sdl_painter_demo.hpp"
 #include "simple_time.hpp"
@@ -133,6 +134,7 @@ private:
   command_line_argument_value<float> m_radial_gradient_change_rate;
   command_line_argument_value<std::string> m_path_file;
   command_line_argument_value<bool> m_print_path;
+  command_line_argument_value<unsigned int> m_prepare_threads;
   color_stop_arguments m_color_stop_args;
   command_line_argument_value<std::string> m_image_file;
   command_line_argument_value<unsigned int> m_image_slack;
@@ -264,6 +266,11 @@ painter_stroke_test(void):
   m_print_path(false, "print_path",
                "If true, print the geometry data of the path drawn to stdout",
                *this),
+  m_prepare_threads(0, "prepare_threads",
+                    "If non-zero, build the fill and stroke data of the path "
+                    "with a PathPreparer using the specified number of threads "
+                    "and print the time taken to do so",
+                    *this),
   m_color_stop_args(*this),
   m_image_file("", "image", "if a valid file name, apply an image to drawing the fill", *this),
   m_image_slack(0, "image_slack", "amount of slack on tiles when loading image", *this),
@@ -942,6 +949,17 @@ create_stroked_path_attributes(void)
   P.m_curve_tessellation = 2.0f * float(M_PI) / static_cast<float>(m_points_per_circle.m_value);
   m_path.tessellation_params(P);
 
+  if(m_prepare_threads.m_value > 0)
+    {
+      simple_time prepare_timer;
+      PathPreparer preparer(m_prepare_threads.m_value);
+
+      preparer.add_path(m_path);
+      preparer.wait();
+      std::cout << "Prepared path with " << preparer.number_threads()
+                << " threads in " << prepare_timer.elapsed_us() << " us\n";
+    }
+
   m_max_miter = 0.0f;
   const_c_array<StrokedPath::point> miter_points;
   miter_points = m_path.tessellation()->stroked()->points(StrokedPath::miter_join_point_set, true);
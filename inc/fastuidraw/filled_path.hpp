@@ -21,8 +21,10 @@
 
 #include <fastuidraw/util/fastuidraw_memory.hpp>
 #include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/util/matrix.hpp>
 #include <fastuidraw/util/c_array.hpp>
 #include <fastuidraw/util/reference_counted.hpp>
+#include <fastuidraw/util/data_buffer.hpp>
 
 namespace fastuidraw  {
 
@@ -37,12 +39,97 @@ class Path;
 /*!
   A FilledPath represents the data needed to draw a path filled.
   It contains -all- the data needed to fill a path regardless of
-  the fill rule.
+  the fill rule. In addition, a FilledPath is partitioned into a
+  hierarchy of Subset objects, each with a bounding box so that
+  only those portions of a FilledPath that are visible need to be
+  drawn (see select_subsets()). The hierarchy is built by splitting
+  the path in half by a vertical or horizontal line recursively;
+  a Subset is the portion of the path within a rectangle.
  */
 class FilledPath:
     public reference_counted<FilledPath>::non_concurrent
 {
 public:
+  /*!
+    A Subset represents a handle to a portion of a FilledPath.
+    The handle is only valid while the FilledPath that created
+    it is alive. The data of a Subset is constructed lazily and
+    all index values of a Subset are into the points() of the
+    Subset (not the points() of the FilledPath). The lazy
+    construction of points(), indices(), winding_numbers()
+    and painter_data() may be triggered from several threads
+    simultaneously (see PathPreparer).
+   */
+  class Subset
+  {
+  public:
+    /*!
+      Returns the points of the Subset.
+     */
+    const_c_array<vec2>
+    points(void) const;
+
+    /*!
+      Returns an array listing what winding number values
+      for which indices() will return a non-empty array.
+      The array is sorted in ascending order.
+     */
+    const_c_array<int>
+    winding_numbers(void) const;
+
+    /*!
+      Return indices into points() to draw triangles of
+      the Subset of a given winding number.
+     */
+    const_c_array<unsigned int>
+    indices(int winding_number) const;
+
+    /*!
+      Returns data that can be passed to a PainterPacker
+      to fill the Subset. The data is organized exactly
+      as FilledPath::painter_data(), see
+      PainterAttributeDataFillerPathFill.
+     */
+    const PainterAttributeData&
+    painter_data(void) const;
+
+    /*!
+      Returns the minimum point of the bounding box of
+      the Subset. The bounding box contains all triangles
+      of the Subset, including those triangles with
+      winding number zero.
+     */
+    vec2
+    bounding_box_min(void) const;
+
+    /*!
+      Returns the maximum point of the bounding box of
+      the Subset. The bounding box contains all triangles
+      of the Subset, including those triangles with
+      winding number zero.
+     */
+    vec2
+    bounding_box_max(void) const;
+
+    /*!
+      Returns true if the Subset is not divided further.
+      The data of a leaf Subset is made by tessellating
+      its portion of the path; the data of a Subset that
+      is not a leaf is made by merging the data of the
+      leaf Subset objects it contains.
+     */
+    bool
+    is_leaf(void) const;
+
+  private:
+    friend class FilledPath;
+
+    explicit
+    Subset(void *d);
+
+    void *m_d;
+  };
+
   /*!
     Ctor. Construct a FilledPath from the data
     of a TessellatedPath.
@@ -118,7 +205,74 @@ public:
   const PainterAttributeData&
   painter_data(void) const;
 
+  /*!
+    Returns the number of Subset objects of the FilledPath.
+    Subset values are numbered so that the Subset with ID 0
+    is the entire FilledPath.
+   */
+  unsigned int
+  number_subsets(void) const;
+
+  /*!
+    Return the named Subset object of the FilledPath.
+    \param I ID of Subset to fetch, must be less than
+             number_subsets().
+   */
+  Subset
+  subset(unsigned int I) const;
+
+  /*!
+    Fetch those Subset objects that are at least partially
+    visible against a set of clip equations. The Subset
+    objects selected are disjoint and together they cover
+    all of the FilledPath that is visible. A Subset whose
+    bounding box is entirely within the clip equations is
+    taken instead of its descendants when doing so keeps the
+    size of the selected Subset small enough to be drawn as
+    one chunk. Returns the number of Subset ID's written
+    to dst.
+    \param clip_equations array of clip equations, in clip
+                          coordinates, a point p in clip
+                          coordinates is visible if
+                          dot(p, clip_equations[i]) >= 0
+                          for each i.
+    \param clip_matrix_local transformation from local coordinates
+                             of the FilledPath to clip coordinates
+    \param dst location to which to write the Subset ID's, must
+               be of size atleast number_subsets().
+   */
+  unsigned int
+  select_subsets(const_c_array<vec3> clip_equations,
+                 const float3x3 &clip_matrix_local,
+                 c_array<unsigned int> dst) const;
+
+  /*!
+    Write the data of this FilledPath to a BakedDataWriter:
+    the hierarchy of Subset objects together with the points,
+    indices and PainterAttributeData of each leaf Subset and
+    of each other Subset whose data has already been built.
+    The data of each leaf Subset is built if it is not yet
+    built. Typically, one bakes a FilledPath with
+    TessellatedPath::bake().
+    \param dst BakedDataWriter to which to write
+   */
+  void
+  bake(BakedDataWriter &dst) const;
+
+  /*!
+    Load a FilledPath written by bake(). The point, index
+    and attribute data are not copied, they point directly
+    into src.buffer(). Returns a NULL handle if the data
+    could not be read.
+    \param src BakedDataReader from which to read
+   */
+  static
+  reference_counted_ptr<const FilledPath>
+  load_baked(BakedDataReader &src);
+
 private:
+  FilledPath(void);
+
   void *m_d;
 };
 
@@ -0,0 +1,204 @@
+/*!
+ * \file painter_backend_null.hpp
+ * \brief file painter_backend_null.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/glsl/painter_backend_glsl.hpp>
+#include <fastuidraw/painter/packing/painter_draw.hpp>
+
+namespace fastuidraw
+{
+  namespace glsl
+  {
+/*!\addtogroup GLSLShaderBuilder
+  @{
+ */
+    /*!
+      A PainterBackendNull implements PainterBackend without
+      any 3D API: the glyph, image and colorstop atlases are
+      backed by CPU memory and the PainterDraw objects it
+      maps are CPU buffers that are never sent anywhere.
+      Shaders are absorbed as by PainterBackendGLSL, so the
+      GLSL uber-shaders can still be constructed with
+      construct_shader(). A PainterBackendNull is used to
+      run, benchmark and test the CPU side of Painter and
+      PainterPacker without a GL context. A derived class
+      can inspect what is drawn by implementing on_draw()
+      and on_draw_break().
+     */
+    class PainterBackendNull:public PainterBackendGLSL
+    {
+    public:
+      /*!
+        A ConfigurationNull gives parameters how to contruct
+        a PainterBackendNull.
+       */
+      class ConfigurationNull
+      {
+      public:
+        /*!
+          Ctor.
+         */
+        ConfigurationNull(void);
+
+        /*!
+          Copy ctor.
+          \param obj value from which to copy
+         */
+        ConfigurationNull(const ConfigurationNull &obj);
+
+        ~ConfigurationNull();
+
+        /*!
+          Assignment operator
+          \param rhs value from which to copy
+         */
+        ConfigurationNull&
+        operator=(const ConfigurationNull &rhs);
+
+        /*!
+          The number of attributes of each PainterDraw,
+          default is the same as PainterBackendGL.
+         */
+        unsigned int
+        attributes_per_buffer(void) const;
+
+        /*!
+          Set the value returned by attributes_per_buffer(void) const.
+         */
+        ConfigurationNull&
+        attributes_per_buffer(unsigned int v);
+
+        /*!
+          The number of indices of each PainterDraw,
+          default is the same as PainterBackendGL.
+         */
+        unsigned int
+        indices_per_buffer(void) const;
+
+        /*!
+          Set the value returned by indices_per_buffer(void) const.
+         */
+        ConfigurationNull&
+        indices_per_buffer(unsigned int v);
+
+        /*!
+          The size of the data store of each PainterDraw
+          in units of blocks, where each block is
+          PainterBackend::ConfigurationBase::alignment()
+          generic_data values. Default is the same as
+          PainterBackendGL.
+         */
+        unsigned int
+        data_blocks_per_store_buffer(void) const;
+
+        /*!
+          Set the value returned by data_blocks_per_store_buffer(void) const.
+         */
+        ConfigurationNull&
+        data_blocks_per_store_buffer(unsigned int v);
+
+      private:
+        void *m_d;
+      };
+
+      /*!
+        Ctor. Does not require a GL context.
+        \param config_null ConfigurationNull providing configuration parameters
+        \param config_glsl ConfigurationGLSL parameters inherited from
+                           PainterBackendGLSL; these only influence the
+                           shaders made by construct_shader()
+        \param config_base ConfigurationBase parameters inherited from PainterBackend
+       */
+      explicit
+      PainterBackendNull(const ConfigurationNull &config_null = ConfigurationNull(),
+                         const ConfigurationGLSL &config_glsl = ConfigurationGLSL(),
+                         const ConfigurationBase &config_base = ConfigurationBase());
+
+      ~PainterBackendNull();
+
+      /*!
+        Returns the ConfigurationNull passed in the ctor.
+       */
+      const ConfigurationNull&
+      configuration_null(void) const;
+
+      virtual
+      void
+      on_pre_draw(void);
+
+      virtual
+      void
+      on_post_draw(void);
+
+      virtual
+      reference_counted_ptr<const PainterDraw>
+      map_draw(void);
+
+    protected:
+      /*!
+        To be optionally implemented by a derived class to
+        see each draw break of a PainterDraw made by map_draw().
+        Called from within PainterDraw::draw_break() of the
+        PainterDraw, i.e. while it is being filled. Default
+        implementation does nothing.
+        \param draw PainterDraw on which the draw break is made
+        \param old_groups PainterShaderGroup before state change
+        \param new_groups PainterShaderGroup after state change
+        \param attributes_written number of attributes written before the change
+        \param indices_written number of indices written before the change
+       */
+      virtual
+      void
+      on_draw_break(const PainterDraw &draw,
+                    const PainterShaderGroup &old_groups,
+                    const PainterShaderGroup &new_groups,
+                    unsigned int attributes_written,
+                    unsigned int indices_written);
+
+      /*!
+        To be optionally implemented by a derived class to
+        see the contents of each PainterDraw made by map_draw().
+        Called from within PainterDraw::draw() of the PainterDraw,
+        i.e. between on_pre_draw() and on_post_draw(). Unlike
+        for a PainterBackendGL, the arrays of the PainterDraw
+        can be read. Default implementation does nothing.
+        \param draw PainterDraw being drawn
+        \param attributes_written number of elements written to
+                                  PainterDraw::m_attributes and
+                                  PainterDraw::m_header_attributes
+        \param indices_written number of elements written to
+                               PainterDraw::m_indices
+        \param data_store_written number of elements written to
+                                  PainterDraw::m_store
+       */
+      virtual
+      void
+      on_draw(const PainterDraw &draw,
+              unsigned int attributes_written,
+              unsigned int indices_written,
+              unsigned int data_store_written);
+
+    private:
+      friend class PainterBackendNullDraw;
+      void *m_d;
+    };
+/*! @} */
+  }
+}
@@ -0,0 +1,207 @@
+/*!
+ * \file painter_backend_recorder.hpp
+ * \brief file painter_backend_recorder.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/util/data_buffer.hpp>
+#include <fastuidraw/glsl/painter_backend_null.hpp>
+
+namespace fastuidraw
+{
+  namespace glsl
+  {
+/*!\addtogroup GLSLShaderBuilder
+  @{
+ */
+    /*!
+      A PainterBackendRecorder is a PainterBackendNull that
+      writes what it is asked to draw to a trace. Two runs
+      that send the same data to the backend give the same
+      trace, so traces can be compared to detect changes in
+      what Painter and PainterPacker produce. The trace is
+      written with a BakedDataWriter as a sequence of
+      records, each record starting with a value of
+      \ref trace_tag_t written as a uint32_t:
+       - trace_pre_draw and trace_post_draw have no
+         further data; they mark the start and end of
+         the draws sent by a PainterPacker::end().
+       - trace_draw is written for each PainterDraw drawn.
+         It is followed by the number of attributes, indices
+         and data store values written, then an array of
+         \ref draw_break_t for each draw break, then an
+         array of \ref header_t for each run of attributes
+         sharing a header, then the store data of each
+         header (as an array of generic_data, the headers
+         in order and each of PainterHeader::header_size
+         values). If record_data() is true, the arrays of
+         the attributes, header attributes, indices and
+         data store follow; otherwise four uint32_t
+         values that are a hash of each of those arrays.
+     */
+    class PainterBackendRecorder:public PainterBackendNull
+    {
+    public:
+      /*!
+        Enumeration of the tags starting each record
+        of a trace.
+       */
+      enum trace_tag_t
+        {
+          trace_pre_draw, /*!< tag for on_pre_draw() */
+          trace_post_draw, /*!< tag for on_post_draw() */
+          trace_draw, /*!< tag for a PainterDraw drawn */
+        };
+
+      /*!
+        A draw_break_t is how a draw break is written
+        in a trace.
+       */
+      class draw_break_t
+      {
+      public:
+        /*!
+          Number of attributes written before the break.
+         */
+        uint32_t m_attributes_written;
+
+        /*!
+          Number of indices written before the break.
+         */
+        uint32_t m_indices_written;
+
+        /*!
+          PainterShaderGroup::item_group() after the break.
+         */
+        uint32_t m_item_group;
+
+        /*!
+          PainterShaderGroup::blend_group() after the break.
+         */
+        uint32_t m_blend_group;
+
+        /*!
+          PainterShaderGroup::brush() after the break.
+         */
+        uint32_t m_brush;
+
+        /*!
+          PainterShaderGroup::packed_blend_mode() after the break.
+         */
+        uint32_t m_packed_blend_mode;
+      };
+
+      /*!
+        A header_t is how a run of attributes sharing a
+        header is written in a trace.
+       */
+      class header_t
+      {
+      public:
+        /*!
+          Index of the first attribute of the run.
+         */
+        uint32_t m_first_attribute;
+
+        /*!
+          Number of attributes in the run.
+         */
+        uint32_t m_number_attributes;
+
+        /*!
+          Location of the header in the data store, i.e.
+          the value of PainterDraw::m_header_attributes
+          for the attributes of the run.
+         */
+        uint32_t m_location;
+      };
+
+      /*!
+        Ctor. Parameters are as in PainterBackendNull.
+        \param record_data if true, the attribute, index and data
+                           store values are written to the trace
+                           in full instead of as hashes
+        \param config_null ConfigurationNull providing configuration parameters
+        \param config_glsl ConfigurationGLSL parameters inherited from
+                           PainterBackendGLSL
+        \param config_base ConfigurationBase parameters inherited from PainterBackend
+       */
+      explicit
+      PainterBackendRecorder(bool record_data = false,
+                             const ConfigurationNull &config_null = ConfigurationNull(),
+                             const ConfigurationGLSL &config_glsl = ConfigurationGLSL(),
+                             const ConfigurationBase &config_base = ConfigurationBase());
+
+      ~PainterBackendRecorder();
+
+      /*!
+        Returns the value passed as record_data in the ctor.
+       */
+      bool
+      record_data(void) const;
+
+      /*!
+        Returns the trace written so far.
+       */
+      const_c_array<uint8_t>
+      trace(void) const;
+
+      /*!
+        Write the trace written so far to a file, returns
+        false if the file could not be written.
+        \param filename name of file to which to write
+       */
+      bool
+      save_trace(const char *filename) const;
+
+      /*!
+        Clear the trace.
+       */
+      void
+      clear_trace(void);
+
+      virtual
+      void
+      on_pre_draw(void);
+
+      virtual
+      void
+      on_post_draw(void);
+
+    protected:
+      virtual
+      void
+      on_draw_break(const PainterDraw &draw,
+                    const PainterShaderGroup &old_groups,
+                    const PainterShaderGroup &new_groups,
+                    unsigned int attributes_written,
+                    unsigned int indices_written);
+
+      virtual
+      void
+      on_draw(const PainterDraw &draw,
+              unsigned int attributes_written,
+              unsigned int indices_written,
+              unsigned int data_store_written);
+
+    private:
+      void *m_d;
+    };
+/*! @} */
+  }
+}
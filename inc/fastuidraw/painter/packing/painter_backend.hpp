@@ -134,6 +134,58 @@ namespace fastuidraw
       PerformanceHints&
       clipping_via_hw_clip_planes(bool v);
 
+      /*!
+        Returns the number of attributes (and header attributes)
+        of each PainterDraw returned by map_draw(), i.e. the size
+        of PainterDraw::m_attributes. A value of 0 indicates that
+        the PainterBackend does not specify the value.
+       */
+      unsigned int
+      attributes_per_draw(void) const;
+
+      /*!
+        Set the value returned by
+        attributes_per_draw(void) const,
+        default value is 0.
+       */
+      PerformanceHints&
+      attributes_per_draw(unsigned int v);
+
+      /*!
+        Returns the number of indices of each PainterDraw
+        returned by map_draw(), i.e. the size of
+        PainterDraw::m_indices. A value of 0 indicates that
+        the PainterBackend does not specify the value.
+       */
+      unsigned int
+      indices_per_draw(void) const;
+
+      /*!
+        Set the value returned by
+        indices_per_draw(void) const,
+        default value is 0.
+       */
+      PerformanceHints&
+      indices_per_draw(unsigned int v);
+
+      /*!
+        Returns the number of blocks of PainterDraw::m_store
+        of each PainterDraw returned by map_draw() where a
+        block is ConfigurationBase::alignment() elements. A
+        value of 0 indicates that the PainterBackend does not
+        specify the value.
+       */
+      unsigned int
+      data_blocks_per_draw(void) const;
+
+      /*!
+        Set the value returned by
+        data_blocks_per_draw(void) const,
+        default value is 0.
+       */
+      PerformanceHints&
+      data_blocks_per_draw(unsigned int v);
+
     private:
       void *m_d;
     };
@@ -79,6 +79,223 @@ namespace fastuidraw
       header_added(const PainterHeader &original_value, c_array<generic_data> mapped_location) = 0;
     };
 
+    /*!
+      Enumeration to query the statistics of a PainterPacker,
+      see query_stat(), and of each of the PainterDraw objects
+      it sends to the PainterBackend, see StatsCallBack.
+     */
+    enum stats_t
+      {
+        /*!
+          Number of PainterDraw objects taken into use, i.e.
+          obtained with PainterBackend::map_draw().
+         */
+        num_draws,
+
+        /*!
+          Number of calls to PainterDraw::draw_break().
+         */
+        num_draw_breaks,
+
+        /*!
+          Number of calls to PainterDraw::draw_break() for which
+          PainterShaderGroup::item_group() changed.
+         */
+        num_draw_breaks_item_group,
+
+        /*!
+          Number of calls to PainterDraw::draw_break() for which
+          PainterShaderGroup::blend_group() changed.
+         */
+        num_draw_breaks_blend_group,
+
+        /*!
+          Number of calls to PainterDraw::draw_break() for which
+          PainterShaderGroup::brush() changed in the bits of
+          PainterBackend::ConfigurationBase::brush_shader_mask().
+         */
+        num_draw_breaks_brush,
+
+        /*!
+          Number of calls to PainterDraw::draw_break() for which
+          PainterShaderGroup::packed_blend_mode() changed.
+         */
+        num_draw_breaks_blend_mode,
+
+        /*!
+          Number of calls to PainterDraw::draw_break() avoided
+          by reordering items, see reorder_window().
+         */
+        num_draw_breaks_saved,
+
+        /*!
+          Number of headers (PainterHeader) written.
+         */
+        num_headers,
+
+        /*!
+          Number of attributes written.
+         */
+        num_attributes,
+
+        /*!
+          Number of indices written.
+         */
+        num_indices,
+
+        /*!
+          Number of blocks of PainterDraw::m_store written,
+          where a block is PainterBackend::ConfigurationBase::alignment()
+          elements.
+         */
+        num_store_blocks,
+
+        /*!
+          Number of times a PainterPackedValue was used
+          whose data was already in the PainterDraw.
+         */
+        num_packed_values_reused,
+
+        /*!
+          Number of times a PainterPackedValue was used
+          whose data was copied into the PainterDraw.
+         */
+        num_packed_values_copied,
+
+        /*!
+          Number of times a value that is not a
+          PainterPackedValue was packed into the PainterDraw.
+         */
+        num_values_packed,
+
+        /*!
+          Number of times the data of a value, or of a
+          PainterPackedValue, was not written to the
+          PainterDraw because identical data was already
+          written to it, see intern_values().
+         */
+        num_values_interned,
+
+        /*!
+          Time, in microseconds, spent packing, i.e. within
+          draw_generic(), splice() and replay().
+         */
+        packing_time_us,
+
+        /*!
+          Time, in microseconds, spent within methods of the
+          PainterBackend and PainterDraw to obtain and draw the
+          PainterDraw objects, i.e. PainterBackend::map_draw(),
+          PainterBackend::on_pre_draw(), PainterDraw::draw() and
+          PainterBackend::on_post_draw().
+         */
+        backend_time_us,
+
+        num_stats
+      };
+
+    /*!
+      A StatsCallBack is called by a PainterPacker
+      for each PainterDraw it draws.
+     */
+    class StatsCallBack:public reference_counted<StatsCallBack>::default_base
+    {
+    public:
+      /*!
+        To be implemented by a derived class to receive the
+        statistics of a PainterDraw; called after the
+        PainterDraw is drawn.
+        \param h PainterDraw that was drawn
+        \param stats statistics of h, indexed by \ref stats_t;
+                     the value of packing_time_us is the time
+                     spent packing while h was filled.
+       */
+      virtual
+      void
+      draw_stats(const reference_counted_ptr<const PainterDraw> &h,
+                 const_c_array<unsigned int> stats) = 0;
+    };
+
+    /*!
+      A RecordingParams specifies the sizes of the PainterDraw
+      objects of a PainterPacker that records, see
+      PainterPacker(reference_counted_ptr<PainterBackend>, const RecordingParams&).
+      Since each recorded PainterDraw is spliced whole into a
+      PainterDraw of a PainterBackend (see splice()), the sizes
+      must not exceed those of the PainterDraw objects made by
+      PainterBackend::map_draw() of the PainterBackend; a
+      PainterPacker that records lowers each size to that given
+      by PainterBackend::hints() of its PainterBackend (see
+      PainterBackend::PerformanceHints::attributes_per_draw()).
+      If the PainterBackend does not give a size and a recorded
+      PainterDraw is too large, splice() drops it and prints a
+      message to std::cerr.
+     */
+    class RecordingParams
+    {
+    public:
+      /*!
+        Ctor, initializes values.
+       */
+      RecordingParams(void):
+        m_attributes_per_draw(16 * 1024),
+        m_indices_per_draw(24 * 1024),
+        m_data_blocks_per_draw(4 * 1024)
+      {}
+
+      /*!
+        Number of attributes (and header attributes) of each
+        recorded PainterDraw, initial value is 16 * 1024.
+       */
+      unsigned int m_attributes_per_draw;
+
+      /*!
+        Number of indices of each recorded PainterDraw,
+        initial value is 24 * 1024.
+       */
+      unsigned int m_indices_per_draw;
+
+      /*!
+        Number of blocks of PainterDraw::m_store of each
+        recorded PainterDraw where a block is
+        PainterBackend::ConfigurationBase::alignment()
+        elements, initial value is 4 * 1024.
+       */
+      unsigned int m_data_blocks_per_draw;
+    };
+
+    /*!
+      A RetainedDraws holds what a PainterPacker that records
+      packed between its begin() and end(), see retain(). The
+      data of a RetainedDraws does not change, so it can be
+      added to the draws of a PainterPacker any number of
+      times, and from any number of frames, with replay().
+     */
+    class RetainedDraws:public reference_counted<RetainedDraws>::default_base
+    {
+    public:
+      ~RetainedDraws();
+
+      /*!
+        Returns the number of attributes held.
+       */
+      unsigned int
+      number_attributes(void) const;
+
+      /*!
+        Returns the number of indices held.
+       */
+      unsigned int
+      number_indices(void) const;
+
+    private:
+      friend class PainterPacker;
+
+      RetainedDraws(void);
+
+      void *m_d;
+    };
+
     /*!
       Ctor.
       \param backend handle to PainterBackend for the constructed PainterPacker
@@ -86,6 +303,27 @@ namespace fastuidraw
     explicit
     PainterPacker(reference_counted_ptr<PainterBackend> backend);
 
+    /*!
+      Ctor for a PainterPacker that records. A PainterPacker
+      that records packs into PainterDraw objects backed by
+      CPU memory instead of those of PainterBackend::map_draw()
+      and it never sends anything to the PainterBackend; what
+      it packed between begin() and end() is instead added to
+      the draws of another PainterPacker with splice(). Since it
+      does not touch the PainterBackend when drawing, different
+      PainterPacker objects that record can pack concurrently
+      from different threads; the PainterPacker itself must be
+      constructed, and shaders registered, from the thread that
+      uses the PainterBackend.
+      \param backend handle to PainterBackend whose configuration,
+                     atlases and shaders the constructed PainterPacker
+                     uses; it is the PainterBackend of the PainterPacker
+                     on which the recording is to be spliced.
+      \param params sizes of the recorded PainterDraw objects
+     */
+    PainterPacker(reference_counted_ptr<PainterBackend> backend,
+                  const RecordingParams &params);
+
     virtual
     ~PainterPacker();
 
@@ -153,11 +391,151 @@ namespace fastuidraw
     end(void);
 
     /*!
-      Flush all buffered rendering commands.
+      Flush all buffered rendering commands. For a
+      PainterPacker that records, the commands are
+      kept for splice() until the next begin().
      */
     void
     flush(void);
 
+    /*!
+      Returns true if this PainterPacker records, i.e.
+      was constructed with
+      PainterPacker(reference_counted_ptr<PainterBackend>, const RecordingParams&).
+     */
+    bool
+    recording(void) const;
+
+    /*!
+      Add to the draws of this PainterPacker the draws that a
+      PainterPacker that records packed between its last begin()
+      and end(). The data is copied, with the store locations and
+      indices rebased, into the PainterDraw objects of this
+      PainterPacker; the z-values are not changed, so a recording
+      is typically made to use a range of z-values reserved for
+      it. Splicing several recordings in a fixed order gives the
+      same result regardless of the order in which they were
+      recorded. Must be called within a begin()/end() pair of
+      this PainterPacker, which must not record, and after end()
+      of recorded, which must not be packing at the time.
+      \param recorded PainterPacker that records whose draws to add
+     */
+    void
+    splice(const PainterPacker &recorded);
+
+    /*!
+      Returns a RetainedDraws holding what this PainterPacker,
+      which must record, packed between its last begin() and
+      end(); the data is shared and not copied. Must be called
+      after end() and before the next begin().
+     */
+    reference_counted_ptr<const RetainedDraws>
+    retain(void) const;
+
+    /*!
+      Add to the draws of this PainterPacker the draws held by
+      a RetainedDraws. As with splice(), the data is copied with
+      the store locations and indices rebased; in addition, each
+      item matrix M of the retained draws is replaced by
+      item_matrix * M, each clip equation is changed accordingly
+      (i.e. multiplied by the inverse transpose of item_matrix)
+      and z_offset is added to each z-value. Each item matrix and
+      clip equation is changed once no matter how many headers
+      refer to it, so the cost of replay() is essentially that of
+      copying the data. Must be called within a begin()/end()
+      pair of this PainterPacker, which must not record.
+      \param draws RetainedDraws whose draws to add
+      \param item_matrix transformation, in 3D API coordinates,
+                         to apply to the retained draws
+      \param z_offset value to add to the z-values of the retained draws
+     */
+    void
+    replay(const RetainedDraws &draws, const float3x3 &item_matrix, int z_offset);
+
+    /*!
+      Returns the named statistic since the last call to begin();
+      the PainterDraw objects are counted when they are drawn,
+      so the values are complete after end(). Counting is always
+      on and costs little: a few increments per header and draw
+      break, and reading the clock twice per draw_generic() call.
+      \param st statistic to query
+     */
+    unsigned int
+    query_stat(enum stats_t st) const;
+
+    /*!
+      Set the StatsCallBack to be called for each PainterDraw
+      drawn. A NULL handle, the default, means no call back.
+      \param cb StatsCallBack to use
+     */
+    void
+    stats_call_back(const reference_counted_ptr<StatsCallBack> &cb);
+
+    /*!
+      Returns the StatsCallBack as set by stats_call_back().
+     */
+    const reference_counted_ptr<StatsCallBack>&
+    stats_call_back(void) const;
+
+    /*!
+      Set the size of the window, in number of headers, within
+      which the items of a PainterDraw are reordered to reduce
+      the number of calls to PainterDraw::draw_break(). Items
+      are drawn with the depth test so that an item with a
+      larger z-value hides one with a smaller z-value; as done
+      by Painter, the depth values an item writes (its z-value
+      plus the z-offsets of its attributes) are assumed to not
+      overlap those of items with a different z-value. Thus two
+      items can be drawn in either order, regardless of where
+      they are, if their z-values differ and the one with the
+      larger z-value does not read the framebuffer (i.e. its
+      BlendMode does not use the destination value and its
+      PainterBlendShader is not PainterBlendShader::framebuffer_fetch).
+      An item is moved earlier only past items with which it can
+      be exchanged, to the position just after the last item of
+      the window with the same PainterShaderGroup. An item whose
+      header is passed to a DataCallBack may have its z-value
+      changed after it is packed (as Painter does for the
+      occluders of clipping), so it is not moved and no item is
+      moved past it. Only the index
+      data of items is reordered; spliced and replayed draws (see
+      splice() and replay()) are not reordered. A value of 0, the
+      default, means to not reorder. Has no effect on a
+      PainterPacker that records. The value takes effect with
+      the next PainterDraw taken into use.
+      \param N number of headers in a reorder window
+     */
+    void
+    reorder_window(unsigned int N);
+
+    /*!
+      Returns the value set by reorder_window(unsigned int).
+     */
+    unsigned int
+    reorder_window(void) const;
+
+    /*!
+      Set if the data of values packed into PainterDraw::m_store
+      is interned: the data is hashed and if identical data was
+      already written to the same PainterDraw, that data is used
+      instead of writing it again. This reduces the store used
+      when the same values (for example the same PainterBrush)
+      are passed as PainterData::value objects that are not
+      PainterPackedValue objects, at the cost of hashing, and
+      keeping a copy of, the data written. Default value is
+      false. The value takes effect with the next PainterDraw
+      taken into use.
+      \param v if true, intern the data of values
+     */
+    void
+    intern_values(bool v);
+
+    /*!
+      Returns the value set by intern_values(bool).
+     */
+    bool
+    intern_values(void) const;
+
     /*!
       Return the default shaders for common drawing types.
      */
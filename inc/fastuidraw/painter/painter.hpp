@@ -20,6 +20,8 @@
 #pragma once
 
 #include <fastuidraw/path.hpp>
+#include <fastuidraw/filled_path.hpp>
+#include <fastuidraw/text/glyph_cache.hpp>
 
 #include <fastuidraw/painter/packing/painter_packer.hpp>
 #include <fastuidraw/painter/painter_stroke_params.hpp>
@@ -101,12 +103,124 @@ namespace fastuidraw
       bool (*m_fill_rule)(int);
     };
 
+    /*!
+      A DisplayList holds what a Painter that records (see
+      Painter(reference_counted_ptr<PainterBackend>, const PainterPacker::RecordingParams&))
+      drew between its begin() and end(), ready to be drawn
+      again, as often as needed and in different frames, by
+      replay() with a different transformation and z-value;
+      it is made with retain(). Since replaying only copies
+      the packed data and changes the transformation, clip
+      equations and z-values of the recorded items, drawing
+      a DisplayList costs much less than issuing the drawing
+      commands that made it.
+     */
+    class DisplayList:public reference_counted<DisplayList>::default_base
+    {
+    public:
+      /*!
+        Returns the transformation of the Painter that
+        recorded the DisplayList when retain() was called.
+       */
+      const float3x3&
+      transformation(void) const
+      {
+        return m_transformation;
+      }
+
+      /*!
+        Returns the number of z-values the recorded items use,
+        i.e. by how much replay() increments current_z().
+       */
+      unsigned int
+      z_range(void) const
+      {
+        return m_z_range;
+      }
+
+      /*!
+        Returns the packed draws of the DisplayList.
+       */
+      const reference_counted_ptr<const PainterPacker::RetainedDraws>&
+      draws(void) const
+      {
+        return m_draws;
+      }
+
+    private:
+      friend class Painter;
+
+      DisplayList(const reference_counted_ptr<const PainterPacker::RetainedDraws> &draws,
+                  const float3x3 &transformation,
+                  unsigned int z_begin, unsigned int z_range):
+        m_draws(draws),
+        m_transformation(transformation),
+        m_z_begin(z_begin),
+        m_z_range(z_range)
+      {}
+
+      reference_counted_ptr<const PainterPacker::RetainedDraws> m_draws;
+      float3x3 m_transformation;
+      unsigned int m_z_begin, m_z_range;
+    };
+
+    /*!
+      Enumeration to query the statistics of how many draws of
+      a Painter were skipped because they were entirely clipped,
+      see query_stat(). The statistics are reset by begin().
+     */
+    enum query_stats_t
+      {
+        /*!
+          Number of calls to draw_glyphs(), stroke_path(),
+          stroke_dashed_path() and fill_path() whose data
+          was sent to the PainterPacker.
+         */
+        num_items_drawn,
+
+        /*!
+          Number of calls to draw_glyphs(), stroke_path(),
+          stroke_dashed_path() and fill_path() that were
+          skipped because the bounding box of what they
+          draw is entirely outside of the current clipping
+          or, when damage is tracked (see add_damage()),
+          does not intersect the damaged region.
+         */
+        num_items_culled,
+
+        num_stats
+      };
+
     /*!
       Ctor.
      */
     explicit
     Painter(reference_counted_ptr<PainterBackend> backend);
 
+    /*!
+      Ctor for a Painter that records: its PainterPacker is
+      constructed with PainterPacker(reference_counted_ptr<PainterBackend>, const PainterPacker::RecordingParams&),
+      so that what it draws is not sent to the PainterBackend
+      but added to the draws of another Painter with splice().
+      A Painter that records has its own PainterPackedValuePool
+      and working memory, thus different Painter objects that
+      record can draw concurrently from different threads to
+      record independent sub-scenes. For that, the objects
+      used by each such Painter must not be used concurrently
+      by another thread; in particular the PainterPackedValue
+      objects it draws with should come from its own
+      packed_value_pool(), the glyphs and images it draws must
+      already be uploaded to their atlases and a Path it draws
+      must not be drawn by another thread at the same time.
+      The Painter itself must be constructed from the thread
+      that uses the PainterBackend.
+      \param backend PainterBackend of the Painter to which
+                     the recorded sub-scenes are spliced
+      \param params sizes of the recorded PainterDraw objects
+     */
+    Painter(reference_counted_ptr<PainterBackend> backend,
+            const PainterPacker::RecordingParams &params);
+
     ~Painter(void);
 
     /*!
@@ -117,6 +231,23 @@ namespace fastuidraw
     const reference_counted_ptr<GlyphAtlas>&
     glyph_atlas(void) const;
 
+    /*!
+      Returns the GlyphCache set with glyph_cache(const reference_counted_ptr<GlyphCache>&),
+      initial value is NULL.
+     */
+    const reference_counted_ptr<GlyphCache>&
+    glyph_cache(void) const;
+
+    /*!
+      Set the GlyphCache whose pending glyphs are uploaded,
+      see GlyphCache::upload_pending_glyphs(), at each begin().
+      The GlyphCache must use glyph_atlas(). Only an
+      asynchronous GlyphCache needs to be set.
+      \param cache GlyphCache to set, may be NULL
+     */
+    void
+    glyph_cache(const reference_counted_ptr<GlyphCache> &cache);
+
     /*!
       Returns a handle to the ImageAtlas of this
       Painter. All images used by all brushes of
@@ -219,15 +350,110 @@ namespace fastuidraw
     void
     target_resolution(int w, int h);
 
+    /*!
+      Add a rectangle to the damaged region of the current
+      frame. By default, i.e. if add_damage() is not called
+      after begin(), everything is damaged and drawn. Once
+      damage is added, the items (see query_stats_t) drawn
+      afterwards whose bounding box does not intersect the
+      damaged region are skipped before they are packed. The
+      content of the surface outside the damaged region is
+      then expected to be unchanged from the previous frame,
+      which requires the 3D API to only draw within the
+      damaged region, for example by setting a scissor to
+      damage_bounds() before end(). Requires that the target
+      resolution is set, see target_resolution(); the damaged
+      region is reset by begin().
+      \param pmin min-corner of the rectangle in pixel coordinates
+                  where (0, 0) is the top-left corner of the surface
+      \param wh width and height of the rectangle in pixels
+     */
+    void
+    add_damage(const vec2 &pmin, const vec2 &wh);
+
+    /*!
+      Gives the bounding box of the damaged region added
+      with add_damage() since the last begin(). Returns
+      false if no damage was added, i.e. everything is to
+      be drawn.
+      \param[out] out_min min-corner of the box in pixel coordinates
+                          where (0, 0) is the top-left corner of the surface
+      \param[out] out_max max-corner of the box in pixel coordinates
+     */
+    bool
+    damage_bounds(vec2 &out_min, vec2 &out_max) const;
+
     /*!
       Indicate to start drawing with methods of this Painter.
       Drawing commands sent to 3D hardware are buffered and not
       sent to hardware until end() is called.
       All draw commands must be between a begin()/end() pair.
+      The glyphs of glyph_cache() whose data is ready are
+      uploaded first.
      */
     void
     begin(bool reset_z = true);
 
+    /*!
+      Indicate to start drawing with methods of this Painter
+      with current_z() starting at the named value. Typically,
+      a Painter that records (see
+      Painter(reference_counted_ptr<PainterBackend>, const PainterPacker::RecordingParams&))
+      records a sub-scene in a range of z-values reserved for it
+      from the Painter to which it is spliced, the range being
+      reserved by taking current_z() and then calling
+      increment_z() with the size of the range on that Painter.
+      \param z value for current_z() at the start of drawing
+     */
+    void
+    begin_at_z(unsigned int z);
+
+    /*!
+      Add to the draws of this Painter what a Painter that
+      records (see Painter(reference_counted_ptr<PainterBackend>, const PainterPacker::RecordingParams&))
+      drew between its last begin() (or begin_at_z()) and end(),
+      see PainterPacker::splice(). The recorded items keep their
+      own transformation, clipping and z-values; the current
+      state of this Painter does not affect them. Must be called
+      within a begin()/end() pair of this Painter and after the
+      end() of recorded has completed.
+      \param recorded Painter that records whose drawing to add
+     */
+    void
+    splice(const Painter &recorded);
+
+    /*!
+      Returns a DisplayList holding what this Painter, which
+      must record (see Painter(reference_counted_ptr<PainterBackend>, const PainterPacker::RecordingParams&)),
+      drew between its last begin() (or begin_at_z()) and end().
+      The DisplayList also holds the current transformation of
+      this Painter; typically one calls retain() after end()
+      without changing the transformation from the one used
+      to draw the recorded items. Items that were culled when
+      recorded (see query_stat()) are not in the DisplayList,
+      so the transformation used for recording should have all
+      of its content in the window. Must be called after end()
+      and before the next begin().
+     */
+    reference_counted_ptr<const DisplayList>
+    retain(void) const;
+
+    /*!
+      Draw the contents of a DisplayList. The items of the
+      DisplayList are drawn as if the transformation of the
+      Painter that recorded them had been the current
+      transformation of this Painter, i.e. the transformation
+      (in 3D API coordinates) transformation() * inverse(list.transformation())
+      is applied to each recorded item. The items are clipped
+      by the current clipping of this Painter as well as by
+      their own (transformed) clipping. The items use the
+      z-values starting at current_z() and current_z() is
+      incremented by DisplayList::z_range().
+      \param list DisplayList to draw
+     */
+    void
+    replay(const DisplayList &list);
+
     /*!
       Indicate to end drawing with methods of this Painter.
       Drawing commands sent to 3D hardware are buffered and not
@@ -536,6 +762,22 @@ namespace fastuidraw
               const PainterAttributeData &data, enum PainterEnums::fill_rule_t fill_rule,
               const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
 
+    /*!
+      Fill a path, only those FilledPath::Subset objects
+      of the FilledPath that are not culled by the current
+      clipping are drawn.
+      \param draw data for how to draw
+      \param filled_path FilledPath to fill
+      \param fill_rule fill rule with which to fill the path
+      \param shader shader with which to fill the attribute data
+      \param call_back if non-NULL handle, call back called when attribute data
+                       is added.
+     */
+    void
+    fill_path(const reference_counted_ptr<PainterItemShader> &shader, const PainterData &draw,
+              const FilledPath &filled_path, enum PainterEnums::fill_rule_t fill_rule,
+              const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
+
     /*!
       Fill a path.
       \param draw data for how to draw
@@ -576,6 +818,22 @@ namespace fastuidraw
               const PainterAttributeData &data, const CustomFillRuleBase &fill_rule,
               const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
 
+    /*!
+      Fill a path, only those FilledPath::Subset objects
+      of the FilledPath that are not culled by the current
+      clipping are drawn.
+      \param draw data for how to draw
+      \param filled_path FilledPath to fill
+      \param fill_rule custom fill rule with which to fill the path
+      \param shader shader with which to fill the attribute data
+      \param call_back if non-NULL handle, call back called when attribute data
+                       is added.
+     */
+    void
+    fill_path(const reference_counted_ptr<PainterItemShader> &shader, const PainterData &draw,
+              const FilledPath &filled_path, const CustomFillRuleBase &fill_rule,
+              const reference_counted_ptr<PainterPacker::DataCallBack> &call_back = reference_counted_ptr<PainterPacker::DataCallBack>());
+
     /*!
       Fill a path.
       \param draw data for how to draw
@@ -766,6 +1024,48 @@ namespace fastuidraw
     void
     increment_z(int amount = 1);
 
+    /*!
+      Returns the named statistic since the last call to begin().
+      \param st statistic to query
+     */
+    unsigned int
+    query_stat(enum query_stats_t st) const;
+
+    /*!
+      Returns the named statistic of the underlying
+      PainterPacker since the last call to begin(),
+      see PainterPacker::query_stat().
+      \param st statistic to query
+     */
+    unsigned int
+    query_packer_stat(enum PainterPacker::stats_t st) const;
+
+    /*!
+      Set the PainterPacker::StatsCallBack of the underlying
+      PainterPacker, see PainterPacker::stats_call_back().
+      \param cb call back to use, a NULL value indicates
+                to not call anything
+     */
+    void
+    packer_stats_call_back(const reference_counted_ptr<PainterPacker::StatsCallBack> &cb);
+
+    /*!
+      Set the reorder window of the underlying PainterPacker,
+      see PainterPacker::reorder_window(unsigned int).
+      \param N number of headers in a reorder window, 0
+               means to not reorder
+     */
+    void
+    packer_reorder_window(unsigned int N);
+
+    /*!
+      Set if the underlying PainterPacker interns the data
+      of values, see PainterPacker::intern_values(bool).
+      \param v if true, intern the data of values
+     */
+    void
+    packer_intern_values(bool v);
+
     /*!
       Registers a shader for use. Must not be called within a
       begin() / end() pair.
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/data_buffer.hpp>
 #include <fastuidraw/painter/painter_attribute.hpp>
 #include <fastuidraw/painter/painter_attribute_data_filler.hpp>
 
@@ -53,6 +54,27 @@ namespace fastuidraw
     void
     set_data(const PainterAttributeDataFiller &filler);
 
+    /*!
+      Write the index, attribute, z-increment and chunk
+      data of this PainterAttributeData to a BakedDataWriter.
+      \param dst BakedDataWriter to which to write
+     */
+    void
+    bake(BakedDataWriter &dst) const;
+
+    /*!
+      Set the index, attribute, z-increment and chunk data
+      of this PainterAttributeData from data written by
+      bake(). The attribute and index data is not copied,
+      the chunks point directly into src.buffer(), which
+      this PainterAttributeData keeps a handle to. Returns
+      false, and leaves this PainterAttributeData empty, if
+      the data could not be read.
+      \param src BakedDataReader from which to read
+     */
+    bool
+    load_baked(BakedDataReader &src);
+
     /*!
       Returns the attribute data chunks. Usually, for each
       attribute data chunk, there is a matching index data
@@ -116,6 +138,33 @@ namespace fastuidraw
     unsigned int
     increment_z_value(unsigned int i) const;
 
+    /*!
+      Gives the bounding box, in item coordinates, of the
+      attribute data as computed by the
+      PainterAttributeDataFiller::compute_bounding_box() of
+      the filler passed to set_data(). Returns false if the
+      filler did not give a bounding box.
+      \param[out] out_min min-corner of the bounding box
+      \param[out] out_max max-corner of the bounding box
+     */
+    bool
+    bounding_box(vec2 &out_min, vec2 &out_max) const;
+
+    /*!
+      Gives the bounding box, in item coordinates, of the
+      named chunk of attribute_data_chunks(). Only those
+      chunks for which PainterAttributeDataFiller::chunk_has_bounding_box()
+      of the filler passed to set_data() returns true have a
+      bounding box. Returns false if the chunk does not have
+      a bounding box.
+      \param i index of attribute_data_chunks() to query
+      \param[out] out_min min-corner of the bounding box
+      \param[out] out_max max-corner of the bounding box
+     */
+    bool
+    attribute_data_chunk_bounding_box(unsigned int i,
+                                      vec2 &out_min, vec2 &out_max) const;
+
   private:
     void *m_d;
   };
@@ -86,6 +86,48 @@ namespace fastuidraw
               c_array<const_c_array<PainterAttribute> > attrib_chunks,
               c_array<const_c_array<PainterIndex> > index_chunks,
               c_array<unsigned int> zincrements) const = 0;
+
+    /*!
+      To be optionally implemented by a derived class to give
+      a bounding box, in item coordinates, of the positions of
+      the attributes it filled; a Painter uses the box to skip
+      drawing data that is entirely clipped. For data whose
+      vertices are offset from their position when drawn (for
+      example stroking), the box is of the positions before the
+      offset. Called after fill_data(); returns false if no
+      bounding box is given. Default implementation returns false.
+      \param attributes attributes as filled by fill_data()
+      \param[out] out_min min-corner of the bounding box
+      \param[out] out_max max-corner of the bounding box
+     */
+    virtual
+    bool
+    compute_bounding_box(const_c_array<PainterAttribute> attributes,
+                         vec2 &out_min, vec2 &out_max) const
+    {
+      FASTUIDRAWunused(attributes);
+      FASTUIDRAWunused(out_min);
+      FASTUIDRAWunused(out_max);
+      return false;
+    }
+
+    /*!
+      To be optionally implemented by a derived class to
+      specify those attribute chunks for which a bounding
+      box is to be computed, with compute_bounding_box(),
+      and stored (see PainterAttributeData::attribute_data_chunk_bounding_box()).
+      Called after fill_data(). Default implementation
+      returns false.
+      \param chunk index into the attribute chunks filled
+                   by fill_data()
+     */
+    virtual
+    bool
+    chunk_has_bounding_box(unsigned int chunk) const
+    {
+      FASTUIDRAWunused(chunk);
+      return false;
+    }
   };
 /*! @} */
 }
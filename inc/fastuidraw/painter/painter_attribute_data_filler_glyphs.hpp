@@ -42,12 +42,15 @@ namespace fastuidraw
     successfully uploaded to its GlyphCache. That value can be
     queried by number_glyphs(). If all glyphs are uploaded or
     successfully loaded, then number_glyphs() returns the number
-    glyph in the glyph run. Data for glyphs is packed as follows:
+    glyph in the glyph run. A glyph that is pending (see
+    Glyph::pending()) is skipped, the number of such glyphs
+    is given by number_pending_glyphs(); the PainterAttributeData
+    should be filled again once those glyphs are no longer
+    pending. Data for glyphs is packed as follows:
       - PainterAttribute::m_attrib0 .xy   -> xy-texel location in primary atlas (float)
       - PainterAttribute::m_attrib0 .zw   -> xy-texel location in secondary atlas (float)
       - PainterAttribute::m_attrib1 .xy -> position in item coordinates (float)
-      - PainterAttribute::m_attrib1 .z  -> 0 (free)
-      - PainterAttribute::m_attrib1 .w  -> 0 (free)
+      - PainterAttribute::m_attrib1 .zw -> size of glyph in primary atlas (float)
       - PainterAttribute::m_attrib2 .x -> 0 (free)
       - PainterAttribute::m_attrib2 .y -> glyph offset (uint)
       - PainterAttribute::m_attrib2 .z -> layer in primary atlas (uint)
@@ -118,6 +121,14 @@ namespace fastuidraw
     unsigned int
     number_glyphs(void) const;
 
+    /*!
+      After calling PainterAttributeData::set_data() with this object,
+      returns the number of glyphs that were skipped because they
+      are pending, see Glyph::pending().
+     */
+    unsigned int
+    number_pending_glyphs(void) const;
+
     virtual
     void
     compute_sizes(unsigned int &number_attributes,
@@ -132,6 +143,10 @@ namespace fastuidraw
               c_array<const_c_array<PainterAttribute> > attrib_chunks,
               c_array<const_c_array<PainterIndex> > index_chunks,
               c_array<unsigned int> zincrements) const;
+    virtual
+    bool
+    compute_bounding_box(const_c_array<PainterAttribute> attributes,
+                         vec2 &out_min, vec2 &out_max) const;
 
   private:
     void *m_d;
@@ -75,6 +75,10 @@ namespace fastuidraw
               c_array<const_c_array<PainterAttribute> > attrib_chunks,
               c_array<const_c_array<PainterIndex> > index_chunks,
               c_array<unsigned int> zincrements) const;
+    virtual
+    bool
+    compute_bounding_box(const_c_array<PainterAttribute> attributes,
+                         vec2 &out_min, vec2 &out_max) const;
 
     /*!
       Returns the FilledPath from which this object fills
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <fastuidraw/painter/painter_attribute_data_filler.hpp>
+#include <fastuidraw/painter/painter_attribute_data.hpp>
 #include <fastuidraw/painter/painter_enums.hpp>
 #include <fastuidraw/stroked_path.hpp>
 
@@ -44,7 +45,15 @@ namespace fastuidraw
     the function chunk_from_join() returns a value K to be fed to
     PainterAttributeData::attribute_data_chunk() and
     PainterAttributeData::index_data_chunk() to get the attribute
-    and index data or an individual join.
+    and index data or an individual join. Lastly, the edge data and
+    the rounded, bevel and miter join data are also split into
+    pieces, each piece a chunk covering a run of consecutive
+    triangles of the data, so that each piece is spatially coherent
+    and small; the chunks of the pieces, which have a bounding box
+    (see PainterAttributeData::attribute_data_chunk_bounding_box()),
+    are given by pieces(). Drawing all the pieces of a \ref
+    stroking_data_t draws the same triangles as drawing the chunk
+    of the \ref stroking_data_t.
 
     Data for stroking is packed as follows:
     - PainterAttribute::m_attrib0 .xy -> StrokedPath::point::m_position (float)
@@ -125,6 +134,13 @@ namespace fastuidraw
               c_array<const_c_array<PainterAttribute> > attrib_chunks,
               c_array<const_c_array<PainterIndex> > index_chunks,
               c_array<unsigned int> zincrements) const;
+    virtual
+    bool
+    compute_bounding_box(const_c_array<PainterAttribute> attributes,
+                         vec2 &out_min, vec2 &out_max) const;
+    virtual
+    bool
+    chunk_has_bounding_box(unsigned int chunk) const;
 
     /*!
       Returns the StrokedPath from which this object fills
@@ -144,6 +160,23 @@ namespace fastuidraw
     unsigned int
     chunk_from_join(enum stroking_data_t tp, unsigned int J);
 
+    /*!
+      Returns the range of values to feed to
+      PainterAttributeData::index_data_chunk(),
+      PainterAttributeData::attribute_data_chunk() and
+      PainterAttributeData::attribute_data_chunk_bounding_box()
+      for the pieces of the named edge or join data. Returns an
+      empty range if tp is not for edge, rounded join, bevel join
+      or miter join data or if data was not set from a
+      PainterAttributeDataFillerPathStroked.
+      \param data PainterAttributeData whose data was set from a
+                  PainterAttributeDataFillerPathStroked
+      \param tp edge or join data to query
+     */
+    static
+    range_type<unsigned int>
+    pieces(const PainterAttributeData &data, enum stroking_data_t tp);
+
   private:
     void *m_d;
   };
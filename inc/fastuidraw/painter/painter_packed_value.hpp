@@ -71,10 +71,16 @@ namespace fastuidraw
     packed state data and tracks if that underlying data is already is
     already copied to PainterDraw::m_store. If already
     on a store, then rather than copying the data again, the data is
-    reused. The object behind the handle is NOT thread safe. In addition
-    the underlying reference count is not either. Hence any access
-    (even dtor, copy ctor and equality operator) on a fixed object cannot
-    be done from multiple threads simutaneously. A fixed
+    reused. If the PainterPackedValue was made by a PainterPackedValuePool
+    that is not concurrent (see PainterPackedValuePool::concurrent()),
+    the object behind the handle is NOT thread safe and the underlying
+    reference count is not either. Hence any access (even dtor, copy ctor
+    and equality operator) on a fixed object cannot be done from multiple
+    threads simutaneously. If the PainterPackedValuePool is concurrent,
+    the reference count is atomic, so handles to the same object can be
+    copied and released from different threads, but packing the value
+    by a PainterPacker is not thread safe, i.e. a PainterPackedValue
+    must not be used by several PainterPacker objects simutaneously. A fixed
     PainterPackedValue can be used by different Painter (and PainterPacker)
     objects subject to the condition that the data store alignment (see
     PainterPacker::Configuration::alignment()) is the same for each of these
@@ -117,7 +123,7 @@ namespace fastuidraw
     unsigned int
     alignment_packing(void) const
     {
-      return this->m_d->alignment_packing();
+      return PainterPackedValueBase::alignment_packing();
     }
 
     /*!
@@ -186,10 +192,15 @@ namespace fastuidraw
 
   /*!
     A PainterPackedValuePool can be used to create PainterPackedValue
-    objects. Just like PainterPackedValue, PainterPackedValuePool is
-    NOT thread safe, as such it is not a safe operation to use the
+    objects. By default, just like PainterPackedValue, a PainterPackedValuePool
+    is NOT thread safe, as such it is not a safe operation to use the
     same PainterPackedValuePool object from multiple threads at the
-    same time. A fixed PainterPackedValuePool can create PainterPackedValue
+    same time. A PainterPackedValuePool constructed as concurrent can
+    create PainterPackedValue objects from any number of threads at the
+    same time and those objects can be released from any thread; the
+    slots of the pool are managed by lock-free lists. This allows
+    worker threads to pack values ahead of the thread that draws
+    with them. A fixed PainterPackedValuePool can create PainterPackedValue
     objects used by different Painter (and PainterPacker) objects subject
     to the condition that the data store alignment (see
     PainterPacker::Configuration::alignment()) is the same for each of
@@ -202,12 +213,23 @@ namespace fastuidraw
       Ctor.
       \param painter_alignment the alignment to create packed data, see
                                 PainterPacker::Configuration::alignment()
+      \param concurrent if true, the PainterPackedValuePool can create
+                        PainterPackedValue objects from several threads
+                        at the same time and the reference counts of
+                        the PainterPackedValue objects are atomic
      */
     explicit
-    PainterPackedValuePool(int painter_alignment);
+    PainterPackedValuePool(int painter_alignment, bool concurrent = false);
 
     ~PainterPackedValuePool();
 
+    /*!
+      Returns true if the PainterPackedValuePool is
+      concurrent, as set at construction.
+     */
+    bool
+    concurrent(void) const;
+
     /*!
       Create and return a PainterPackedValue<PainterBrush>
       object for the value of a PainterBrush object.
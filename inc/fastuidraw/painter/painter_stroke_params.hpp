@@ -19,6 +19,7 @@
 #pragma once
 
 #include <fastuidraw/painter/painter_shader_data.hpp>
+#include <fastuidraw/painter/painter_stroke_shader.hpp>
 
 namespace fastuidraw
 {
@@ -73,6 +74,16 @@ namespace fastuidraw
      */
     PainterStrokeParams&
     width(float f);
+
+    /*!
+      Constructs and returns a StrokingDataSelectorBase
+      compatible with the data of PainterStrokeParams.
+      \param pixel_width if true, the width is in pixels,
+                         otherwise in item coordinates
+     */
+    static
+    reference_counted_ptr<const StrokingDataSelectorBase>
+    stroking_data_selector(bool pixel_width);
   };
 
 /*! @} */
@@ -21,6 +21,7 @@
 
 
 #include <fastuidraw/painter/painter_item_shader.hpp>
+#include <fastuidraw/painter/painter_shader_data.hpp>
 #include <fastuidraw/painter/painter_enums.hpp>
 
 namespace fastuidraw
@@ -30,6 +31,39 @@ namespace fastuidraw
   @{
  */
 
+  /*!
+    A StrokingDataSelectorBase gives, from the data of
+    a PainterStrokeShader, how far from the path the
+    stroking of the path reaches. A Painter uses it to
+    skip stroking a path whose stroking is entirely
+    clipped.
+   */
+  class StrokingDataSelectorBase:
+    public reference_counted<StrokingDataSelectorBase>::default_base
+  {
+  public:
+    /*!
+      To be implemented by a derived class to give an upper
+      bound for how far from the path the stroking reaches,
+      including miter joins and the corners of square caps,
+      as the sum of a distance in pixels and a distance in
+      item coordinates. Returns false if there is no such
+      bound (for example miter joins without miter limit)
+      or if the data is not of the type expected.
+      \param data PainterItemShaderData::DataBase object holding the data to
+                  be sent to the shader
+      \param js join style of the stroking
+      \param[out] out_pixel_distance part of the distance in pixels
+      \param[out] out_item_space_distance part of the distance in item coordinates
+     */
+    virtual
+    bool
+    stroking_distances(const PainterShaderData::DataBase *data,
+                       enum PainterEnums::join_style js,
+                       float &out_pixel_distance,
+                       float &out_item_space_distance) const = 0;
+  };
+
   /*!
     A PainterStrokeShader hold shading for
     both stroking with and without anit-aliasing.
@@ -150,6 +184,22 @@ namespace fastuidraw
     PainterStrokeShader&
     non_aa_shader(const reference_counted_ptr<PainterItemShader> &sh);
 
+    /*!
+      The StrokingDataSelectorBase to give how far
+      stroking with the shader reaches from the path;
+      if NULL, a Painter does not cull the stroking
+      of paths drawn with the shader.
+     */
+    const reference_counted_ptr<const StrokingDataSelectorBase>&
+    stroking_data_selector(void) const;
+
+    /*!
+      Set the value returned by stroking_data_selector(void) const.
+      \param sh value to use
+     */
+    PainterStrokeShader&
+    stroking_data_selector(const reference_counted_ptr<const StrokingDataSelectorBase> &sh);
+
   private:
     void *m_d;
   };
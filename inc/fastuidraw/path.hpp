@@ -37,20 +37,24 @@ namespace fastuidraw  {
   a Path. Ending a contour, see \ref end(), \ref
   end_generic() and end_arc(), means to specify
   the edge from the last point of the PathContour
-  to the first point.
+  to the first point. The reference count of a
+  PathContour is thread safe because the copies of
+  a Path share their PathContour objects and a
+  PathPreparer tessellates a Path on worker threads.
  */
 class PathContour:
-    public reference_counted<PathContour>::non_concurrent
+    public reference_counted<PathContour>::default_base
 {
 public:
 
   /*!
     Base class to describe how to interpolate from one
     point of a PathContour to the next, i.e. describes
-    the shape of an edge.
+    the shape of an edge. As for PathContour, the
+    reference count is thread safe.
    */
   class interpolator_base:
-    public reference_counted<interpolator_base>::non_concurrent
+    public reference_counted<interpolator_base>::default_base
   {
   public:
     /*!
@@ -222,6 +226,28 @@ public:
     virtual
     ~bezier();
 
+    /*!
+      Returns the points defining the Bezier curve: the
+      start point of the curve, followed by the control
+      points, followed by the end point of the curve.
+     */
+    const_c_array<vec2>
+    pts(void) const;
+
+    /*!
+      Implements produce_tessellation() using the bound on the
+      second derivative given by the control points when
+      TessellatedPath::TessellationParams::m_max_distance is
+      positive, otherwise uses
+      interpolator_generic::produce_tessellation().
+      \param tess_params tessellation parameters
+      \param out_data location to which to write the edge tessellated
+     */
+    virtual
+    unsigned int
+    produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
+                         c_array<TessellatedPath::point> out_data) const;
+
     virtual
     void
     compute(float in_t, vec2 &outp, vec2 &outp_t, vec2 &outp_tt) const;
@@ -408,6 +434,35 @@ private:
 class Path
 {
 public:
+  /*!
+    Enumeration to specify the range and caching of the
+    levels of detail of the tessellations returned by
+    tessellation(float) const.
+   */
+  enum tessellation_lod_t
+    {
+      /*!
+        Coarsest level of detail, i.e. the level of detail
+        used for drawing at a scale factor of 2^min_tessellation_lod
+        or smaller.
+       */
+      min_tessellation_lod = -4,
+
+      /*!
+        Finest level of detail, i.e. the level of detail
+        used for drawing at a scale factor of 2^max_tessellation_lod
+        or larger.
+       */
+      max_tessellation_lod = 8,
+
+      /*!
+        Maximum number of TessellatedPath objects of levels
+        of detail other than 0 that a Path keeps; when more
+        are needed, the least recently used one is released.
+       */
+      tessellation_lod_cache_size = 4
+    };
+
   /*!
     Class that wraps a vec2 to mark a point
     as a control point for a Bezier curve
@@ -783,11 +838,48 @@ public:
     if this Path changes its geometry or
     tessellation parameters, then a new TessellatedPath
     will be contructed on the next call to
-    tessellation().
+    tessellation(). When only the geometry changed, the
+    new TessellatedPath copies the tessellation of the
+    contours that did not change from the previous
+    TessellatedPath (see the ctors of TessellatedPath
+    that take a TessellatedPath to reuse),
+    so that adding a contour to a Path only tessellates
+    the added contour.
    */
   const reference_counted_ptr<const TessellatedPath>&
   tessellation(void) const;
 
+  /*!
+    Return a tessellation of this Path suitable for drawing
+    the Path with a transformation that magnifies by the
+    given factor. The scale factor is quantized to a level
+    of detail, see lod_for_scale_factor(), and the returned
+    TessellatedPath is constructed with the parameters
+    TessellationParams::lod_params() of tessellation_params().
+    A level of detail of 0 returns tessellation(). The
+    TessellatedPath objects of other levels of detail are
+    kept in a small cache (see
+    \ref tessellation_lod_cache_size)
+    that is cleared whenever the geometry or tessellation
+    parameters of this Path change.
+    \param scale_factor how much the Path is magnified, for
+                        example the operator norm of the
+                        transformation from Path coordinates
+                        to pixel coordinates
+   */
+  reference_counted_ptr<const TessellatedPath>
+  tessellation(float scale_factor) const;
+
+  /*!
+    Returns the level of detail for a scale factor, i.e.
+    log2(scale_factor) rounded to the nearest integer and
+    clamped to [min_tessellation_lod, max_tessellation_lod].
+    \param scale_factor how much the Path is magnified
+   */
+  static
+  int
+  lod_for_scale_factor(float scale_factor);
+
 private:
   void *m_d;
 };
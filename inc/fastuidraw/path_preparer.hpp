@@ -0,0 +1,138 @@
+/*!
+ * \file path_preparer.hpp
+ * \brief file path_preparer.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+#include <fastuidraw/util/fastuidraw_memory.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/util/util.hpp>
+
+namespace fastuidraw  {
+
+class Path;
+
+/*!\addtogroup Core
+  @{
+ */
+
+/*!
+  A PathPreparer builds the TessellatedPath, FilledPath and
+  StrokedPath of Path objects on a pool of worker threads.
+  The data is created lazily by Path::tessellation(),
+  TessellatedPath::filled() and TessellatedPath::stroked(),
+  which are safe to call while a PathPreparer is working on
+  a Path: if the data is still being built, the call blocks
+  until it is ready; if it is ready, the call returns it
+  immediately. A Path added to a PathPreparer must not be
+  modified or destroyed until the work on it is done (see
+  wait()) and must not be copied or painted with from another
+  thread except through the above lazy accessors. The
+  copies of a Path share their PathContour objects and
+  tessellations, so all the copies of a Path count as
+  that same Path for these rules.
+ */
+class PathPreparer:noncopyable
+{
+public:
+  /*!
+    Enumeration to specify what to build for a Path, the
+    TessellatedPath of a Path is always built.
+   */
+  enum prepare_bits_t
+    {
+      /*!
+        Build the FilledPath, see TessellatedPath::filled()
+       */
+      prepare_filled_path = 1,
+
+      /*!
+        Build the StrokedPath, see TessellatedPath::stroked()
+       */
+      prepare_stroked_path = 2,
+
+      /*!
+        Build both the FilledPath and StrokedPath
+       */
+      prepare_all = prepare_filled_path | prepare_stroked_path
+    };
+
+  /*!
+    Ctor. Starts the worker threads.
+    \param number_threads number of worker threads to use,
+                          a value of 0 is treated as 1.
+   */
+  explicit
+  PathPreparer(unsigned int number_threads);
+
+  ~PathPreparer();
+
+  /*!
+    Returns the number of worker threads.
+   */
+  unsigned int
+  number_threads(void) const;
+
+  /*!
+    Add a Path for the worker threads to prepare;
+    work on the Path starts immediately.
+    \param path Path to prepare
+    \param what bit field of enumerations of \ref prepare_bits_t
+                to specify what to build
+   */
+  void
+  add_path(const Path &path, uint32_t what = prepare_all);
+
+  /*!
+    Add a batch of Path objects for the worker threads to
+    prepare; work on the Path objects starts immediately.
+    The work of the batch is ordered so that the Path objects
+    are started in the order they are listed.
+    \param paths Path objects to prepare
+    \param what bit field of enumerations of \ref prepare_bits_t
+                to specify what to build
+   */
+  void
+  add_paths(const_c_array<const Path*> paths, uint32_t what = prepare_all);
+
+  /*!
+    Returns the number of jobs that have been added, but
+    not yet completed. A Path is broken into one job
+    for each of the bits of \ref prepare_bits_t that are
+    up when it was added; the job that builds a FilledPath
+    then adds one job for each leaf FilledPath::Subset
+    (see FilledPath::Subset::is_leaf()) to tessellate it.
+   */
+  unsigned int
+  number_jobs_pending(void) const;
+
+  /*!
+    Blocks until all the work that has been added is
+    completed.
+   */
+  void
+  wait(void);
+
+private:
+  void *m_d;
+};
+
+/*! @} */
+
+} //namespace fastuidraw
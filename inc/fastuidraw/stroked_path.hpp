@@ -23,6 +23,7 @@
 #include <fastuidraw/util/vecN.hpp>
 #include <fastuidraw/util/c_array.hpp>
 #include <fastuidraw/util/reference_counted.hpp>
+#include <fastuidraw/util/data_buffer.hpp>
 
 namespace fastuidraw  {
 
@@ -613,7 +614,30 @@ public:
   const PainterAttributeData&
   painter_data(void) const;
 
+  /*!
+    Write the data of this StrokedPath, including its
+    PainterAttributeData (see painter_data()), to a
+    BakedDataWriter. Typically, one bakes a StrokedPath
+    with TessellatedPath::bake().
+    \param dst BakedDataWriter to which to write
+   */
+  void
+  bake(BakedDataWriter &dst) const;
+
+  /*!
+    Load a StrokedPath written by bake(). The point, index
+    and attribute data are not copied, they point directly
+    into src.buffer(). Returns a NULL handle if the data
+    could not be read.
+    \param src BakedDataReader from which to read
+   */
+  static
+  reference_counted_ptr<const StrokedPath>
+  load_baked(BakedDataReader &src);
+
 private:
+  StrokedPath(void);
+
   void *m_d;
 };
 
@@ -24,6 +24,7 @@
 #include <fastuidraw/util/vecN.hpp>
 #include <fastuidraw/util/c_array.hpp>
 #include <fastuidraw/util/reference_counted.hpp>
+#include <fastuidraw/util/data_buffer.hpp>
 #include <fastuidraw/stroked_path.hpp>
 #include <fastuidraw/filled_path.hpp>
 
@@ -39,9 +40,13 @@ class Path;
 
 /*!
   A TessellatedPath represents the tessellation of a Path.
+  The reference count of a TessellatedPath is thread safe
+  because the copies of a Path share their tessellations
+  and a PathPreparer may drop a stale one, see
+  Path::tessellation(), on a worker thread.
  */
 class TessellatedPath:
-    public reference_counted<TessellatedPath>::non_concurrent
+    public reference_counted<TessellatedPath>::default_base
 {
 public:
   /*!
@@ -56,7 +61,8 @@ public:
      */
     TessellationParams(void):
       m_curve_tessellation(float(M_PI)/30.0f),
-      m_max_segments(32)
+      m_max_segments(32),
+      m_max_distance(-1.0f)
     {}
 
     /*!
@@ -67,9 +73,26 @@ public:
     operator!=(const TessellationParams &rhs) const
     {
       return m_curve_tessellation != rhs.m_curve_tessellation
-        || m_max_segments != rhs.m_max_segments;
+        || m_max_segments != rhs.m_max_segments
+        || m_max_distance != rhs.m_max_distance;
     }
 
+    /*!
+      Returns the TessellationParams to use for a level
+      of detail, see Path::tessellation(float). The level
+      of detail L is for drawing with a transformation that
+      magnifies by about 2^L. Because the distance between
+      a curve and its chord grows with the square of the
+      angle the chord spans, m_curve_tessellation is scaled
+      by 2^(-L/2) and, for L > 0, m_max_segments by
+      2^ceil(L/2). If m_max_distance is positive, it is
+      scaled by 2^(-L) so that the tolerance stays the
+      same in pixels. A level of 0 returns *this.
+      \param lod level of detail
+     */
+    TessellationParams
+    lod_params(int lod) const;
+
     /*!
       For each 2 PI units of curvature, goal is to have
       atleast m_curve_tessellation points, initial
@@ -84,6 +107,23 @@ public:
       PathContour of a Path.
      */
     unsigned int m_max_segments;
+
+    /*!
+      If positive, the curves of a path are tessellated so
+      that the distance between each segment and the portion
+      of the curve it approximates is no more than
+      m_max_distance (in the coordinates of the Path),
+      using as few segments as possible, instead of by
+      m_curve_tessellation. For PathContour::bezier and
+      PathContour::arc the number of segments is computed
+      from closed form bounds of the distance; for other
+      PathContour::interpolator_generic derived objects it
+      is estimated from the second derivative. In both
+      cases the number of segments is still bounded by
+      m_max_segments. Initial value is -1.0, i.e. the
+      tessellation is driven by m_curve_tessellation.
+     */
+    float m_max_distance;
   };
 
   /*!
@@ -136,6 +176,51 @@ public:
     float m_closed_contour_length;
   };
 
+  /*!
+    A ScratchContext holds the temporary memory used
+    while constructing a TessellatedPath. Constructing
+    many TessellatedPath objects with the same
+    ScratchContext reuses that memory instead of
+    allocating it for each TessellatedPath. A
+    ScratchContext must not be used by more than
+    one thread at a time.
+   */
+  class ScratchContext:fastuidraw::noncopyable
+  {
+  public:
+    ScratchContext(void);
+
+    ~ScratchContext();
+
+  private:
+    friend class TessellatedPath;
+    void *m_d;
+  };
+
+  /*!
+    Enumeration to specify what to write with bake()
+    in addition to the TessellatedPath.
+   */
+  enum bake_bits_t
+    {
+      /*!
+        Write the StrokedPath, see stroked(), together
+        with its PainterAttributeData.
+       */
+      bake_stroked_path = 1,
+
+      /*!
+        Write the FilledPath, see filled(), together
+        with the PainterAttributeData of its subsets.
+       */
+      bake_filled_path = 2,
+
+      /*!
+        Write both the StrokedPath and FilledPath
+       */
+      bake_all = bake_stroked_path | bake_filled_path
+    };
+
   /*!
     Ctor. Construct a TessellatedPath from a Path
     \param input source path to tessellate
@@ -143,6 +228,48 @@ public:
    */
   TessellatedPath(const Path &input, TessellationParams P);
 
+  /*!
+    Ctor. Construct a TessellatedPath from a Path
+    using the temporary memory of a ScratchContext.
+    \param input source path to tessellate
+    \param P parameters on how to tessellate the source Path
+    \param ctx ScratchContext to use
+   */
+  TessellatedPath(const Path &input, TessellationParams P,
+                  ScratchContext &ctx);
+
+  /*!
+    Ctor. Construct a TessellatedPath from a Path reusing
+    the tessellation of another TessellatedPath. Each
+    contour of input that is ended (see PathContour::ended())
+    and is also a contour of the Path from which reuse was
+    constructed has its point data copied from reuse
+    instead of being tessellated again. Thus, after
+    contours are added to a Path, only the added contours
+    are tessellated. The contours are only reused if
+    reuse was constructed with the same tessellation
+    parameters.
+    \param input source path to tessellate
+    \param P parameters on how to tessellate the source Path
+    \param reuse TessellatedPath from which to copy the
+                 tessellation of contours, may be NULL
+   */
+  TessellatedPath(const Path &input, TessellationParams P,
+                  const TessellatedPath *reuse);
+
+  /*!
+    Ctor. Construct a TessellatedPath from a Path reusing
+    the tessellation of another TessellatedPath and using
+    the temporary memory of a ScratchContext.
+    \param input source path to tessellate
+    \param P parameters on how to tessellate the source Path
+    \param reuse TessellatedPath from which to copy the
+                 tessellation of contours, may be NULL
+    \param ctx ScratchContext to use
+   */
+  TessellatedPath(const Path &input, TessellationParams P,
+                  const TessellatedPath *reuse, ScratchContext &ctx);
+
   ~TessellatedPath();
 
   /*!
@@ -257,7 +384,40 @@ public:
   const reference_counted_ptr<const FilledPath>&
   filled(void) const;
 
+  /*!
+    Write this TessellatedPath, and optionally its StrokedPath
+    and FilledPath, to a BakedDataWriter so that it can later
+    be loaded with load_baked() without doing any of the work
+    of tessellating, stroking or filling. The written data is
+    versioned and only loads on a machine with the same byte
+    order and build of FastUIDraw. The StrokedPath and
+    FilledPath are built if they are not yet built.
+    \param dst BakedDataWriter to which to write
+    \param what bit field of enumerations of \ref bake_bits_t
+                to specify what to write
+   */
+  void
+  bake(BakedDataWriter &dst, uint32_t what = bake_all) const;
+
+  /*!
+    Load a TessellatedPath written by bake(). The point data,
+    the data of the StrokedPath and FilledPath (if they were
+    written) and their PainterAttributeData are not copied,
+    they point directly into src.buffer(); this makes loading
+    cheap, in particular from a DataBuffer that maps a file.
+    Returns a NULL handle if the data could not be read or
+    was written by an incompatible build. A StrokedPath or
+    FilledPath that was not written is built lazily from
+    the loaded point data as usual.
+    \param src BakedDataReader from which to read
+   */
+  static
+  reference_counted_ptr<const TessellatedPath>
+  load_baked(BakedDataReader &src);
+
 private:
+  TessellatedPath(void);
+
   void *m_d;
 };
 
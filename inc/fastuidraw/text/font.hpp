@@ -87,7 +87,9 @@ namespace fastuidraw
 
     /*!
       To be implemented by a derived class to generate glyph
-      rendering data given a glyph code and GlyphRender.
+      rendering data given a glyph code and GlyphRender. The
+      method must be thread safe: GlyphCache::fetch_glyphs()
+      calls it from several threads at the same time.
       \param render specifies object to return via GlyphRender::type(),
                     it is guaranteed by the caller that can_create_rendering_data()
                     returns true on render.type()
@@ -100,6 +102,56 @@ namespace fastuidraw
     compute_rendering_data(GlyphRender render, uint32_t glyph_code,
                            GlyphLayoutData &layout, Path &path) const = 0;
 
+    /*!
+      To be optionally implemented by a derived class to
+      compute only the GlyphLayoutData of a glyph, which is
+      used by an asynchronous GlyphCache to provide the layout
+      of a glyph before its rendering data is generated. The
+      values must be the same as those computed by
+      compute_rendering_data(). Default implementation calls
+      compute_rendering_data() and discards the rendering data.
+      \param render specifies the GlyphRender of the glyph,
+                    it is guaranteed by the caller that can_create_rendering_data()
+                    returns true on render.type()
+      \param glyph_code glyph code of glyph
+      \param[out] layout location to which to place the GlyphLayoutData for the glyph
+     */
+    virtual
+    void
+    compute_layout_data(GlyphRender render, uint32_t glyph_code,
+                        GlyphLayoutData &layout) const
+    {
+      GlyphRenderData *data;
+      Path path;
+
+      data = compute_rendering_data(render, glyph_code, layout, path);
+      FASTUIDRAWdelete(data);
+    }
+
+    /*!
+      To be optionally implemented by a derived class to return
+      a key identifying the glyph data the font generates across
+      processes, i.e. two fonts, possibly of different processes,
+      with the same key generate the same GlyphLayoutData, Path
+      and GlyphRenderData for each glyph code and GlyphRender.
+      The key must change whenever the glyph data would change,
+      for example when the data of the font or the parameters
+      with which glyph data is generated change. The key is
+      used by a GlyphCache with a persistent cache file to find
+      the glyph data of the font stored by an earlier process.
+      An empty key indicates that the glyph data of the font is
+      not to be stored in or read from a persistent cache file.
+      The returned array must stay valid for the lifetime of
+      the font and the method must be thread safe. Default
+      implementation returns an empty key.
+     */
+    virtual
+    const_c_array<uint8_t>
+    persistent_key(void) const
+    {
+      return const_c_array<uint8_t>();
+    }
+
   private:
     FontProperties m_props;
   };
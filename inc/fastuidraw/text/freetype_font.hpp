@@ -39,6 +39,15 @@ namespace fastuidraw
     from character codes to glyph codes for FontFreeType,
     i.e. glyph_code(uint32_t) const, is performed by libfreetype's
     FT_Get_Char_Index().
+
+    An FT_Face can only be used by one thread at a time. A
+    FontFreeType created with one of the create() methods knows
+    the source of the font and opens additional FT_Face objects
+    from it as needed, so that compute_rendering_data() can run
+    concurrently from several threads, each thread using its
+    own FT_Face. A FontFreeType constructed directly from an
+    FT_Face only has that face and serializes the generation
+    of glyph data.
    */
   class FontFreeType:public FontBase
   {
@@ -50,6 +59,30 @@ namespace fastuidraw
     class RenderParams
     {
     public:
+      /*!
+        Enumeration to specify how distance field
+        glyph data is generated.
+       */
+      enum distance_field_generator_t
+        {
+          /*!
+            Solve for the distance to each curve of the
+            outline along the rows and columns of texels;
+            the distance computed is the L1 distance.
+           */
+          distance_field_solver,
+
+          /*!
+            Flatten the outline to line segments, compute the
+            exact Euclidean distance to the segments within a
+            narrow band about the outline and propagate the
+            distances of the band to the remaining texels
+            with a linear time sweep (8SSEDT). Much faster
+            than \ref distance_field_solver.
+           */
+          distance_field_sweep,
+        };
+
       /*!
         Ctor, initializes values to defaults.
        */
@@ -103,6 +136,20 @@ namespace fastuidraw
       RenderParams&
       distance_field_max_distance(float v);
 
+      /*!
+        Method by which distance field glyph data is generated.
+       */
+      enum distance_field_generator_t
+      distance_field_generator(void) const;
+
+      /*!
+        Set the value returned by distance_field_generator(void) const,
+        initial value is \ref distance_field_solver.
+        \param v value
+       */
+      RenderParams&
+      distance_field_generator(enum distance_field_generator_t v);
+
       /*!
         Pixel size at which to render curve pair scalable glyphs.
        */
@@ -117,6 +164,36 @@ namespace fastuidraw
       RenderParams&
       curve_pair_pixel_size(unsigned int v);
 
+      /*!
+        Pixel size at which to render multi-channel distance
+        field scalable glyphs.
+       */
+      unsigned int
+      msdf_pixel_size(void) const;
+
+      /*!
+        Set the value returned by msdf_pixel_size(void) const,
+        initial value is 24
+        \param v value
+       */
+      RenderParams&
+      msdf_pixel_size(unsigned int v);
+
+      /*!
+        Maximum distance value to record in multi-channel
+        distance field glyphs, units are in 1/64'th of a pixel.
+       */
+      float
+      msdf_max_distance(void) const;
+
+      /*!
+        Set the value returned by msdf_max_distance(void) const,
+        initial value is 128.0, i.e. 2 pixels
+        \param v value
+       */
+      RenderParams&
+      msdf_max_distance(float v);
+
     private:
       void *m_d;
     };
@@ -188,6 +265,21 @@ namespace fastuidraw
            const RenderParams &render_params = RenderParams(),
            int face_index = 0);
 
+    /*!
+      Ctor. Create a font from font data in memory and guess the
+      FontProperties from the FT_Face. The data is copied, so the
+      array need not stay valid after the call.
+      \param data font file data from which to load the font
+      \param lib FreetypeLib used to create FreeTypeFont object
+      \param render_params specifies how to generate data for scalable glyph data
+      \param face_index face index for face into font data to load
+     */
+    static
+    reference_counted_ptr<FontFreeType>
+    create(const_c_array<uint8_t> data, reference_counted_ptr<FreetypeLib> lib,
+           const RenderParams &render_params = RenderParams(),
+           int face_index = 0);
+
     /*!
       Create fonts from all faces of a font file.
       Returns the number of faces that are in font file.
@@ -212,11 +304,21 @@ namespace fastuidraw
     render_params(void) const;
 
     /*!
-      Return the FT_Face of this FontFreeType object.
+      Return the FT_Face of this FontFreeType object. Beware
+      that the face may be in use by a thread generating
+      glyph data with compute_rendering_data().
      */
     FT_Face
     face(void) const;
 
+    /*!
+      Returns the number of FT_Face objects this FontFreeType
+      has opened, i.e. the largest number of threads that
+      have generated glyph data from it concurrently.
+     */
+    unsigned int
+    number_faces(void) const;
+
     /*!
       Fill the field of a FontProperties from the values of an FT_Face.
       Beware that the foundary name is not assigned!
@@ -246,6 +348,24 @@ namespace fastuidraw
     compute_rendering_data(GlyphRender render, uint32_t glyph_code,
                            GlyphLayoutData &layout, Path &path) const;
 
+    virtual
+    void
+    compute_layout_data(GlyphRender render, uint32_t glyph_code,
+                        GlyphLayoutData &layout) const;
+
+    /*!
+      Implements FontBase::persistent_key(). For a FontFreeType
+      created with one of the create() methods, the key is made
+      from a hash of the font data, the face index, the version
+      of libfreetype and render_params(); the key is computed
+      on the first call, which reads all the font data. A
+      FontFreeType constructed directly from an FT_Face does
+      not know its font data and returns an empty key.
+     */
+    virtual
+    const_c_array<uint8_t>
+    persistent_key(void) const;
+
   private:
     void *m_d;
   };
@@ -34,7 +34,11 @@ namespace fastuidraw
 
   /*!
     A FreetypeLib wraps an FT_Library object of libFreeType
-    in a reference counted object.
+    in a reference counted object. libFreeType requires that
+    the creation and destruction of FT_Face objects from the
+    same FT_Library are not done concurrently; a FreetypeLib
+    provides a mutex, see lock() and unlock(), to serialize
+    those calls.
    */
   class FreetypeLib:public reference_counted<FreetypeLib>::default_base
   {
@@ -67,8 +71,25 @@ namespace fastuidraw
       return m_lib != NULL;
     }
 
+    /*!
+      Lock the mutex of this FreetypeLib. The mutex
+      should be locked around calls to FT_New_Face(),
+      FT_New_Memory_Face() and FT_Done_Face() using
+      lib() whenever other threads may also create or
+      destroy faces from lib().
+     */
+    void
+    lock(void);
+
+    /*!
+      Unlock the mutex of this FreetypeLib, see lock().
+     */
+    void
+    unlock(void);
+
   private:
     FT_Library m_lib;
+    void *m_d;
   };
 /*! @} */
 };
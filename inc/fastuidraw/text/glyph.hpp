@@ -129,13 +129,27 @@ namespace fastuidraw
       If returns \ref routine_fail, then the GlyphCache
       on which the glyph resides needs to be cleared
       first. If the glyph is already uploaded returns
-      immediately with \ref routine_success.
+      immediately with \ref routine_success. A glyph
+      that is pending cannot be uploaded and returns
+      \ref routine_fail, check pending() first.
      */
     enum return_code
     upload_to_atlas(void) const;
 
     /*!
-      Returns the path of the Glyph.
+      Returns true if the rendering data of the glyph is
+      not yet generated, see GlyphCache. The layout()
+      of a pending glyph is valid, but the glyph cannot
+      be uploaded to the GlyphAtlas and its path() is
+      empty. The return value of valid() must be true.
+      If not, debug builds assert and release builds crash.
+     */
+    bool
+    pending(void) const;
+
+    /*!
+      Returns the path of the Glyph, the path is
+      empty while the glyph is pending().
      */
     const Path&
     path(void) const;
@@ -34,6 +34,34 @@ namespace fastuidraw
   /*!
     A GlyphCache represents a cache of glyphs and manages the uploading
     of the data to a GlyphAtlas. Methods are NOT thread safe.
+
+    A GlyphCache is either synchronous or asynchronous. When a glyph
+    is not in a synchronous GlyphCache, fetch_glyph() generates the
+    glyph's rendering data before returning. When a glyph is not in an
+    asynchronous GlyphCache, fetch_glyph() only computes the glyph's
+    layout (see FontBase::compute_layout_data()) and returns a Glyph
+    that is pending (see Glyph::pending()); the rendering data of the
+    glyph is generated by a thread of the GlyphCache and taken by the
+    glyph at the next call to upload_pending_glyphs(). A pending glyph
+    has its layout data, but no path and it cannot be uploaded to
+    the GlyphAtlas. Painter::begin() calls upload_pending_glyphs() on
+    the GlyphCache set with Painter::glyph_cache().
+
+    A GlyphCache can have a persistent cache file in which it stores
+    the GlyphLayoutData, Path and GlyphRenderData of the glyphs it
+    generates so that a later process, or a later GlyphCache, can read
+    the glyph data from the file instead of generating it again. A
+    glyph is found in the file by FontBase::persistent_key() of its
+    font, its glyph code and its GlyphRender; the glyphs of a font
+    whose key is empty are neither read from nor written to the file.
+    On construction only the index of the file is read, the data of
+    a glyph is read from the file when the glyph is first fetched,
+    except for its Path which is read on the first call to
+    Glyph::path(). A glyph read from the file is never pending. A file
+    written by an incompatible version of FastUIDraw, or by a machine of
+    a different byte order, is replaced by a new file (the old file is
+    left as it is for the processes that have it open); a damaged glyph
+    in the file is generated again.
    */
   class GlyphCache:public reference_counted<GlyphCache>::default_base
   {
@@ -41,22 +69,126 @@ namespace fastuidraw
     /*!
       Ctor
       \param patlas GlyphAtlas to store glyph data
+      \param number_generation_threads if non-zero, the GlyphCache
+                                       is asynchronous and uses this
+                                       many threads to generate glyph
+                                       rendering data
+      \param persistent_cache_file if non-NULL, name of the persistent
+                                   cache file of the GlyphCache, the
+                                   file is created if it does not exist
      */
     explicit
-    GlyphCache(reference_counted_ptr<GlyphAtlas> patlas);
+    GlyphCache(reference_counted_ptr<GlyphAtlas> patlas,
+               unsigned int number_generation_threads = 0,
+               const char *persistent_cache_file = NULL);
 
     ~GlyphCache();
 
     /*!
       Fetch, and if necessay create and store, a glyph given a
       glyph code of a font and a GlyphRender specifying how
-      to render the glyph.
+      to render the glyph. If the GlyphCache is asynchronous,
+      a glyph not in the cache is returned pending.
      */
     Glyph
     fetch_glyph(GlyphRender render,
                 const reference_counted_ptr<const FontBase> &font,
                 uint32_t glyph_code);
 
+    /*!
+      Fetch, and if necessary create and store, many glyphs of
+      a single font at once. The glyph data of those glyphs not
+      yet in the cache is generated concurrently by several
+      threads and the new glyphs are then uploaded to the
+      GlyphAtlas in one pass. Use this instead of many calls
+      to fetch_glyph() to warm the cache with a large set of
+      glyphs. As with fetch_glyph(), the method is NOT thread
+      safe, but the font must support having
+      FontBase::compute_rendering_data() called from several
+      threads at the same time.
+      \param render specifies how to render the glyphs
+      \param font font of the glyphs
+      \param glyph_codes glyph codes of the glyphs
+      \param[out] out_glyphs location to which to write the glyphs,
+                             out_glyphs[i] is the glyph of glyph_codes[i];
+                             must be the same size as glyph_codes
+      \param number_threads number of threads to use to generate glyph
+                            data, including the calling thread. A value
+                            of 0 indicates to use as many threads as
+                            the hardware can run concurrently.
+     */
+    void
+    fetch_glyphs(GlyphRender render,
+                 const reference_counted_ptr<const FontBase> &font,
+                 const_c_array<uint32_t> glyph_codes,
+                 c_array<Glyph> out_glyphs,
+                 unsigned int number_threads = 0);
+
+    /*!
+      Fetch, and if necessary create and store, many glyphs at
+      once where each glyph has its own font. Same as
+      fetch_glyphs(GlyphRender, const reference_counted_ptr<const FontBase>&, const_c_array<uint32_t>, c_array<Glyph>, unsigned int)
+      except that fonts[i] is the font of glyph_codes[i].
+      \param render specifies how to render the glyphs
+      \param fonts font of each glyph, must be the same size as glyph_codes
+      \param glyph_codes glyph codes of the glyphs
+      \param[out] out_glyphs location to which to write the glyphs,
+                             out_glyphs[i] is the glyph of glyph_codes[i];
+                             must be the same size as glyph_codes
+      \param number_threads number of threads to use to generate glyph
+                            data, including the calling thread. A value
+                            of 0 indicates to use as many threads as
+                            the hardware can run concurrently.
+     */
+    void
+    fetch_glyphs(GlyphRender render,
+                 const_c_array<reference_counted_ptr<const FontBase> > fonts,
+                 const_c_array<uint32_t> glyph_codes,
+                 c_array<Glyph> out_glyphs,
+                 unsigned int number_threads = 0);
+
+    /*!
+      Returns true if the GlyphCache is asynchronous.
+     */
+    bool
+    asynchronous(void) const;
+
+    /*!
+      Returns true if the GlyphCache has a persistent cache
+      file, i.e. if a file was named at construction and it
+      could be opened.
+     */
+    bool
+    persistent(void) const;
+
+    /*!
+      Returns the number of glyphs of this GlyphCache
+      that are pending.
+     */
+    unsigned int
+    number_pending_glyphs(void) const;
+
+    /*!
+      For an asynchronous GlyphCache, give the pending glyphs
+      whose rendering data has been generated their data and
+      upload them to the GlyphAtlas; these glyphs are then no
+      longer pending. A glyph that fails to upload is handled
+      as any other glyph not uploaded, see Glyph::upload_to_atlas().
+      Returns the number of glyphs that are no longer pending.
+      Does nothing for a synchronous GlyphCache.
+     */
+    unsigned int
+    upload_pending_glyphs(void);
+
+    /*!
+      Wait until the rendering data of all pending glyphs is
+      generated and then call upload_pending_glyphs(), i.e.
+      on return no glyph of the cache is pending. Returns the
+      return value of upload_pending_glyphs().
+     */
+    unsigned int
+    wait_pending_glyphs(void);
+
     /*!
       Removes a glyph from the -CACHE-, i.e. the GlyphCache,
       thus to use that glyph again requires calling fetch_glyph()
@@ -60,6 +60,13 @@ namespace fastuidraw
        */
       curve_pair_glyph,
 
+      /*!
+        Glyph is a multi-channel signed distance field
+        glyph, generated from a GlyphRenderDataMSDF.
+        Glyph is scalable.
+       */
+      msdf_glyph,
+
       /*!
         Tag to indicate invalid glyph type; the value is much
         larger than the last glyph type to allow for later ABI
@@ -104,8 +111,8 @@ namespace fastuidraw
 
     /*!
       Returns true if and only if the data for a glyph type
-      is scalable, for example distance_field_glyph and
-      curve_pair_glyph are scalable
+      is scalable, for example distance_field_glyph,
+      curve_pair_glyph and msdf_glyph are scalable
      */
     static
     bool
@@ -0,0 +1,122 @@
+/*!
+ * \file glyph_render_data_msdf.hpp
+ * \brief file glyph_render_data_msdf.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <fastuidraw/text/glyph_render_data.hpp>
+
+namespace fastuidraw
+{
+/*!\addtogroup Text
+  @{
+*/
+
+  /*!
+    Represents a multi-channel signed distance field of a
+    glyph. Each of the three channels is a signed distance
+    field to a subset of the edges of the outline of the
+    glyph, chosen so that at each corner of the glyph the two
+    edges meeting at the corner do not share all channels.
+    The glyph is reconstructed by taking the median of the
+    three channels, which keeps corners sharp so that a
+    much smaller field than for GlyphRenderDataDistanceField
+    gives the same quality.
+
+    On a GlyphAtlas, the red channel is stored at the
+    primary location and the green and blue channels at
+    the secondary location: the green channel at the
+    secondary location and the blue channel above it,
+    offset by the height of the glyph plus one.
+   */
+  class GlyphRenderDataMSDF:public GlyphRenderData
+  {
+  public:
+    /*!
+      Enumeration of the channels of the distance field.
+     */
+    enum channel_t
+      {
+        red_channel, /*!< red channel */
+        green_channel, /*!< green channel */
+        blue_channel, /*!< blue channel */
+
+        number_channels /*!< number of channels */
+      };
+
+    /*!
+      Ctor, initialized the resolution as (0,0).
+     */
+    GlyphRenderDataMSDF(void);
+    ~GlyphRenderDataMSDF(void);
+
+    /*!
+      Returns the resolution of each channel of the glyph
+      with padding. The padding is to be 1 pixel wide on
+      the bottom and on the right, i.e.
+      GlyphAtlas::Padding::m_right = GlyphAtlas::Padding::m_bottom = 1
+      and GlyphAtlas::Padding::m_left = GlyphAtlas::Padding::m_top = 0.
+     */
+    ivec2
+    resolution(void) const;
+
+    /*!
+      Returns the distance values of a channel. The texel
+      (x,y) is located at I where I is given by
+      I = x + y * resolution().x(). Values are 8-bit
+      normalized signed distances where 0 is the maximum
+      distance outside, 255 the maximum distance inside
+      and 127.5 is on the edge.
+      \param c channel
+     */
+    const_c_array<uint8_t>
+    distance_values(enum channel_t c) const;
+
+    /*!
+      Returns the distance values of a channel. The texel
+      (x,y) is located at I where I is given by
+      I = x + y * resolution().x(). Values are 8-bit
+      normalized signed distances where 0 is the maximum
+      distance outside, 255 the maximum distance inside
+      and 127.5 is on the edge.
+      \param c channel
+     */
+    c_array<uint8_t>
+    distance_values(enum channel_t c);
+
+    /*!
+      Change the resolution
+      \param sz new resolution
+     */
+    void
+    resize(ivec2 sz);
+
+    virtual
+    enum fastuidraw::return_code
+    upload_to_atlas(const reference_counted_ptr<GlyphAtlas> &atlas,
+                    GlyphLocation &atlas_location,
+                    GlyphLocation &secondary_atlas_location,
+                    int &geometry_offset,
+                    int &geometry_length) const;
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+
+} //namespace fastuidraw
@@ -194,6 +194,66 @@ namespace fastuidraw
                                      input_iterator character_codes_end,
                                      output_iterator output_begin);
 
+    /*!
+      Fetch many Glyph values with font merging at once from an
+      array of character codes. The glyph data of glyphs not yet
+      in the GlyphCache is generated concurrently, see
+      GlyphCache::fetch_glyphs().
+      \param tp glyph rendering type
+      \param group FontGroup to choose what font
+      \param character_codes character codes of the glyphs to fetch
+      \param[out] out_glyphs location to which to write the glyphs,
+                             must be the same size as character_codes
+      \param number_threads number of threads to use to generate glyph
+                            data, see GlyphCache::fetch_glyphs()
+     */
+    void
+    fetch_glyphs(GlyphRender tp, FontGroup group,
+                 const_c_array<uint32_t> character_codes,
+                 c_array<Glyph> out_glyphs,
+                 unsigned int number_threads = 0);
+
+    /*!
+      Fetch many Glyph values with font merging at once from an
+      array of character codes. The glyph data of glyphs not yet
+      in the GlyphCache is generated concurrently, see
+      GlyphCache::fetch_glyphs().
+      \param tp glyph rendering type
+      \param h handle to font from which to fetch the glyphs, if a glyph
+               is not present in the font attempt to get the glyph from
+               a font of similiar properties
+      \param character_codes character codes of the glyphs to fetch
+      \param[out] out_glyphs location to which to write the glyphs,
+                             must be the same size as character_codes
+      \param number_threads number of threads to use to generate glyph
+                            data, see GlyphCache::fetch_glyphs()
+     */
+    void
+    fetch_glyphs(GlyphRender tp, reference_counted_ptr<const FontBase> h,
+                 const_c_array<uint32_t> character_codes,
+                 c_array<Glyph> out_glyphs,
+                 unsigned int number_threads = 0);
+
+    /*!
+      Fetch many Glyph values without font merging at once from
+      an array of character codes. The glyph data of glyphs not
+      yet in the GlyphCache is generated concurrently, see
+      GlyphCache::fetch_glyphs().
+      \param tp glyph rendering type
+      \param h handle to font from which to fetch the glyphs, if a glyph
+               is not present in the font, then its Glyph is invalid.
+      \param character_codes character codes of the glyphs to fetch
+      \param[out] out_glyphs location to which to write the glyphs,
+                             must be the same size as character_codes
+      \param number_threads number of threads to use to generate glyph
+                            data, see GlyphCache::fetch_glyphs()
+     */
+    void
+    fetch_glyphs_no_merging(GlyphRender tp, reference_counted_ptr<const FontBase> h,
+                            const_c_array<uint32_t> character_codes,
+                            c_array<Glyph> out_glyphs,
+                            unsigned int number_threads = 0);
+
   private:
     void
     lock_mutex(void);
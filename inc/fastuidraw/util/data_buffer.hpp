@@ -0,0 +1,278 @@
+/*!
+ * \file data_buffer.hpp
+ * \brief file data_buffer.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/c_array.hpp>
+#include <fastuidraw/util/reference_counted.hpp>
+
+namespace fastuidraw
+{
+/*!\addtogroup Utility
+  @{
+ */
+
+  /*!
+    A DataBuffer holds a read-only block of bytes, either
+    copied from memory or mapped from a file. The bytes
+    of a DataBuffer are aligned to at least 4 bytes and
+    never change or move for the lifetime of the DataBuffer.
+   */
+  class DataBuffer:
+    public reference_counted<DataBuffer>::default_base
+  {
+  public:
+    /*!
+      Ctor. Maps the contents of a file into memory; if the
+      file cannot be opened or mapped, data() is empty.
+      \param filename name of file to map
+     */
+    explicit
+    DataBuffer(const char *filename);
+
+    /*!
+      Ctor. Copies bytes into the DataBuffer.
+      \param bytes bytes to copy
+     */
+    explicit
+    DataBuffer(const_c_array<uint8_t> bytes);
+
+    ~DataBuffer();
+
+    /*!
+      Returns the bytes of the DataBuffer.
+     */
+    const_c_array<uint8_t>
+    data(void) const;
+
+  private:
+    void *m_d;
+  };
+
+  /*!
+    A BakedDataWriter writes values and arrays of plain
+    data into a byte stream that a BakedDataReader can
+    read back. Arrays are aligned within the stream so that
+    a BakedDataReader returns arrays that point directly
+    into the bytes it reads from. The data is written in the
+    byte order and struct layout of the machine; the objects
+    that bake themselves with a BakedDataWriter write enough
+    header information to detect a mismatch on load.
+   */
+  class BakedDataWriter:noncopyable
+  {
+  public:
+    enum
+      {
+        /*!
+          Alignment, in bytes from the start of the
+          stream, of the elements of each array.
+         */
+        array_alignment = 16
+      };
+
+    BakedDataWriter(void);
+
+    ~BakedDataWriter();
+
+    /*!
+      Write a single value.
+      \param v value to write, T must be a plain data type
+               whose size is a multiple of 4 bytes
+     */
+    template<typename T>
+    void
+    write_value(const T &v)
+    {
+      write_bytes(&v, sizeof(T), sizeof(uint32_t));
+    }
+
+    /*!
+      Write an array, the element count followed by the
+      elements starting at the next multiple of \ref
+      array_alignment.
+      \param values array to write, T must be a plain data
+                    type whose size is a multiple of 4 bytes
+     */
+    template<typename T>
+    void
+    write_array(const_c_array<T> values)
+    {
+      write_value(uint32_t(values.size()));
+      write_bytes(values.c_ptr(), values.size() * sizeof(T), array_alignment);
+    }
+
+    /*!
+      Provided as a conveniance, equivalent to
+      \code
+      write_array(const_c_array<T>(values))
+      \endcode
+      \param values array to write
+     */
+    template<typename T>
+    void
+    write_array(c_array<T> values)
+    {
+      write_array(const_c_array<T>(values));
+    }
+
+    /*!
+      Write raw bytes, first padding the stream with zeros
+      to the named alignment.
+      \param bytes location of bytes to write
+      \param num_bytes number of bytes to write
+      \param alignment alignment, must be a power of 2
+     */
+    void
+    write_bytes(const void *bytes, unsigned int num_bytes, unsigned int alignment);
+
+    /*!
+      Returns the bytes written so far.
+     */
+    const_c_array<uint8_t>
+    data(void) const;
+
+    /*!
+      Write the bytes written so far to a file,
+      returns false if the file could not be written.
+      \param filename name of file to which to write
+     */
+    bool
+    save(const char *filename) const;
+
+  private:
+    void *m_d;
+  };
+
+  /*!
+    A BakedDataReader reads back, from a DataBuffer, what a
+    BakedDataWriter wrote. Arrays are returned as pointing
+    into the DataBuffer, objects loaded from a BakedDataReader
+    keep a handle to buffer() so that the arrays stay valid.
+    Once a read fails, error() returns true and every
+    following read fails.
+   */
+  class BakedDataReader:noncopyable
+  {
+  public:
+    /*!
+      Ctor.
+      \param buffer DataBuffer from which to read
+     */
+    explicit
+    BakedDataReader(const reference_counted_ptr<const DataBuffer> &buffer);
+
+    ~BakedDataReader();
+
+    /*!
+      Read a single value written with
+      BakedDataWriter::write_value(), returns
+      false on failure.
+      \param v location to which to write the value
+     */
+    template<typename T>
+    bool
+    read_value(T &v)
+    {
+      const_c_array<uint8_t> bytes;
+
+      bytes = read_bytes(sizeof(T), sizeof(uint32_t));
+      if(bytes.size() != sizeof(T))
+        {
+          return false;
+        }
+      /* T may be a class type such as vecN, copy
+         through void* as T is only plain data.
+       */
+      memcpy(static_cast<void*>(&v), bytes.c_ptr(), sizeof(T));
+      return true;
+    }
+
+    /*!
+      Read an array written with BakedDataWriter::write_array(),
+      returns false on failure. On success, the array points
+      directly into buffer().
+      \param values location to which to write the array
+     */
+    template<typename T>
+    bool
+    read_array(const_c_array<T> &values)
+    {
+      uint32_t count;
+      const_c_array<uint8_t> bytes;
+
+      if(!read_value(count) || count > remaining() / sizeof(T))
+        {
+          set_error();
+          return false;
+        }
+
+      bytes = read_bytes(count * sizeof(T), BakedDataWriter::array_alignment);
+      if(error())
+        {
+          return false;
+        }
+      values = const_c_array<T>(reinterpret_cast<const T*>(bytes.c_ptr()), count);
+      return true;
+    }
+
+    /*!
+      Read raw bytes written by BakedDataWriter::write_bytes(),
+      on failure returns an empty array and sets error().
+      \param num_bytes number of bytes to read
+      \param alignment alignment passed to BakedDataWriter::write_bytes()
+     */
+    const_c_array<uint8_t>
+    read_bytes(unsigned int num_bytes, unsigned int alignment);
+
+    /*!
+      Returns the number of bytes not yet read.
+     */
+    unsigned int
+    remaining(void) const;
+
+    /*!
+      Returns true if any read has failed.
+     */
+    bool
+    error(void) const;
+
+    /*!
+      Mark the BakedDataReader as having failed; objects
+      loading themselves call this when the values read
+      are not consistent.
+     */
+    void
+    set_error(void);
+
+    /*!
+      Returns the DataBuffer from which this
+      BakedDataReader reads.
+     */
+    const reference_counted_ptr<const DataBuffer>&
+    buffer(void) const;
+
+  private:
+    void *m_d;
+  };
+/*! @} */
+}
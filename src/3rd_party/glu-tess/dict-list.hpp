@@ -41,7 +41,7 @@
 #define Dict            DictList
 #define DictNode        DictListNode
 
-#define dictNewDict(frame,leq)          glu_fastuidraw_gl_dictListNewDict(frame,leq)
+#define dictNewDict(arena,frame,leq)    glu_fastuidraw_gl_dictListNewDict(arena,frame,leq)
 #define dictDeleteDict(dict)            glu_fastuidraw_gl_dictListDeleteDict(dict)
 
 #define dictSearch(dict,key)            glu_fastuidraw_gl_dictListSearch(dict,key)
@@ -60,8 +60,14 @@
 typedef void *DictKey;
 typedef struct Dict Dict;
 typedef struct DictNode DictNode;
+typedef struct GLUarena GLUarena;
 
+/* The dictionary and its nodes are allocated from arena;
+ * dictDeleteDict() is O(1), the storage of the nodes is
+ * reclaimed when the arena is reset.
+ */
 Dict            *dictNewDict(
+                        GLUarena *arena,
                         void *frame,
                         int (*leq)(void *frame, DictKey key1, DictKey key2) );
 
@@ -95,6 +101,7 @@ struct Dict {
   DictNode      head;
   void          *frame;
   int           (*leq)(void *frame, DictKey key1, DictKey key2);
+  GLUarena      *arena;
 };
 
 #endif
@@ -37,10 +37,10 @@
 #include "memalloc.hpp"
 
 /* really glu_fastuidraw_gl_dictListNewDict */
-Dict *dictNewDict( void *frame,
+Dict *dictNewDict( GLUarena *arena, void *frame,
                    int (*leq)(void *frame, DictKey key1, DictKey key2) )
 {
-  Dict *dict = (Dict *) memAlloc( sizeof( Dict ));
+  Dict *dict = (Dict *) arenaAlloc( arena, sizeof( Dict ));
   DictNode *head;
 
   if (dict == NULL) return NULL;
@@ -53,6 +53,7 @@ Dict *dictNewDict( void *frame,
 
   dict->frame = frame;
   dict->leq = leq;
+  dict->arena = arena;
 
   return dict;
 }
@@ -60,13 +61,7 @@ Dict *dictNewDict( void *frame,
 /* really glu_fastuidraw_gl_dictListDeleteDict */
 void dictDeleteDict( Dict *dict )
 {
-  DictNode *node, *next;
-
-  for( node = dict->head.next; node != &dict->head; node = next ) {
-    next = node->next;
-    memFree( node );
-  }
-  memFree( dict );
+  arenaFree( dict->arena, dict, sizeof( Dict ));
 }
 
 /* really glu_fastuidraw_gl_dictListInsertBefore */
@@ -78,7 +73,7 @@ DictNode *dictInsertBefore( Dict *dict, DictNode *node, DictKey key )
     node = node->prev;
   } while( node->key != NULL && ! (*dict->leq)(dict->frame, node->key, key));
 
-  newNode = (DictNode *) memAlloc( sizeof( DictNode ));
+  newNode = (DictNode *) arenaAlloc( dict->arena, sizeof( DictNode ));
   if (newNode == NULL) return NULL;
 
   newNode->key = key;
@@ -91,11 +86,11 @@ DictNode *dictInsertBefore( Dict *dict, DictNode *node, DictKey key )
 }
 
 /* really glu_fastuidraw_gl_dictListDelete */
-void dictDelete( Dict *dict, DictNode *node ) /*ARGSUSED*/
+void dictDelete( Dict *dict, DictNode *node )
 {
   node->next->prev = node->prev;
   node->prev->next = node->next;
-  memFree( node );
+  arenaFree( dict->arena, node, sizeof( DictNode ));
 }
 
 /* really glu_fastuidraw_gl_dictListSearch */
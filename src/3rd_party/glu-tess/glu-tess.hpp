@@ -50,6 +50,7 @@
 #pragma once
 
 #include <climits>
+#include <stddef.h>
 
 /* the ID FASTUIDRAW_GLU_NULL_CLIENT_ID is reserved for use
    by FASTUIDRAW_GLU to represent a "NULL" vertex, do not
@@ -228,6 +229,30 @@ void fastuidraw_gluTessPropertyTolerance(fastuidraw_GLUtesselator *tess, double
 int fastuidraw_gluGetTessPropertyBoundaryOnly(fastuidraw_GLUtesselator *tess);
 void fastuidraw_gluTessPropertyBoundaryOnly(fastuidraw_GLUtesselator *tess, int value);
 
+/*
+  The mesh, edge dictionary and priority queue nodes of a
+  tessellator are allocated from an arena owned by the
+  tessellator. The arena is reset when a polygon is done,
+  keeping its blocks for the following polygons; the blocks
+  are only returned to the system when the tessellator is
+  deleted. Set and fetch the size in bytes of the blocks the
+  arena allocates (default 64KB); a new value only affects
+  blocks allocated afterwards.
+ */
+unsigned int fastuidraw_gluGetTessPropertyArenaBlockSize(fastuidraw_GLUtesselator *tess);
+void fastuidraw_gluTessPropertyArenaBlockSize(fastuidraw_GLUtesselator *tess, unsigned int value);
+
+/*
+  fetch statistics of the arena of a tessellator:
+   - PeakBytes: the largest number of bytes the arena had
+     in use at any time
+   - ReservedBytes: the total size of the blocks of the arena
+   - BlockCount: the number of blocks of the arena
+ */
+size_t fastuidraw_gluGetTessArenaPeakBytes(fastuidraw_GLUtesselator *tess);
+size_t fastuidraw_gluGetTessArenaReservedBytes(fastuidraw_GLUtesselator *tess);
+unsigned int fastuidraw_gluGetTessArenaBlockCount(fastuidraw_GLUtesselator *tess);
+
 
 #define FASTUIDRAW_GLU_TESS_TYPE_SAFE_CALL_BACK(which, type, label)                \
   void fastuidraw_gluTessCallback##label(fastuidraw_GLUtesselator *tess, type f)
@@ -52,3 +52,137 @@ void *glu_fastuidraw_gl_memAlloc( size_t n )
   return memset( FASTUIDRAWmalloc( n ), 0xa5, n );
 }
 #endif
+
+#define ARENA_ROUND_UP(n) \
+  (((n) + GLU_ARENA_ALIGNMENT - 1) & ~((size_t)GLU_ARENA_ALIGNMENT - 1))
+
+/* the usable bytes of a block come right after the (padded) header */
+#define ARENA_BLOCK_HEADER_SIZE         ARENA_ROUND_UP(sizeof(GLUarenaBlock))
+#define ARENA_BLOCK_DATA(b)             ((char *)(b) + ARENA_BLOCK_HEADER_SIZE)
+
+void glu_fastuidraw_gl_arenaInit( GLUarena *arena, size_t blockSize )
+{
+  int i;
+
+  arena->first = NULL;
+  arena->current = NULL;
+  arena->offset = 0;
+  arena->blockSize = ARENA_ROUND_UP(blockSize);
+  for( i = 0; i < GLU_ARENA_NUM_FREE_LISTS; ++i ) {
+    arena->freeLists[i] = NULL;
+  }
+  arena->bytesUsed = 0;
+  arena->peakBytes = 0;
+  arena->bytesReserved = 0;
+  arena->blockCount = 0;
+}
+
+void glu_fastuidraw_gl_arenaRelease( GLUarena *arena )
+{
+  GLUarenaBlock *b, *next;
+  size_t blockSize = arena->blockSize;
+
+  for( b = arena->first; b != NULL; b = next ) {
+    next = b->next;
+    memFree( b );
+  }
+  glu_fastuidraw_gl_arenaInit( arena, blockSize );
+}
+
+void glu_fastuidraw_gl_arenaReset( GLUarena *arena )
+{
+  int i;
+
+  arena->current = arena->first;
+  arena->offset = 0;
+  for( i = 0; i < GLU_ARENA_NUM_FREE_LISTS; ++i ) {
+    arena->freeLists[i] = NULL;
+  }
+  arena->bytesUsed = 0;
+}
+
+void *glu_fastuidraw_gl_arenaAlloc( GLUarena *arena, size_t n )
+{
+  GLUarenaBlock *b, *prev;
+  void *p;
+
+  n = ARENA_ROUND_UP(n);
+  if( n == 0 ) n = GLU_ARENA_ALIGNMENT;
+
+  if( n <= GLU_ARENA_NUM_FREE_LISTS * GLU_ARENA_ALIGNMENT ) {
+    void **freeList = &arena->freeLists[n / GLU_ARENA_ALIGNMENT - 1];
+    if( *freeList != NULL ) {
+      p = *freeList;
+      *freeList = *(void **)p;
+      return p;
+    }
+  }
+
+  if( arena->current == NULL || arena->offset + n > arena->current->size ) {
+    /* Move to the next block large enough, the remaining bytes of the
+     * blocks skipped are reclaimed by the next arenaReset().
+     */
+    prev = arena->current;
+    b = (prev != NULL) ? prev->next : arena->first;
+    while( b != NULL && b->size < n ) {
+      prev = b;
+      b = b->next;
+    }
+
+    if( b == NULL ) {
+      size_t sz = (n > arena->blockSize) ? n : arena->blockSize;
+
+      b = (GLUarenaBlock *)memAlloc( ARENA_BLOCK_HEADER_SIZE + sz );
+      if( b == NULL ) return NULL;
+
+      b->size = sz;
+      b->next = NULL;
+      if( prev != NULL ) {
+        prev->next = b;
+      } else {
+        arena->first = b;
+      }
+      arena->bytesReserved += sz;
+      ++arena->blockCount;
+    }
+    arena->current = b;
+    arena->offset = 0;
+  }
+
+  p = ARENA_BLOCK_DATA(arena->current) + arena->offset;
+  arena->offset += n;
+  arena->bytesUsed += n;
+  if( arena->bytesUsed > arena->peakBytes ) {
+    arena->peakBytes = arena->bytesUsed;
+  }
+  return p;
+}
+
+void *glu_fastuidraw_gl_arenaRealloc( GLUarena *arena, void *p,
+                                      size_t oldSize, size_t newSize )
+{
+  void *q;
+
+  q = glu_fastuidraw_gl_arenaAlloc( arena, newSize );
+  if( q == NULL ) return NULL;
+
+  if( p != NULL ) {
+    memcpy( q, p, (oldSize < newSize) ? oldSize : newSize );
+    glu_fastuidraw_gl_arenaFree( arena, p, oldSize );
+  }
+  return q;
+}
+
+void glu_fastuidraw_gl_arenaFree( GLUarena *arena, void *p, size_t n )
+{
+  if( p == NULL ) return;
+
+  n = ARENA_ROUND_UP(n);
+  if( n == 0 ) n = GLU_ARENA_ALIGNMENT;
+
+  if( n <= GLU_ARENA_NUM_FREE_LISTS * GLU_ARENA_ALIGNMENT ) {
+    void **freeList = &arena->freeLists[n / GLU_ARENA_ALIGNMENT - 1];
+    *(void **)p = *freeList;
+    *freeList = p;
+  }
+}
@@ -52,4 +52,70 @@ extern int              glu_fastuidraw_gl_memInit( size_t );
 extern void *           glu_fastuidraw_gl_memAlloc( size_t );
 #endif
 
+/* A GLUarena is a resettable block allocator. A tessellator owns
+ * one arena from which all the nodes of its mesh, edge dictionary
+ * and priority queue are allocated. Nodes freed with arenaFree()
+ * are kept on per-size free lists and recycled; arenaReset() makes
+ * all of the memory of the arena available again in O(1) without
+ * returning the blocks to the system, so that after the first few
+ * polygons a tessellation performs no calls to malloc at all.
+ */
+#define GLU_ARENA_ALIGNMENT             16
+#define GLU_ARENA_NUM_FREE_LISTS        16
+#define GLU_ARENA_DEFAULT_BLOCK_SIZE    65536
+
+typedef struct GLUarenaBlock GLUarenaBlock;
+typedef struct GLUarena GLUarena;
+
+struct GLUarenaBlock {
+  GLUarenaBlock *next;
+  size_t        size;           /* number of usable bytes of the block */
+};
+
+struct GLUarena {
+  GLUarenaBlock *first;         /* all blocks of the arena */
+  GLUarenaBlock *current;       /* block from which to allocate */
+  size_t        offset;         /* bytes used of current */
+  size_t        blockSize;      /* size of blocks to allocate */
+
+  /* freeLists[i] holds freed nodes of size (i + 1) * GLU_ARENA_ALIGNMENT */
+  void          *freeLists[GLU_ARENA_NUM_FREE_LISTS];
+
+  size_t        bytesUsed;      /* bytes taken from blocks since last reset */
+  size_t        peakBytes;      /* maximum value bytesUsed has reached */
+  size_t        bytesReserved;  /* sum of size of all blocks */
+  unsigned int  blockCount;     /* number of blocks */
+};
+
+#define arenaInit       glu_fastuidraw_gl_arenaInit
+#define arenaRelease    glu_fastuidraw_gl_arenaRelease
+#define arenaReset      glu_fastuidraw_gl_arenaReset
+#define arenaAlloc      glu_fastuidraw_gl_arenaAlloc
+#define arenaRealloc    glu_fastuidraw_gl_arenaRealloc
+#define arenaFree       glu_fastuidraw_gl_arenaFree
+
+/* arenaInit() initializes an arena with no blocks;
+ * arenaRelease() returns all blocks to the system.
+ */
+extern void             glu_fastuidraw_gl_arenaInit( GLUarena *arena, size_t blockSize );
+extern void             glu_fastuidraw_gl_arenaRelease( GLUarena *arena );
+
+/* Invalidates all allocations made from the arena,
+ * keeping its blocks for later allocations.
+ */
+extern void             glu_fastuidraw_gl_arenaReset( GLUarena *arena );
+
+/* Returns NULL if out of memory. */
+extern void *           glu_fastuidraw_gl_arenaAlloc( GLUarena *arena, size_t n );
+
+/* Returns NULL if out of memory, in which case p is not freed. */
+extern void *           glu_fastuidraw_gl_arenaRealloc( GLUarena *arena, void *p,
+                                                        size_t oldSize, size_t newSize );
+
+/* n must be the size passed to arenaAlloc() (or arenaRealloc()) for p;
+ * only small nodes are recycled, the memory of large allocations is
+ * reclaimed by arenaReset().
+ */
+extern void             glu_fastuidraw_gl_arenaFree( GLUarena *arena, void *p, size_t n );
+
 #endif
@@ -45,14 +45,17 @@
 #define FALSE 0
 #endif
 
-static GLUvertex *allocVertex()
+/* All elements of a mesh are allocated from the arena of the mesh,
+ * see memalloc.hpp.
+ */
+static GLUvertex *allocVertex( GLUmesh *mesh )
 {
-   return (GLUvertex *)memAlloc( sizeof( GLUvertex ));
+   return (GLUvertex *)arenaAlloc( mesh->arena, sizeof( GLUvertex ));
 }
 
-static GLUface *allocFace()
+static GLUface *allocFace( GLUmesh *mesh )
 {
-   return (GLUface *)memAlloc( sizeof( GLUface ));
+   return (GLUface *)arenaAlloc( mesh->arena, sizeof( GLUface ));
 }
 
 /************************ Utility Routines ************************/
@@ -66,12 +69,12 @@ typedef struct { GLUhalfEdge e, eSym; } EdgePair;
  * No vertex or face structures are allocated, but these must be assigned
  * before the current edge operation is completed.
  */
-static GLUhalfEdge *MakeEdge( GLUhalfEdge *eNext )
+static GLUhalfEdge *MakeEdge( GLUmesh *mesh, GLUhalfEdge *eNext )
 {
   GLUhalfEdge *e;
   GLUhalfEdge *eSym;
   GLUhalfEdge *ePrev;
-  EdgePair *pair = (EdgePair *)memAlloc( sizeof( EdgePair ));
+  EdgePair *pair = (EdgePair *)arenaAlloc( mesh->arena, sizeof( EdgePair ));
   if (pair == NULL) return NULL;
 
   e = &pair->e;
@@ -202,7 +205,7 @@ static void MakeFace( GLUface *newFace, GLUhalfEdge *eOrig, GLUface *fNext )
 /* KillEdge( eDel ) destroys an edge (the half-edges eDel and eDel->Sym),
  * and removes from the global edge list.
  */
-static void KillEdge( GLUhalfEdge *eDel )
+static void KillEdge( GLUmesh *mesh, GLUhalfEdge *eDel )
 {
   GLUhalfEdge *ePrev, *eNext;
 
@@ -215,14 +218,14 @@ static void KillEdge( GLUhalfEdge *eDel )
   eNext->Sym->next = ePrev;
   ePrev->Sym->next = eNext;
 
-  memFree( eDel );
+  arenaFree( mesh->arena, eDel, sizeof( EdgePair ));
 }
 
 
 /* KillVertex( vDel ) destroys a vertex and removes it from the global
  * vertex list.  It updates the vertex loop to point to a given new vertex.
  */
-static void KillVertex( GLUvertex *vDel, GLUvertex *newOrg )
+static void KillVertex( GLUmesh *mesh, GLUvertex *vDel, GLUvertex *newOrg )
 {
   GLUhalfEdge *e, *eStart = vDel->anEdge;
   GLUvertex *vPrev, *vNext;
@@ -240,13 +243,13 @@ static void KillVertex( GLUvertex *vDel, GLUvertex *newOrg )
   vNext->prev = vPrev;
   vPrev->next = vNext;
 
-  memFree( vDel );
+  arenaFree( mesh->arena, vDel, sizeof( GLUvertex ));
 }
 
 /* KillFace( fDel ) destroys a face and removes it from the global face
  * list.  It updates the face loop to point to a given new face.
  */
-static void KillFace( GLUface *fDel, GLUface *newLface )
+static void KillFace( GLUmesh *mesh, GLUface *fDel, GLUface *newLface )
 {
   GLUhalfEdge *e, *eStart = fDel->anEdge;
   GLUface *fPrev, *fNext;
@@ -264,7 +267,7 @@ static void KillFace( GLUface *fDel, GLUface *newLface )
   fNext->prev = fPrev;
   fPrev->next = fNext;
 
-  memFree( fDel );
+  arenaFree( mesh->arena, fDel, sizeof( GLUface ));
 }
 
 
@@ -275,24 +278,24 @@ static void KillFace( GLUface *fDel, GLUface *newLface )
  */
 GLUhalfEdge *glu_fastuidraw_gl_meshMakeEdge( GLUmesh *mesh )
 {
-  GLUvertex *newVertex1= allocVertex();
-  GLUvertex *newVertex2= allocVertex();
-  GLUface *newFace= allocFace();
+  GLUvertex *newVertex1= allocVertex( mesh );
+  GLUvertex *newVertex2= allocVertex( mesh );
+  GLUface *newFace= allocFace( mesh );
   GLUhalfEdge *e;
 
   /* if any one is null then all get freed */
   if (newVertex1 == NULL || newVertex2 == NULL || newFace == NULL) {
-     if (newVertex1 != NULL) memFree(newVertex1);
-     if (newVertex2 != NULL) memFree(newVertex2);
-     if (newFace != NULL) memFree(newFace);
+     arenaFree( mesh->arena, newVertex1, sizeof( GLUvertex ));
+     arenaFree( mesh->arena, newVertex2, sizeof( GLUvertex ));
+     arenaFree( mesh->arena, newFace, sizeof( GLUface ));
      return NULL;
   }
 
-  e = MakeEdge( &mesh->eHead );
+  e = MakeEdge( mesh, &mesh->eHead );
   if (e == NULL) {
-     memFree(newVertex1);
-     memFree(newVertex2);
-     memFree(newFace);
+     arenaFree( mesh->arena, newVertex1, sizeof( GLUvertex ));
+     arenaFree( mesh->arena, newVertex2, sizeof( GLUvertex ));
+     arenaFree( mesh->arena, newFace, sizeof( GLUface ));
      return NULL;
   }
 
@@ -326,7 +329,7 @@ GLUhalfEdge *glu_fastuidraw_gl_meshMakeEdge( GLUmesh *mesh )
  * If eDst == eOrg->Onext, the new vertex will have a single edge.
  * If eDst == eOrg->Oprev, the old vertex will have a single edge.
  */
-int glu_fastuidraw_gl_meshSplice( GLUhalfEdge *eOrg, GLUhalfEdge *eDst )
+int glu_fastuidraw_gl_meshSplice( GLUmesh *mesh, GLUhalfEdge *eOrg, GLUhalfEdge *eDst )
 {
   int joiningLoops = FALSE;
   int joiningVertices = FALSE;
@@ -336,19 +339,19 @@ int glu_fastuidraw_gl_meshSplice( GLUhalfEdge *eOrg, GLUhalfEdge *eDst )
   if( eDst->Org != eOrg->Org ) {
     /* We are merging two disjoint vertices -- destroy eDst->Org */
     joiningVertices = TRUE;
-    KillVertex( eDst->Org, eOrg->Org );
+    KillVertex( mesh, eDst->Org, eOrg->Org );
   }
   if( eDst->Lface != eOrg->Lface ) {
     /* We are connecting two disjoint loops -- destroy eDst->Lface */
     joiningLoops = TRUE;
-    KillFace( eDst->Lface, eOrg->Lface );
+    KillFace( mesh, eDst->Lface, eOrg->Lface );
   }
 
   /* Change the edge structure */
   Splice( eDst, eOrg );
 
   if( ! joiningVertices ) {
-    GLUvertex *newVertex= allocVertex();
+    GLUvertex *newVertex= allocVertex( mesh );
     if (newVertex == NULL) return 0;
 
     /* We split one vertex into two -- the new vertex is eDst->Org.
@@ -358,7 +361,7 @@ int glu_fastuidraw_gl_meshSplice( GLUhalfEdge *eOrg, GLUhalfEdge *eDst )
     eOrg->Org->anEdge = eOrg;
   }
   if( ! joiningLoops ) {
-    GLUface *newFace= allocFace();
+    GLUface *newFace= allocFace( mesh );
     if (newFace == NULL) return 0;
 
     /* We split one loop into two -- the new loop is eDst->Lface.
@@ -382,7 +385,7 @@ int glu_fastuidraw_gl_meshSplice( GLUhalfEdge *eOrg, GLUhalfEdge *eDst )
  * plus a few calls to memFree, but this would allocate and delete
  * unnecessary vertices and faces.
  */
-int glu_fastuidraw_gl_meshDelete( GLUhalfEdge *eDel )
+int glu_fastuidraw_gl_meshDelete( GLUmesh *mesh, GLUhalfEdge *eDel )
 {
   GLUhalfEdge *eDelSym = eDel->Sym;
   int joiningLoops = FALSE;
@@ -393,11 +396,11 @@ int glu_fastuidraw_gl_meshDelete( GLUhalfEdge *eDel )
   if( eDel->Lface != eDel->Rface ) {
     /* We are joining two loops into one -- remove the left face */
     joiningLoops = TRUE;
-    KillFace( eDel->Lface, eDel->Rface );
+    KillFace( mesh, eDel->Lface, eDel->Rface );
   }
 
   if( eDel->Onext == eDel ) {
-    KillVertex( eDel->Org, NULL );
+    KillVertex( mesh, eDel->Org, NULL );
   } else {
     /* Make sure that eDel->Org and eDel->Rface point to valid half-edges */
     eDel->Rface->anEdge = eDel->Oprev;
@@ -405,7 +408,7 @@ int glu_fastuidraw_gl_meshDelete( GLUhalfEdge *eDel )
 
     Splice( eDel, eDel->Oprev );
     if( ! joiningLoops ) {
-      GLUface *newFace= allocFace();
+      GLUface *newFace= allocFace( mesh );
       if (newFace == NULL) return 0;
 
       /* We are splitting one loop into two -- create a new loop for eDel. */
@@ -417,8 +420,8 @@ int glu_fastuidraw_gl_meshDelete( GLUhalfEdge *eDel )
    * may have been deleted.  Now we disconnect eDel->Dst.
    */
   if( eDelSym->Onext == eDelSym ) {
-    KillVertex( eDelSym->Org, NULL );
-    KillFace( eDelSym->Lface, NULL );
+    KillVertex( mesh, eDelSym->Org, NULL );
+    KillFace( mesh, eDelSym->Lface, NULL );
   } else {
     /* Make sure that eDel->Dst and eDel->Lface point to valid half-edges */
     eDel->Lface->anEdge = eDelSym->Oprev;
@@ -427,7 +430,7 @@ int glu_fastuidraw_gl_meshDelete( GLUhalfEdge *eDel )
   }
 
   /* Any isolated vertices or faces have already been freed. */
-  KillEdge( eDel );
+  KillEdge( mesh, eDel );
 
   return 1;
 }
@@ -444,10 +447,10 @@ int glu_fastuidraw_gl_meshDelete( GLUhalfEdge *eDel )
  * eNew == eOrg->Lnext, and eNew->Dst is a newly created vertex.
  * eOrg and eNew will have the same left face.
  */
-GLUhalfEdge *glu_fastuidraw_gl_meshAddEdgeVertex( GLUhalfEdge *eOrg )
+GLUhalfEdge *glu_fastuidraw_gl_meshAddEdgeVertex( GLUmesh *mesh, GLUhalfEdge *eOrg )
 {
   GLUhalfEdge *eNewSym;
-  GLUhalfEdge *eNew = MakeEdge( eOrg );
+  GLUhalfEdge *eNew = MakeEdge( mesh, eOrg );
   if (eNew == NULL) return NULL;
 
   eNewSym = eNew->Sym;
@@ -458,7 +461,7 @@ GLUhalfEdge *glu_fastuidraw_gl_meshAddEdgeVertex( GLUhalfEdge *eOrg )
   /* Set the vertex and face information */
   eNew->Org = eOrg->Dst;
   {
-    GLUvertex *newVertex= allocVertex();
+    GLUvertex *newVertex= allocVertex( mesh );
     if (newVertex == NULL) return NULL;
 
     MakeVertex( newVertex, eNewSym, eNew->Org );
@@ -473,10 +476,10 @@ GLUhalfEdge *glu_fastuidraw_gl_meshAddEdgeVertex( GLUhalfEdge *eOrg )
  * such that eNew == eOrg->Lnext.  The new vertex is eOrg->Dst == eNew->Org.
  * eOrg and eNew will have the same left face.
  */
-GLUhalfEdge *glu_fastuidraw_gl_meshSplitEdge( GLUhalfEdge *eOrg )
+GLUhalfEdge *glu_fastuidraw_gl_meshSplitEdge( GLUmesh *mesh, GLUhalfEdge *eOrg )
 {
   GLUhalfEdge *eNew;
-  GLUhalfEdge *tempHalfEdge= glu_fastuidraw_gl_meshAddEdgeVertex( eOrg );
+  GLUhalfEdge *tempHalfEdge= glu_fastuidraw_gl_meshAddEdgeVertex( mesh, eOrg );
   if (tempHalfEdge == NULL) return NULL;
 
   eNew = tempHalfEdge->Sym;
@@ -506,11 +509,11 @@ GLUhalfEdge *glu_fastuidraw_gl_meshSplitEdge( GLUhalfEdge *eOrg )
  * If (eOrg->Lnext == eDst), the old face is reduced to a single edge.
  * If (eOrg->Lnext->Lnext == eDst), the old face is reduced to two edges.
  */
-GLUhalfEdge *glu_fastuidraw_gl_meshConnect( GLUhalfEdge *eOrg, GLUhalfEdge *eDst )
+GLUhalfEdge *glu_fastuidraw_gl_meshConnect( GLUmesh *mesh, GLUhalfEdge *eOrg, GLUhalfEdge *eDst )
 {
   GLUhalfEdge *eNewSym;
   int joiningLoops = FALSE;
-  GLUhalfEdge *eNew = MakeEdge( eOrg );
+  GLUhalfEdge *eNew = MakeEdge( mesh, eOrg );
   if (eNew == NULL) return NULL;
 
   eNewSym = eNew->Sym;
@@ -518,7 +521,7 @@ GLUhalfEdge *glu_fastuidraw_gl_meshConnect( GLUhalfEdge *eOrg, GLUhalfEdge *eDst
   if( eDst->Lface != eOrg->Lface ) {
     /* We are connecting two disjoint loops -- destroy eDst->Lface */
     joiningLoops = TRUE;
-    KillFace( eDst->Lface, eOrg->Lface );
+    KillFace( mesh, eDst->Lface, eOrg->Lface );
   }
 
   /* Connect the new edge appropriately */
@@ -534,7 +537,7 @@ GLUhalfEdge *glu_fastuidraw_gl_meshConnect( GLUhalfEdge *eOrg, GLUhalfEdge *eDst
   eOrg->Lface->anEdge = eNewSym;
 
   if( ! joiningLoops ) {
-    GLUface *newFace= allocFace();
+    GLUface *newFace= allocFace( mesh );
     if (newFace == NULL) return NULL;
 
     /* We split one loop into two -- the new loop is eNew->Lface */
@@ -553,7 +556,7 @@ GLUhalfEdge *glu_fastuidraw_gl_meshConnect( GLUhalfEdge *eOrg, GLUhalfEdge *eDst
  * An entire mesh can be deleted by zapping its faces, one at a time,
  * in any order.  Zapped faces cannot be used in further mesh operations!
  */
-void glu_fastuidraw_gl_meshZapFace( GLUface *fZap )
+void glu_fastuidraw_gl_meshZapFace( GLUmesh *mesh, GLUface *fZap )
 {
   GLUhalfEdge *eStart = fZap->anEdge;
   GLUhalfEdge *e, *eNext, *eSym;
@@ -570,7 +573,7 @@ void glu_fastuidraw_gl_meshZapFace( GLUface *fZap )
       /* delete the edge -- see glu_fastuidraw_gl_MeshDelete above */
 
       if( e->Onext == e ) {
-        KillVertex( e->Org, NULL );
+        KillVertex( mesh, e->Org, NULL );
       } else {
         /* Make sure that e->Org points to a valid half-edge */
         e->Org->anEdge = e->Onext;
@@ -578,13 +581,13 @@ void glu_fastuidraw_gl_meshZapFace( GLUface *fZap )
       }
       eSym = e->Sym;
       if( eSym->Onext == eSym ) {
-        KillVertex( eSym->Org, NULL );
+        KillVertex( mesh, eSym->Org, NULL );
       } else {
         /* Make sure that eSym->Org points to a valid half-edge */
         eSym->Org->anEdge = eSym->Onext;
         Splice( eSym, eSym->Oprev );
       }
-      KillEdge( e );
+      KillEdge( mesh, e );
     }
   } while( e != eStart );
 
@@ -594,24 +597,26 @@ void glu_fastuidraw_gl_meshZapFace( GLUface *fZap )
   fNext->prev = fPrev;
   fPrev->next = fNext;
 
-  memFree( fZap );
+  arenaFree( mesh->arena, fZap, sizeof( GLUface ));
 }
 
 
-/* glu_fastuidraw_gl_meshNewMesh() creates a new mesh with no edges, no vertices,
- * and no loops (what we usually call a "face").
+/* glu_fastuidraw_gl_meshNewMesh( arena ) creates a new mesh with no edges, no vertices,
+ * and no loops (what we usually call a "face") whose storage comes from arena.
  */
-GLUmesh *glu_fastuidraw_gl_meshNewMesh( void )
+GLUmesh *glu_fastuidraw_gl_meshNewMesh( GLUarena *arena )
 {
   GLUvertex *v;
   GLUface *f;
   GLUhalfEdge *e;
   GLUhalfEdge *eSym;
-  GLUmesh *mesh = (GLUmesh *)memAlloc( sizeof( GLUmesh ));
+  GLUmesh *mesh = (GLUmesh *)arenaAlloc( arena, sizeof( GLUmesh ));
   if (mesh == NULL) {
      return NULL;
   }
 
+  mesh->arena = arena;
+
   v = &mesh->vHead;
   f = &mesh->fHead;
   e = &mesh->eHead;
@@ -684,58 +689,19 @@ GLUmesh *glu_fastuidraw_gl_meshUnion( GLUmesh *mesh1, GLUmesh *mesh2 )
     e1->Sym->next = e2->Sym->next;
   }
 
-  memFree( mesh2 );
+  arenaFree( mesh2->arena, mesh2, sizeof( GLUmesh ));
   return mesh1;
 }
 
 
-#ifdef DELETE_BY_ZAPPING
-
-/* glu_fastuidraw_gl_meshDeleteMesh( mesh ) will free all storage for any valid mesh.
- */
-void glu_fastuidraw_gl_meshDeleteMesh( GLUmesh *mesh )
-{
-  GLUface *fHead = &mesh->fHead;
-
-  while( fHead->next != fHead ) {
-    glu_fastuidraw_gl_meshZapFace( fHead->next );
-  }
-  assert( mesh->vHead.next == &mesh->vHead );
-
-  memFree( mesh );
-}
-
-#else
-
-/* glu_fastuidraw_gl_meshDeleteMesh( mesh ) will free all storage for any valid mesh.
+/* glu_fastuidraw_gl_meshDeleteMesh( mesh ) releases a mesh in O(1); the storage
+ * of its elements stays in the arena of the mesh until the arena is reset.
  */
 void glu_fastuidraw_gl_meshDeleteMesh( GLUmesh *mesh )
 {
-  GLUface *f, *fNext;
-  GLUvertex *v, *vNext;
-  GLUhalfEdge *e, *eNext;
-
-  for( f = mesh->fHead.next; f != &mesh->fHead; f = fNext ) {
-    fNext = f->next;
-    memFree( f );
-  }
-
-  for( v = mesh->vHead.next; v != &mesh->vHead; v = vNext ) {
-    vNext = v->next;
-    memFree( v );
-  }
-
-  for( e = mesh->eHead.next; e != &mesh->eHead; e = eNext ) {
-    /* One call frees both e and e->Sym (see EdgePair above) */
-    eNext = e->next;
-    memFree( e );
-  }
-
-  memFree( mesh );
+  arenaFree( mesh->arena, mesh, sizeof( GLUmesh ));
 }
 
-#endif
-
 #ifndef NDEBUG
 
 /* glu_fastuidraw_gl_meshCheckMesh( mesh ) checks a mesh for self-consistency.
@@ -45,6 +45,8 @@ typedef struct GLUhalfEdge GLUhalfEdge;
 
 typedef struct ActiveRegion ActiveRegion;       /* Internal data */
 
+typedef struct GLUarena GLUarena;               /* see memalloc.hpp */
+
 /* The mesh structure is similar in spirit, notation, and operations
  * to the "quad-edge" structure (see L. Guibas and J. Stolfi, Primitives
  * for the manipulation of general subdivisions and the computation of
@@ -166,6 +168,7 @@ struct GLUmesh {
   GLUface       fHead;          /* dummy header for face list */
   GLUhalfEdge   eHead;          /* dummy header for edge list */
   GLUhalfEdge   eHeadSym;       /* and its symmetric counterpart */
+  GLUarena      *arena;         /* storage for all elements of the mesh */
 };
 
 /* The mesh operations below have three motivations: completeness,
@@ -184,10 +187,14 @@ struct GLUmesh {
  *
  * ********************** Basic Edge Operations **************************
  *
+ * All elements of a mesh are allocated from the arena of the mesh; the
+ * operations that create or destroy elements therefore take the mesh
+ * as their first argument.
+ *
  * glu_fastuidraw_gl_meshMakeEdge( mesh ) creates one edge, two vertices, and a loop.
  * The loop (face) consists of the two new half-edges.
  *
- * glu_fastuidraw_gl_meshSplice( eOrg, eDst ) is the basic operation for changing the
+ * glu_fastuidraw_gl_meshSplice( mesh, eOrg, eDst ) is the basic operation for changing the
  * mesh connectivity and topology.  It changes the mesh so that
  *      eOrg->Onext <- OLD( eDst->Onext )
  *      eDst->Onext <- OLD( eOrg->Onext )
@@ -203,7 +210,7 @@ struct GLUmesh {
  *  - if eOrg->Lface != eDst->Lface, two distinct loops are joined into one
  * In both cases, eDst->Lface is changed and eOrg->Lface is unaffected.
  *
- * glu_fastuidraw_gl_meshDelete( eDel ) removes the edge eDel.  There are several cases:
+ * glu_fastuidraw_gl_meshDelete( mesh, eDel ) removes the edge eDel.  There are several cases:
  * if (eDel->Lface != eDel->Rface), we join two loops into one; the loop
  * eDel->Lface is deleted.  Otherwise, we are splitting one loop into two;
  * the newly created loop will contain eDel->Dst.  If the deletion of eDel
@@ -211,15 +218,15 @@ struct GLUmesh {
  *
  * ********************** Other Edge Operations **************************
  *
- * glu_fastuidraw_gl_meshAddEdgeVertex( eOrg ) creates a new edge eNew such that
+ * glu_fastuidraw_gl_meshAddEdgeVertex( mesh, eOrg ) creates a new edge eNew such that
  * eNew == eOrg->Lnext, and eNew->Dst is a newly created vertex.
  * eOrg and eNew will have the same left face.
  *
- * glu_fastuidraw_gl_meshSplitEdge( eOrg ) splits eOrg into two edges eOrg and eNew,
+ * glu_fastuidraw_gl_meshSplitEdge( mesh, eOrg ) splits eOrg into two edges eOrg and eNew,
  * such that eNew == eOrg->Lnext.  The new vertex is eOrg->Dst == eNew->Org.
  * eOrg and eNew will have the same left face.
  *
- * glu_fastuidraw_gl_meshConnect( eOrg, eDst ) creates a new edge from eOrg->Dst
+ * glu_fastuidraw_gl_meshConnect( mesh, eOrg, eDst ) creates a new edge from eOrg->Dst
  * to eDst->Org, and returns the corresponding half-edge eNew.
  * If eOrg->Lface == eDst->Lface, this splits one loop into two,
  * and the newly created loop is eNew->Lface.  Otherwise, two disjoint
@@ -227,15 +234,16 @@ struct GLUmesh {
  *
  * ************************ Other Operations *****************************
  *
- * glu_fastuidraw_gl_meshNewMesh() creates a new mesh with no edges, no vertices,
- * and no loops (what we usually call a "face").
+ * glu_fastuidraw_gl_meshNewMesh( arena ) creates a new mesh with no edges, no vertices,
+ * and no loops (what we usually call a "face"), allocating from arena.
  *
  * glu_fastuidraw_gl_meshUnion( mesh1, mesh2 ) forms the union of all structures in
  * both meshes, and returns the new mesh (the old meshes are destroyed).
  *
- * glu_fastuidraw_gl_meshDeleteMesh( mesh ) will free all storage for any valid mesh.
+ * glu_fastuidraw_gl_meshDeleteMesh( mesh ) releases a mesh in O(1); the storage
+ * of its elements is reclaimed when the arena of the mesh is reset.
  *
- * glu_fastuidraw_gl_meshZapFace( fZap ) destroys a face and removes it from the
+ * glu_fastuidraw_gl_meshZapFace( mesh, fZap ) destroys a face and removes it from the
  * global face list.  All edges of fZap will have a NULL pointer as their
  * left face.  Any edges which also have a NULL pointer as their right face
  * are deleted entirely (along with any isolated vertices this produces).
@@ -246,17 +254,17 @@ struct GLUmesh {
  */
 
 GLUhalfEdge     *glu_fastuidraw_gl_meshMakeEdge( GLUmesh *mesh );
-int             glu_fastuidraw_gl_meshSplice( GLUhalfEdge *eOrg, GLUhalfEdge *eDst );
-int             glu_fastuidraw_gl_meshDelete( GLUhalfEdge *eDel );
+int             glu_fastuidraw_gl_meshSplice( GLUmesh *mesh, GLUhalfEdge *eOrg, GLUhalfEdge *eDst );
+int             glu_fastuidraw_gl_meshDelete( GLUmesh *mesh, GLUhalfEdge *eDel );
 
-GLUhalfEdge     *glu_fastuidraw_gl_meshAddEdgeVertex( GLUhalfEdge *eOrg );
-GLUhalfEdge     *glu_fastuidraw_gl_meshSplitEdge( GLUhalfEdge *eOrg );
-GLUhalfEdge     *glu_fastuidraw_gl_meshConnect( GLUhalfEdge *eOrg, GLUhalfEdge *eDst );
+GLUhalfEdge     *glu_fastuidraw_gl_meshAddEdgeVertex( GLUmesh *mesh, GLUhalfEdge *eOrg );
+GLUhalfEdge     *glu_fastuidraw_gl_meshSplitEdge( GLUmesh *mesh, GLUhalfEdge *eOrg );
+GLUhalfEdge     *glu_fastuidraw_gl_meshConnect( GLUmesh *mesh, GLUhalfEdge *eOrg, GLUhalfEdge *eDst );
 
-GLUmesh         *glu_fastuidraw_gl_meshNewMesh( void );
+GLUmesh         *glu_fastuidraw_gl_meshNewMesh( GLUarena *arena );
 GLUmesh         *glu_fastuidraw_gl_meshUnion( GLUmesh *mesh1, GLUmesh *mesh2 );
 void            glu_fastuidraw_gl_meshDeleteMesh( GLUmesh *mesh );
-void            glu_fastuidraw_gl_meshZapFace( GLUface *fZap );
+void            glu_fastuidraw_gl_meshZapFace( GLUmesh *mesh, GLUface *fZap );
 
 #ifdef NDEBUG
 #define         glu_fastuidraw_gl_meshCheckMesh( mesh )
@@ -41,7 +41,7 @@
 #define PQhandle                PQHeapHandle
 #define PriorityQ               PriorityQHeap
 
-#define pqNewPriorityQ(leq)     glu_fastuidraw_gl_pqHeapNewPriorityQ(leq)
+#define pqNewPriorityQ(arena,leq) glu_fastuidraw_gl_pqHeapNewPriorityQ(arena,leq)
 #define pqDeletePriorityQ(pq)   glu_fastuidraw_gl_pqHeapDeletePriorityQ(pq)
 
 /* The basic operations are insertion of a new key (pqInsert),
@@ -79,6 +79,7 @@
 typedef void *PQkey;
 typedef long PQhandle;
 typedef struct PriorityQ PriorityQ;
+typedef struct GLUarena GLUarena;
 
 typedef struct { PQhandle handle; } PQnode;
 typedef struct { PQkey key; PQhandle node; } PQhandleElem;
@@ -90,9 +91,11 @@ struct PriorityQ {
   PQhandle      freeList;
   int           initialized;
   int           (*leq)(PQkey key1, PQkey key2);
+  GLUarena      *arena;
 };
 
-PriorityQ       *pqNewPriorityQ( int (*leq)(PQkey key1, PQkey key2) );
+/* The queue and its arrays are allocated from arena */
+PriorityQ       *pqNewPriorityQ( GLUarena *arena, int (*leq)(PQkey key1, PQkey key2) );
 void            pqDeletePriorityQ( PriorityQ *pq );
 
 void            pqInit( PriorityQ *pq );
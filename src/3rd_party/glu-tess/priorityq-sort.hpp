@@ -55,7 +55,7 @@
 #define PQhandle                PQSortHandle
 #define PriorityQ               PriorityQSort
 
-#define pqNewPriorityQ(leq)     glu_fastuidraw_gl_pqSortNewPriorityQ(leq)
+#define pqNewPriorityQ(arena,leq) glu_fastuidraw_gl_pqSortNewPriorityQ(arena,leq)
 #define pqDeletePriorityQ(pq)   glu_fastuidraw_gl_pqSortDeletePriorityQ(pq)
 
 /* The basic operations are insertion of a new key (pqInsert),
@@ -101,9 +101,11 @@ struct PriorityQ {
   PQhandle      size, max;
   int           initialized;
   int           (*leq)(PQkey key1, PQkey key2);
+  GLUarena      *arena;
 };
 
-PriorityQ       *pqNewPriorityQ( int (*leq)(PQkey key1, PQkey key2) );
+/* The queue and its arrays are allocated from arena */
+PriorityQ       *pqNewPriorityQ( GLUarena *arena, int (*leq)(PQkey key1, PQkey key2) );
 void            pqDeletePriorityQ( PriorityQ *pq );
 
 int             pqInit( PriorityQ *pq );
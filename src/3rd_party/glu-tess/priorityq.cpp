@@ -47,21 +47,23 @@
 #include "priorityq-sort.hpp"
 
 /* really glu_fastuidraw_gl_pqSortNewPriorityQ */
-PriorityQ *pqNewPriorityQ( int (*leq)(PQkey key1, PQkey key2) )
+PriorityQ *pqNewPriorityQ( GLUarena *arena, int (*leq)(PQkey key1, PQkey key2) )
 {
-  PriorityQ *pq = (PriorityQ *)memAlloc( sizeof( PriorityQ ));
+  PriorityQ *pq = (PriorityQ *)arenaAlloc( arena, sizeof( PriorityQ ));
   if (pq == NULL) return NULL;
 
-  pq->heap = glu_fastuidraw_gl_pqHeapNewPriorityQ( leq );
+  pq->arena = arena;
+  pq->order = NULL;
+  pq->heap = glu_fastuidraw_gl_pqHeapNewPriorityQ( arena, leq );
   if (pq->heap == NULL) {
-     memFree(pq);
+     arenaFree( arena, pq, sizeof( PriorityQ ));
      return NULL;
   }
 
-  pq->keys = (PQHeapKey *)memAlloc( INIT_SIZE * sizeof(pq->keys[0]) );
+  pq->keys = (PQHeapKey *)arenaAlloc( arena, INIT_SIZE * sizeof(pq->keys[0]) );
   if (pq->keys == NULL) {
      glu_fastuidraw_gl_pqHeapDeletePriorityQ(pq->heap);
-     memFree(pq);
+     arenaFree( arena, pq, sizeof( PriorityQ ));
      return NULL;
   }
 
@@ -77,9 +79,10 @@ void pqDeletePriorityQ( PriorityQ *pq )
 {
   assert(pq != NULL);
   if (pq->heap != NULL) glu_fastuidraw_gl_pqHeapDeletePriorityQ( pq->heap );
-  if (pq->order != NULL) memFree( pq->order );
-  if (pq->keys != NULL) memFree( pq->keys );
-  memFree( pq );
+  /* pq->order and pq->keys are large arrays and are not recycled
+   * by arenaFree(), their storage is reclaimed by arenaReset().
+   */
+  arenaFree( pq->arena, pq, sizeof( PriorityQ ));
 }
 
 
@@ -101,7 +104,7 @@ int pqInit( PriorityQ *pq )
   pq->order = (PQHeapKey **)memAlloc( (size_t)
                                   (pq->size * sizeof(pq->order[0])) );
 */
-  pq->order = (PQHeapKey **)memAlloc( (size_t)
+  pq->order = (PQHeapKey **)arenaAlloc( pq->arena, (size_t)
                                   ((pq->size+1) * sizeof(pq->order[0])) );
 /* the previous line is a patch to compensate for the fact that IBM */
 /* machines return a null on a malloc of zero bytes (unlike SGI),   */
@@ -180,12 +183,13 @@ PQhandle pqInsert( PriorityQ *pq, PQkey keyNew )
   curr = pq->size;
   if( ++ pq->size >= pq->max ) {
     PQkey *saveKey= pq->keys;
+    PQhandle oldMax = pq->max;
 
     /* If the heap overflows, double its size. */
     pq->max <<= 1;
-    pq->keys = (PQHeapKey *)memRealloc( pq->keys,
-                                        (size_t)
-                                         (pq->max * sizeof( pq->keys[0] )));
+    pq->keys = (PQHeapKey *)arenaRealloc( pq->arena, pq->keys,
+                                          (size_t)(oldMax * sizeof( pq->keys[0] )),
+                                          (size_t)(pq->max * sizeof( pq->keys[0] )));
     if (pq->keys == NULL) {
        pq->keys = saveKey;      /* restore ptr to free upon return */
        return LONG_MAX;
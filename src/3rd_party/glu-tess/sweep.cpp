@@ -159,17 +159,17 @@ static void DeleteRegion( fastuidraw_GLUtesselator *tess, ActiveRegion *reg )
   }
   reg->eUp->activeRegion = NULL;
   dictDelete( tess->dict, reg->nodeUp ); /* glu_fastuidraw_gl_dictListDelete */
-  memFree( reg );
+  arenaFree( &tess->arena, reg, sizeof( ActiveRegion ));
 }
 
 
-static int FixUpperEdge( ActiveRegion *reg, GLUhalfEdge *newEdge )
+static int FixUpperEdge( fastuidraw_GLUtesselator *tess, ActiveRegion *reg, GLUhalfEdge *newEdge )
 /*
  * Replace an upper edge which needs fixing (see ConnectRightVertex).
  */
 {
   assert( reg->fixUpperEdge );
-  if ( !glu_fastuidraw_gl_meshDelete( reg->eUp ) ) return 0;
+  if ( !glu_fastuidraw_gl_meshDelete( tess->mesh, reg->eUp ) ) return 0;
   reg->fixUpperEdge = FALSE;
   reg->eUp = newEdge;
   newEdge->activeRegion = reg;
@@ -177,7 +177,7 @@ static int FixUpperEdge( ActiveRegion *reg, GLUhalfEdge *newEdge )
   return 1;
 }
 
-static ActiveRegion *TopLeftRegion( ActiveRegion *reg )
+static ActiveRegion *TopLeftRegion( fastuidraw_GLUtesselator *tess, ActiveRegion *reg )
 {
   GLUvertex *org = reg->eUp->Org;
   GLUhalfEdge *e;
@@ -191,9 +191,9 @@ static ActiveRegion *TopLeftRegion( ActiveRegion *reg )
    * now is the time to fix it.
    */
   if( reg->fixUpperEdge ) {
-    e = glu_fastuidraw_gl_meshConnect( RegionBelow(reg)->eUp->Sym, reg->eUp->Lnext );
+    e = glu_fastuidraw_gl_meshConnect( tess->mesh, RegionBelow(reg)->eUp->Sym, reg->eUp->Lnext );
     if (e == NULL) return NULL;
-    if ( !FixUpperEdge( reg, e ) ) return NULL;
+    if ( !FixUpperEdge( tess, reg, e ) ) return NULL;
     reg = RegionAbove( reg );
   }
   return reg;
@@ -220,7 +220,7 @@ static ActiveRegion *AddRegionBelow( fastuidraw_GLUtesselator *tess,
  * Winding number and "inside" flag are not updated.
  */
 {
-  ActiveRegion *regNew = (ActiveRegion *)memAlloc( sizeof( ActiveRegion ));
+  ActiveRegion *regNew = (ActiveRegion *)arenaAlloc( &tess->arena, sizeof( ActiveRegion ));
   if (regNew == NULL) longjmp(tess->env,1);
 
   regNew->eUp = eNewUp;
@@ -321,15 +321,15 @@ static GLUhalfEdge *FinishLeftRegions( fastuidraw_GLUtesselator *tess,
       /* If the edge below was a temporary edge introduced by
        * ConnectRightVertex, now is the time to fix it.
        */
-      e = glu_fastuidraw_gl_meshConnect( ePrev->Lprev, e->Sym );
+      e = glu_fastuidraw_gl_meshConnect( tess->mesh, ePrev->Lprev, e->Sym );
       if (e == NULL) longjmp(tess->env,1);
-      if ( !FixUpperEdge( reg, e ) ) longjmp(tess->env,1);
+      if ( !FixUpperEdge( tess, reg, e ) ) longjmp(tess->env,1);
     }
 
     /* Relink edges so that ePrev->Onext == e */
     if( ePrev->Onext != e ) {
-      if ( !glu_fastuidraw_gl_meshSplice( e->Oprev, e ) ) longjmp(tess->env,1);
-      if ( !glu_fastuidraw_gl_meshSplice( ePrev, e ) ) longjmp(tess->env,1);
+      if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, e->Oprev, e ) ) longjmp(tess->env,1);
+      if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, ePrev, e ) ) longjmp(tess->env,1);
     }
     FinishRegion( tess, regPrev );      /* may change reg->eUp */
     ePrev = reg->eUp;
@@ -381,8 +381,8 @@ static void AddRightEdges( fastuidraw_GLUtesselator *tess, ActiveRegion *regUp,
 
     if( e->Onext != ePrev ) {
       /* Unlink e from its current position, and relink below ePrev */
-      if ( !glu_fastuidraw_gl_meshSplice( e->Oprev, e ) ) longjmp(tess->env,1);
-      if ( !glu_fastuidraw_gl_meshSplice( ePrev->Oprev, e ) ) longjmp(tess->env,1);
+      if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, e->Oprev, e ) ) longjmp(tess->env,1);
+      if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, ePrev->Oprev, e ) ) longjmp(tess->env,1);
     }
     /* Compute the winding number and "inside" flag for the new regions */
     reg->windingNumber = regPrev->windingNumber - e->winding;
@@ -395,7 +395,7 @@ static void AddRightEdges( fastuidraw_GLUtesselator *tess, ActiveRegion *regUp,
     if( ! firstTime && CheckForRightSplice( tess, regPrev )) {
       AddWinding( e, ePrev );
       DeleteRegion( tess, regPrev );
-      if ( !glu_fastuidraw_gl_meshDelete( ePrev ) ) longjmp(tess->env,1);
+      if ( !glu_fastuidraw_gl_meshDelete( tess->mesh, ePrev ) ) longjmp(tess->env,1);
     }
     firstTime = FALSE;
     regPrev = reg;
@@ -423,6 +423,11 @@ static void CallCombine( fastuidraw_GLUtesselator *tess, GLUvertex *isect,
 
   if( needed ) {
     CALL_COMBINE_OR_COMBINE_DATA( x, y, data, weights, &isect->client_id );
+  } else {
+    /* The vertices are at the same location, thus
+     * the merged vertex can simply reuse the first ID.
+     */
+    isect->client_id = data[0];
   }
 }
 
@@ -446,7 +451,7 @@ static void SpliceMergeVertices( fastuidraw_GLUtesselator *tess, GLUhalfEdge *e1
   data[0] = e1->Org->client_id;
   data[1] = e2->Org->client_id;
   CallCombine( tess, e1->Org, data, weights, FALSE );
-  if ( !glu_fastuidraw_gl_meshSplice( e1, e2 ) ) longjmp(tess->env,1);
+  if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, e1, e2 ) ) longjmp(tess->env,1);
 }
 
 static void VertexWeights( GLUvertex *isect, GLUvertex *org, GLUvertex *dst,
@@ -527,8 +532,8 @@ static int CheckForRightSplice( fastuidraw_GLUtesselator *tess, ActiveRegion *re
     /* eUp->Org appears to be below eLo */
     if( ! VertEq( eUp->Org, eLo->Org )) {
       /* Splice eUp->Org into eLo */
-      if ( glu_fastuidraw_gl_meshSplitEdge( eLo->Sym ) == NULL) longjmp(tess->env,1);
-      if ( !glu_fastuidraw_gl_meshSplice( eUp, eLo->Oprev ) ) longjmp(tess->env,1);
+      if ( glu_fastuidraw_gl_meshSplitEdge( tess->mesh, eLo->Sym ) == NULL) longjmp(tess->env,1);
+      if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, eUp, eLo->Oprev ) ) longjmp(tess->env,1);
       regUp->dirty = regLo->dirty = TRUE;
 
     } else if( eUp->Org != eLo->Org ) {
@@ -541,8 +546,8 @@ static int CheckForRightSplice( fastuidraw_GLUtesselator *tess, ActiveRegion *re
 
     /* eLo->Org appears to be above eUp, so splice eLo->Org into eUp */
     RegionAbove(regUp)->dirty = regUp->dirty = TRUE;
-    if (glu_fastuidraw_gl_meshSplitEdge( eUp->Sym ) == NULL) longjmp(tess->env,1);
-    if ( !glu_fastuidraw_gl_meshSplice( eLo->Oprev, eUp ) ) longjmp(tess->env,1);
+    if (glu_fastuidraw_gl_meshSplitEdge( tess->mesh, eUp->Sym ) == NULL) longjmp(tess->env,1);
+    if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, eLo->Oprev, eUp ) ) longjmp(tess->env,1);
   }
   return TRUE;
 }
@@ -579,18 +584,18 @@ static int CheckForLeftSplice( fastuidraw_GLUtesselator *tess, ActiveRegion *reg
 
     /* eLo->Dst is above eUp, so splice eLo->Dst into eUp */
     RegionAbove(regUp)->dirty = regUp->dirty = TRUE;
-    e = glu_fastuidraw_gl_meshSplitEdge( eUp );
+    e = glu_fastuidraw_gl_meshSplitEdge( tess->mesh, eUp );
     if (e == NULL) longjmp(tess->env,1);
-    if ( !glu_fastuidraw_gl_meshSplice( eLo->Sym, e ) ) longjmp(tess->env,1);
+    if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, eLo->Sym, e ) ) longjmp(tess->env,1);
     e->Lface->inside = regUp->inside;
   } else {
     if( EdgeSign( eLo->Dst, eUp->Dst, eLo->Org ) > 0 ) return FALSE;
 
     /* eUp->Dst is below eLo, so splice eUp->Dst into eLo */
     regUp->dirty = regLo->dirty = TRUE;
-    e = glu_fastuidraw_gl_meshSplitEdge( eLo );
+    e = glu_fastuidraw_gl_meshSplitEdge( tess->mesh, eLo );
     if (e == NULL) longjmp(tess->env,1);
-    if ( !glu_fastuidraw_gl_meshSplice( eUp->Lnext, eLo->Sym ) ) longjmp(tess->env,1);
+    if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, eUp->Lnext, eLo->Sym ) ) longjmp(tess->env,1);
     e->Rface->inside = regUp->inside;
   }
   return TRUE;
@@ -686,9 +691,9 @@ static int CheckForIntersect( fastuidraw_GLUtesselator *tess, ActiveRegion *regU
      */
     if( dstLo == tess->event ) {
       /* Splice dstLo into eUp, and process the new region(s) */
-      if (glu_fastuidraw_gl_meshSplitEdge( eUp->Sym ) == NULL) longjmp(tess->env,1);
-      if ( !glu_fastuidraw_gl_meshSplice( eLo->Sym, eUp ) ) longjmp(tess->env,1);
-      regUp = TopLeftRegion( regUp );
+      if (glu_fastuidraw_gl_meshSplitEdge( tess->mesh, eUp->Sym ) == NULL) longjmp(tess->env,1);
+      if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, eLo->Sym, eUp ) ) longjmp(tess->env,1);
+      regUp = TopLeftRegion( tess, regUp );
       if (regUp == NULL) longjmp(tess->env,1);
       eUp = RegionBelow(regUp)->eUp;
       FinishLeftRegions( tess, RegionBelow(regUp), regLo );
@@ -697,8 +702,8 @@ static int CheckForIntersect( fastuidraw_GLUtesselator *tess, ActiveRegion *regU
     }
     if( dstUp == tess->event ) {
       /* Splice dstUp into eLo, and process the new region(s) */
-      if (glu_fastuidraw_gl_meshSplitEdge( eLo->Sym ) == NULL) longjmp(tess->env,1);
-      if ( !glu_fastuidraw_gl_meshSplice( eUp->Lnext, eLo->Oprev ) ) longjmp(tess->env,1);
+      if (glu_fastuidraw_gl_meshSplitEdge( tess->mesh, eLo->Sym ) == NULL) longjmp(tess->env,1);
+      if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, eUp->Lnext, eLo->Oprev ) ) longjmp(tess->env,1);
       regLo = regUp;
       regUp = TopRightRegion( regUp );
       e = RegionBelow(regUp)->eUp->Rprev;
@@ -713,13 +718,13 @@ static int CheckForIntersect( fastuidraw_GLUtesselator *tess, ActiveRegion *regU
      */
     if( EdgeSign( dstUp, tess->event, &isect ) >= 0 ) {
       RegionAbove(regUp)->dirty = regUp->dirty = TRUE;
-      if (glu_fastuidraw_gl_meshSplitEdge( eUp->Sym ) == NULL) longjmp(tess->env,1);
+      if (glu_fastuidraw_gl_meshSplitEdge( tess->mesh, eUp->Sym ) == NULL) longjmp(tess->env,1);
       eUp->Org->s = tess->event->s;
       eUp->Org->t = tess->event->t;
     }
     if( EdgeSign( dstLo, tess->event, &isect ) <= 0 ) {
       regUp->dirty = regLo->dirty = TRUE;
-      if (glu_fastuidraw_gl_meshSplitEdge( eLo->Sym ) == NULL) longjmp(tess->env,1);
+      if (glu_fastuidraw_gl_meshSplitEdge( tess->mesh, eLo->Sym ) == NULL) longjmp(tess->env,1);
       eLo->Org->s = tess->event->s;
       eLo->Org->t = tess->event->t;
     }
@@ -735,9 +740,9 @@ static int CheckForIntersect( fastuidraw_GLUtesselator *tess, ActiveRegion *regU
    * the mesh (ie. eUp->Lface) to be smaller than the faces in the
    * unprocessed original contours (which will be eLo->Oprev->Lface).
    */
-  if (glu_fastuidraw_gl_meshSplitEdge( eUp->Sym ) == NULL) longjmp(tess->env,1);
-  if (glu_fastuidraw_gl_meshSplitEdge( eLo->Sym ) == NULL) longjmp(tess->env,1);
-  if ( !glu_fastuidraw_gl_meshSplice( eLo->Oprev, eUp ) ) longjmp(tess->env,1);
+  if (glu_fastuidraw_gl_meshSplitEdge( tess->mesh, eUp->Sym ) == NULL) longjmp(tess->env,1);
+  if (glu_fastuidraw_gl_meshSplitEdge( tess->mesh, eLo->Sym ) == NULL) longjmp(tess->env,1);
+  if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, eLo->Oprev, eUp ) ) longjmp(tess->env,1);
   eUp->Org->s = isect.s;
   eUp->Org->t = isect.t;
   eUp->Org->pqHandle = pqInsert( tess->pq, eUp->Org ); /* glu_fastuidraw_gl_pqSortInsert */
@@ -792,12 +797,12 @@ static void WalkDirtyRegions( fastuidraw_GLUtesselator *tess, ActiveRegion *regU
          */
         if( regLo->fixUpperEdge ) {
           DeleteRegion( tess, regLo );
-          if ( !glu_fastuidraw_gl_meshDelete( eLo ) ) longjmp(tess->env,1);
+          if ( !glu_fastuidraw_gl_meshDelete( tess->mesh, eLo ) ) longjmp(tess->env,1);
           regLo = RegionBelow( regUp );
           eLo = regLo->eUp;
         } else if( regUp->fixUpperEdge ) {
           DeleteRegion( tess, regUp );
-          if ( !glu_fastuidraw_gl_meshDelete( eUp ) ) longjmp(tess->env,1);
+          if ( !glu_fastuidraw_gl_meshDelete( tess->mesh, eUp ) ) longjmp(tess->env,1);
           regUp = RegionAbove( regLo );
           eUp = regUp->eUp;
         }
@@ -831,7 +836,7 @@ static void WalkDirtyRegions( fastuidraw_GLUtesselator *tess, ActiveRegion *regU
       /* A degenerate loop consisting of only two edges -- delete it. */
       AddWinding( eLo, eUp );
       DeleteRegion( tess, regUp );
-      if ( !glu_fastuidraw_gl_meshDelete( eUp ) ) longjmp(tess->env,1);
+      if ( !glu_fastuidraw_gl_meshDelete( tess->mesh, eUp ) ) longjmp(tess->env,1);
       regUp = RegionAbove( regLo );
     }
   }
@@ -887,15 +892,15 @@ static void ConnectRightVertex( fastuidraw_GLUtesselator *tess, ActiveRegion *re
    * through vEvent, or may coincide with new intersection vertex
    */
   if( VertEq( eUp->Org, tess->event )) {
-    if ( !glu_fastuidraw_gl_meshSplice( eTopLeft->Oprev, eUp ) ) longjmp(tess->env,1);
-    regUp = TopLeftRegion( regUp );
+    if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, eTopLeft->Oprev, eUp ) ) longjmp(tess->env,1);
+    regUp = TopLeftRegion( tess, regUp );
     if (regUp == NULL) longjmp(tess->env,1);
     eTopLeft = RegionBelow( regUp )->eUp;
     FinishLeftRegions( tess, RegionBelow(regUp), regLo );
     degenerate = TRUE;
   }
   if( VertEq( eLo->Org, tess->event )) {
-    if ( !glu_fastuidraw_gl_meshSplice( eBottomLeft, eLo->Oprev ) ) longjmp(tess->env,1);
+    if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, eBottomLeft, eLo->Oprev ) ) longjmp(tess->env,1);
     eBottomLeft = FinishLeftRegions( tess, regLo, NULL );
     degenerate = TRUE;
   }
@@ -912,7 +917,7 @@ static void ConnectRightVertex( fastuidraw_GLUtesselator *tess, ActiveRegion *re
   } else {
     eNew = eUp;
   }
-  eNew = glu_fastuidraw_gl_meshConnect( eBottomLeft->Lprev, eNew );
+  eNew = glu_fastuidraw_gl_meshConnect( tess->mesh, eBottomLeft->Lprev, eNew );
   if (eNew == NULL) longjmp(tess->env,1);
 
   /* Prevent cleanup, otherwise eNew might disappear before we've even
@@ -955,13 +960,13 @@ static void ConnectLeftDegenerate( fastuidraw_GLUtesselator *tess,
 
   if( ! VertEq( e->Dst, vEvent )) {
     /* General case -- splice vEvent into edge e which passes through it */
-    if (glu_fastuidraw_gl_meshSplitEdge( e->Sym ) == NULL) longjmp(tess->env,1);
+    if (glu_fastuidraw_gl_meshSplitEdge( tess->mesh, e->Sym ) == NULL) longjmp(tess->env,1);
     if( regUp->fixUpperEdge ) {
       /* This edge was fixable -- delete unused portion of original edge */
-      if ( !glu_fastuidraw_gl_meshDelete( e->Onext ) ) longjmp(tess->env,1);
+      if ( !glu_fastuidraw_gl_meshDelete( tess->mesh, e->Onext ) ) longjmp(tess->env,1);
       regUp->fixUpperEdge = FALSE;
     }
-    if ( !glu_fastuidraw_gl_meshSplice( vEvent->anEdge, e ) ) longjmp(tess->env,1);
+    if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, vEvent->anEdge, e ) ) longjmp(tess->env,1);
     SweepEvent( tess, vEvent ); /* recurse */
     return;
   }
@@ -980,10 +985,10 @@ static void ConnectLeftDegenerate( fastuidraw_GLUtesselator *tess,
      */
     assert( eTopLeft != eTopRight );   /* there are some left edges too */
     DeleteRegion( tess, reg );
-    if ( !glu_fastuidraw_gl_meshDelete( eTopRight ) ) longjmp(tess->env,1);
+    if ( !glu_fastuidraw_gl_meshDelete( tess->mesh, eTopRight ) ) longjmp(tess->env,1);
     eTopRight = eTopLeft->Oprev;
   }
-  if ( !glu_fastuidraw_gl_meshSplice( vEvent->anEdge, eTopRight ) ) longjmp(tess->env,1);
+  if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, vEvent->anEdge, eTopRight ) ) longjmp(tess->env,1);
   if( ! EdgeGoesLeft( eTopLeft )) {
     /* e->Dst had no left-going edges -- indicate this to AddRightEdges() */
     eTopLeft = NULL;
@@ -1036,16 +1041,16 @@ static void ConnectLeftVertex( fastuidraw_GLUtesselator *tess, GLUvertex *vEvent
 
   if( regUp->inside || reg->fixUpperEdge) {
     if( reg == regUp ) {
-      eNew = glu_fastuidraw_gl_meshConnect( vEvent->anEdge->Sym, eUp->Lnext );
+      eNew = glu_fastuidraw_gl_meshConnect( tess->mesh, vEvent->anEdge->Sym, eUp->Lnext );
       if (eNew == NULL) longjmp(tess->env,1);
     } else {
-      GLUhalfEdge *tempHalfEdge= glu_fastuidraw_gl_meshConnect( eLo->Dnext, vEvent->anEdge);
+      GLUhalfEdge *tempHalfEdge= glu_fastuidraw_gl_meshConnect( tess->mesh, eLo->Dnext, vEvent->anEdge);
       if (tempHalfEdge == NULL) longjmp(tess->env,1);
 
       eNew = tempHalfEdge->Sym;
     }
     if( reg->fixUpperEdge ) {
-      if ( !FixUpperEdge( reg, eNew ) ) longjmp(tess->env,1);
+      if ( !FixUpperEdge( tess, reg, eNew ) ) longjmp(tess->env,1);
     } else {
       ComputeWinding( tess, AddRegionBelow( tess, regUp, eNew ));
     }
@@ -1092,7 +1097,7 @@ static void SweepEvent( fastuidraw_GLUtesselator *tess, GLUvertex *vEvent )
    * to their winding number, and delete the edges from the dictionary.
    * This takes care of all the left-going edges from vEvent.
    */
-  regUp = TopLeftRegion( e->activeRegion );
+  regUp = TopLeftRegion( tess, e->activeRegion );
   if (regUp == NULL) longjmp(tess->env,1);
   reg = RegionBelow( regUp );
   eTopLeft = reg->eUp;
@@ -1126,7 +1131,7 @@ static void AddSentinel( fastuidraw_GLUtesselator *tess, double t )
  */
 {
   GLUhalfEdge *e;
-  ActiveRegion *reg = (ActiveRegion *)memAlloc( sizeof( ActiveRegion ));
+  ActiveRegion *reg = (ActiveRegion *)arenaAlloc( &tess->arena, sizeof( ActiveRegion ));
   if (reg == NULL) longjmp(tess->env,1);
 
   e = glu_fastuidraw_gl_meshMakeEdge( tess->mesh );
@@ -1156,7 +1161,7 @@ static void InitEdgeDict( fastuidraw_GLUtesselator *tess )
  */
 {
   /* glu_fastuidraw_gl_dictListNewDict */
-  tess->dict = dictNewDict( tess, (int (*)(void *, DictKey, DictKey)) EdgeLeq );
+  tess->dict = dictNewDict( &tess->arena, tess, (int (*)(void *, DictKey, DictKey)) EdgeLeq );
   if (tess->dict == NULL) longjmp(tess->env,1);
 
   AddSentinel( tess, -SENTINEL_COORD );
@@ -1184,7 +1189,7 @@ static void DoneEdgeDict( fastuidraw_GLUtesselator *tess )
     }
     assert( reg->windingNumber == 0 );
     DeleteRegion( tess, reg );
-/*    glu_fastuidraw_gl_meshDelete( reg->eUp );*/
+/*    glu_fastuidraw_gl_meshDelete( tess->mesh, reg->eUp );*/
   }
   dictDeleteDict( tess->dict ); /* glu_fastuidraw_gl_dictListDeleteDict */
 }
@@ -1207,7 +1212,7 @@ static void RemoveDegenerateEdges( fastuidraw_GLUtesselator *tess )
       /* Zero-length edge, contour has at least 3 edges */
 
       SpliceMergeVertices( tess, eLnext, e );   /* deletes e->Org */
-      if ( !glu_fastuidraw_gl_meshDelete( e ) ) longjmp(tess->env,1); /* e is a self-loop */
+      if ( !glu_fastuidraw_gl_meshDelete( tess->mesh, e ) ) longjmp(tess->env,1); /* e is a self-loop */
       e = eLnext;
       eLnext = e->Lnext;
     }
@@ -1216,10 +1221,10 @@ static void RemoveDegenerateEdges( fastuidraw_GLUtesselator *tess )
 
       if( eLnext != e ) {
         if( eLnext == eNext || eLnext == eNext->Sym ) { eNext = eNext->next; }
-        if ( !glu_fastuidraw_gl_meshDelete( eLnext ) ) longjmp(tess->env,1);
+        if ( !glu_fastuidraw_gl_meshDelete( tess->mesh, eLnext ) ) longjmp(tess->env,1);
       }
       if( e == eNext || e == eNext->Sym ) { eNext = eNext->next; }
-      if ( !glu_fastuidraw_gl_meshDelete( e ) ) longjmp(tess->env,1);
+      if ( !glu_fastuidraw_gl_meshDelete( tess->mesh, e ) ) longjmp(tess->env,1);
     }
   }
 }
@@ -1234,7 +1239,7 @@ static int InitPriorityQ( fastuidraw_GLUtesselator *tess )
   GLUvertex *v, *vHead;
 
   /* glu_fastuidraw_gl_pqSortNewPriorityQ */
-  pq = tess->pq = pqNewPriorityQ( (int (*)(PQkey, PQkey)) glu_fastuidraw_gl_vertLeq );
+  pq = tess->pq = pqNewPriorityQ( &tess->arena, (int (*)(PQkey, PQkey)) glu_fastuidraw_gl_vertLeq );
   if (pq == NULL) return 0;
 
   vHead = &tess->mesh->vHead;
@@ -1286,7 +1291,7 @@ static int RemoveDegenerateFaces( GLUmesh *mesh )
     if( e->Lnext->Lnext == e ) {
       /* A face with only two edges */
       AddWinding( e->Onext, e );
-      if ( !glu_fastuidraw_gl_meshDelete( e ) ) return 0;
+      if ( !glu_fastuidraw_gl_meshDelete( mesh, e ) ) return 0;
     }
   }
   return 1;
@@ -212,19 +212,30 @@ fastuidraw_gluNewTess_release( void )
 
   tess->fastuidraw_alloc_tracker = NULL;
 
+  arenaInit( &tess->arena, GLU_ARENA_DEFAULT_BLOCK_SIZE );
+
   return tess;
 }
 
-static void MakeDormant( fastuidraw_GLUtesselator *tess )
+static void ReleaseMesh( fastuidraw_GLUtesselator *tess )
 {
-  /* Return the tessellator to its original dormant state. */
-
+  /* Everything allocated for the mesh (and the sweep) comes from
+   * tess->arena, resetting it releases it all at once.
+   */
   if( tess->mesh != NULL ) {
     glu_fastuidraw_gl_meshDeleteMesh( tess->mesh );
   }
+  tess->mesh = NULL;
+  arenaReset( &tess->arena );
+}
+
+static void MakeDormant( fastuidraw_GLUtesselator *tess )
+{
+  /* Return the tessellator to its original dormant state. */
+
+  ReleaseMesh( tess );
   tess->state = T_DORMANT;
   tess->lastEdge = NULL;
-  tess->mesh = NULL;
 }
 
 #define RequireState( tess, s )   if( tess->state != s ) GotoState(tess,s)
@@ -278,6 +289,7 @@ void REGALFASTUIDRAW_GLU_CALL
 fastuidraw_gluDeleteTess_release( fastuidraw_GLUtesselator *tess )
 {
   RequireState( tess, T_DORMANT );
+  arenaRelease( &tess->arena );
   memFree( tess );
 }
 
@@ -295,6 +307,38 @@ fastuidraw_gluGetTessPropertyTolerance(fastuidraw_GLUtesselator *tess)
   return tess->relTolerance;
 }
 
+void REGALFASTUIDRAW_GLU_CALL
+fastuidraw_gluTessPropertyArenaBlockSize(fastuidraw_GLUtesselator *tess, unsigned int value)
+{
+  if( value == 0 ) return;
+
+  tess->arena.blockSize = value;
+}
+
+unsigned int REGALFASTUIDRAW_GLU_CALL
+fastuidraw_gluGetTessPropertyArenaBlockSize(fastuidraw_GLUtesselator *tess)
+{
+  return tess->arena.blockSize;
+}
+
+size_t REGALFASTUIDRAW_GLU_CALL
+fastuidraw_gluGetTessArenaPeakBytes(fastuidraw_GLUtesselator *tess)
+{
+  return tess->arena.peakBytes;
+}
+
+size_t REGALFASTUIDRAW_GLU_CALL
+fastuidraw_gluGetTessArenaReservedBytes(fastuidraw_GLUtesselator *tess)
+{
+  return tess->arena.bytesReserved;
+}
+
+unsigned int REGALFASTUIDRAW_GLU_CALL
+fastuidraw_gluGetTessArenaBlockCount(fastuidraw_GLUtesselator *tess)
+{
+  return tess->arena.blockCount;
+}
+
 
 void REGALFASTUIDRAW_GLU_CALL
 fastuidraw_gluTessPropertyBoundaryOnly(fastuidraw_GLUtesselator *tess, int value)
@@ -410,12 +454,12 @@ static int AddVertex( fastuidraw_GLUtesselator *tess, double x, double y, unsign
 
     e = glu_fastuidraw_gl_meshMakeEdge( tess->mesh );
     if (e == NULL) return 0;
-    if ( !glu_fastuidraw_gl_meshSplice( e, e->Sym ) ) return 0;
+    if ( !glu_fastuidraw_gl_meshSplice( tess->mesh, e, e->Sym ) ) return 0;
   } else {
     /* Create a new vertex and edge which immediately follow e
      * in the ordering around the left face.
      */
-    if (glu_fastuidraw_gl_meshSplitEdge( e ) == NULL) return 0;
+    if (glu_fastuidraw_gl_meshSplitEdge( tess->mesh, e ) == NULL) return 0;
     e = e->Lnext;
   }
 
@@ -454,7 +498,7 @@ static int EmptyCache( fastuidraw_GLUtesselator *tess )
   CachedVertex *v = tess->cache;
   CachedVertex *vLast;
 
-  tess->mesh = glu_fastuidraw_gl_meshNewMesh();
+  tess->mesh = glu_fastuidraw_gl_meshNewMesh( &tess->arena );
   if (tess->mesh == NULL) return 0;
 
   for( vLast = v + tess->cacheCount; v < vLast; ++v ) {
@@ -564,6 +608,8 @@ fastuidraw_gluTessEndPolygon( fastuidraw_GLUtesselator *tess )
   if (setjmp(tess->env) != 0) {
      /* come back here if out of memory */
      CALL_ERROR_OR_ERROR_DATA( FASTUIDRAW_GLU_OUT_OF_MEMORY );
+     tess->mesh = NULL;
+     arenaReset( &tess->arena );
      return;
   }
 
@@ -634,15 +680,14 @@ fastuidraw_gluTessEndPolygon( fastuidraw_GLUtesselator *tess )
        * faces in the first place.
        */
       glu_fastuidraw_gl_meshDiscardExterior( mesh );
+      /* the mesh is stored in tess->arena, so it is only
+       * valid for the duration of the callback.
+       */
       (*tess->callMesh)( mesh );                /* user wants the mesh itself */
-      tess->mesh = NULL;
-      tess->polygonData= NULL;
-      return;
     }
   }
-  glu_fastuidraw_gl_meshDeleteMesh( mesh );
+  ReleaseMesh( tess );
   tess->polygonData= NULL;
-  tess->mesh = NULL;
 }
 
 
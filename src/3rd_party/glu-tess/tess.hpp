@@ -42,6 +42,7 @@
 #include "mesh.hpp"
 #include "dict.hpp"
 #include "priorityq.hpp"
+#include "memalloc.hpp"
 
 
 /* The begin/end calls must be properly nested.  We keep track of
@@ -68,6 +69,8 @@ struct fastuidraw_GLUtesselator {
   GLUhalfEdge   *lastEdge;      /* lastEdge->Org is the most recent vertex */
   GLUmesh       *mesh;          /* stores the input contours, and eventually
                                    the tessellation itself */
+  GLUarena      arena;          /* storage for mesh, dict and pq; reset
+                                   once a polygon is done */
 
   void          (REGALFASTUIDRAW_GLU_CALL *callError)( FASTUIDRAW_GLUenum errnum );
 
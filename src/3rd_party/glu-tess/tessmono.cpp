@@ -42,7 +42,7 @@
 #define AddWinding(eDst,eSrc)   (eDst->winding += eSrc->winding, \
                                  eDst->Sym->winding += eSrc->Sym->winding)
 
-/* glu_fastuidraw_gl_meshTessellateMonoRegion( face ) tessellates a monotone region
+/* glu_fastuidraw_gl_meshTessellateMonoRegion( mesh, face ) tessellates a monotone region
  * (what else would it do??)  The region must consist of a single
  * loop of half-edges (see mesh.h) oriented CCW.  "Monotone" in this
  * case means that any vertical line intersects the interior of the
@@ -69,7 +69,7 @@
  * to the fan is a simple orientation test.  By making the fan as large
  * as possible, we restore the invariant (check it yourself).
  */
-int glu_fastuidraw_gl_meshTessellateMonoRegion( GLUface *face )
+int glu_fastuidraw_gl_meshTessellateMonoRegion( GLUmesh *mesh, GLUface *face )
 {
   GLUhalfEdge *up, *lo;
 
@@ -95,7 +95,7 @@ int glu_fastuidraw_gl_meshTessellateMonoRegion( GLUface *face )
        */
       while( lo->Lnext != up && (EdgeGoesLeft( lo->Lnext )
              || EdgeSign( lo->Org, lo->Dst, lo->Lnext->Dst ) <= 0 )) {
-        GLUhalfEdge *tempHalfEdge= glu_fastuidraw_gl_meshConnect( lo->Lnext, lo );
+        GLUhalfEdge *tempHalfEdge= glu_fastuidraw_gl_meshConnect( mesh, lo->Lnext, lo );
         if (tempHalfEdge == NULL) return 0;
         lo = tempHalfEdge->Sym;
       }
@@ -104,7 +104,7 @@ int glu_fastuidraw_gl_meshTessellateMonoRegion( GLUface *face )
       /* lo->Org is on the left.  We can make CCW triangles from up->Dst. */
       while( lo->Lnext != up && (EdgeGoesRight( up->Lprev )
              || EdgeSign( up->Dst, up->Org, up->Lprev->Org ) >= 0 )) {
-        GLUhalfEdge *tempHalfEdge= glu_fastuidraw_gl_meshConnect( up, up->Lprev );
+        GLUhalfEdge *tempHalfEdge= glu_fastuidraw_gl_meshConnect( mesh, up, up->Lprev );
         if (tempHalfEdge == NULL) return 0;
         up = tempHalfEdge->Sym;
       }
@@ -117,7 +117,7 @@ int glu_fastuidraw_gl_meshTessellateMonoRegion( GLUface *face )
    */
   assert( lo->Lnext != up );
   while( lo->Lnext->Lnext != up ) {
-    GLUhalfEdge *tempHalfEdge= glu_fastuidraw_gl_meshConnect( lo->Lnext, lo );
+    GLUhalfEdge *tempHalfEdge= glu_fastuidraw_gl_meshConnect( mesh, lo->Lnext, lo );
     if (tempHalfEdge == NULL) return 0;
     lo = tempHalfEdge->Sym;
   }
@@ -139,7 +139,7 @@ int glu_fastuidraw_gl_meshTessellateInterior( GLUmesh *mesh )
     /* Make sure we don''t try to tessellate the new triangles. */
     next = f->next;
     if( f->inside ) {
-      if ( !glu_fastuidraw_gl_meshTessellateMonoRegion( f ) ) return 0;
+      if ( !glu_fastuidraw_gl_meshTessellateMonoRegion( mesh, f ) ) return 0;
     }
   }
 
@@ -161,7 +161,7 @@ void glu_fastuidraw_gl_meshDiscardExterior( GLUmesh *mesh )
     /* Since f will be destroyed, save its next pointer. */
     next = f->next;
     if( ! f->inside ) {
-      glu_fastuidraw_gl_meshZapFace( f );
+      glu_fastuidraw_gl_meshZapFace( mesh, f );
     }
   }
 }
@@ -193,7 +193,7 @@ int glu_fastuidraw_gl_meshSetWindingNumber( GLUmesh *mesh, int value,
       if( ! keepOnlyBoundary ) {
         e->winding = 0;
       } else {
-        if ( !glu_fastuidraw_gl_meshDelete( e ) ) return 0;
+        if ( !glu_fastuidraw_gl_meshDelete( mesh, e ) ) return 0;
       }
     }
   }
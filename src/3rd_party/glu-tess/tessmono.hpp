@@ -35,7 +35,7 @@
 #ifndef fastuidraw_glu_tessmono_h_
 #define fastuidraw_glu_tessmono_h_
 
-/* glu_fastuidraw_gl_meshTessellateMonoRegion( face ) tessellates a monotone region
+/* glu_fastuidraw_gl_meshTessellateMonoRegion( mesh, face ) tessellates a monotone region
  * (what else would it do??)  The region must consist of a single
  * loop of half-edges (see mesh.h) oriented CCW.  "Monotone" in this
  * case means that any vertical line intersects the interior of the
@@ -62,7 +62,7 @@
  * separate an interior region from an exterior one.
  */
 
-int glu_fastuidraw_gl_meshTessellateMonoRegion( GLUface *face );
+int glu_fastuidraw_gl_meshTessellateMonoRegion( GLUmesh *mesh, GLUface *face );
 int glu_fastuidraw_gl_meshTessellateInterior( GLUmesh *mesh );
 void glu_fastuidraw_gl_meshDiscardExterior( GLUmesh *mesh );
 int glu_fastuidraw_gl_meshSetWindingNumber( GLUmesh *mesh, int value,
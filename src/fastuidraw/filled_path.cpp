@@ -19,7 +19,6 @@
 
 #include <vector>
 #include <map>
-#include <list>
 #include <algorithm>
 
 #include <fastuidraw/filled_path.hpp>
@@ -35,31 +34,36 @@
 
 namespace
 {
-  class per_winding_data:
-    public fastuidraw::reference_counted<per_winding_data>::non_concurrent
+  /* per_winding_data holds the indices of the triangles
+     of a single winding number in a flat array; clear()
+     keeps the storage so that a BuildScratch reuses it
+     from one build to the next.
+   */
+  class per_winding_data
   {
   public:
-    per_winding_data(void):
-      m_count(0)
-    {}
-
     void
     add_index(unsigned int idx)
     {
       m_indices.push_back(idx);
-      ++m_count;
     }
 
     unsigned int
     count(void) const
     {
-      return m_count;
+      return m_indices.size();
+    }
+
+    void
+    clear(void)
+    {
+      m_indices.clear();
     }
 
     void
     fill_at(unsigned int &offset,
             fastuidraw::c_array<unsigned int> dest,
-            fastuidraw::const_c_array<unsigned int> &sub_range)
+            fastuidraw::const_c_array<unsigned int> &sub_range) const
     {
       assert(count() + offset <= dest.size());
       std::copy(m_indices.begin(), m_indices.end(), &dest[offset]);
@@ -68,11 +72,77 @@ namespace
     }
 
   private:
-    std::list<unsigned int> m_indices;
-    unsigned int m_count;
+    std::vector<unsigned int> m_indices;
   };
 
-  typedef std::map<int, fastuidraw::reference_counted_ptr<per_winding_data> > winding_index_hoard;
+  /* winding_index_hoard maps winding numbers to per_winding_data.
+     The winding numbers -1, 0 and 1 cover nearly all triangles of
+     typical paths and are stored directly; only the other winding
+     numbers go through a std::map.
+   */
+  class winding_index_hoard:fastuidraw::noncopyable
+  {
+  public:
+    typedef std::pair<int, const per_winding_data*> entry;
+
+    per_winding_data&
+    operator[](int winding_number)
+    {
+      return (winding_number >= -1 && winding_number <= 1) ?
+        m_common[winding_number + 1] :
+        m_others[winding_number];
+    }
+
+    void
+    clear(void)
+    {
+      for(unsigned int i = 0; i < 3; ++i)
+        {
+          m_common[i].clear();
+        }
+      m_others.clear();
+    }
+
+    /* returns those entries with a non-zero count, sorted
+       in increasing winding number.
+     */
+    const std::vector<entry>&
+    non_empty_entries(void)
+    {
+      std::map<int, per_winding_data>::const_iterator iter, end;
+
+      m_entries.clear();
+      for(iter = m_others.begin(), end = m_others.end(); iter != end && iter->first < -1; ++iter)
+        {
+          add_entry(iter->first, iter->second);
+        }
+
+      for(int w = -1; w <= 1; ++w)
+        {
+          add_entry(w, m_common[w + 1]);
+        }
+
+      for(; iter != end; ++iter)
+        {
+          add_entry(iter->first, iter->second);
+        }
+      return m_entries;
+    }
+
+  private:
+    void
+    add_entry(int winding_number, const per_winding_data &data)
+    {
+      if(data.count() > 0)
+        {
+          m_entries.push_back(entry(winding_number, &data));
+        }
+    }
+
+    per_winding_data m_common[3];
+    std::map<int, per_winding_data> m_others;
+    std::vector<entry> m_entries;
+  };
 
   bool
   is_even(int v)
@@ -80,16 +150,157 @@ namespace
     return (v % 2) == 0;
   }
 
+  void
+  fill_indices(winding_index_hoard &hoard,
+               std::vector<unsigned int> &indices,
+               std::map<int, fastuidraw::const_c_array<unsigned int> > &winding_map,
+               unsigned int &even_non_zero_start,
+               unsigned int &zero_start)
+  {
+    std::vector<winding_index_hoard::entry>::const_iterator iter, end;
+    const std::vector<winding_index_hoard::entry> &entries(hoard.non_empty_entries());
+    unsigned int total(0), num_odd(0), num_even_non_zero(0), num_zero(0);
+
+    /* compute number indices needed */
+    for(iter = entries.begin(), end = entries.end(); iter != end; ++iter)
+      {
+        unsigned int cnt;
+
+        cnt = iter->second->count();
+        total += cnt;
+
+        // std::cout << "Winding=" << iter->first << " has " << cnt << " indices\n";
+
+        if(iter->first == 0)
+          {
+            num_zero += cnt;
+          }
+        else if (is_even(iter->first))
+          {
+            num_even_non_zero += cnt;
+          }
+        else
+          {
+            num_odd += cnt;
+          }
+      }
+
+    /* pack as follows:
+        - odd
+        - even non-zero
+        - zero
+     */
+    unsigned int current_odd(0), current_even_non_zero(num_odd);
+    unsigned int current_zero(num_even_non_zero + num_odd);
+
+    indices.resize(total);
+    for(iter = entries.begin(), end = entries.end(); iter != end; ++iter)
+      {
+        if(iter->first == 0)
+          {
+            iter->second->fill_at(current_zero,
+                                  fastuidraw::make_c_array(indices),
+                                  winding_map[iter->first]);
+          }
+        else if(is_even(iter->first))
+          {
+            iter->second->fill_at(current_even_non_zero,
+                                  fastuidraw::make_c_array(indices),
+                                  winding_map[iter->first]);
+          }
+        else
+          {
+            iter->second->fill_at(current_odd,
+                                  fastuidraw::make_c_array(indices),
+                                  winding_map[iter->first]);
+          }
+      }
+
+    assert(current_zero == total);
+    assert(current_odd == num_odd);
+    assert(current_even_non_zero == current_odd + num_even_non_zero);
+    FASTUIDRAWunused(num_zero);
+
+    even_non_zero_start = num_odd;
+    zero_start = current_odd + num_even_non_zero;
+  }
+
+  /* A SubPath is the portion of a path that is within a
+     rectangle. Each contour is stored as a closed polygon
+     that has been clipped to the rectangle. Clipping a
+     closed polygon against a half-plane does not change
+     the winding number of any point strictly within the
+     half plane, thus filling a SubPath gives the same
+     winding numbers as the original path within its
+     rectangle.
+   */
+  class SubPath:fastuidraw::noncopyable
+  {
+  public:
+    typedef std::vector<fastuidraw::vec2> SubContour;
+
+    explicit
+    SubPath(const fastuidraw::TessellatedPath &P);
+
+    const std::vector<SubContour>&
+    contours(void) const
+    {
+      return m_contours;
+    }
+
+    const fastuidraw::vec2&
+    bounds_min(void) const
+    {
+      return m_bounds_min;
+    }
+
+    const fastuidraw::vec2&
+    bounds_max(void) const
+    {
+      return m_bounds_max;
+    }
+
+    unsigned int
+    total_points(void) const
+    {
+      return m_total_points;
+    }
+
+    /* Split the SubPath into two by a line along the
+       longer side of its rectangle; the returned
+       objects are to be deleted by the caller.
+     */
+    fastuidraw::vecN<SubPath*, 2>
+    split(void) const;
+
+  private:
+    SubPath(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &pmax);
+
+    void
+    add_contour(const SubContour &C);
+
+    static
+    void
+    clip_contour(const SubContour &src, int coordinate,
+                 float value, bool keep_less, SubContour &dst);
+
+    fastuidraw::vec2 m_bounds_min, m_bounds_max;
+    unsigned int m_total_points;
+    std::vector<SubContour> m_contours;
+  };
+
   class tesser:fastuidraw::noncopyable
   {
   public:
     /* points is arranged as follows:
-         - first all points from the source Path
+         - first all points from the source SubPath
          - bounding box points (4 points)
          - added points from tessellation
+       tess is the GLU tessellator to use, it is not
+       owned by the tesser.
      */
-    explicit
-    tesser(std::vector<fastuidraw::vec2> &points);
+    tesser(fastuidraw_GLUtesselator *tess,
+           std::vector<fastuidraw::vec2> &points);
 
     virtual
     ~tesser(void);
@@ -101,10 +312,10 @@ namespace
     stop(void);
 
     void
-    add_path(const fastuidraw::TessellatedPath &P);
+    add_path(const SubPath &P);
 
     void
-    add_path_boundary(const fastuidraw::TessellatedPath &P);
+    add_path_boundary(const SubPath &P);
 
     virtual
     void
@@ -159,16 +370,18 @@ namespace
 
     static
     void
-    execute_path(std::vector<fastuidraw::vec2> &points,
-                 const fastuidraw::TessellatedPath &P,
+    execute_path(fastuidraw_GLUtesselator *tess,
+                 std::vector<fastuidraw::vec2> &points,
+                 const SubPath &P,
                  winding_index_hoard &hoard)
     {
-      non_zero_tesser NZ(points, P, hoard);
+      non_zero_tesser NZ(tess, points, P, hoard);
     }
 
   private:
-    non_zero_tesser(std::vector<fastuidraw::vec2> &points,
-                    const fastuidraw::TessellatedPath &P,
+    non_zero_tesser(fastuidraw_GLUtesselator *tess,
+                    std::vector<fastuidraw::vec2> &points,
+                    const SubPath &P,
                     winding_index_hoard &hoard);
 
     virtual
@@ -185,7 +398,7 @@ namespace
 
     winding_index_hoard &m_hoard;
     int m_current_winding;
-    fastuidraw::reference_counted_ptr<per_winding_data> m_current_indices;
+    per_winding_data *m_current_indices;
   };
 
   class zero_tesser:private tesser
@@ -194,17 +407,19 @@ namespace
 
     static
     void
-    execute_path(std::vector<fastuidraw::vec2> &points,
-                 const fastuidraw::TessellatedPath &P,
+    execute_path(fastuidraw_GLUtesselator *tess,
+                 std::vector<fastuidraw::vec2> &points,
+                 const SubPath &P,
                  winding_index_hoard &hoard)
     {
-      zero_tesser Z(points, P, hoard);
+      zero_tesser Z(tess, points, P, hoard);
     }
 
   private:
 
-    zero_tesser(std::vector<fastuidraw::vec2> &points,
-                const fastuidraw::TessellatedPath &P,
+    zero_tesser(fastuidraw_GLUtesselator *tess,
+                std::vector<fastuidraw::vec2> &points,
+                const SubPath &P,
                 winding_index_hoard &hoard);
 
     virtual
@@ -219,42 +434,110 @@ namespace
     FASTUIDRAW_GLUboolean
     fill_region(int winding_number);
 
-    fastuidraw::reference_counted_ptr<per_winding_data> &m_indices;
+    per_winding_data &m_indices;
   };
 
-  class builder:fastuidraw::noncopyable
+  /* BuildScratch holds the GLU tessellator and the work
+     buffers used to tessellate a SubPath. It is reused
+     across the leafs of all FilledPath objects so that once
+     the buffers have grown, tessellating a leaf only
+     allocates the final storage of its FillData.
+   */
+  class BuildScratch:fastuidraw::noncopyable
   {
   public:
-    explicit
-    builder(const fastuidraw::TessellatedPath &P,
-            std::vector<fastuidraw::vec2> &pts);
+    BuildScratch(void)
+    {
+      m_tess = fastuidraw_gluNewTess;
+    }
+
+    ~BuildScratch()
+    {
+      fastuidraw_gluDeleteTess(m_tess);
+    }
+
+    fastuidraw_GLUtesselator *m_tess;
+    std::vector<fastuidraw::vec2> m_points;
+    winding_index_hoard m_hoard;
+  };
+
+  /* A BuildScratchPool holds the BuildScratch objects that
+     are not in use; there is one BuildScratchPool for the
+     process (see build_scratch_pool()) and the leafs of
+     FilledPath objects may be built from several threads
+     simultaneously (see PathPreparer).
+   */
+  class BuildScratchPool:fastuidraw::noncopyable
+  {
+  public:
+    ~BuildScratchPool();
 
-    ~builder();
+    BuildScratch*
+    acquire(void);
 
     void
-    fill_indices(std::vector<unsigned int> &indices,
-                 std::map<int, fastuidraw::const_c_array<unsigned int> > &winding_map,
-                 unsigned int &even_non_zero_start,
-                 unsigned int &zero_start);
+    release(BuildScratch *p);
 
   private:
+    boost::mutex m_mutex;
+    std::vector<BuildScratch*> m_free;
+  };
 
-    void
-    init_points(const fastuidraw::TessellatedPath &P);
+  BuildScratchPool&
+  build_scratch_pool(void)
+  {
+    static BuildScratchPool R;
+    return R;
+  }
 
-    winding_index_hoard m_hoard;
-    std::vector<fastuidraw::vec2> &m_points;
+  class builder:fastuidraw::noncopyable
+  {
+  public:
+    /* the tessellation is written to scratch.m_points
+       and scratch.m_hoard.
+     */
+    builder(const SubPath &P, BuildScratch &scratch);
+
+  private:
+    void
+    init_points(const SubPath &P, std::vector<fastuidraw::vec2> &points);
   };
 
-  class FilledPathPrivate
+  class FillData:fastuidraw::noncopyable
   {
   public:
-    explicit
-    FilledPathPrivate(const fastuidraw::TessellatedPath &P);
+    /* construct by tessellating a SubPath
+     */
+    FillData(const SubPath &P, BuildScratch &scratch);
 
-    ~FilledPathPrivate();
+    /* construct from points and indices already
+       made; the contents of pts are taken.
+     */
+    FillData(std::vector<fastuidraw::vec2> &pts,
+             winding_index_hoard &hoard);
 
-    std::vector<fastuidraw::vec2> m_points;
+    /* load data written by bake(), returns NULL on failure;
+       the arrays point into src.buffer().
+     */
+    static
+    FillData*
+    load_baked(fastuidraw::BakedDataReader &src);
+
+    void
+    bake(fastuidraw::BakedDataWriter &dst) const;
+
+    fastuidraw::const_c_array<unsigned int>
+    indices(int winding_number) const
+    {
+      std::map<int, fastuidraw::const_c_array<unsigned int> >::const_iterator iter;
+
+      iter = m_per_fill.find(winding_number);
+      return (iter != m_per_fill.end()) ?
+        iter->second:
+        fastuidraw::const_c_array<unsigned int>();
+    }
+
+    fastuidraw::const_c_array<fastuidraw::vec2> m_points;
 
     /* Carefully organize indices as follows:
        - first all elements with odd winding number
@@ -266,7 +549,7 @@ namespace
        - complement of odd-even fill
        - complement of non-zero
     */
-    std::vector<unsigned int> m_indices;
+    fastuidraw::const_c_array<unsigned int> m_indices;
 
     /* m_per_fill[w] gives the indices to the triangles
        with the winding number w. The value points into
@@ -276,139 +559,499 @@ namespace
 
     /* list of values V for which m_per_fill[V] entry exists
      */
-    std::vector<int> m_winding_numbers;
+    fastuidraw::const_c_array<int> m_winding_numbers;
 
     fastuidraw::const_c_array<unsigned int> m_nonzero_winding, m_odd_winding;
     fastuidraw::const_c_array<unsigned int> m_even_winding, m_zero_winding;
 
-    fastuidraw::PainterAttributeData *m_attribute_data;
-  };
-}
+  private:
+    FillData(void)
+    {}
 
-////////////////////////////////////////
-// tesser methods
-tesser::
-tesser(std::vector<fastuidraw::vec2> &points):
-  m_points(points)
-{
-  m_tess = fastuidraw_gluNewTess;
-  fastuidraw_gluTessCallbackBegin(m_tess, &begin_callBack);
-  fastuidraw_gluTessCallbackVertex(m_tess, &vertex_callBack);
-  fastuidraw_gluTessCallbackCombine(m_tess, &combine_callback);
-  fastuidraw_gluTessCallbackFillRule(m_tess, &winding_callBack);
-  fastuidraw_gluTessPropertyBoundaryOnly(m_tess, FASTUIDRAW_GLU_FALSE);
-}
+    void
+    finalize(winding_index_hoard &hoard);
 
-tesser::
-~tesser(void)
-{
-  fastuidraw_gluDeleteTess(m_tess);
-}
+    void
+    set_winding_ranges(unsigned int even_non_zero_start,
+                       unsigned int zero_start);
 
+    /* backing of m_points, m_indices and m_winding_numbers
+       unless they point into m_baked_data.
+     */
+    std::vector<fastuidraw::vec2> m_points_store;
+    std::vector<unsigned int> m_indices_store;
+    std::vector<int> m_winding_numbers_store;
+    fastuidraw::reference_counted_ptr<const fastuidraw::DataBuffer> m_baked_data;
+  };
 
-void
-tesser::
-start(void)
-{
-  fastuidraw_gluTessBeginPolygon(m_tess, this);
-}
+  /* Same layout as PainterAttributeDataFillerPathFill,
+     but filling from a FillData.
+   */
+  class FillDataAttributeFiller:public fastuidraw::PainterAttributeDataFiller
+  {
+  public:
+    FillDataAttributeFiller(const FillData &data,
+                            const fastuidraw::vec2 &bounds_min,
+                            const fastuidraw::vec2 &bounds_max):
+      m_data(data),
+      m_bounds_min(bounds_min),
+      m_bounds_max(bounds_max)
+    {}
 
-void
-tesser::
-stop(void)
-{
-  fastuidraw_gluTessEndPolygon(m_tess);
-}
+    virtual
+    void
+    compute_sizes(unsigned int &number_attributes,
+                  unsigned int &number_indices,
+                  unsigned int &number_attribute_chunks,
+                  unsigned int &number_index_chunks,
+                  unsigned int &number_z_increments) const;
 
-void
-tesser::
-add_path(const fastuidraw::TessellatedPath &input)
-{
-  for(unsigned int o = 0, endo = input.number_contours(); o < endo; ++o)
+    virtual
+    void
+    fill_data(fastuidraw::c_array<fastuidraw::PainterAttribute> attributes,
+              fastuidraw::c_array<fastuidraw::PainterIndex> index_data,
+              fastuidraw::c_array<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > attrib_chunks,
+              fastuidraw::c_array<fastuidraw::const_c_array<fastuidraw::PainterIndex> > index_chunks,
+              fastuidraw::c_array<unsigned int> zincrements) const;
+
+    virtual
+    bool
+    compute_bounding_box(fastuidraw::const_c_array<fastuidraw::PainterAttribute> attributes,
+                         fastuidraw::vec2 &out_min, fastuidraw::vec2 &out_max) const
     {
-      fastuidraw_gluTessBeginContour(m_tess);
-      for(unsigned int e = 0, ende = input.number_edges(o); e < ende; ++e)
-        {
-          fastuidraw::range_type<unsigned int> R(input.edge_range(o, e));
-          for(unsigned int v = R.m_begin; v + 1 < R.m_end; ++v)
-            {
-              fastuidraw_gluTessVertex(m_tess, m_points[v].x(), m_points[v].y(), v);
-            }
-        }
-      fastuidraw_gluTessEndContour(m_tess);
+      out_min = m_bounds_min;
+      out_max = m_bounds_max;
+      return !attributes.empty();
     }
-}
 
-unsigned int
-tesser::
-add_point_to_store(float x, float y)
-{
-  unsigned int return_value(m_points.size());
-  m_points.push_back(fastuidraw::vec2(x, y));
+  private:
+    const FillData &m_data;
+    fastuidraw::vec2 m_bounds_min, m_bounds_max;
+  };
 
-  //std::cout << "add point " << m_points.back() << "@"  << m_ids_of_added_points.back() << "\n";
+  class SubsetPrivate:fastuidraw::noncopyable
+  {
+  public:
+    enum
+      {
+        /* A SubsetPrivate is split further if it has
+           more than this many points and the recursion
+           limit is not yet reached.
+         */
+        max_points_per_leaf = 512,
+
+        max_recursion_depth = 12,
+
+        /* The data of a SubsetPrivate that is not a leaf
+           is constructed (by merging the data of the leafs)
+           only if it has no more than this many points.
+         */
+        max_points_to_merge = 4096
+      };
+
+    /* Takes ownership of P, the ID of the created object
+       is the size of out_values before it is added to it.
+     */
+    SubsetPrivate(SubPath *P, int max_recursion,
+                  std::vector<SubsetPrivate*> &out_values);
 
-  return return_value;
-}
+    /* load a SubsetPrivate written by bake(), returns NULL
+       on failure; the children are not set, their ID's
+       are written to child_ids.
+     */
+    static
+    SubsetPrivate*
+    load_baked(fastuidraw::BakedDataReader &src, unsigned int ID,
+               fastuidraw::uvec2 &child_ids);
 
-void
-tesser::
-add_path_boundary(const fastuidraw::TessellatedPath &P)
-{
-  fastuidraw_gluTessBeginContour(m_tess);
-  for(unsigned int i = 0, v = P.point_data().size(); i < 4; ++i, ++v)
+    void
+    bake(fastuidraw::BakedDataWriter &dst);
+
+    void
+    set_children(SubsetPrivate *child0, SubsetPrivate *child1)
     {
-      fastuidraw_gluTessVertex(m_tess, m_points[v].x(), m_points[v].y(), v);
+      m_children[0] = child0;
+      m_children[1] = child1;
     }
-  fastuidraw_gluTessEndContour(m_tess);
-}
 
+    ~SubsetPrivate();
 
-void
-tesser::
-begin_callBack(FASTUIDRAW_GLUenum type, int winding_number, void *tess)
-{
-  tesser *p;
-  p = static_cast<tesser*>(tess);
-  assert(FASTUIDRAW_GLU_TRIANGLES == type);
-  FASTUIDRAWunused(type);
-
-  //std::cout << "begin_callBack(" << winding_number << ")\n";
-  p->m_temp_vert_count = 0;
-  p->on_begin_polygon(winding_number);
-}
+    unsigned int
+    ID(void) const
+    {
+      return m_ID;
+    }
 
-void
-tesser::
-vertex_callBack(unsigned int vertex_id, void *tess)
-{
-  tesser *p;
-  p = static_cast<tesser*>(tess);
-  // std::cout << "add vertex [" << *data << "] = " << p->m_points[*data] << "\n";
+    const fastuidraw::vec2&
+    bounds_min(void) const
+    {
+      return m_bounds_min;
+    }
 
-  /* Cache added vertices in groups of 3 (triangles),
-     then if all vertices are NOT FASTUIDRAW_GLU_NULL_CLIENT_ID,
-     then add them.
-   */
-  p->m_temp_verts[p->m_temp_vert_count] = vertex_id;
-  p->m_temp_vert_count++;
-  if(p->m_temp_vert_count == 3)
+    const fastuidraw::vec2&
+    bounds_max(void) const
     {
-      p->m_temp_vert_count = 0;
-      /*
-        if vertex_id is FASTUIDRAW_GLU_NULL_CLIENT_ID, that means
-        the triangle is junked.
-      */
-      if(p->m_temp_verts[0] != FASTUIDRAW_GLU_NULL_CLIENT_ID
-         && p->m_temp_verts[1] != FASTUIDRAW_GLU_NULL_CLIENT_ID
-         && p->m_temp_verts[2] != FASTUIDRAW_GLU_NULL_CLIENT_ID)
-        {
-          p->add_vertex_to_polygon(p->m_temp_verts[0]);
-          p->add_vertex_to_polygon(p->m_temp_verts[1]);
-          p->add_vertex_to_polygon(p->m_temp_verts[2]);
-        }
+      return m_bounds_max;
     }
-}
+
+    bool
+    is_leaf(void) const
+    {
+      return m_children[0] == NULL;
+    }
+
+    /* the data is built on first call, may be called
+       from multiple threads simultaneously.
+     */
+    const FillData&
+    data(void);
+
+    /* the data is built on first call, may be called
+       from multiple threads simultaneously.
+     */
+    const fastuidraw::PainterAttributeData&
+    painter_data(void);
+
+    /* clip_equations are in local coordinates
+     */
+    void
+    select_subsets(fastuidraw::const_c_array<fastuidraw::vec3> clip_equations,
+                   fastuidraw::c_array<unsigned int> dst,
+                   unsigned int &current);
+
+  private:
+    SubsetPrivate(unsigned int ID,
+                  const fastuidraw::vec2 &bounds_min,
+                  const fastuidraw::vec2 &bounds_max,
+                  unsigned int num_points);
+
+    /* returns true if the bounding box is culled,
+       sets unclipped to true if the box is entirely
+       within the clip equations.
+     */
+    bool
+    bounding_box_culled(fastuidraw::const_c_array<fastuidraw::vec3> clip_equations,
+                        bool &unclipped) const;
+
+    void
+    merge_data_from_children(void);
+
+    unsigned int m_ID;
+    fastuidraw::vec2 m_bounds_min, m_bounds_max;
+
+    /* number of points of the SubPath(s) used to construct
+       the leafs of this SubsetPrivate.
+     */
+    unsigned int m_num_points;
+    fastuidraw::vecN<SubsetPrivate*, 2> m_children;
+
+    /* for a leaf, the SubPath to tessellate,
+       deleted once m_data is built.
+     */
+    SubPath *m_sub_path;
+    FillData *m_data;
+    boost::mutex m_data_mutex;
+
+    /* a different mutex than m_data_mutex because
+       building m_painter_data locks m_data_mutex.
+     */
+    boost::mutex m_painter_data_mutex;
+    fastuidraw::PainterAttributeData *m_painter_data;
+  };
+
+  class FilledPathPrivate
+  {
+  public:
+    explicit
+    FilledPathPrivate(const fastuidraw::TessellatedPath &P);
+
+    /* ctor for a FilledPath loaded from baked data */
+    FilledPathPrivate(void):
+      m_root(NULL)
+    {}
+
+    ~FilledPathPrivate();
+
+    bool
+    load_baked(fastuidraw::BakedDataReader &src);
+
+    SubsetPrivate *m_root;
+
+    /* m_subsets[i] has ID i, ordered depth first
+       with m_subsets[0] as m_root.
+     */
+    std::vector<SubsetPrivate*> m_subsets;
+  };
+
+  fastuidraw::PainterAttribute
+  generate_attribute(const fastuidraw::vec2 &src)
+  {
+    fastuidraw::PainterAttribute dst;
+
+    dst.m_attrib0 = fastuidraw::pack_vec4(src.x(), src.y(), 0.0f, 0.0f);
+    dst.m_attrib1 = fastuidraw::uvec4(0u, 0u, 0u, 0u);
+    dst.m_attrib2 = fastuidraw::uvec4(0u, 0u, 0u, 0u);
+
+    return dst;
+  }
+}
+
+///////////////////////////////////////
+// SubPath methods
+SubPath::
+SubPath(const fastuidraw::TessellatedPath &P):
+  m_total_points(0)
+{
+  fastuidraw::vec2 pdelta;
+  float tiny(1e-6);
+
+  pdelta = (P.bounding_box_max() - P.bounding_box_min()) * tiny;
+  m_bounds_min = P.bounding_box_min() - pdelta;
+  m_bounds_max = P.bounding_box_max() + pdelta;
+
+  m_contours.resize(P.number_contours());
+  for(unsigned int o = 0, endo = P.number_contours(); o < endo; ++o)
+    {
+      SubContour &C(m_contours[o]);
+      for(unsigned int e = 0, ende = P.number_edges(o); e < ende; ++e)
+        {
+          fastuidraw::range_type<unsigned int> R(P.edge_range(o, e));
+          for(unsigned int v = R.m_begin; v + 1 < R.m_end; ++v)
+            {
+              C.push_back(P.point_data()[v].m_p);
+            }
+        }
+      m_total_points += C.size();
+    }
+}
+
+SubPath::
+SubPath(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &pmax):
+  m_bounds_min(pmin),
+  m_bounds_max(pmax),
+  m_total_points(0)
+{}
+
+void
+SubPath::
+add_contour(const SubContour &C)
+{
+  /* a contour with fewer than 3 points has no area
+     and does not affect any winding number.
+   */
+  if(C.size() >= 3)
+    {
+      m_contours.push_back(C);
+      m_total_points += C.size();
+    }
+}
+
+void
+SubPath::
+clip_contour(const SubContour &src, int coordinate,
+             float value, bool keep_less, SubContour &dst)
+{
+  dst.clear();
+  if(src.empty())
+    {
+      return;
+    }
+
+  /* Sutherland-Hodgman clipping of a closed polygon
+     against the half plane { p : p[coordinate] <= value }
+     or { p : p[coordinate] >= value }.
+   */
+  fastuidraw::vec2 prev(src.back());
+  bool prev_in;
+
+  prev_in = keep_less ?
+    prev[coordinate] <= value :
+    prev[coordinate] >= value;
+
+  for(unsigned int i = 0, endi = src.size(); i < endi; ++i)
+    {
+      const fastuidraw::vec2 &current(src[i]);
+      bool current_in;
+
+      current_in = keep_less ?
+        current[coordinate] <= value :
+        current[coordinate] >= value;
+
+      if(current_in != prev_in)
+        {
+          fastuidraw::vec2 p;
+          float t;
+
+          t = (value - prev[coordinate]) / (current[coordinate] - prev[coordinate]);
+          p = prev + t * (current - prev);
+          p[coordinate] = value;
+          dst.push_back(p);
+        }
+
+      if(current_in)
+        {
+          dst.push_back(current);
+        }
+
+      prev = current;
+      prev_in = current_in;
+    }
+}
+
+fastuidraw::vecN<SubPath*, 2>
+SubPath::
+split(void) const
+{
+  fastuidraw::vecN<SubPath*, 2> return_value;
+  fastuidraw::vec2 sz(m_bounds_max - m_bounds_min);
+  fastuidraw::vec2 min_max(m_bounds_max), max_min(m_bounds_min);
+  int coordinate;
+  float mid;
+
+  coordinate = (sz.x() >= sz.y()) ? 0 : 1;
+  mid = 0.5f * (m_bounds_min[coordinate] + m_bounds_max[coordinate]);
+  min_max[coordinate] = mid;
+  max_min[coordinate] = mid;
+
+  return_value[0] = FASTUIDRAWnew SubPath(m_bounds_min, min_max);
+  return_value[1] = FASTUIDRAWnew SubPath(max_min, m_bounds_max);
+
+  SubContour work_room;
+  for(unsigned int i = 0, endi = m_contours.size(); i < endi; ++i)
+    {
+      clip_contour(m_contours[i], coordinate, mid, true, work_room);
+      return_value[0]->add_contour(work_room);
+
+      clip_contour(m_contours[i], coordinate, mid, false, work_room);
+      return_value[1]->add_contour(work_room);
+    }
+
+  return return_value;
+}
+
+////////////////////////////////////////
+// tesser methods
+tesser::
+tesser(fastuidraw_GLUtesselator *tess,
+       std::vector<fastuidraw::vec2> &points):
+  m_tess(tess),
+  m_points(points)
+{
+  fastuidraw_gluTessCallbackBegin(m_tess, &begin_callBack);
+  fastuidraw_gluTessCallbackVertex(m_tess, &vertex_callBack);
+  fastuidraw_gluTessCallbackCombine(m_tess, &combine_callback);
+  fastuidraw_gluTessCallbackFillRule(m_tess, &winding_callBack);
+  fastuidraw_gluTessPropertyBoundaryOnly(m_tess, FASTUIDRAW_GLU_FALSE);
+}
+
+tesser::
+~tesser(void)
+{
+}
+
+
+void
+tesser::
+start(void)
+{
+  fastuidraw_gluTessBeginPolygon(m_tess, this);
+}
+
+void
+tesser::
+stop(void)
+{
+  fastuidraw_gluTessEndPolygon(m_tess);
+}
+
+void
+tesser::
+add_path(const SubPath &P)
+{
+  unsigned int v(0);
+  for(unsigned int o = 0, endo = P.contours().size(); o < endo; ++o)
+    {
+      const SubPath::SubContour &C(P.contours()[o]);
+
+      fastuidraw_gluTessBeginContour(m_tess);
+      for(unsigned int i = 0, endi = C.size(); i < endi; ++i, ++v)
+        {
+          fastuidraw_gluTessVertex(m_tess, m_points[v].x(), m_points[v].y(), v);
+        }
+      fastuidraw_gluTessEndContour(m_tess);
+    }
+}
+
+unsigned int
+tesser::
+add_point_to_store(float x, float y)
+{
+  unsigned int return_value(m_points.size());
+  m_points.push_back(fastuidraw::vec2(x, y));
+
+  //std::cout << "add point " << m_points.back() << "@"  << m_ids_of_added_points.back() << "\n";
+
+  return return_value;
+}
+
+void
+tesser::
+add_path_boundary(const SubPath &P)
+{
+  fastuidraw_gluTessBeginContour(m_tess);
+  for(unsigned int i = 0, v = P.total_points(); i < 4; ++i, ++v)
+    {
+      fastuidraw_gluTessVertex(m_tess, m_points[v].x(), m_points[v].y(), v);
+    }
+  fastuidraw_gluTessEndContour(m_tess);
+}
+
+
+void
+tesser::
+begin_callBack(FASTUIDRAW_GLUenum type, int winding_number, void *tess)
+{
+  tesser *p;
+  p = static_cast<tesser*>(tess);
+  assert(FASTUIDRAW_GLU_TRIANGLES == type);
+  FASTUIDRAWunused(type);
+
+  //std::cout << "begin_callBack(" << winding_number << ")\n";
+  p->m_temp_vert_count = 0;
+  p->on_begin_polygon(winding_number);
+}
+
+void
+tesser::
+vertex_callBack(unsigned int vertex_id, void *tess)
+{
+  tesser *p;
+  p = static_cast<tesser*>(tess);
+  // std::cout << "add vertex [" << *data << "] = " << p->m_points[*data] << "\n";
+
+  /* Cache added vertices in groups of 3 (triangles),
+     then if all vertices are NOT FASTUIDRAW_GLU_NULL_CLIENT_ID,
+     then add them.
+   */
+  p->m_temp_verts[p->m_temp_vert_count] = vertex_id;
+  p->m_temp_vert_count++;
+  if(p->m_temp_vert_count == 3)
+    {
+      p->m_temp_vert_count = 0;
+      /*
+        if vertex_id is FASTUIDRAW_GLU_NULL_CLIENT_ID, that means
+        the triangle is junked.
+      */
+      if(p->m_temp_verts[0] != FASTUIDRAW_GLU_NULL_CLIENT_ID
+         && p->m_temp_verts[1] != FASTUIDRAW_GLU_NULL_CLIENT_ID
+         && p->m_temp_verts[2] != FASTUIDRAW_GLU_NULL_CLIENT_ID)
+        {
+          p->add_vertex_to_polygon(p->m_temp_verts[0]);
+          p->add_vertex_to_polygon(p->m_temp_verts[1]);
+          p->add_vertex_to_polygon(p->m_temp_verts[2]);
+        }
+    }
+}
 
 
 void
@@ -452,12 +1095,14 @@ winding_callBack(int winding_number, void *tess)
 ///////////////////////////////////
 // non_zero_tesser methods
 non_zero_tesser::
-non_zero_tesser(std::vector<fastuidraw::vec2> &points,
-                const fastuidraw::TessellatedPath &P,
+non_zero_tesser(fastuidraw_GLUtesselator *tess,
+                std::vector<fastuidraw::vec2> &points,
+                const SubPath &P,
                 winding_index_hoard &hoard):
-  tesser(points),
+  tesser(tess, points),
   m_hoard(hoard),
-  m_current_winding(0)
+  m_current_winding(0),
+  m_current_indices(NULL)
 {
   start();
   add_path(P);
@@ -469,269 +1114,853 @@ non_zero_tesser::
 on_begin_polygon(int winding_number)
 {
   // std::cout << "nonzero_tesser::on_begin_polygon(" << winding_number << ")\n";
-  if(!m_current_indices || m_current_winding != winding_number)
+  if(m_current_indices == NULL || m_current_winding != winding_number)
     {
-      fastuidraw::reference_counted_ptr<per_winding_data> &h(m_hoard[winding_number]);
       m_current_winding = winding_number;
-      if(!h)
+      m_current_indices = &m_hoard[winding_number];
+    }
+}
+
+void
+non_zero_tesser::
+add_vertex_to_polygon(unsigned int vertex)
+{
+  // std::cout << "\tadd " << point(vertex) << "@" << vertex << "\n";
+  m_current_indices->add_index(vertex);
+}
+
+
+FASTUIDRAW_GLUboolean
+non_zero_tesser::
+fill_region(int winding_number)
+{
+  return winding_number != 0 ?
+    FASTUIDRAW_GLU_TRUE :
+    FASTUIDRAW_GLU_FALSE;
+}
+
+///////////////////////////////
+// zero_tesser methods
+zero_tesser::
+zero_tesser(fastuidraw_GLUtesselator *tess,
+            std::vector<fastuidraw::vec2> &points,
+            const SubPath &P,
+            winding_index_hoard &hoard):
+  tesser(tess, points),
+  m_indices(hoard[0])
+{
+  start();
+  add_path(P);
+  add_path_boundary(P);
+  stop();
+}
+
+void
+zero_tesser::
+on_begin_polygon(int winding_number)
+{
+  // std::cout << "zero_tesser::on_begin_polygon(" << winding_number << ")\n";
+  assert(winding_number == -1);
+  FASTUIDRAWunused(winding_number);
+}
+
+void
+zero_tesser::
+add_vertex_to_polygon(unsigned int vertex)
+{
+  // std::cout << "\tadd " << point(vertex) << "@" << vertex << "\n";
+  m_indices.add_index(vertex);
+}
+
+FASTUIDRAW_GLUboolean
+zero_tesser::
+fill_region(int winding_number)
+{
+  return winding_number == -1 ?
+    FASTUIDRAW_GLU_TRUE :
+    FASTUIDRAW_GLU_FALSE;
+}
+
+/////////////////////////////////////////
+// BuildScratchPool methods
+BuildScratchPool::
+~BuildScratchPool()
+{
+  for(unsigned int i = 0, endi = m_free.size(); i < endi; ++i)
+    {
+      FASTUIDRAWdelete(m_free[i]);
+    }
+}
+
+BuildScratch*
+BuildScratchPool::
+acquire(void)
+{
+  BuildScratch *return_value(NULL);
+
+  m_mutex.lock();
+  if(!m_free.empty())
+    {
+      return_value = m_free.back();
+      m_free.pop_back();
+    }
+  m_mutex.unlock();
+
+  if(return_value == NULL)
+    {
+      return_value = FASTUIDRAWnew BuildScratch();
+    }
+  return return_value;
+}
+
+void
+BuildScratchPool::
+release(BuildScratch *p)
+{
+  fastuidraw::autolock_mutex m(m_mutex);
+  m_free.push_back(p);
+}
+
+/////////////////////////////////////////
+// builder methods
+builder::
+builder(const SubPath &P, BuildScratch &scratch)
+{
+  init_points(P, scratch.m_points);
+  scratch.m_hoard.clear();
+
+  // std::cout << "Non-zero building\n";
+  non_zero_tesser::execute_path(scratch.m_tess, scratch.m_points, P, scratch.m_hoard);
+
+  // std::cout << "Zero building\n";
+  zero_tesser::execute_path(scratch.m_tess, scratch.m_points, P, scratch.m_hoard);
+}
+
+void
+builder::
+init_points(const SubPath &P, std::vector<fastuidraw::vec2> &points)
+{
+  points.clear();
+  for(unsigned int o = 0, endo = P.contours().size(); o < endo; ++o)
+    {
+      const SubPath::SubContour &C(P.contours()[o]);
+      points.insert(points.end(), C.begin(), C.end());
+    }
+
+  const fastuidraw::vec2 &pmin(P.bounds_min());
+  const fastuidraw::vec2 &pmax(P.bounds_max());
+
+  points.push_back(fastuidraw::vec2(pmin.x(), pmin.y()));
+  points.push_back(fastuidraw::vec2(pmin.x(), pmax.y()));
+  points.push_back(fastuidraw::vec2(pmax.x(), pmax.y()));
+  points.push_back(fastuidraw::vec2(pmax.x(), pmin.y()));
+}
+
+/////////////////////////////////
+// FillData methods
+FillData::
+FillData(const SubPath &P, BuildScratch &scratch)
+{
+  builder B(P, scratch);
+
+  /* copying from the scratch gives storage of exactly
+     the size needed.
+   */
+  m_points_store = scratch.m_points;
+  finalize(scratch.m_hoard);
+}
+
+FillData::
+FillData(std::vector<fastuidraw::vec2> &pts,
+         winding_index_hoard &hoard)
+{
+  /* copy/swap into fresh std::vector to free extra storage
+   */
+  std::vector<fastuidraw::vec2> temp(pts);
+  temp.swap(m_points_store);
+  finalize(hoard);
+}
+
+void
+FillData::
+finalize(winding_index_hoard &hoard)
+{
+  unsigned int even_non_zero_start, zero_start;
+
+  fill_indices(hoard, m_indices_store, m_per_fill, even_non_zero_start, zero_start);
+  if(m_indices_store.empty())
+    {
+      std::vector<fastuidraw::vec2> temp;
+      temp.swap(m_points_store);
+    }
+
+  m_points = fastuidraw::make_c_array(m_points_store);
+  m_indices = fastuidraw::make_c_array(m_indices_store);
+  set_winding_ranges(even_non_zero_start, zero_start);
+
+  m_winding_numbers_store.reserve(m_per_fill.size());
+  for(std::map<int, fastuidraw::const_c_array<unsigned int> >::iterator
+        iter = m_per_fill.begin(), end = m_per_fill.end();
+      iter != end; ++iter)
+    {
+      assert(!iter->second.empty());
+      m_winding_numbers_store.push_back(iter->first);
+    }
+  m_winding_numbers = fastuidraw::make_c_array(m_winding_numbers_store);
+
+  /*
+  std::cout << "NonZero range= " << range_type<unsigned int>(0, zero_start) << "\n"
+            << "Odd-Even range=" << range_type<unsigned int>(0, even_non_zero_start) << "\n"
+            << "Even range=" << range_type<unsigned int>(even_non_zero_start, indices_ptr.size()) << "\n"
+            << "Zero range=" << range_type<unsigned int>(zero_start, indices_ptr.size()) << "\n";
+  */
+}
+
+void
+FillData::
+set_winding_ranges(unsigned int even_non_zero_start,
+                   unsigned int zero_start)
+{
+  m_nonzero_winding = m_indices.sub_array(0, zero_start);
+  m_odd_winding = m_indices.sub_array(0, even_non_zero_start);
+  m_even_winding = m_indices.sub_array(even_non_zero_start);
+  m_zero_winding = m_indices.sub_array(zero_start);
+}
+
+void
+FillData::
+bake(fastuidraw::BakedDataWriter &dst) const
+{
+  std::vector<fastuidraw::range_type<unsigned int> > ranges;
+
+  /* the indices of each winding number are written
+     as a range into m_indices.
+   */
+  ranges.reserve(m_winding_numbers.size());
+  for(unsigned int i = 0, endi = m_winding_numbers.size(); i < endi; ++i)
+    {
+      fastuidraw::const_c_array<unsigned int> idx(indices(m_winding_numbers[i]));
+      unsigned int begin(idx.c_ptr() - m_indices.c_ptr());
+
+      ranges.push_back(fastuidraw::range_type<unsigned int>(begin, begin + idx.size()));
+    }
+
+  dst.write_array(m_points);
+  dst.write_array(m_indices);
+  dst.write_value(uint32_t(m_odd_winding.size()));
+  dst.write_value(uint32_t(m_nonzero_winding.size()));
+  dst.write_array(m_winding_numbers);
+  dst.write_array(fastuidraw::make_c_array(ranges));
+}
+
+FillData*
+FillData::
+load_baked(fastuidraw::BakedDataReader &src)
+{
+  FillData *return_value;
+  uint32_t even_non_zero_start, zero_start;
+  fastuidraw::const_c_array<fastuidraw::range_type<unsigned int> > ranges;
+  bool ok;
+
+  return_value = FASTUIDRAWnew FillData();
+  ok = src.read_array(return_value->m_points)
+    && src.read_array(return_value->m_indices)
+    && src.read_value(even_non_zero_start)
+    && src.read_value(zero_start)
+    && src.read_array(return_value->m_winding_numbers)
+    && src.read_array(ranges)
+    && even_non_zero_start <= zero_start
+    && zero_start <= return_value->m_indices.size()
+    && ranges.size() == return_value->m_winding_numbers.size();
+
+  for(unsigned int i = 0; ok && i < ranges.size(); ++i)
+    {
+      ok = ranges[i].m_begin < ranges[i].m_end
+        && ranges[i].m_end <= return_value->m_indices.size()
+        && (i == 0 || return_value->m_winding_numbers[i - 1] < return_value->m_winding_numbers[i]);
+      if(ok)
+        {
+          return_value->m_per_fill[return_value->m_winding_numbers[i]] =
+            return_value->m_indices.sub_array(ranges[i]);
+        }
+    }
+
+  for(unsigned int i = 0; ok && i < return_value->m_indices.size(); ++i)
+    {
+      ok = return_value->m_indices[i] < return_value->m_points.size();
+    }
+
+  if(!ok)
+    {
+      src.set_error();
+      FASTUIDRAWdelete(return_value);
+      return NULL;
+    }
+
+  return_value->set_winding_ranges(even_non_zero_start, zero_start);
+  return_value->m_baked_data = src.buffer();
+  return return_value;
+}
+
+///////////////////////////////////////////
+// FillDataAttributeFiller methods
+void
+FillDataAttributeFiller::
+compute_sizes(unsigned int &number_attributes,
+              unsigned int &number_indices,
+              unsigned int &number_attribute_chunks,
+              unsigned int &number_index_chunks,
+              unsigned int &number_z_increments) const
+{
+  using namespace fastuidraw;
+
+  number_z_increments = 0;
+  if(m_data.m_winding_numbers.empty())
+    {
+      number_attributes = 0;
+      number_indices = 0;
+      number_attribute_chunks = 0;
+      number_index_chunks = 0;
+      return;
+    }
+
+  number_attributes = m_data.m_points.size();
+  number_attribute_chunks = 1;
+
+  number_indices = m_data.m_odd_winding.size()
+    + m_data.m_nonzero_winding.size()
+    + m_data.m_even_winding.size()
+    + m_data.m_zero_winding.size();
+  for(const_c_array<int>::iterator iter = m_data.m_winding_numbers.begin(),
+        end = m_data.m_winding_numbers.end(); iter != end; ++iter)
+    {
+      if(*iter != 0) //winding number 0 is by complement_nonzero_fill_rule
+        {
+          number_indices += m_data.indices(*iter).size();
+        }
+    }
+
+  /* now get how big the index_chunks really needs to be
+   */
+  int smallest_winding(m_data.m_winding_numbers.front());
+  int largest_winding(m_data.m_winding_numbers.back());
+  unsigned int largest_winding_idx(PainterAttributeDataFillerPathFill::index_chunk_from_winding_number(largest_winding));
+  unsigned int smallest_winding_idx(PainterAttributeDataFillerPathFill::index_chunk_from_winding_number(smallest_winding));
+  number_index_chunks = 1 + std::max(largest_winding_idx, smallest_winding_idx);
+}
+
+void
+FillDataAttributeFiller::
+fill_data(fastuidraw::c_array<fastuidraw::PainterAttribute> attributes,
+          fastuidraw::c_array<fastuidraw::PainterIndex> index_data,
+          fastuidraw::c_array<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > attrib_chunks,
+          fastuidraw::c_array<fastuidraw::const_c_array<fastuidraw::PainterIndex> > index_chunks,
+          fastuidraw::c_array<unsigned int> zincrements) const
+{
+  using namespace fastuidraw;
+
+  if(m_data.m_winding_numbers.empty())
+    {
+      return;
+    }
+
+  assert(attributes.size() == m_data.m_points.size());
+  assert(attrib_chunks.size() == 1);
+  assert(zincrements.empty());
+  FASTUIDRAWunused(zincrements);
+
+  /* generate attribute data
+   */
+  std::transform(m_data.m_points.begin(), m_data.m_points.end(),
+                 attributes.begin(), generate_attribute);
+  attrib_chunks[0] = attributes;
+
+  unsigned int current(0);
+
+#define GRAB_MACRO(enum_name, member_name) do {                 \
+    c_array<PainterIndex> dst;                                  \
+    dst = index_data.sub_array(current, m_data.member_name.size()); \
+    std::copy(m_data.member_name.begin(),                       \
+              m_data.member_name.end(), dst.begin());           \
+    index_chunks[PainterEnums::enum_name] = dst;                \
+    current += dst.size();                                      \
+  } while(0)
+
+  GRAB_MACRO(odd_even_fill_rule, m_odd_winding);
+  GRAB_MACRO(nonzero_fill_rule, m_nonzero_winding);
+  GRAB_MACRO(complement_odd_even_fill_rule, m_even_winding);
+  GRAB_MACRO(complement_nonzero_fill_rule, m_zero_winding);
+
+#undef GRAB_MACRO
+
+  for(const_c_array<int>::iterator iter = m_data.m_winding_numbers.begin(),
+        end = m_data.m_winding_numbers.end(); iter != end; ++iter)
+    {
+      if(*iter != 0) //winding number 0 is by complement_nonzero_fill_rule
+        {
+          c_array<PainterIndex> dst;
+          const_c_array<unsigned int> src;
+          unsigned int idx;
+
+          idx = PainterAttributeDataFillerPathFill::index_chunk_from_winding_number(*iter);
+          src = m_data.indices(*iter);
+          dst = index_data.sub_array(current, src.size());
+          assert(dst.size() == src.size());
+
+          std::copy(src.begin(), src.end(), dst.begin());
+
+          index_chunks[idx] = dst;
+          current += dst.size();
+        }
+    }
+}
+
+/////////////////////////////////
+// SubsetPrivate methods
+SubsetPrivate::
+SubsetPrivate(SubPath *P, int max_recursion,
+              std::vector<SubsetPrivate*> &out_values):
+  m_ID(out_values.size()),
+  m_bounds_min(P->bounds_min()),
+  m_bounds_max(P->bounds_max()),
+  m_num_points(P->total_points()),
+  m_children(NULL, NULL),
+  m_sub_path(NULL),
+  m_data(NULL),
+  m_painter_data(NULL)
+{
+  out_values.push_back(this);
+  if(max_recursion > 0 && P->total_points() > max_points_per_leaf)
+    {
+      fastuidraw::vecN<SubPath*, 2> C(P->split());
+
+      FASTUIDRAWdelete(P);
+      m_children[0] = FASTUIDRAWnew SubsetPrivate(C[0], max_recursion - 1, out_values);
+      m_children[1] = FASTUIDRAWnew SubsetPrivate(C[1], max_recursion - 1, out_values);
+      m_num_points = m_children[0]->m_num_points + m_children[1]->m_num_points;
+    }
+  else
+    {
+      /* tessellation is delayed until the data is
+         needed so that leafs that are never visible
+         are never tessellated.
+       */
+      m_sub_path = P;
+    }
+}
+
+SubsetPrivate::
+SubsetPrivate(unsigned int ID,
+              const fastuidraw::vec2 &bounds_min,
+              const fastuidraw::vec2 &bounds_max,
+              unsigned int num_points):
+  m_ID(ID),
+  m_bounds_min(bounds_min),
+  m_bounds_max(bounds_max),
+  m_num_points(num_points),
+  m_children(NULL, NULL),
+  m_sub_path(NULL),
+  m_data(NULL),
+  m_painter_data(NULL)
+{}
+
+SubsetPrivate::
+~SubsetPrivate()
+{
+  if(m_sub_path != NULL)
+    {
+      FASTUIDRAWdelete(m_sub_path);
+    }
+
+  if(m_data != NULL)
+    {
+      FASTUIDRAWdelete(m_data);
+    }
+
+  if(m_painter_data != NULL)
+    {
+      FASTUIDRAWdelete(m_painter_data);
+    }
+
+  if(m_children[0] != NULL)
+    {
+      FASTUIDRAWdelete(m_children[0]);
+      FASTUIDRAWdelete(m_children[1]);
+    }
+}
+
+const FillData&
+SubsetPrivate::
+data(void)
+{
+  fastuidraw::autolock_mutex m(m_data_mutex);
+  if(m_data == NULL)
+    {
+      if(is_leaf())
+        {
+          BuildScratch *scratch;
+
+          scratch = build_scratch_pool().acquire();
+          m_data = FASTUIDRAWnew FillData(*m_sub_path, *scratch);
+          build_scratch_pool().release(scratch);
+          FASTUIDRAWdelete(m_sub_path);
+          m_sub_path = NULL;
+        }
+      else
         {
-          h = FASTUIDRAWnew per_winding_data();
+          merge_data_from_children();
         }
-      m_current_indices = h;
     }
+  return *m_data;
 }
 
 void
-non_zero_tesser::
-add_vertex_to_polygon(unsigned int vertex)
+SubsetPrivate::
+merge_data_from_children(void)
 {
-  // std::cout << "\tadd " << point(vertex) << "@" << vertex << "\n";
-  m_current_indices->add_index(vertex);
-}
+  std::vector<fastuidraw::vec2> pts;
+  winding_index_hoard hoard;
 
+  assert(m_children[0] != NULL);
+  assert(m_data == NULL);
+  for(unsigned int c = 0; c < 2; ++c)
+    {
+      const FillData &src(m_children[c]->data());
+      unsigned int offset(pts.size());
 
-FASTUIDRAW_GLUboolean
-non_zero_tesser::
-fill_region(int winding_number)
-{
-  return winding_number != 0 ?
-    FASTUIDRAW_GLU_TRUE :
-    FASTUIDRAW_GLU_FALSE;
+      pts.insert(pts.end(), src.m_points.begin(), src.m_points.end());
+      for(fastuidraw::const_c_array<int>::iterator iter = src.m_winding_numbers.begin(),
+            end = src.m_winding_numbers.end(); iter != end; ++iter)
+        {
+          per_winding_data &h(hoard[*iter]);
+          fastuidraw::const_c_array<unsigned int> src_indices(src.indices(*iter));
+
+          for(unsigned int i = 0, endi = src_indices.size(); i < endi; ++i)
+            {
+              h.add_index(src_indices[i] + offset);
+            }
+        }
+    }
+  m_data = FASTUIDRAWnew FillData(pts, hoard);
 }
 
-///////////////////////////////
-// zero_tesser methods
-zero_tesser::
-zero_tesser(std::vector<fastuidraw::vec2> &points,
-            const fastuidraw::TessellatedPath &P,
-            winding_index_hoard &hoard):
-  tesser(points),
-  m_indices(hoard[0])
+const fastuidraw::PainterAttributeData&
+SubsetPrivate::
+painter_data(void)
 {
-  if(!m_indices)
+  /* Painful note: the reference count is initialized as 0.
+     If a handle is made at ctor, the reference count is made
+     to be 1, and then when the handle goes out of scope
+     it is zero, triggering delete. In particular making a
+     handle at ctor time is very bad. This is one of the reasons
+     why it must be made lazily and not at ctor.
+   */
+  fastuidraw::autolock_mutex m(m_painter_data_mutex);
+  if(m_painter_data == NULL)
     {
-      m_indices = FASTUIDRAWnew per_winding_data();
+      m_painter_data = FASTUIDRAWnew fastuidraw::PainterAttributeData();
+      m_painter_data->set_data(FillDataAttributeFiller(data(), m_bounds_min, m_bounds_max));
     }
-
-  start();
-  add_path(P);
-  add_path_boundary(P);
-  stop();
+  return *m_painter_data;
 }
 
 void
-zero_tesser::
-on_begin_polygon(int winding_number)
+SubsetPrivate::
+bake(fastuidraw::BakedDataWriter &dst)
 {
-  // std::cout << "zero_tesser::on_begin_polygon(" << winding_number << ")\n";
-  assert(winding_number == -1);
-  FASTUIDRAWunused(winding_number);
-}
+  uint32_t has_data;
 
-void
-zero_tesser::
-add_vertex_to_polygon(unsigned int vertex)
-{
-  // std::cout << "\tadd " << point(vertex) << "@" << vertex << "\n";
-  m_indices->add_index(vertex);
-}
+  /* the data of a leaf is always written so that a loaded
+     SubsetPrivate never needs its SubPath; the data of a
+     non-leaf is only written if it was made, otherwise it
+     is merged from the children on demand after loading.
+   */
+  if(is_leaf())
+    {
+      data();
+    }
 
-FASTUIDRAW_GLUboolean
-zero_tesser::
-fill_region(int winding_number)
-{
-  return winding_number == -1 ?
-    FASTUIDRAW_GLU_TRUE :
-    FASTUIDRAW_GLU_FALSE;
+  {
+    fastuidraw::autolock_mutex m(m_data_mutex);
+    has_data = (m_data != NULL) ? 1u : 0u;
+  }
+
+  dst.write_value(m_bounds_min);
+  dst.write_value(m_bounds_max);
+  dst.write_value(uint32_t(m_num_points));
+  dst.write_value(fastuidraw::uvec2(is_leaf() ? 0u : m_children[0]->m_ID,
+                                    is_leaf() ? 0u : m_children[1]->m_ID));
+  dst.write_value(has_data);
+  if(has_data)
+    {
+      m_data->bake(dst);
+      painter_data().bake(dst);
+    }
 }
 
-/////////////////////////////////////////
-// builder methods
-builder::
-builder(const fastuidraw::TessellatedPath &P, std::vector<fastuidraw::vec2> &points):
-  m_points(points)
+SubsetPrivate*
+SubsetPrivate::
+load_baked(fastuidraw::BakedDataReader &src, unsigned int ID,
+           fastuidraw::uvec2 &child_ids)
 {
-  init_points(P);
+  fastuidraw::vec2 bounds_min, bounds_max;
+  uint32_t num_points, has_data;
+  SubsetPrivate *return_value;
+
+  if(!src.read_value(bounds_min)
+     || !src.read_value(bounds_max)
+     || !src.read_value(num_points)
+     || !src.read_value(child_ids)
+     || !src.read_value(has_data))
+    {
+      return NULL;
+    }
 
-  // std::cout << "Non-zero building\n";
-  non_zero_tesser::execute_path(m_points, P, m_hoard);
+  if(!has_data && child_ids[0] == 0 && child_ids[1] == 0)
+    {
+      src.set_error();
+      return NULL;
+    }
 
-  // std::cout << "Zero building\n";
-  zero_tesser::execute_path(m_points, P, m_hoard);
+  return_value = FASTUIDRAWnew SubsetPrivate(ID, bounds_min, bounds_max, num_points);
+  if(has_data)
+    {
+      return_value->m_data = FillData::load_baked(src);
+      return_value->m_painter_data = FASTUIDRAWnew fastuidraw::PainterAttributeData();
+      if(return_value->m_data == NULL
+         || !return_value->m_painter_data->load_baked(src))
+        {
+          FASTUIDRAWdelete(return_value);
+          return NULL;
+        }
+    }
+  return return_value;
 }
 
-builder::
-~builder()
+bool
+SubsetPrivate::
+bounding_box_culled(fastuidraw::const_c_array<fastuidraw::vec3> clip_equations,
+                    bool &unclipped) const
 {
+  fastuidraw::vecN<fastuidraw::vec3, 4> pts;
+
+  pts[0] = fastuidraw::vec3(m_bounds_min.x(), m_bounds_min.y(), 1.0f);
+  pts[1] = fastuidraw::vec3(m_bounds_min.x(), m_bounds_max.y(), 1.0f);
+  pts[2] = fastuidraw::vec3(m_bounds_max.x(), m_bounds_max.y(), 1.0f);
+  pts[3] = fastuidraw::vec3(m_bounds_max.x(), m_bounds_min.y(), 1.0f);
+
+  unclipped = true;
+  for(unsigned int i = 0; i < clip_equations.size(); ++i)
+    {
+      unsigned int num_inside(0);
+      for(unsigned int k = 0; k < 4; ++k)
+        {
+          if(fastuidraw::dot(pts[k], clip_equations[i]) >= 0.0f)
+            {
+              ++num_inside;
+            }
+        }
+
+      if(num_inside == 0)
+        {
+          return true;
+        }
+      unclipped = unclipped && (num_inside == 4);
+    }
+  return false;
 }
 
 void
-builder::
-init_points(const fastuidraw::TessellatedPath &P)
+SubsetPrivate::
+select_subsets(fastuidraw::const_c_array<fastuidraw::vec3> clip_equations,
+               fastuidraw::c_array<unsigned int> dst,
+               unsigned int &current)
 {
-  m_points.resize(P.point_data().size() + 4);
-  for(unsigned int i = 0, endi = P.point_data().size(); i < endi; ++i)
+  bool unclipped;
+
+  if(bounding_box_culled(clip_equations, unclipped))
     {
-      m_points[i] = P.point_data()[i].m_p;
+      return;
     }
 
-  fastuidraw::vec2 pmin, pmax, pdelta;
-  float tiny(1e-6);
-
-  pmin = P.bounding_box_min();
-  pmax = P.bounding_box_max();
-  pdelta = (pmax - pmin) * tiny;
-
-  pmin -= pdelta;
-  pmax += pdelta;
-
-  m_points[P.point_data().size() + 0] = fastuidraw::vec2(pmin.x(), pmin.y());
-  m_points[P.point_data().size() + 1] = fastuidraw::vec2(pmin.x(), pmax.y());
-  m_points[P.point_data().size() + 2] = fastuidraw::vec2(pmax.x(), pmax.y());
-  m_points[P.point_data().size() + 3] = fastuidraw::vec2(pmax.x(), pmin.y());
+  if(is_leaf() || (unclipped && m_num_points <= max_points_to_merge))
+    {
+      assert(current < dst.size());
+      dst[current] = m_ID;
+      ++current;
+    }
+  else
+    {
+      m_children[0]->select_subsets(clip_equations, dst, current);
+      m_children[1]->select_subsets(clip_equations, dst, current);
+    }
 }
 
+/////////////////////////////////
+// FilledPathPrivate methods
+FilledPathPrivate::
+FilledPathPrivate(const fastuidraw::TessellatedPath &P)
+{
+  SubPath *sub_path;
 
+  sub_path = FASTUIDRAWnew SubPath(P);
+  m_root = FASTUIDRAWnew SubsetPrivate(sub_path, SubsetPrivate::max_recursion_depth,
+                                      m_subsets);
+}
 
-void
-builder::
-fill_indices(std::vector<unsigned int> &indices,
-             std::map<int, fastuidraw::const_c_array<unsigned int> > &winding_map,
-             unsigned int &even_non_zero_start,
-             unsigned int &zero_start)
+FilledPathPrivate::
+~FilledPathPrivate()
 {
-  winding_index_hoard::iterator iter, end;
-  unsigned int total(0), num_odd(0), num_even_non_zero(0), num_zero(0);
-
-  /* compute number indices needed */
-  for(iter = m_hoard.begin(), end = m_hoard.end(); iter != end; ++iter)
+  if(m_root != NULL)
     {
-      unsigned int cnt;
+      FASTUIDRAWdelete(m_root);
+    }
+}
 
-      cnt = iter->second->count();
-      total += cnt;
+bool
+FilledPathPrivate::
+load_baked(fastuidraw::BakedDataReader &src)
+{
+  uint32_t number_subsets;
+  std::vector<fastuidraw::uvec2> child_ids;
+  std::vector<unsigned int> parent_count;
+  bool ok;
 
-      // std::cout << "Winding=" << iter->first << " has " << cnt << " indices\n";
+  ok = src.read_value(number_subsets)
+    && number_subsets > 0
+    && number_subsets <= src.remaining();
 
-      if(iter->first == 0)
-        {
-          num_zero += cnt;
-        }
-      else if (is_even(iter->first))
-        {
-          num_even_non_zero += cnt;
-        }
-      else
+  for(unsigned int i = 0; ok && i < number_subsets; ++i)
+    {
+      SubsetPrivate *S;
+      fastuidraw::uvec2 ids;
+
+      S = SubsetPrivate::load_baked(src, i, ids);
+      if(S != NULL)
         {
-          num_odd += cnt;
+          m_subsets.push_back(S);
+          child_ids.push_back(ids);
         }
+      ok = (S != NULL);
     }
 
-  /* pack as follows:
-      - odd
-      - even non-zero
-      - zero
+  /* the subsets are ordered depth first, so a child always
+     comes after its parent; each subset other than the root
+     must be the child of exactly one subset.
    */
-  unsigned int current_odd(0), current_even_non_zero(num_odd);
-  unsigned int current_zero(num_even_non_zero + num_odd);
-
-  indices.resize(total);
-  for(iter = m_hoard.begin(), end = m_hoard.end(); iter != end; ++iter)
+  parent_count.resize(m_subsets.size(), 0);
+  for(unsigned int i = 0; ok && i < m_subsets.size(); ++i)
     {
-      if(iter->first == 0)
+      const fastuidraw::uvec2 &ids(child_ids[i]);
+      if(ids[0] != 0 || ids[1] != 0)
         {
-          if(iter->second->count() > 0)
+          ok = ids[0] > i && ids[1] > i
+            && ids[0] < m_subsets.size() && ids[1] < m_subsets.size()
+            && ids[0] != ids[1];
+          if(ok)
             {
-              iter->second->fill_at(current_zero,
-                                    fastuidraw::make_c_array(indices),
-                                    winding_map[iter->first]);
+              ++parent_count[ids[0]];
+              ++parent_count[ids[1]];
             }
         }
-      else if(is_even(iter->first))
+    }
+
+  for(unsigned int i = 0; ok && i < m_subsets.size(); ++i)
+    {
+      ok = parent_count[i] == ((i == 0) ? 0u : 1u);
+    }
+
+  if(!ok)
+    {
+      for(unsigned int i = 0; i < m_subsets.size(); ++i)
         {
-          if(iter->second->count() > 0)
-            {
-              iter->second->fill_at(current_even_non_zero,
-                                    fastuidraw::make_c_array(indices),
-                                    winding_map[iter->first]);
-            }
+          FASTUIDRAWdelete(m_subsets[i]);
         }
-      else
+      m_subsets.clear();
+      src.set_error();
+      return false;
+    }
+
+  for(unsigned int i = 0; i < m_subsets.size(); ++i)
+    {
+      const fastuidraw::uvec2 &ids(child_ids[i]);
+      if(ids[0] != 0)
         {
-          if(iter->second->count() > 0)
-            {
-              iter->second->fill_at(current_odd,
-                                    fastuidraw::make_c_array(indices),
-                                    winding_map[iter->first]);
-            }
+          m_subsets[i]->set_children(m_subsets[ids[0]], m_subsets[ids[1]]);
         }
     }
+  m_root = m_subsets[0];
+  return true;
+}
 
-  assert(current_zero == total);
-  assert(current_odd == num_odd);
-  assert(current_even_non_zero == current_odd + num_even_non_zero);
-
-  even_non_zero_start = num_odd;
-  zero_start = current_odd + num_even_non_zero;
+///////////////////////////////////////
+// fastuidraw::FilledPath::Subset methods
+fastuidraw::FilledPath::Subset::
+Subset(void *d):
+  m_d(d)
+{}
 
+fastuidraw::const_c_array<fastuidraw::vec2>
+fastuidraw::FilledPath::Subset::
+points(void) const
+{
+  SubsetPrivate *d;
+  d = reinterpret_cast<SubsetPrivate*>(m_d);
+  return d->data().m_points;
 }
 
-/////////////////////////////////
-// FilledPathPrivate methods
-FilledPathPrivate::
-FilledPathPrivate(const fastuidraw::TessellatedPath &P):
-  m_attribute_data(NULL)
+fastuidraw::const_c_array<int>
+fastuidraw::FilledPath::Subset::
+winding_numbers(void) const
 {
-  builder B(P, m_points);
-  unsigned int even_non_zero_start, zero_start;
-
-  B.fill_indices(m_indices, m_per_fill, even_non_zero_start, zero_start);
-
-  /* copy/swap into fresh std::vector to free extra storage
-   */
-  if(m_indices.empty())
-    {
-      std::vector<fastuidraw::vec2> temp;
-      temp.swap(m_points);
-    }
-  else
-    {
-      std::vector<fastuidraw::vec2> temp(m_points);
-      temp.swap(m_points);
-    }
+  SubsetPrivate *d;
+  d = reinterpret_cast<SubsetPrivate*>(m_d);
+  return d->data().m_winding_numbers;
+}
 
+fastuidraw::const_c_array<unsigned int>
+fastuidraw::FilledPath::Subset::
+indices(int winding_number) const
+{
+  SubsetPrivate *d;
+  d = reinterpret_cast<SubsetPrivate*>(m_d);
+  return d->data().indices(winding_number);
+}
 
-  fastuidraw::const_c_array<unsigned int> indices_ptr;
-  indices_ptr = fastuidraw::make_c_array(m_indices);
-  m_nonzero_winding = indices_ptr.sub_array(0, zero_start);
-  m_odd_winding = indices_ptr.sub_array(0, even_non_zero_start);
-  m_even_winding = indices_ptr.sub_array(even_non_zero_start);
-  m_zero_winding = indices_ptr.sub_array(zero_start);
+const fastuidraw::PainterAttributeData&
+fastuidraw::FilledPath::Subset::
+painter_data(void) const
+{
+  SubsetPrivate *d;
+  d = reinterpret_cast<SubsetPrivate*>(m_d);
+  return d->painter_data();
+}
 
-  m_winding_numbers.reserve(m_per_fill.size());
-  for(std::map<int, fastuidraw::const_c_array<unsigned int> >::iterator
-        iter = m_per_fill.begin(), end = m_per_fill.end();
-      iter != end; ++iter)
-    {
-      assert(!iter->second.empty());
-      m_winding_numbers.push_back(iter->first);
-    }
+fastuidraw::vec2
+fastuidraw::FilledPath::Subset::
+bounding_box_min(void) const
+{
+  SubsetPrivate *d;
+  d = reinterpret_cast<SubsetPrivate*>(m_d);
+  return d->bounds_min();
+}
 
-  /*
-  std::cout << "NonZero range= " << range_type<unsigned int>(0, zero_start) << "\n"
-            << "Odd-Even range=" << range_type<unsigned int>(0, even_non_zero_start) << "\n"
-            << "Even range=" << range_type<unsigned int>(even_non_zero_start, indices_ptr.size()) << "\n"
-            << "Zero range=" << range_type<unsigned int>(zero_start, indices_ptr.size()) << "\n";
-  */
+fastuidraw::vec2
+fastuidraw::FilledPath::Subset::
+bounding_box_max(void) const
+{
+  SubsetPrivate *d;
+  d = reinterpret_cast<SubsetPrivate*>(m_d);
+  return d->bounds_max();
 }
 
-FilledPathPrivate::
-~FilledPathPrivate()
+bool
+fastuidraw::FilledPath::Subset::
+is_leaf(void) const
 {
-  if(m_attribute_data != NULL)
-    {
-      FASTUIDRAWdelete(m_attribute_data);
-    }
+  SubsetPrivate *d;
+  d = reinterpret_cast<SubsetPrivate*>(m_d);
+  return d->is_leaf();
 }
 
 ///////////////////////////////////////
@@ -742,6 +1971,12 @@ FilledPath(const TessellatedPath &P)
   m_d = FASTUIDRAWnew FilledPathPrivate(P);
 }
 
+fastuidraw::FilledPath::
+FilledPath(void)
+{
+  m_d = FASTUIDRAWnew FilledPathPrivate();
+}
+
 fastuidraw::FilledPath::
 ~FilledPath()
 {
@@ -757,13 +1992,7 @@ indices(int winding_number) const
 {
   FilledPathPrivate *d;
   d = reinterpret_cast<FilledPathPrivate*>(m_d);
-
-  std::map<int, const_c_array<unsigned int> >::const_iterator iter;
-
-  iter = d->m_per_fill.find(winding_number);
-  return (iter != d->m_per_fill.end()) ?
-    iter->second:
-    const_c_array<unsigned int>();
+  return d->m_root->data().indices(winding_number);
 }
 
 const fastuidraw::PainterAttributeData&
@@ -772,20 +2001,7 @@ painter_data(void) const
 {
   FilledPathPrivate *d;
   d = reinterpret_cast<FilledPathPrivate*>(m_d);
-
-  /* Painful note: the reference count is initialized as 0.
-     If a handle is made at ctor, the reference count is made
-     to be 1, and then when the handle goes out of scope
-     it is zero, triggering delete. In particular making a
-     handle at ctor time is very bad. This is one of the reasons
-     why it must be made lazily and not at ctor.
-   */
-  if(d->m_attribute_data == NULL)
-    {
-      d->m_attribute_data = FASTUIDRAWnew PainterAttributeData();
-      d->m_attribute_data->set_data(PainterAttributeDataFillerPathFill(this));
-    }
-  return *d->m_attribute_data;
+  return d->m_root->painter_data();
 }
 
 fastuidraw::const_c_array<fastuidraw::vec2>
@@ -794,7 +2010,7 @@ points(void) const
 {
   FilledPathPrivate *d;
   d = reinterpret_cast<FilledPathPrivate*>(m_d);
-  return make_c_array(d->m_points);
+  return d->m_root->data().m_points;
 }
 
 fastuidraw::const_c_array<int>
@@ -803,7 +2019,7 @@ winding_numbers(void) const
 {
   FilledPathPrivate *d;
   d = reinterpret_cast<FilledPathPrivate*>(m_d);
-  return make_c_array(d->m_winding_numbers);
+  return d->m_root->data().m_winding_numbers;
 }
 
 fastuidraw::const_c_array<unsigned int>
@@ -812,7 +2028,7 @@ nonzero_winding_indices(void) const
 {
   FilledPathPrivate *d;
   d = reinterpret_cast<FilledPathPrivate*>(m_d);
-  return d->m_nonzero_winding;
+  return d->m_root->data().m_nonzero_winding;
 }
 
 fastuidraw::const_c_array<unsigned int>
@@ -821,7 +2037,7 @@ odd_winding_indices(void) const
 {
   FilledPathPrivate *d;
   d = reinterpret_cast<FilledPathPrivate*>(m_d);
-  return d->m_odd_winding;
+  return d->m_root->data().m_odd_winding;
 }
 
 fastuidraw::const_c_array<unsigned int>
@@ -830,7 +2046,7 @@ zero_winding_indices(void) const
 {
   FilledPathPrivate *d;
   d = reinterpret_cast<FilledPathPrivate*>(m_d);
-  return d->m_zero_winding;
+  return d->m_root->data().m_zero_winding;
 }
 
 fastuidraw::const_c_array<unsigned int>
@@ -839,5 +2055,93 @@ even_winding_indices(void) const
 {
   FilledPathPrivate *d;
   d = reinterpret_cast<FilledPathPrivate*>(m_d);
-  return d->m_even_winding;
+  return d->m_root->data().m_even_winding;
+}
+
+unsigned int
+fastuidraw::FilledPath::
+number_subsets(void) const
+{
+  FilledPathPrivate *d;
+  d = reinterpret_cast<FilledPathPrivate*>(m_d);
+  return d->m_subsets.size();
+}
+
+fastuidraw::FilledPath::Subset
+fastuidraw::FilledPath::
+subset(unsigned int I) const
+{
+  FilledPathPrivate *d;
+  d = reinterpret_cast<FilledPathPrivate*>(m_d);
+  assert(I < d->m_subsets.size());
+  return Subset(d->m_subsets[I]);
+}
+
+unsigned int
+fastuidraw::FilledPath::
+select_subsets(const_c_array<vec3> clip_equations,
+               const float3x3 &clip_matrix_local,
+               c_array<unsigned int> dst) const
+{
+  FilledPathPrivate *d;
+  unsigned int return_value(0);
+  vecN<vec3, 4> local_equations;
+  std::vector<vec3> local_equations_overflow;
+  c_array<vec3> local;
+
+  d = reinterpret_cast<FilledPathPrivate*>(m_d);
+  assert(dst.size() >= d->m_subsets.size());
+
+  /* transform the clip equations into local coordinates;
+     the work room is local because several threads may
+     select subsets of the same FilledPath at once.
+   */
+  if(clip_equations.size() <= local_equations.size())
+    {
+      local = c_array<vec3>(local_equations.c_ptr(), clip_equations.size());
+    }
+  else
+    {
+      local_equations_overflow.resize(clip_equations.size());
+      local = make_c_array(local_equations_overflow);
+    }
+
+  for(unsigned int i = 0; i < clip_equations.size(); ++i)
+    {
+      local[i] = clip_equations[i] * clip_matrix_local;
+    }
+
+  d->m_root->select_subsets(local, dst, return_value);
+  return return_value;
+}
+
+void
+fastuidraw::FilledPath::
+bake(BakedDataWriter &dst) const
+{
+  FilledPathPrivate *d;
+  d = reinterpret_cast<FilledPathPrivate*>(m_d);
+
+  dst.write_value(uint32_t(d->m_subsets.size()));
+  for(unsigned int i = 0, endi = d->m_subsets.size(); i < endi; ++i)
+    {
+      d->m_subsets[i]->bake(dst);
+    }
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::FilledPath>
+fastuidraw::FilledPath::
+load_baked(BakedDataReader &src)
+{
+  FilledPath *return_value;
+  FilledPathPrivate *d;
+
+  return_value = FASTUIDRAWnew FilledPath();
+  d = reinterpret_cast<FilledPathPrivate*>(return_value->m_d);
+  if(!d->load_baked(src))
+    {
+      FASTUIDRAWdelete(return_value);
+      return reference_counted_ptr<const FilledPath>();
+    }
+  return return_value;
 }
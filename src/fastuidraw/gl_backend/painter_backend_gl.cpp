@@ -1415,7 +1415,16 @@ PainterBackendGL(const ConfigurationGL &config_gl,
                      PainterBackendGLPrivate::compute_glsl_config(config_gl),
                      PainterBackendGLPrivate::compute_base_config(config_gl, config_base))
 {
-  m_d = FASTUIDRAWnew PainterBackendGLPrivate(config_gl, this);
+  PainterBackendGLPrivate *d;
+
+  d = FASTUIDRAWnew PainterBackendGLPrivate(config_gl, this);
+  m_d = d;
+
+  /* configure_backend() may have lowered the sizes */
+  set_hints()
+    .attributes_per_draw(d->m_params.attributes_per_buffer())
+    .indices_per_draw(d->m_params.indices_per_buffer())
+    .data_blocks_per_draw(d->m_params.data_blocks_per_store_buffer());
 }
 
 fastuidraw::gl::PainterBackendGL::
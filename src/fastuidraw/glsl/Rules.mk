@@ -13,7 +13,8 @@ include $(dir)/Rules.mk
 
 LIBRARY_SOURCES += $(call filelist, shader_source.cpp shader_code.cpp \
 	painter_item_shader_glsl.cpp painter_blend_shader_glsl.cpp \
-	painter_backend_glsl.cpp)
+	painter_backend_glsl.cpp painter_backend_null.cpp \
+	painter_backend_recorder.cpp)
 
 
 # Begin standard footer
@@ -0,0 +1,630 @@
+/*!
+ * \file painter_backend_null.cpp
+ * \brief file painter_backend_null.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <vector>
+#include <algorithm>
+
+#include <fastuidraw/glsl/painter_backend_null.hpp>
+#include <fastuidraw/image.hpp>
+#include <fastuidraw/colorstop_atlas.hpp>
+#include <fastuidraw/text/glyph_atlas.hpp>
+#include "../private/util_private.hpp"
+
+namespace
+{
+  /* CPU memory behind a backing store whose texels
+     are addressed by (x, y, layer), i.e. the
+     analogue of a GL_TEXTURE_2D_ARRAY.
+   */
+  template<typename T>
+  class cpu_texel_store
+  {
+  public:
+    explicit
+    cpu_texel_store(fastuidraw::ivec3 dims):
+      m_dims(dims),
+      m_texels(dims.x() * dims.y() * dims.z())
+    {}
+
+    void
+    set_data(int x, int y, int l, int w, int h,
+             fastuidraw::const_c_array<T> data)
+    {
+      assert(data.size() == static_cast<unsigned int>(w * h));
+      assert(x >= 0 && x + w <= m_dims.x());
+      assert(y >= 0 && y + h <= m_dims.y());
+      assert(l >= 0 && l < m_dims.z());
+
+      for(int j = 0; j < h; ++j)
+        {
+          unsigned int src, dst;
+
+          src = j * w;
+          dst = x + (y + j) * m_dims.x() + l * m_dims.x() * m_dims.y();
+          std::copy(data.c_ptr() + src, data.c_ptr() + src + w, m_texels.begin() + dst);
+        }
+    }
+
+    void
+    resize(int new_num_layers)
+    {
+      m_dims.z() = new_num_layers;
+      m_texels.resize(m_dims.x() * m_dims.y() * m_dims.z());
+    }
+
+  private:
+    fastuidraw::ivec3 m_dims;
+    std::vector<T> m_texels;
+  };
+
+  class ColorBackingStoreNull:public fastuidraw::AtlasColorBackingStoreBase
+  {
+  public:
+    ColorBackingStoreNull(int tile_size, int num_tiles_per_row_per_col, int num_layers):
+      fastuidraw::AtlasColorBackingStoreBase(tile_size * num_tiles_per_row_per_col,
+                                             tile_size * num_tiles_per_row_per_col,
+                                             num_layers, true),
+      m_store(dimensions())
+    {}
+
+    virtual
+    void
+    set_data(int x, int y, int l, int w, int h,
+             fastuidraw::const_c_array<fastuidraw::u8vec4> data)
+    {
+      m_store.set_data(x, y, l, w, h, data);
+    }
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(int new_num_layers)
+    {
+      m_store.resize(new_num_layers);
+    }
+
+  private:
+    cpu_texel_store<fastuidraw::u8vec4> m_store;
+  };
+
+  /* the index store holds, for each texel, the
+     tile location as passed to set_data() instead
+     of the texel values a shader would read.
+   */
+  class IndexBackingStoreNull:public fastuidraw::AtlasIndexBackingStoreBase
+  {
+  public:
+    IndexBackingStoreNull(int tile_size, int num_tiles_per_row_per_col, int num_layers):
+      fastuidraw::AtlasIndexBackingStoreBase(tile_size * num_tiles_per_row_per_col,
+                                             tile_size * num_tiles_per_row_per_col,
+                                             num_layers, true),
+      m_store(dimensions())
+    {}
+
+    virtual
+    void
+    set_data(int x, int y, int l, int w, int h,
+             fastuidraw::const_c_array<fastuidraw::ivec3> data,
+             int slack,
+             const fastuidraw::AtlasColorBackingStoreBase *C,
+             int color_tile_size)
+    {
+      FASTUIDRAWunused(slack);
+      FASTUIDRAWunused(C);
+      FASTUIDRAWunused(color_tile_size);
+      m_store.set_data(x, y, l, w, h, data);
+    }
+
+    virtual
+    void
+    set_data(int x, int y, int l, int w, int h,
+             fastuidraw::const_c_array<fastuidraw::ivec3> data)
+    {
+      m_store.set_data(x, y, l, w, h, data);
+    }
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(int new_num_layers)
+    {
+      m_store.resize(new_num_layers);
+    }
+
+  private:
+    cpu_texel_store<fastuidraw::ivec3> m_store;
+  };
+
+  class GlyphTexelBackingStoreNull:public fastuidraw::GlyphAtlasTexelBackingStoreBase
+  {
+  public:
+    explicit
+    GlyphTexelBackingStoreNull(fastuidraw::ivec3 dims):
+      fastuidraw::GlyphAtlasTexelBackingStoreBase(dims, true),
+      m_store(dimensions())
+    {}
+
+    virtual
+    void
+    set_data(int x, int y, int l, int w, int h,
+             fastuidraw::const_c_array<uint8_t> data)
+    {
+      m_store.set_data(x, y, l, w, h, data);
+    }
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(int new_num_layers)
+    {
+      m_store.resize(new_num_layers);
+    }
+
+  private:
+    cpu_texel_store<uint8_t> m_store;
+  };
+
+  class GlyphGeometryBackingStoreNull:public fastuidraw::GlyphAtlasGeometryBackingStoreBase
+  {
+  public:
+    GlyphGeometryBackingStoreNull(unsigned int alignment, unsigned int number_blocks):
+      fastuidraw::GlyphAtlasGeometryBackingStoreBase(alignment, number_blocks, true),
+      m_store(alignment * number_blocks)
+    {}
+
+    virtual
+    void
+    set_values(unsigned int location,
+               fastuidraw::const_c_array<fastuidraw::generic_data> pdata)
+    {
+      assert(pdata.size() % alignment() == 0);
+      assert((location + pdata.size() / alignment()) * alignment() <= m_store.size());
+      std::copy(pdata.begin(), pdata.end(), m_store.begin() + location * alignment());
+    }
+
+    virtual
+    void
+    flush(void)
+    {}
+
+  protected:
+    virtual
+    void
+    resize_implement(unsigned int new_size)
+    {
+      m_store.resize(new_size * alignment());
+    }
+
+  private:
+    std::vector<fastuidraw::generic_data> m_store;
+  };
+
+  class ColorStopBackingStoreNull:public fastuidraw::ColorStopBackingStore
+  {
+  public:
+    ColorStopBackingStoreNull(int width, int num_layers):
+      fastuidraw::ColorStopBackingStore(width, num_layers, true),
+      m_store(width * num_layers)
+    {}
+
+    virtual
+    void
+    set_data(int x, int l, int w,
+             fastuidraw::const_c_array<fastuidraw::u8vec4> data)
+    {
+      FASTUIDRAWunused(w);
+      assert(data.size() == static_cast<unsigned int>(w));
+      assert(x >= 0 && x + w <= dimensions().x());
+      std::copy(data.begin(), data.end(), m_store.begin() + x + l * dimensions().x());
+    }
+
+  protected:
+    virtual
+    void
+    resize_implement(int new_num_layers)
+    {
+      m_store.resize(dimensions().x() * new_num_layers);
+    }
+
+  private:
+    std::vector<fastuidraw::u8vec4> m_store;
+  };
+
+  /* CPU buffers of a PainterDraw; the buffers are
+     kept by a draw_buffer_pool so that they are
+     allocated only once.
+   */
+  class draw_buffers
+  {
+  public:
+    draw_buffers(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &params,
+                 int alignment):
+      m_attributes(params.attributes_per_buffer()),
+      m_header_attributes(params.attributes_per_buffer()),
+      m_indices(params.indices_per_buffer()),
+      m_store(params.data_blocks_per_store_buffer() * alignment)
+    {}
+
+    std::vector<fastuidraw::PainterAttribute> m_attributes;
+    std::vector<uint32_t> m_header_attributes;
+    std::vector<fastuidraw::PainterIndex> m_indices;
+    std::vector<fastuidraw::generic_data> m_store;
+  };
+
+  class draw_buffer_pool:
+    public fastuidraw::reference_counted<draw_buffer_pool>::default_base
+  {
+  public:
+    draw_buffer_pool(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &params,
+                     int alignment):
+      m_params(params),
+      m_alignment(alignment)
+    {}
+
+    ~draw_buffer_pool()
+    {
+      assert(m_free.size() == m_all.size());
+      for(std::vector<draw_buffers*>::iterator iter = m_all.begin(),
+            end = m_all.end(); iter != end; ++iter)
+        {
+          FASTUIDRAWdelete(*iter);
+        }
+    }
+
+    draw_buffers*
+    acquire(void)
+    {
+      draw_buffers *return_value;
+      if(m_free.empty())
+        {
+          return_value = FASTUIDRAWnew draw_buffers(m_params, m_alignment);
+          m_all.push_back(return_value);
+        }
+      else
+        {
+          return_value = m_free.back();
+          m_free.pop_back();
+        }
+      return return_value;
+    }
+
+    void
+    release(draw_buffers *p)
+    {
+      m_free.push_back(p);
+    }
+
+  private:
+    fastuidraw::glsl::PainterBackendNull::ConfigurationNull m_params;
+    int m_alignment;
+    std::vector<draw_buffers*> m_all, m_free;
+  };
+
+  class ConfigurationNullPrivate
+  {
+  public:
+    ConfigurationNullPrivate(void):
+      m_attributes_per_buffer(512 * 512),
+      m_indices_per_buffer((m_attributes_per_buffer * 6) / 4),
+      m_data_blocks_per_store_buffer(1024 * 64)
+    {}
+
+    unsigned int m_attributes_per_buffer;
+    unsigned int m_indices_per_buffer;
+    unsigned int m_data_blocks_per_store_buffer;
+  };
+
+  class PainterBackendNullPrivate
+  {
+  public:
+    PainterBackendNullPrivate(const fastuidraw::glsl::PainterBackendNull::ConfigurationNull &P,
+                              int alignment):
+      m_params(P)
+    {
+      m_pool = FASTUIDRAWnew draw_buffer_pool(m_params, alignment);
+    }
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>
+    create_glyph_atlas(void);
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas>
+    create_image_atlas(void);
+
+    static
+    fastuidraw::reference_counted_ptr<fastuidraw::ColorStopAtlas>
+    create_colorstop_atlas(void);
+
+    fastuidraw::glsl::PainterBackendNull::ConfigurationNull m_params;
+    fastuidraw::reference_counted_ptr<draw_buffer_pool> m_pool;
+  };
+}
+
+namespace fastuidraw
+{
+  namespace glsl
+  {
+    class PainterBackendNullDraw:public PainterDraw
+    {
+    public:
+      PainterBackendNullDraw(PainterBackendNull *backend,
+                             const reference_counted_ptr<draw_buffer_pool> &pool):
+        m_backend(backend),
+        m_pool(pool),
+        m_buffers(pool->acquire()),
+        m_attributes_written(0),
+        m_indices_written(0),
+        m_data_store_written(0)
+      {
+        m_attributes = make_c_array(m_buffers->m_attributes);
+        m_header_attributes = make_c_array(m_buffers->m_header_attributes);
+        m_indices = make_c_array(m_buffers->m_indices);
+        m_store = make_c_array(m_buffers->m_store);
+      }
+
+      ~PainterBackendNullDraw()
+      {
+        m_pool->release(m_buffers);
+      }
+
+      virtual
+      void
+      draw_break(const PainterShaderGroup &old_groups,
+                 const PainterShaderGroup &new_groups,
+                 unsigned int attributes_written,
+                 unsigned int indices_written) const
+      {
+        m_backend->on_draw_break(*this, old_groups, new_groups,
+                                 attributes_written, indices_written);
+      }
+
+      virtual
+      void
+      draw(void) const
+      {
+        m_backend->on_draw(*this, m_attributes_written,
+                           m_indices_written, m_data_store_written);
+      }
+
+    protected:
+      virtual
+      void
+      unmap_implement(unsigned int attributes_written,
+                      unsigned int indices_written,
+                      unsigned int data_store_written) const
+      {
+        m_attributes_written = attributes_written;
+        m_indices_written = indices_written;
+        m_data_store_written = data_store_written;
+      }
+
+    private:
+      PainterBackendNull *m_backend;
+      reference_counted_ptr<draw_buffer_pool> m_pool;
+      draw_buffers *m_buffers;
+      mutable unsigned int m_attributes_written;
+      mutable unsigned int m_indices_written;
+      mutable unsigned int m_data_store_written;
+    };
+  }
+}
+
+////////////////////////////////////////////
+// PainterBackendNullPrivate methods
+fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>
+PainterBackendNullPrivate::
+create_glyph_atlas(void)
+{
+  using namespace fastuidraw;
+  reference_counted_ptr<GlyphAtlasTexelBackingStoreBase> texels;
+  reference_counted_ptr<GlyphAtlasGeometryBackingStoreBase> geometry;
+
+  texels = FASTUIDRAWnew GlyphTexelBackingStoreNull(ivec3(1024, 1024, 4));
+  geometry = FASTUIDRAWnew GlyphGeometryBackingStoreNull(4, 256 * 1024);
+  return FASTUIDRAWnew GlyphAtlas(texels, geometry);
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas>
+PainterBackendNullPrivate::
+create_image_atlas(void)
+{
+  using namespace fastuidraw;
+  reference_counted_ptr<AtlasColorBackingStoreBase> color;
+  reference_counted_ptr<AtlasIndexBackingStoreBase> index;
+  int color_tile_size(32), index_tile_size(4);
+
+  color = FASTUIDRAWnew ColorBackingStoreNull(color_tile_size, 64, 1);
+  index = FASTUIDRAWnew IndexBackingStoreNull(index_tile_size, 64, 4);
+  return FASTUIDRAWnew ImageAtlas(color_tile_size, index_tile_size, color, index);
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::ColorStopAtlas>
+PainterBackendNullPrivate::
+create_colorstop_atlas(void)
+{
+  using namespace fastuidraw;
+  reference_counted_ptr<ColorStopBackingStore> store;
+
+  store = FASTUIDRAWnew ColorStopBackingStoreNull(1024, 32);
+  return FASTUIDRAWnew ColorStopAtlas(store);
+}
+
+///////////////////////////////////////////////
+// fastuidraw::glsl::PainterBackendNull::ConfigurationNull methods
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull::
+ConfigurationNull(void)
+{
+  m_d = FASTUIDRAWnew ConfigurationNullPrivate();
+}
+
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull::
+ConfigurationNull(const ConfigurationNull &obj)
+{
+  ConfigurationNullPrivate *d;
+  d = reinterpret_cast<ConfigurationNullPrivate*>(obj.m_d);
+  m_d = FASTUIDRAWnew ConfigurationNullPrivate(*d);
+}
+
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull::
+~ConfigurationNull()
+{
+  ConfigurationNullPrivate *d;
+  d = reinterpret_cast<ConfigurationNullPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull&
+fastuidraw::glsl::PainterBackendNull::ConfigurationNull::
+operator=(const ConfigurationNull &rhs)
+{
+  if(this != &rhs)
+    {
+      ConfigurationNullPrivate *d, *rhs_d;
+      d = reinterpret_cast<ConfigurationNullPrivate*>(m_d);
+      rhs_d = reinterpret_cast<ConfigurationNullPrivate*>(rhs.m_d);
+      *d = *rhs_d;
+    }
+  return *this;
+}
+
+#define setget_implement(type, name)                                    \
+  fastuidraw::glsl::PainterBackendNull::ConfigurationNull&              \
+  fastuidraw::glsl::PainterBackendNull::ConfigurationNull::             \
+  name(type v)                                                          \
+  {                                                                     \
+    ConfigurationNullPrivate *d;                                        \
+    d = reinterpret_cast<ConfigurationNullPrivate*>(m_d);               \
+    d->m_##name = v;                                                    \
+    return *this;                                                       \
+  }                                                                     \
+                                                                        \
+  type                                                                  \
+  fastuidraw::glsl::PainterBackendNull::ConfigurationNull::             \
+  name(void) const                                                      \
+  {                                                                     \
+    ConfigurationNullPrivate *d;                                        \
+    d = reinterpret_cast<ConfigurationNullPrivate*>(m_d);               \
+    return d->m_##name;                                                 \
+  }
+
+setget_implement(unsigned int, attributes_per_buffer)
+setget_implement(unsigned int, indices_per_buffer)
+setget_implement(unsigned int, data_blocks_per_store_buffer)
+
+#undef setget_implement
+
+///////////////////////////////////////////////
+// fastuidraw::glsl::PainterBackendNull methods
+fastuidraw::glsl::PainterBackendNull::
+PainterBackendNull(const ConfigurationNull &config_null,
+                   const ConfigurationGLSL &config_glsl,
+                   const ConfigurationBase &config_base):
+  PainterBackendGLSL(PainterBackendNullPrivate::create_glyph_atlas(),
+                     PainterBackendNullPrivate::create_image_atlas(),
+                     PainterBackendNullPrivate::create_colorstop_atlas(),
+                     config_glsl, config_base)
+{
+  m_d = FASTUIDRAWnew PainterBackendNullPrivate(config_null, config_base.alignment());
+  set_hints()
+    .attributes_per_draw(config_null.attributes_per_buffer())
+    .indices_per_draw(config_null.indices_per_buffer())
+    .data_blocks_per_draw(config_null.data_blocks_per_store_buffer());
+}
+
+fastuidraw::glsl::PainterBackendNull::
+~PainterBackendNull()
+{
+  PainterBackendNullPrivate *d;
+  d = reinterpret_cast<PainterBackendNullPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+const fastuidraw::glsl::PainterBackendNull::ConfigurationNull&
+fastuidraw::glsl::PainterBackendNull::
+configuration_null(void) const
+{
+  PainterBackendNullPrivate *d;
+  d = reinterpret_cast<PainterBackendNullPrivate*>(m_d);
+  return d->m_params;
+}
+
+void
+fastuidraw::glsl::PainterBackendNull::
+on_pre_draw(void)
+{}
+
+void
+fastuidraw::glsl::PainterBackendNull::
+on_post_draw(void)
+{}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw>
+fastuidraw::glsl::PainterBackendNull::
+map_draw(void)
+{
+  PainterBackendNullPrivate *d;
+  d = reinterpret_cast<PainterBackendNullPrivate*>(m_d);
+  return FASTUIDRAWnew PainterBackendNullDraw(this, d->m_pool);
+}
+
+void
+fastuidraw::glsl::PainterBackendNull::
+on_draw_break(const PainterDraw &draw,
+              const PainterShaderGroup &old_groups,
+              const PainterShaderGroup &new_groups,
+              unsigned int attributes_written,
+              unsigned int indices_written)
+{
+  FASTUIDRAWunused(draw);
+  FASTUIDRAWunused(old_groups);
+  FASTUIDRAWunused(new_groups);
+  FASTUIDRAWunused(attributes_written);
+  FASTUIDRAWunused(indices_written);
+}
+
+void
+fastuidraw::glsl::PainterBackendNull::
+on_draw(const PainterDraw &draw,
+        unsigned int attributes_written,
+        unsigned int indices_written,
+        unsigned int data_store_written)
+{
+  FASTUIDRAWunused(draw);
+  FASTUIDRAWunused(attributes_written);
+  FASTUIDRAWunused(indices_written);
+  FASTUIDRAWunused(data_store_written);
+}
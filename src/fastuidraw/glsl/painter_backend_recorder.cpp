@@ -0,0 +1,251 @@
+/*!
+ * \file painter_backend_recorder.cpp
+ * \brief file painter_backend_recorder.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <map>
+#include <vector>
+
+#include <fastuidraw/glsl/painter_backend_recorder.hpp>
+#include <fastuidraw/painter/painter_header.hpp>
+#include "../private/util_private.hpp"
+
+namespace
+{
+  /* FNV-1a of the bytes of an array */
+  template<typename T>
+  uint32_t
+  hash_array(fastuidraw::const_c_array<T> values)
+  {
+    const uint8_t *bytes;
+    unsigned int num_bytes;
+    uint32_t return_value(2166136261u);
+
+    bytes = reinterpret_cast<const uint8_t*>(values.c_ptr());
+    num_bytes = values.size() * sizeof(T);
+    for(unsigned int i = 0; i < num_bytes; ++i)
+      {
+        return_value ^= bytes[i];
+        return_value *= 16777619u;
+      }
+    return return_value;
+  }
+
+  class PainterBackendRecorderPrivate
+  {
+  public:
+    explicit
+    PainterBackendRecorderPrivate(bool record_data):
+      m_record_data(record_data)
+    {
+      m_writer = FASTUIDRAWnew fastuidraw::BakedDataWriter();
+    }
+
+    ~PainterBackendRecorderPrivate()
+    {
+      FASTUIDRAWdelete(m_writer);
+    }
+
+    typedef fastuidraw::glsl::PainterBackendRecorder::draw_break_t draw_break_t;
+    typedef fastuidraw::glsl::PainterBackendRecorder::header_t header_t;
+
+    bool m_record_data;
+    fastuidraw::BakedDataWriter *m_writer;
+
+    /* draw breaks of each PainterDraw not yet drawn */
+    std::map<const fastuidraw::PainterDraw*, std::vector<draw_break_t> > m_draw_breaks;
+
+    /* work room for on_draw() */
+    std::vector<header_t> m_headers;
+    std::vector<fastuidraw::generic_data> m_header_values;
+  };
+}
+
+///////////////////////////////////////////////
+// fastuidraw::glsl::PainterBackendRecorder methods
+fastuidraw::glsl::PainterBackendRecorder::
+PainterBackendRecorder(bool record_data,
+                       const ConfigurationNull &config_null,
+                       const ConfigurationGLSL &config_glsl,
+                       const ConfigurationBase &config_base):
+  PainterBackendNull(config_null, config_glsl, config_base)
+{
+  m_d = FASTUIDRAWnew PainterBackendRecorderPrivate(record_data);
+}
+
+fastuidraw::glsl::PainterBackendRecorder::
+~PainterBackendRecorder()
+{
+  PainterBackendRecorderPrivate *d;
+  d = reinterpret_cast<PainterBackendRecorderPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+bool
+fastuidraw::glsl::PainterBackendRecorder::
+record_data(void) const
+{
+  PainterBackendRecorderPrivate *d;
+  d = reinterpret_cast<PainterBackendRecorderPrivate*>(m_d);
+  return d->m_record_data;
+}
+
+fastuidraw::const_c_array<uint8_t>
+fastuidraw::glsl::PainterBackendRecorder::
+trace(void) const
+{
+  PainterBackendRecorderPrivate *d;
+  d = reinterpret_cast<PainterBackendRecorderPrivate*>(m_d);
+  return d->m_writer->data();
+}
+
+bool
+fastuidraw::glsl::PainterBackendRecorder::
+save_trace(const char *filename) const
+{
+  PainterBackendRecorderPrivate *d;
+  d = reinterpret_cast<PainterBackendRecorderPrivate*>(m_d);
+  return d->m_writer->save(filename);
+}
+
+void
+fastuidraw::glsl::PainterBackendRecorder::
+clear_trace(void)
+{
+  PainterBackendRecorderPrivate *d;
+  d = reinterpret_cast<PainterBackendRecorderPrivate*>(m_d);
+  FASTUIDRAWdelete(d->m_writer);
+  d->m_writer = FASTUIDRAWnew BakedDataWriter();
+}
+
+void
+fastuidraw::glsl::PainterBackendRecorder::
+on_pre_draw(void)
+{
+  PainterBackendRecorderPrivate *d;
+  d = reinterpret_cast<PainterBackendRecorderPrivate*>(m_d);
+  d->m_writer->write_value(uint32_t(trace_pre_draw));
+}
+
+void
+fastuidraw::glsl::PainterBackendRecorder::
+on_post_draw(void)
+{
+  PainterBackendRecorderPrivate *d;
+  d = reinterpret_cast<PainterBackendRecorderPrivate*>(m_d);
+  d->m_writer->write_value(uint32_t(trace_post_draw));
+}
+
+void
+fastuidraw::glsl::PainterBackendRecorder::
+on_draw_break(const PainterDraw &draw,
+              const PainterShaderGroup &old_groups,
+              const PainterShaderGroup &new_groups,
+              unsigned int attributes_written,
+              unsigned int indices_written)
+{
+  PainterBackendRecorderPrivate *d;
+  draw_break_t v;
+
+  d = reinterpret_cast<PainterBackendRecorderPrivate*>(m_d);
+  FASTUIDRAWunused(old_groups);
+  v.m_attributes_written = attributes_written;
+  v.m_indices_written = indices_written;
+  v.m_item_group = new_groups.item_group();
+  v.m_blend_group = new_groups.blend_group();
+  v.m_brush = new_groups.brush();
+  v.m_packed_blend_mode = new_groups.packed_blend_mode();
+  d->m_draw_breaks[&draw].push_back(v);
+}
+
+void
+fastuidraw::glsl::PainterBackendRecorder::
+on_draw(const PainterDraw &draw,
+        unsigned int attributes_written,
+        unsigned int indices_written,
+        unsigned int data_store_written)
+{
+  PainterBackendRecorderPrivate *d;
+  const_c_array<PainterAttribute> attributes;
+  const_c_array<uint32_t> header_attributes;
+  const_c_array<PainterIndex> indices;
+  const_c_array<generic_data> store;
+  std::map<const PainterDraw*, std::vector<draw_break_t> >::iterator breaks;
+  unsigned int alignment;
+
+  d = reinterpret_cast<PainterBackendRecorderPrivate*>(m_d);
+  alignment = configuration_base().alignment();
+  attributes = draw.m_attributes.sub_array(0, attributes_written);
+  header_attributes = draw.m_header_attributes.sub_array(0, attributes_written);
+  indices = draw.m_indices.sub_array(0, indices_written);
+  store = draw.m_store.sub_array(0, data_store_written);
+
+  d->m_headers.clear();
+  d->m_header_values.clear();
+  for(unsigned int i = 0; i < attributes_written; ++i)
+    {
+      if(d->m_headers.empty() || d->m_headers.back().m_location != header_attributes[i])
+        {
+          header_t h;
+          const_c_array<generic_data> values;
+
+          h.m_first_attribute = i;
+          h.m_number_attributes = 0;
+          h.m_location = header_attributes[i];
+          d->m_headers.push_back(h);
+
+          values = store.sub_array(h.m_location * alignment, PainterHeader::header_size);
+          d->m_header_values.insert(d->m_header_values.end(), values.begin(), values.end());
+        }
+      ++d->m_headers.back().m_number_attributes;
+    }
+
+  d->m_writer->write_value(uint32_t(trace_draw));
+  d->m_writer->write_value(uint32_t(attributes_written));
+  d->m_writer->write_value(uint32_t(indices_written));
+  d->m_writer->write_value(uint32_t(data_store_written));
+
+  breaks = d->m_draw_breaks.find(&draw);
+  if(breaks != d->m_draw_breaks.end())
+    {
+      d->m_writer->write_array(make_c_array(breaks->second));
+      d->m_draw_breaks.erase(breaks);
+    }
+  else
+    {
+      d->m_writer->write_array(const_c_array<draw_break_t>());
+    }
+
+  d->m_writer->write_array(make_c_array(d->m_headers));
+  d->m_writer->write_array(make_c_array(d->m_header_values));
+
+  if(d->m_record_data)
+    {
+      d->m_writer->write_array(attributes);
+      d->m_writer->write_array(header_attributes);
+      d->m_writer->write_array(indices);
+      d->m_writer->write_array(store);
+    }
+  else
+    {
+      d->m_writer->write_value(hash_array(attributes));
+      d->m_writer->write_value(hash_array(header_attributes));
+      d->m_writer->write_value(hash_array(indices));
+      d->m_writer->write_value(hash_array(store));
+    }
+}
@@ -322,6 +322,10 @@ create_glyph_shader(bool anisotropic)
         .shader(curve_pair_glyph,
                 create_glyph_item_shader("fastuidraw_painter_glyph_curve_pair.vert.glsl.resource_string",
                                          "fastuidraw_painter_glyph_curve_pair_anisotropic.frag.glsl.resource_string",
+                                         varyings))
+        .shader(msdf_glyph,
+                create_glyph_item_shader("fastuidraw_painter_glyph_msdf.vert.glsl.resource_string",
+                                         "fastuidraw_painter_glyph_msdf_anisotropic.frag.glsl.resource_string",
                                          varyings));
     }
   else
@@ -334,6 +338,10 @@ create_glyph_shader(bool anisotropic)
         .shader(curve_pair_glyph,
                 create_glyph_item_shader("fastuidraw_painter_glyph_curve_pair.vert.glsl.resource_string",
                                          "fastuidraw_painter_glyph_curve_pair.frag.glsl.resource_string",
+                                         varyings))
+        .shader(msdf_glyph,
+                create_glyph_item_shader("fastuidraw_painter_glyph_msdf.vert.glsl.resource_string",
+                                         "fastuidraw_painter_glyph_msdf.frag.glsl.resource_string",
                                          varyings));
     }
 
@@ -375,10 +383,16 @@ create_stroke_shader(enum PainterEnums::cap_style stroke_style,
   using namespace fastuidraw::PainterEnums;
 
   PainterStrokeShader return_value;
+  reference_counted_ptr<const StrokingDataSelectorBase> se;
+
+  se = (stroke_style == number_cap_styles) ?
+    PainterStrokeParams::stroking_data_selector(pixel_width_stroking) :
+    PainterDashedStrokeParams::stroking_data_selector(pixel_width_stroking);
   return_value
     .aa_shader_pass1(create_stroke_item_shader(stroke_style, pixel_width_stroking, uber_stroke_opaque_pass))
     .aa_shader_pass2(create_stroke_item_shader(stroke_style, pixel_width_stroking, uber_stroke_aa_pass))
-    .non_aa_shader(create_stroke_item_shader(stroke_style, pixel_width_stroking, uber_stroke_non_aa));
+    .non_aa_shader(create_stroke_item_shader(stroke_style, pixel_width_stroking, uber_stroke_non_aa))
+    .stroking_data_selector(se);
   return return_value;
 }
 
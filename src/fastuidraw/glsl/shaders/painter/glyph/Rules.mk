@@ -12,6 +12,9 @@ LIBRARY_RESOURCE_STRING += $(call filelist, fastuidraw_painter_glyph_coverage.ve
 	fastuidraw_painter_glyph_curve_pair.vert.glsl.resource_string \
 	fastuidraw_painter_glyph_curve_pair.frag.glsl.resource_string \
 	fastuidraw_painter_glyph_curve_pair_anisotropic.frag.glsl.resource_string \
+	fastuidraw_painter_glyph_msdf.vert.glsl.resource_string \
+	fastuidraw_painter_glyph_msdf.frag.glsl.resource_string \
+	fastuidraw_painter_glyph_msdf_anisotropic.frag.glsl.resource_string \
 	)
 
 # Begin standard footer
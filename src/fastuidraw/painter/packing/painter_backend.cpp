@@ -25,10 +25,16 @@ namespace
   {
   public:
     PerformanceHintsPrivate(void):
-      m_clipping_via_hw_clip_planes(true)
+      m_clipping_via_hw_clip_planes(true),
+      m_attributes_per_draw(0),
+      m_indices_per_draw(0),
+      m_data_blocks_per_draw(0)
     {}
 
     bool m_clipping_via_hw_clip_planes;
+    unsigned int m_attributes_per_draw;
+    unsigned int m_indices_per_draw;
+    unsigned int m_data_blocks_per_draw;
   };
 
   class PainterBackendPrivate
@@ -105,6 +111,63 @@ clipping_via_hw_clip_planes(bool v)
   return *this;
 }
 
+unsigned int
+fastuidraw::PainterBackend::PerformanceHints::
+attributes_per_draw(void) const
+{
+  PerformanceHintsPrivate *d;
+  d = static_cast<PerformanceHintsPrivate*>(m_d);
+  return d->m_attributes_per_draw;
+}
+
+fastuidraw::PainterBackend::PerformanceHints&
+fastuidraw::PainterBackend::PerformanceHints::
+attributes_per_draw(unsigned int v)
+{
+  PerformanceHintsPrivate *d;
+  d = static_cast<PerformanceHintsPrivate*>(m_d);
+  d->m_attributes_per_draw = v;
+  return *this;
+}
+
+unsigned int
+fastuidraw::PainterBackend::PerformanceHints::
+indices_per_draw(void) const
+{
+  PerformanceHintsPrivate *d;
+  d = static_cast<PerformanceHintsPrivate*>(m_d);
+  return d->m_indices_per_draw;
+}
+
+fastuidraw::PainterBackend::PerformanceHints&
+fastuidraw::PainterBackend::PerformanceHints::
+indices_per_draw(unsigned int v)
+{
+  PerformanceHintsPrivate *d;
+  d = static_cast<PerformanceHintsPrivate*>(m_d);
+  d->m_indices_per_draw = v;
+  return *this;
+}
+
+unsigned int
+fastuidraw::PainterBackend::PerformanceHints::
+data_blocks_per_draw(void) const
+{
+  PerformanceHintsPrivate *d;
+  d = static_cast<PerformanceHintsPrivate*>(m_d);
+  return d->m_data_blocks_per_draw;
+}
+
+fastuidraw::PainterBackend::PerformanceHints&
+fastuidraw::PainterBackend::PerformanceHints::
+data_blocks_per_draw(unsigned int v)
+{
+  PerformanceHintsPrivate *d;
+  d = static_cast<PerformanceHintsPrivate*>(m_d);
+  d->m_data_blocks_per_draw = v;
+  return *this;
+}
+
 ///////////////////////////////////////////////////
 // fastuidraw::PainterBackend::ConfigurationBase methods
 fastuidraw::PainterBackend::ConfigurationBase::
@@ -20,10 +20,16 @@
 
 #include <vector>
 #include <list>
+#include <map>
 #include <cstring>
+#include <iostream>
+#include <boost/atomic.hpp>
+#include <boost/thread.hpp>
 
 #include <fastuidraw/painter/packing/painter_packer.hpp>
 #include <fastuidraw/painter/painter_header.hpp>
+#include <fastuidraw/painter/painter_item_matrix.hpp>
+#include <fastuidraw/painter/painter_clip_equations.hpp>
 #include "../../private/util_private.hpp"
 
 namespace
@@ -63,6 +69,11 @@ namespace
     PainterShaderGroupPrivate(void)
     {}
 
+    explicit
+    PainterShaderGroupPrivate(const PainterShaderGroupValues &obj):
+      PainterShaderGroupValues(obj)
+    {}
+
     PainterShaderGroupPrivate(const PainterShaderGroupPrivate &obj):
       PainterShaderGroupValues(obj)
     {}
@@ -74,10 +85,16 @@ namespace
     }
   };
 
-  /* QUESTION
-      - does the reference count to a pool need to be thread safe?
+  /* A PoolBase holds pool_size slots. The free slots form
+     a lock-free stack (Treiber stack) so that slots can be
+     aquired and released from any thread: m_free_head holds
+     in its low 32-bits one plus the slot at the top of the
+     stack (0 for an empty stack) and in its high 32-bits a
+     tag incremented on each change to avoid ABA problems.
+     The link of a free slot to the free slot below it is in
+     m_next_free.
    */
-  class PoolBase:public fastuidraw::reference_counted<PoolBase>::non_concurrent
+  class PoolBase:public fastuidraw::reference_counted<PoolBase>::default_base
   {
   public:
     enum
@@ -85,69 +102,82 @@ namespace
         pool_size = 1024
       };
 
-    PoolBase(void):
-      m_free_slots_back(pool_size - 1)
+    PoolBase(void)
     {
       for(unsigned int i = 0; i < pool_size; ++i)
         {
-          m_free_slots[i] = pool_size - 1 - i;
+          m_next_free[i].store(i, boost::memory_order_relaxed);
         }
+      m_free_head.store(pool_size, boost::memory_order_release);
     }
 
     ~PoolBase()
     {
-      assert(m_free_slots_back == pool_size - 1);
+      #ifndef NDEBUG
+        {
+          uint64_t top;
+          unsigned int count(0);
+
+          top = m_free_head.load(boost::memory_order_acquire) & 0xFFFFFFFFu;
+          for(; top != 0; top = m_next_free[top - 1].load(boost::memory_order_relaxed))
+            {
+              ++count;
+            }
+          assert(count == pool_size);
+        }
+      #endif
     }
 
     int
     aquire_slot(void)
     {
-      /* Should we make this thread safe? We can make it
-         thread safe by using atomic operation on m_free_slots_back.
-         The following code would make it thread safe.
-
-         return_value = m_free_slots_back.fetch_sub(1, boost::memory_order_aquire)
-         if(return_value < 0)
-           {
-              m_free_slots_back.fetch_add(1, boost::memory_order_aquire);
-           }
-         return return_value;
-       */
-      int return_value(-1);
+      uint64_t head, new_head, top;
 
-      if(m_free_slots_back >= 0)
+      head = m_free_head.load(boost::memory_order_acquire);
+      do
         {
-          return_value = m_free_slots[m_free_slots_back];
-          --m_free_slots_back;
+          top = head & 0xFFFFFFFFu;
+          if(top == 0)
+            {
+              return -1;
+            }
+          new_head = next_tag(head) | m_next_free[top - 1].load(boost::memory_order_relaxed);
         }
-      return return_value;
+      while(!m_free_head.compare_exchange_weak(head, new_head,
+                                               boost::memory_order_acquire,
+                                               boost::memory_order_acquire));
+      return static_cast<int>(top - 1);
     }
 
     void
     release_slot(int v)
     {
-      /* Should we make this thread safe? We can make it
-         thread safe by using atomic operation on m_free_slots_back.
-         The following code would make it thread safe.
+      uint64_t head, new_head;
 
-         int S;
-         S = m_free_slots_back.fetch_add(1, boost::memory_order_release);
-         boost::atomic_thread_fence(boost::memory_order_acquire);
-         assert(S < pool_size);
-         m_free_slots[S] = v;
-       */
       assert(v >= 0);
       assert(v < pool_size);
 
-      ++m_free_slots_back;
-
-      assert(m_free_slots_back < pool_size);
-      m_free_slots[m_free_slots_back] = v;
+      head = m_free_head.load(boost::memory_order_relaxed);
+      do
+        {
+          m_next_free[v].store(head & 0xFFFFFFFFu, boost::memory_order_relaxed);
+          new_head = next_tag(head) | static_cast<uint64_t>(v + 1);
+        }
+      while(!m_free_head.compare_exchange_weak(head, new_head,
+                                               boost::memory_order_release,
+                                               boost::memory_order_relaxed));
     }
 
   private:
-    int m_free_slots_back;
-    fastuidraw::vecN<int, pool_size> m_free_slots;
+    static
+    uint64_t
+    next_tag(uint64_t head)
+    {
+      return ((head >> 32u) + 1u) << 32u;
+    }
+
+    boost::atomic<uint64_t> m_free_head;
+    boost::atomic<uint32_t> m_next_free[pool_size];
   };
 
   class EntryBase
@@ -156,7 +186,9 @@ namespace
 
     EntryBase(void):
       m_raw_value(NULL),
-      m_pool_slot(-1)
+      m_pool_slot(-1),
+      m_concurrent(false),
+      m_count(0)
     {}
 
     void
@@ -164,19 +196,51 @@ namespace
     {
       assert(m_pool);
       assert(m_pool_slot >= 0);
-      m_count.add_reference();
+      if(m_concurrent)
+        {
+          m_count.fetch_add(1, boost::memory_order_relaxed);
+        }
+      else
+        {
+          m_count.store(m_count.load(boost::memory_order_relaxed) + 1, boost::memory_order_relaxed);
+        }
     }
 
     void
     release(void)
     {
+      bool last_reference;
+
       assert(m_pool);
       assert(m_pool_slot >= 0);
-      if(m_count.remove_reference())
+      if(m_concurrent)
         {
-          m_pool->release_slot(m_pool_slot);
+          last_reference = (m_count.fetch_sub(1, boost::memory_order_release) == 1);
+          if(last_reference)
+            {
+              boost::atomic_thread_fence(boost::memory_order_acquire);
+            }
+        }
+      else
+        {
+          int v;
+          v = m_count.load(boost::memory_order_relaxed) - 1;
+          m_count.store(v, boost::memory_order_relaxed);
+          last_reference = (v == 0);
+        }
+
+      if(last_reference)
+        {
+          /* clear the fields before the slot is released
+             since another thread may take the slot as soon
+             as it is released.
+           */
+          fastuidraw::reference_counted_ptr<PoolBase> pool(m_pool);
+          int slot(m_pool_slot);
+
           m_pool_slot = -1;
           m_pool = NULL;
+          pool->release_slot(slot);
         }
     }
 
@@ -209,11 +273,15 @@ namespace
     fastuidraw::reference_counted_ptr<PoolBase> m_pool;
     int m_pool_slot;
 
+    /* if true, m_count is modified with atomic
+       operations, otherwise just loaded and
+       stored (as the PainterPackedValuePool that
+       made the entry is not concurrent)
+     */
+    bool m_concurrent;
+
   private:
-    /* Entry reference count is not thread safe because
-       the objects themselves are not.
-    */
-    fastuidraw::reference_count_non_concurrent m_count;
+    boost::atomic<int> m_count;
   };
 
   template<typename T>
@@ -226,7 +294,7 @@ namespace
     }
 
     void
-    set(const T &st, int alignment, PoolBase *p, int slot)
+    set(const T &st, int alignment, bool concurrent, PoolBase *p, int slot)
     {
       assert(p);
       assert(slot >= 0);
@@ -234,6 +302,7 @@ namespace
       m_pool = p;
       m_state = st;
       m_pool_slot = slot;
+      m_concurrent = concurrent;
 
       this->m_begin_id = -1;
       this->m_draw_command_id = 0;
@@ -254,7 +323,7 @@ namespace
     /* Returning NULL indicates no free entries left in the pool
      */
     Entry<T>*
-    allocate(const T &st, int alignment)
+    allocate(const T &st, int alignment, bool concurrent)
     {
       Entry<T> *return_value(NULL);
       int slot;
@@ -263,7 +332,7 @@ namespace
       if(slot >= 0)
         {
           return_value = &m_data[slot];
-          return_value->set(st, alignment, this, slot);
+          return_value->set(st, alignment, concurrent, this, slot);
         }
       return return_value;
     }
@@ -272,6 +341,10 @@ namespace
     fastuidraw::vecN<Entry<T>, PoolBase::pool_size> m_data;
   };
 
+  /* A PoolSet allocates from its current Pool, which is
+     replaced by a new Pool when it is full; the mutex is
+     only locked to add a Pool.
+   */
   template<typename T>
   class PoolSet:fastuidraw::noncopyable
   {
@@ -280,37 +353,67 @@ namespace
     PoolSet(void)
     {
       m_pools.push_back(FASTUIDRAWnew Pool<T>());
+      m_current.store(m_pools.back().get(), boost::memory_order_release);
     }
 
     Entry<T>*
-    allocate(const T &st, int alignment)
+    allocate(const T &st, int alignment, bool concurrent)
     {
       Entry<T> *return_value;
+      Pool<T> *pool;
 
-      return_value = m_pools.back()->allocate(st, alignment);
-      if(!return_value)
+      pool = m_current.load(boost::memory_order_acquire);
+      return_value = pool->allocate(st, alignment, concurrent);
+      while(!return_value)
         {
-          m_pools.push_back(FASTUIDRAWnew Pool<T>());
-          return_value = m_pools.back()->allocate(st, alignment);
+          if(concurrent)
+            {
+              boost::mutex::scoped_lock lock(m_mutex);
+              pool = add_pool(pool);
+            }
+          else
+            {
+              pool = add_pool(pool);
+            }
+          return_value = pool->allocate(st, alignment, concurrent);
         }
-
-      assert(return_value);
       return return_value;
     }
 
   private:
+    /* add a new Pool if the current Pool is still
+       full_pool, returns the current Pool
+     */
+    Pool<T>*
+    add_pool(Pool<T> *full_pool)
+    {
+      Pool<T> *current;
+
+      current = m_current.load(boost::memory_order_acquire);
+      if(current == full_pool)
+        {
+          m_pools.push_back(FASTUIDRAWnew Pool<T>());
+          current = m_pools.back().get();
+          m_current.store(current, boost::memory_order_release);
+        }
+      return current;
+    }
+
+    boost::atomic<Pool<T>*> m_current;
+    boost::mutex m_mutex;
     std::vector<fastuidraw::reference_counted_ptr<Pool<T> > > m_pools;
   };
 
   class PainterPackedValuePoolPrivate
   {
   public:
-    explicit
-    PainterPackedValuePoolPrivate(int d):
-      m_alignment(d)
+    PainterPackedValuePoolPrivate(int d, bool concurrent):
+      m_alignment(d),
+      m_concurrent(concurrent)
     {}
 
     int m_alignment;
+    bool m_concurrent;
 
     PoolSet<fastuidraw::PainterBrush> m_brush_pool;
     PoolSet<fastuidraw::PainterClipEquations> m_clip_equations_pool;
@@ -331,11 +434,254 @@ namespace
 
   class PainterPackerPrivate;
 
+  /* A RecordingDraw is a PainterDraw backed by CPU memory
+     that a PainterPacker that records packs into.
+   */
+  class RecordingDraw:public fastuidraw::PainterDraw
+  {
+  public:
+    RecordingDraw(const fastuidraw::PainterPacker::RecordingParams &params,
+                  unsigned int alignment):
+      m_attributes_backing(params.m_attributes_per_draw),
+      m_header_attributes_backing(params.m_attributes_per_draw),
+      m_indices_backing(params.m_indices_per_draw),
+      m_store_backing(params.m_data_blocks_per_draw * alignment)
+    {
+      m_attributes = fastuidraw::make_c_array(m_attributes_backing);
+      m_header_attributes = fastuidraw::make_c_array(m_header_attributes_backing);
+      m_indices = fastuidraw::make_c_array(m_indices_backing);
+      m_store = fastuidraw::make_c_array(m_store_backing);
+    }
+
+    /* the draw breaks are recomputed when the
+       recorded data is spliced
+     */
+    virtual
+    void
+    draw_break(const fastuidraw::PainterShaderGroup &old_groups,
+               const fastuidraw::PainterShaderGroup &new_groups,
+               unsigned int attributes_written,
+               unsigned int indices_written) const
+    {
+      FASTUIDRAWunused(old_groups);
+      FASTUIDRAWunused(new_groups);
+      FASTUIDRAWunused(attributes_written);
+      FASTUIDRAWunused(indices_written);
+    }
+
+    virtual
+    void
+    draw(void) const
+    {
+      assert(!"A recorded PainterDraw is drawn by splicing it to another PainterPacker");
+    }
+
+  protected:
+    virtual
+    void
+    unmap_implement(unsigned int attributes_written,
+                    unsigned int indices_written,
+                    unsigned int data_store_written) const
+    {
+      FASTUIDRAWunused(attributes_written);
+      FASTUIDRAWunused(indices_written);
+      FASTUIDRAWunused(data_store_written);
+    }
+
+  private:
+    std::vector<fastuidraw::PainterAttribute> m_attributes_backing;
+    std::vector<uint32_t> m_header_attributes_backing;
+    std::vector<fastuidraw::PainterIndex> m_indices_backing;
+    std::vector<fastuidraw::generic_data> m_store_backing;
+  };
+
+  /* what a per_draw_command of a PainterPacker that records
+     keeps of each header it packs so that the header can
+     be relocated and the draw breaks recomputed on splicing.
+   */
+  class recorded_header
+  {
+  public:
+    unsigned int m_block;
+    unsigned int m_attributes_written, m_indices_written;
+    PainterShaderGroupValues m_group;
+  };
+
+  /* returns true if drawing with the named blend shader and
+     3D API blend mode reads the value already in the framebuffer
+   */
+  bool
+  blend_reads_destination(const fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> &blend_shader,
+                          fastuidraw::BlendMode::packed_value packed_blend_mode)
+  {
+    if(blend_shader && blend_shader->type() == fastuidraw::PainterBlendShader::framebuffer_fetch)
+      {
+        return true;
+      }
+
+    fastuidraw::BlendMode mode(packed_blend_mode);
+    if(!mode.blending_on())
+      {
+        return false;
+      }
+
+    if(mode.equation_rgb() == fastuidraw::BlendMode::MIN
+       || mode.equation_rgb() == fastuidraw::BlendMode::MAX
+       || mode.equation_alpha() == fastuidraw::BlendMode::MIN
+       || mode.equation_alpha() == fastuidraw::BlendMode::MAX
+       || mode.func_dst_rgb() != fastuidraw::BlendMode::ZERO
+       || mode.func_dst_alpha() != fastuidraw::BlendMode::ZERO)
+      {
+        return true;
+      }
+
+    enum fastuidraw::BlendMode::func_t src[2] =
+      {
+        mode.func_src_rgb(),
+        mode.func_src_alpha()
+      };
+
+    for(unsigned int i = 0; i < 2; ++i)
+      {
+        switch(src[i])
+          {
+          case fastuidraw::BlendMode::DST_COLOR:
+          case fastuidraw::BlendMode::ONE_MINUS_DST_COLOR:
+          case fastuidraw::BlendMode::DST_ALPHA:
+          case fastuidraw::BlendMode::ONE_MINUS_DST_ALPHA:
+          case fastuidraw::BlendMode::SRC_ALPHA_SATURATE:
+            return true;
+          default:
+            break;
+          }
+      }
+    return false;
+  }
+
+  /* hash of data to be written to PainterDraw::m_store,
+     used to intern the data, see PainterPacker::intern_values().
+   */
+  uint32_t
+  hash_store_data(fastuidraw::const_c_array<fastuidraw::generic_data> data)
+  {
+    /* FNV-1a on each 32-bit value */
+    uint32_t return_value(2166136261u);
+    for(unsigned int i = 0; i < data.size(); ++i)
+      {
+        return_value ^= data[i].u;
+        return_value *= 16777619u;
+      }
+    return return_value;
+  }
+
+  /* a block of data written to PainterDraw::m_store
+     that is interned.
+   */
+  class interned_block
+  {
+  public:
+    /* range into per_draw_command::m_interned_data
+       holding a copy of the data
+     */
+    unsigned int m_begin, m_size;
+
+    /* location, in blocks, in PainterDraw::m_store */
+    uint32_t m_location;
+  };
+
+  /* an item (i.e. a header and the indices that follow it)
+     of a per_draw_command waiting to be reordered, see
+     PainterPacker::reorder_window().
+   */
+  class reorder_item
+  {
+  public:
+    reorder_item(const PainterShaderGroupPrivate &group,
+                 unsigned int z, bool reads_destination,
+                 bool z_delayed, unsigned int attributes_written,
+                 unsigned int begin):
+      m_group(group),
+      m_z(z),
+      m_reads_destination(reads_destination),
+      m_z_delayed(z_delayed),
+      m_attributes_written(attributes_written),
+      m_begin(begin),
+      m_end(begin)
+    {}
+
+    PainterShaderGroupPrivate m_group;
+    unsigned int m_z;
+    bool m_reads_destination;
+
+    /* true if the header of the item is handed to a
+       PainterPacker::DataCallBack, which may change its
+       z-value after it is packed (for example Painter
+       sets the z-value of the occluders of clipping when
+       the clipping is popped); m_z is then not the z-value
+       with which the item is drawn.
+     */
+    bool m_z_delayed;
+
+    /* number of attributes written when the header
+       of the item was packed
+     */
+    unsigned int m_attributes_written;
+
+    /* range into per_draw_command::m_reorder_indices */
+    unsigned int m_begin, m_end;
+
+    /* returns true if this item and the item b
+       can be drawn in either order
+     */
+    bool
+    can_exchange(const reorder_item &b) const
+    {
+      if(m_z == b.m_z || m_z_delayed || b.m_z_delayed)
+        {
+          return false;
+        }
+      return (m_z > b.m_z) ?
+        !m_reads_destination :
+        !b.m_reads_destination;
+    }
+  };
+
+  /* transformation applied to the data of a per_draw_command
+     when it is spliced, see PainterPacker::replay().
+   */
+  class splice_transformation
+  {
+  public:
+    splice_transformation(const fastuidraw::float3x3 &item_matrix, int z_offset):
+      m_item_matrix(item_matrix),
+      m_z_offset(z_offset)
+    {
+      m_item_matrix.inverse_transpose(m_item_matrix_inverse_transpose);
+    }
+
+    void
+    transform_item_matrix(fastuidraw::c_array<fastuidraw::generic_data> dst) const;
+
+    void
+    transform_clip_equations(fastuidraw::c_array<fastuidraw::generic_data> dst) const;
+
+    fastuidraw::float3x3 m_item_matrix;
+    fastuidraw::float3x3 m_item_matrix_inverse_transpose;
+    int m_z_offset;
+
+    /* work room: for each block of the data spliced, if
+       the data starting at the block has been transformed
+     */
+    std::vector<bool> m_block_transformed;
+  };
+
   class per_draw_command
   {
   public:
     per_draw_command(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> &r,
-                     const fastuidraw::PainterBackend::ConfigurationBase &config);
+                     const fastuidraw::PainterBackend::ConfigurationBase &config,
+                     bool record_headers, unsigned int reorder_window,
+                     bool intern_values);
 
     unsigned int
     attribute_room(void)
@@ -361,14 +707,35 @@ namespace
     }
 
     unsigned int
-    store_written(void)
+    store_written(void) const
     {
       return current_block() * m_alignment;
     }
 
+    /* returns the room needed in the store to write data,
+       taking into account interning; data is also a work room
+     */
+    unsigned int
+    interned_room_needed(fastuidraw::const_c_array<fastuidraw::generic_data> data) const
+    {
+      uint32_t location;
+      return find_interned(data, hash_store_data(data), location) ? 0u : data.size();
+    }
+
+    /* returns where to write the next num_indices indices,
+       the caller increments m_indices_written afterwards
+     */
+    fastuidraw::c_array<fastuidraw::PainterIndex>
+    index_destination(unsigned int num_indices);
+
     void
     unmap(void)
     {
+      flush_reorder();
+      m_stats[fastuidraw::PainterPacker::num_draws] = 1;
+      m_stats[fastuidraw::PainterPacker::num_attributes] = m_attributes_written;
+      m_stats[fastuidraw::PainterPacker::num_indices] = m_indices_written;
+      m_stats[fastuidraw::PainterPacker::num_store_blocks] = current_block();
       m_draw_command->unmap(m_attributes_written, m_indices_written, store_written());
     }
 
@@ -386,15 +753,75 @@ namespace
                 const painter_state_location &loc,
                 const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
 
+    /* returns true if the data recorded by src fits */
+    bool
+    can_splice(const per_draw_command &src)
+    {
+      return attribute_room() >= src.m_attributes_written
+        && index_room() >= src.m_indices_written
+        && store_room() >= src.store_written();
+    }
+
+    /* append the data recorded by src, if tr is non-NULL
+       the appended data is transformed by it.
+     */
+    void
+    splice(const per_draw_command &src, splice_transformation *tr);
+
     fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> m_draw_command;
     unsigned int m_attributes_written, m_indices_written;
 
+    /* stats_t values are computed at unmap(),
+       except for the timings which are in
+       m_packing_time_ns and m_backend_time_ns.
+     */
+    fastuidraw::vecN<unsigned int, fastuidraw::PainterPacker::num_stats> m_stats;
+    uint64_t m_packing_time_ns, m_backend_time_ns;
+
   private:
+    /* record a change of PainterShaderGroup, issuing
+       a draw break if needed
+     */
+    void
+    change_group(const PainterShaderGroupPrivate &current,
+                 unsigned int attributes_written,
+                 unsigned int indices_written);
+
+    bool
+    is_draw_break(const PainterShaderGroupPrivate &prev,
+                  const PainterShaderGroupPrivate &current) const
+    {
+      return current.m_item_group != prev.m_item_group
+        || current.m_blend_group != prev.m_blend_group
+        || (m_brush_shader_mask & (current.m_brush ^ prev.m_brush)) != 0u
+        || current.m_blend_mode != prev.m_blend_mode;
+    }
+
+    /* returns the number of draw breaks of drawing
+       the items m_reorder_items[order[i]] in order
+     */
+    unsigned int
+    count_draw_breaks(const std::vector<unsigned int> &order) const;
+
+    /* start a new item for reordering, flushing the
+       reorder window first if it is full
+     */
+    void
+    begin_reorder_item(const PainterShaderGroupPrivate &current,
+                       unsigned int z, bool reads_destination,
+                       bool z_delayed);
+
+    /* reorder the items of the reorder window, write their
+       indices in the new order and issue the draw breaks
+     */
+    void
+    flush_reorder(void);
+
     fastuidraw::c_array<fastuidraw::generic_data>
     allocate_store(unsigned int num_elements);
 
     unsigned int
-    current_block(void)
+    current_block(void) const
     {
       return m_store_blocks_written;
     }
@@ -406,15 +833,39 @@ namespace
     void
     pack_state_data_from_value(const T &st, uint32_t &location)
     {
-      fastuidraw::c_array<fastuidraw::generic_data> dst;
       unsigned int data_sz;
 
-      location = current_block();
       data_sz = st.data_size(m_alignment);
-      dst = allocate_store(data_sz);
-      st.pack_data(m_alignment, dst);
+      if(m_intern_values)
+        {
+          m_intern_work_room.resize(data_sz);
+          st.pack_data(m_alignment, fastuidraw::make_c_array(m_intern_work_room));
+          location = pack_interned(fastuidraw::make_c_array(m_intern_work_room));
+        }
+      else
+        {
+          fastuidraw::c_array<fastuidraw::generic_data> dst;
+
+          location = current_block();
+          dst = allocate_store(data_sz);
+          st.pack_data(m_alignment, dst);
+        }
+      ++m_stats[fastuidraw::PainterPacker::num_values_packed];
     }
 
+    /* returns true if data is interned, setting
+       location to where it is in the store.
+     */
+    bool
+    find_interned(fastuidraw::const_c_array<fastuidraw::generic_data> data,
+                  uint32_t hash, uint32_t &location) const;
+
+    /* write data to the store, unless identical data is
+       already interned, and return the location of it.
+     */
+    uint32_t
+    pack_interned(fastuidraw::const_c_array<fastuidraw::generic_data> data);
+
     template<typename T>
     void
     pack_state_data(PainterPackerPrivate *p,
@@ -448,30 +899,100 @@ namespace
     uint32_t m_brush_shader_mask;
     PainterShaderGroupPrivate m_prev_state;
     fastuidraw::BlendMode m_prev_blend_mode;
+
+    bool m_record_headers;
+    std::vector<recorded_header> m_headers;
+
+    /* the items waiting to be reordered, their indices and
+       the location in m_draw_command->m_indices where the
+       indices of the first item go.
+     */
+    unsigned int m_reorder_window;
+    std::vector<reorder_item> m_reorder_items;
+    std::vector<fastuidraw::PainterIndex> m_reorder_indices;
+    unsigned int m_reorder_indices_start;
+
+    /* work room for flush_reorder() */
+    std::vector<unsigned int> m_reorder_order, m_submit_order;
+
+    /* interned data keyed by hash_store_data(); the store is
+       mapped write-only, so a copy of interned data is kept
+       to compare against
+     */
+    bool m_intern_values;
+    std::multimap<uint32_t, interned_block> m_interned;
+    std::vector<fastuidraw::generic_data> m_interned_data;
+    std::vector<fastuidraw::generic_data> m_intern_work_room;
   };
 
   class PainterPackerPrivateWorkroom
   {
   public:
     std::vector<unsigned int> m_attribs_loaded;
+    std::vector<fastuidraw::generic_data> m_interned_room;
   };
 
   class PainterPackerPrivate
   {
   public:
-    explicit
     PainterPackerPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend,
-                         fastuidraw::PainterPacker *p);
+                         fastuidraw::PainterPacker *p, bool recording,
+                         const fastuidraw::PainterPacker::RecordingParams &recording_params);
 
     void
     start_new_command(void);
 
+    /* add the statistics of a per_draw_command that is
+       drawn (or recorded) to m_stats and call the
+       StatsCallBack on it.
+     */
+    void
+    add_stats(per_draw_command &cmd);
+
+    /* append the draws recorded by a PainterPacker that
+       records, if tr is non-NULL the data is transformed
+       by it.
+     */
+    void
+    splice_draws(const std::vector<per_draw_command> &draws,
+                 splice_transformation *tr);
+
     void
     upload_draw_state(const fastuidraw::PainterPackerData &draw_state);
 
     unsigned int
     compute_room_needed_for_packing(const fastuidraw::PainterPackerData &draw_state);
 
+    /* room needed taking into account the data already interned
+       by the current per_draw_command; more expensive than
+       compute_room_needed_for_packing().
+     */
+    unsigned int
+    compute_interned_room_needed_for_packing(const fastuidraw::PainterPackerData &draw_state);
+
+    template<typename T>
+    unsigned int
+    compute_interned_room_needed_for_packing(const fastuidraw::PainterData::value<T> &obj)
+    {
+      const per_draw_command &cmd(m_accumulated_draws.back());
+      if(obj.m_packed_value)
+        {
+          EntryBase *d;
+          d = reinterpret_cast<EntryBase*>(obj.m_packed_value.opaque_data());
+          if(d->m_painter == m_p && d->m_begin_id == m_number_begins
+             && d->m_draw_command_id == m_accumulated_draws.size())
+            {
+              return 0;
+            }
+          return cmd.interned_room_needed(fastuidraw::make_c_array(d->m_data));
+        }
+
+      const T &v(fetch_value(obj));
+      m_work_room.m_interned_room.resize(v.data_size(m_alignment));
+      v.pack_data(m_alignment, fastuidraw::make_c_array(m_work_room.m_interned_room));
+      return cmd.interned_room_needed(fastuidraw::make_c_array(m_work_room.m_interned_room));
+    }
+
     template<typename T>
     unsigned int
     compute_room_needed_for_packing(const fastuidraw::PainterData::value<T> &obj)
@@ -514,8 +1035,74 @@ namespace
     std::vector<per_draw_command> m_accumulated_draws;
     fastuidraw::PainterPacker *m_p;
 
+    /* if true, draws are packed to RecordingDraw objects that
+       are moved to m_recorded_draws on flush() for splice().
+     */
+    bool m_recording;
+    fastuidraw::PainterPacker::RecordingParams m_recording_params;
+    std::vector<per_draw_command> m_recorded_draws;
+
+    /* statistics since begin(), the timings are
+       kept in nanoseconds
+     */
+    fastuidraw::vecN<unsigned int, fastuidraw::PainterPacker::num_stats> m_stats;
+    uint64_t m_packing_time_ns, m_backend_time_ns;
+    fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::StatsCallBack> m_stats_call_back;
+
+    unsigned int m_reorder_window;
+    bool m_intern_values;
+
     PainterPackerPrivateWorkroom m_work_room;
   };
+
+  class RetainedDrawsPrivate
+  {
+  public:
+    RetainedDrawsPrivate(void):
+      m_number_attributes(0),
+      m_number_indices(0)
+    {}
+
+    std::vector<per_draw_command> m_draws;
+    unsigned int m_number_attributes, m_number_indices;
+  };
+}
+
+//////////////////////////////////////////
+// splice_transformation methods
+void
+splice_transformation::
+transform_item_matrix(fastuidraw::c_array<fastuidraw::generic_data> dst) const
+{
+  fastuidraw::float3x3 m;
+
+  m(0, 0) = dst[fastuidraw::PainterItemMatrix::matrix00_offset].f;
+  m(0, 1) = dst[fastuidraw::PainterItemMatrix::matrix01_offset].f;
+  m(0, 2) = dst[fastuidraw::PainterItemMatrix::matrix02_offset].f;
+  m(1, 0) = dst[fastuidraw::PainterItemMatrix::matrix10_offset].f;
+  m(1, 1) = dst[fastuidraw::PainterItemMatrix::matrix11_offset].f;
+  m(1, 2) = dst[fastuidraw::PainterItemMatrix::matrix12_offset].f;
+  m(2, 0) = dst[fastuidraw::PainterItemMatrix::matrix20_offset].f;
+  m(2, 1) = dst[fastuidraw::PainterItemMatrix::matrix21_offset].f;
+  m(2, 2) = dst[fastuidraw::PainterItemMatrix::matrix22_offset].f;
+  fastuidraw::PainterItemMatrix(m_item_matrix * m).pack_data(0, dst);
+}
+
+void
+splice_transformation::
+transform_clip_equations(fastuidraw::c_array<fastuidraw::generic_data> dst) const
+{
+  fastuidraw::PainterClipEquations cl;
+
+  for(unsigned int i = 0; i < 4; ++i)
+    {
+      unsigned int k(3 * i);
+      fastuidraw::vec3 eq(dst[k + fastuidraw::PainterClipEquations::clip0_coeff_x].f,
+                          dst[k + fastuidraw::PainterClipEquations::clip0_coeff_y].f,
+                          dst[k + fastuidraw::PainterClipEquations::clip0_coeff_w].f);
+      cl.m_clip_equations[i] = m_item_matrix_inverse_transpose * eq;
+    }
+  cl.pack_data(0, dst);
 }
 
 
@@ -523,19 +1110,161 @@ namespace
 // per_draw_command methods
 per_draw_command::
 per_draw_command(const fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> &r,
-                 const fastuidraw::PainterBackend::ConfigurationBase &config):
+                 const fastuidraw::PainterBackend::ConfigurationBase &config,
+                 bool record_headers, unsigned int reorder_window,
+                 bool intern_values):
   m_draw_command(r),
   m_attributes_written(0),
   m_indices_written(0),
+  m_stats(0u),
+  m_packing_time_ns(0u),
+  m_backend_time_ns(0u),
   m_store_blocks_written(0),
   m_alignment(config.alignment()),
-  m_brush_shader_mask(config.brush_shader_mask())
+  m_brush_shader_mask(config.brush_shader_mask()),
+  m_record_headers(record_headers),
+  m_reorder_window(record_headers ? 0u : reorder_window),
+  m_reorder_indices_start(0),
+  m_intern_values(intern_values)
 {
   m_prev_state.m_item_group = 0;
   m_prev_state.m_brush = 0;
   m_prev_state.m_blend_group = 0;
 }
 
+fastuidraw::c_array<fastuidraw::PainterIndex>
+per_draw_command::
+index_destination(unsigned int num_indices)
+{
+  if(m_reorder_window == 0)
+    {
+      return m_draw_command->m_indices.sub_array(m_indices_written, num_indices);
+    }
+
+  unsigned int sz;
+  sz = m_reorder_indices.size();
+  m_reorder_indices.resize(sz + num_indices);
+  return fastuidraw::c_array<fastuidraw::PainterIndex>(&m_reorder_indices[sz], num_indices);
+}
+
+void
+per_draw_command::
+begin_reorder_item(const PainterShaderGroupPrivate &current,
+                   unsigned int z, bool reads_destination,
+                   bool z_delayed)
+{
+  if(m_reorder_items.size() >= m_reorder_window)
+    {
+      flush_reorder();
+    }
+
+  if(m_reorder_items.empty())
+    {
+      m_reorder_indices_start = m_indices_written;
+    }
+  else
+    {
+      m_reorder_items.back().m_end = m_reorder_indices.size();
+    }
+
+  m_reorder_items.push_back(reorder_item(current, z, reads_destination, z_delayed,
+                                         m_attributes_written, m_reorder_indices.size()));
+}
+
+unsigned int
+per_draw_command::
+count_draw_breaks(const std::vector<unsigned int> &order) const
+{
+  unsigned int return_value(0);
+  const PainterShaderGroupPrivate *prev(&m_prev_state);
+
+  for(unsigned int i = 0, endi = order.size(); i < endi; ++i)
+    {
+      const PainterShaderGroupPrivate &current(m_reorder_items[order[i]].m_group);
+      if(is_draw_break(*prev, current))
+        {
+          ++return_value;
+        }
+      prev = &current;
+    }
+  return return_value;
+}
+
+void
+per_draw_command::
+flush_reorder(void)
+{
+  if(m_reorder_items.empty())
+    {
+      return;
+    }
+
+  m_reorder_items.back().m_end = m_reorder_indices.size();
+
+  /* place each item just after the last item before it with
+     the same group, provided it can be exchanged with each
+     item it moves in front of; otherwise place it last.
+   */
+  m_reorder_order.clear();
+  m_submit_order.clear();
+  for(unsigned int i = 0, endi = m_reorder_items.size(); i < endi; ++i)
+    {
+      const reorder_item &item(m_reorder_items[i]);
+      unsigned int location(m_reorder_order.size());
+
+      for(unsigned int k = m_reorder_order.size(); k > 0; --k)
+        {
+          const reorder_item &other(m_reorder_items[m_reorder_order[k - 1]]);
+          if(!is_draw_break(other.m_group, item.m_group))
+            {
+              location = k;
+              break;
+            }
+
+          if(!item.can_exchange(other))
+            {
+              break;
+            }
+        }
+      m_reorder_order.insert(m_reorder_order.begin() + location, i);
+      m_submit_order.push_back(i);
+    }
+
+  /* only use the new order if it saves draw breaks */
+  unsigned int reorder_breaks, submit_breaks;
+  const std::vector<unsigned int> *order;
+
+  reorder_breaks = count_draw_breaks(m_reorder_order);
+  submit_breaks = count_draw_breaks(m_submit_order);
+  if(reorder_breaks < submit_breaks)
+    {
+      order = &m_reorder_order;
+      m_stats[fastuidraw::PainterPacker::num_draw_breaks_saved] += submit_breaks - reorder_breaks;
+    }
+  else
+    {
+      order = &m_submit_order;
+    }
+
+  unsigned int loc(m_reorder_indices_start);
+  for(unsigned int i = 0, endi = order->size(); i < endi; ++i)
+    {
+      const reorder_item &item(m_reorder_items[(*order)[i]]);
+      fastuidraw::c_array<fastuidraw::PainterIndex> dst;
+
+      change_group(item.m_group, item.m_attributes_written, loc);
+      dst = m_draw_command->m_indices.sub_array(loc, item.m_end - item.m_begin);
+      std::copy(m_reorder_indices.begin() + item.m_begin,
+                m_reorder_indices.begin() + item.m_end,
+                dst.begin());
+      loc += dst.size();
+    }
+  assert(loc == m_indices_written);
+
+  m_reorder_items.clear();
+  m_reorder_indices.clear();
+}
+
 
 fastuidraw::c_array<fastuidraw::generic_data>
 per_draw_command::
@@ -548,6 +1277,57 @@ allocate_store(unsigned int num_elements)
   return return_value;
 }
 
+bool
+per_draw_command::
+find_interned(fastuidraw::const_c_array<fastuidraw::generic_data> data,
+              uint32_t hash, uint32_t &location) const
+{
+  typedef std::multimap<uint32_t, interned_block>::const_iterator iterator;
+  std::pair<iterator, iterator> range;
+
+  range = m_interned.equal_range(hash);
+  for(iterator iter = range.first; iter != range.second; ++iter)
+    {
+      const interned_block &block(iter->second);
+      if(block.m_size == data.size()
+         && std::memcmp(&m_interned_data[block.m_begin], data.c_ptr(),
+                        sizeof(fastuidraw::generic_data) * data.size()) == 0)
+        {
+          location = block.m_location;
+          return true;
+        }
+    }
+  return false;
+}
+
+uint32_t
+per_draw_command::
+pack_interned(fastuidraw::const_c_array<fastuidraw::generic_data> data)
+{
+  uint32_t hash, location;
+  fastuidraw::c_array<fastuidraw::generic_data> dst;
+  interned_block block;
+
+  hash = hash_store_data(data);
+  if(find_interned(data, hash, location))
+    {
+      ++m_stats[fastuidraw::PainterPacker::num_values_interned];
+      return location;
+    }
+
+  location = current_block();
+  dst = allocate_store(data.size());
+  std::copy(data.begin(), data.end(), dst.begin());
+
+  block.m_begin = m_interned_data.size();
+  block.m_size = data.size();
+  block.m_location = location;
+  m_interned_data.insert(m_interned_data.end(), data.begin(), data.end());
+  m_interned.insert(std::make_pair(hash, block));
+
+  return location;
+}
+
 void
 per_draw_command::
 pack_state_data(PainterPackerPrivate *p,
@@ -557,6 +1337,7 @@ pack_state_data(PainterPackerPrivate *p,
      && d->m_draw_command_id == p->m_accumulated_draws.size())
     {
       location = d->m_offset;
+      ++m_stats[fastuidraw::PainterPacker::num_packed_values_reused];
       return;
     }
 
@@ -564,17 +1345,26 @@ pack_state_data(PainterPackerPrivate *p,
      it to the current store.
    */
   fastuidraw::const_c_array<fastuidraw::generic_data> src;
-  fastuidraw::c_array<fastuidraw::generic_data> dst;
 
-  location = current_block();
   src = fastuidraw::make_c_array(d->m_data);
-  dst = allocate_store(src.size());
-  std::copy(src.begin(), src.end(), dst.begin());
+  if(m_intern_values)
+    {
+      location = pack_interned(src);
+    }
+  else
+    {
+      fastuidraw::c_array<fastuidraw::generic_data> dst;
+
+      location = current_block();
+      dst = allocate_store(src.size());
+      std::copy(src.begin(), src.end(), dst.begin());
+    }
 
   d->m_painter = p->m_p;
   d->m_begin_id = p->m_number_begins;
   d->m_draw_command_id = p->m_accumulated_draws.size();
   d->m_offset = location;
+  ++m_stats[fastuidraw::PainterPacker::num_packed_values_copied];
 }
 
 void
@@ -652,18 +1442,26 @@ pack_header(unsigned int header_size,
   header.m_blend_shader = blend.m_ID;
   header.m_z = z;
   header.pack_data(m_alignment, dst);
+  ++m_stats[fastuidraw::PainterPacker::num_headers];
 
-  if(current.m_item_group != m_prev_state.m_item_group
-     || current.m_blend_group != m_prev_state.m_blend_group
-     || (m_brush_shader_mask & (current.m_brush ^ m_prev_state.m_brush)) != 0u
-     || current.m_blend_mode != m_prev_state.m_blend_mode)
+  if(m_record_headers)
     {
-      m_draw_command->draw_break(m_prev_state, current,
-                                 m_attributes_written,
-                                 m_indices_written);
+      m_headers.push_back(recorded_header());
+      m_headers.back().m_block = return_value;
+      m_headers.back().m_attributes_written = m_attributes_written;
+      m_headers.back().m_indices_written = m_indices_written;
+      m_headers.back().m_group = current;
     }
 
-  m_prev_state = current;
+  if(m_reorder_window > 0)
+    {
+      begin_reorder_item(current, z, blend_reads_destination(blend_shader, blend_mode),
+                         call_back.get() != NULL);
+    }
+  else
+    {
+      change_group(current, m_attributes_written, m_indices_written);
+    }
 
   if(call_back)
     {
@@ -673,13 +1471,163 @@ pack_header(unsigned int header_size,
   return return_value;
 }
 
+void
+per_draw_command::
+change_group(const PainterShaderGroupPrivate &current,
+             unsigned int attributes_written,
+             unsigned int indices_written)
+{
+  bool item_group, blend_group, brush, blend_mode;
+
+  item_group = (current.m_item_group != m_prev_state.m_item_group);
+  blend_group = (current.m_blend_group != m_prev_state.m_blend_group);
+  brush = ((m_brush_shader_mask & (current.m_brush ^ m_prev_state.m_brush)) != 0u);
+  blend_mode = (current.m_blend_mode != m_prev_state.m_blend_mode);
+
+  if(item_group || blend_group || brush || blend_mode)
+    {
+      ++m_stats[fastuidraw::PainterPacker::num_draw_breaks];
+      m_stats[fastuidraw::PainterPacker::num_draw_breaks_item_group] += item_group;
+      m_stats[fastuidraw::PainterPacker::num_draw_breaks_blend_group] += blend_group;
+      m_stats[fastuidraw::PainterPacker::num_draw_breaks_brush] += brush;
+      m_stats[fastuidraw::PainterPacker::num_draw_breaks_blend_mode] += blend_mode;
+      m_draw_command->draw_break(m_prev_state, current,
+                                 attributes_written,
+                                 indices_written);
+    }
+
+  m_prev_state = current;
+}
+
+void
+per_draw_command::
+splice(const per_draw_command &src, splice_transformation *tr)
+{
+  unsigned int block, attrib_offset, index_offset;
+  fastuidraw::const_c_array<fastuidraw::generic_data> src_store;
+  fastuidraw::c_array<fastuidraw::generic_data> dst_store;
+
+  assert(src.m_draw_command->unmapped());
+  assert(src.m_alignment == m_alignment);
+  assert(can_splice(src));
+
+  /* spliced draws are not reordered */
+  flush_reorder();
+
+  /* the store locations written by src are relative to its
+     start, add block to them; the indices written by src are
+     relative to its start, add attrib_offset to them.
+   */
+  block = current_block();
+  attrib_offset = m_attributes_written;
+  index_offset = m_indices_written;
+
+  src_store = src.m_draw_command->m_store.sub_array(0, src.store_written());
+  dst_store = allocate_store(src_store.size());
+  std::copy(src_store.begin(), src_store.end(), dst_store.begin());
+
+  if(tr)
+    {
+      tr->m_block_transformed.clear();
+      tr->m_block_transformed.resize(src.current_block(), false);
+    }
+
+  for(unsigned int h = 0, endh = src.m_headers.size(); h < endh; ++h)
+    {
+      const recorded_header &header(src.m_headers[h]);
+      fastuidraw::c_array<fastuidraw::generic_data> dst;
+
+      dst = dst_store.sub_array(header.m_block * m_alignment,
+                                fastuidraw::PainterHeader::data_size(m_alignment));
+      if(tr)
+        {
+          uint32_t matrix_loc, clip_loc;
+
+          /* transform the item matrix and clip equations
+             that the header refers to, unless already done
+             for a previous header
+           */
+          matrix_loc = dst[fastuidraw::PainterHeader::item_matrix_location_offset].u;
+          if(!tr->m_block_transformed[matrix_loc])
+            {
+              tr->m_block_transformed[matrix_loc] = true;
+              tr->transform_item_matrix(dst_store.sub_array(matrix_loc * m_alignment,
+                                                            fastuidraw::PainterItemMatrix::matrix_data_size));
+            }
+
+          clip_loc = dst[fastuidraw::PainterHeader::clip_equations_location_offset].u;
+          if(!tr->m_block_transformed[clip_loc])
+            {
+              tr->m_block_transformed[clip_loc] = true;
+              tr->transform_clip_equations(dst_store.sub_array(clip_loc * m_alignment,
+                                                               fastuidraw::PainterClipEquations::clip_data_size));
+            }
+          dst[fastuidraw::PainterHeader::z_offset].u += tr->m_z_offset;
+        }
+      dst[fastuidraw::PainterHeader::clip_equations_location_offset].u += block;
+      dst[fastuidraw::PainterHeader::item_matrix_location_offset].u += block;
+      dst[fastuidraw::PainterHeader::brush_shader_data_location_offset].u += block;
+      dst[fastuidraw::PainterHeader::item_shader_data_location_offset].u += block;
+      dst[fastuidraw::PainterHeader::blend_shader_data_location_offset].u += block;
+
+      m_attributes_written = attrib_offset + header.m_attributes_written;
+      m_indices_written = index_offset + header.m_indices_written;
+      change_group(PainterShaderGroupPrivate(header.m_group), m_attributes_written, m_indices_written);
+    }
+  m_stats[fastuidraw::PainterPacker::num_headers] += src.m_headers.size();
+  m_stats[fastuidraw::PainterPacker::num_packed_values_reused] += src.m_stats[fastuidraw::PainterPacker::num_packed_values_reused];
+  m_stats[fastuidraw::PainterPacker::num_packed_values_copied] += src.m_stats[fastuidraw::PainterPacker::num_packed_values_copied];
+  m_stats[fastuidraw::PainterPacker::num_values_packed] += src.m_stats[fastuidraw::PainterPacker::num_values_packed];
+
+  fastuidraw::const_c_array<fastuidraw::PainterAttribute> src_attribs;
+  fastuidraw::const_c_array<uint32_t> src_header_attribs;
+  fastuidraw::c_array<uint32_t> dst_header_attribs;
+  fastuidraw::const_c_array<fastuidraw::PainterIndex> src_indices;
+  fastuidraw::c_array<fastuidraw::PainterIndex> dst_indices;
+
+  src_attribs = src.m_draw_command->m_attributes.sub_array(0, src.m_attributes_written);
+  std::copy(src_attribs.begin(), src_attribs.end(),
+            m_draw_command->m_attributes.sub_array(attrib_offset, src_attribs.size()).begin());
+
+  src_header_attribs = src.m_draw_command->m_header_attributes.sub_array(0, src.m_attributes_written);
+  dst_header_attribs = m_draw_command->m_header_attributes.sub_array(attrib_offset, src_header_attribs.size());
+  for(unsigned int i = 0; i < src_header_attribs.size(); ++i)
+    {
+      dst_header_attribs[i] = src_header_attribs[i] + block;
+    }
+
+  src_indices = src.m_draw_command->m_indices.sub_array(0, src.m_indices_written);
+  dst_indices = m_draw_command->m_indices.sub_array(index_offset, src_indices.size());
+  for(unsigned int i = 0; i < src_indices.size(); ++i)
+    {
+      dst_indices[i] = src_indices[i] + attrib_offset;
+    }
+
+  m_attributes_written = attrib_offset + src.m_attributes_written;
+  m_indices_written = index_offset + src.m_indices_written;
+
+  /* keep the images and color stops used by src alive until drawn */
+  m_images_active.insert(m_images_active.end(), src.m_images_active.begin(), src.m_images_active.end());
+  m_color_stops_active.insert(m_color_stops_active.end(), src.m_color_stops_active.begin(), src.m_color_stops_active.end());
+  m_last_image.clear();
+  m_last_color_stop.clear();
+}
+
 ///////////////////////////////////////////
 // PainterPackerPrivate methods
 PainterPackerPrivate::
 PainterPackerPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend,
-                     fastuidraw::PainterPacker *p):
+                     fastuidraw::PainterPacker *p, bool recording,
+                     const fastuidraw::PainterPacker::RecordingParams &recording_params):
   m_backend(backend),
-  m_p(p)
+  m_p(p),
+  m_recording(recording),
+  m_recording_params(recording_params),
+  m_stats(0u),
+  m_packing_time_ns(0u),
+  m_backend_time_ns(0u),
+  m_reorder_window(0u),
+  m_intern_values(false)
 {
   m_alignment = m_backend->configuration_base().alignment();
   m_header_size = fastuidraw::PainterHeader::data_size(m_alignment);
@@ -690,6 +1638,29 @@ PainterPackerPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBacken
   // the shaders as well.
   m_default_shaders = m_backend->default_shaders();
   m_number_begins = 0;
+
+  if(m_recording)
+    {
+      /* a recorded PainterDraw is spliced whole into a PainterDraw
+         of the PainterBackend, so it must not be larger than those.
+       */
+      const fastuidraw::PainterBackend::PerformanceHints &hints(m_backend->hints());
+      if(hints.attributes_per_draw() > 0)
+        {
+          m_recording_params.m_attributes_per_draw = fastuidraw::t_min(m_recording_params.m_attributes_per_draw,
+                                                                       hints.attributes_per_draw());
+        }
+      if(hints.indices_per_draw() > 0)
+        {
+          m_recording_params.m_indices_per_draw = fastuidraw::t_min(m_recording_params.m_indices_per_draw,
+                                                                    hints.indices_per_draw());
+        }
+      if(hints.data_blocks_per_draw() > 0)
+        {
+          m_recording_params.m_data_blocks_per_draw = fastuidraw::t_min(m_recording_params.m_data_blocks_per_draw,
+                                                                        hints.data_blocks_per_draw());
+        }
+    }
 }
 
 void
@@ -702,8 +1673,18 @@ start_new_command(void)
     }
 
   fastuidraw::reference_counted_ptr<const fastuidraw::PainterDraw> r;
-  r = m_backend->map_draw();
-  m_accumulated_draws.push_back(per_draw_command(r, m_backend->configuration_base()));
+  uint64_t start(fastuidraw::monotonic_time_ns());
+  if(m_recording)
+    {
+      r = FASTUIDRAWnew RecordingDraw(m_recording_params, m_alignment);
+    }
+  else
+    {
+      r = m_backend->map_draw();
+    }
+  m_accumulated_draws.push_back(per_draw_command(r, m_backend->configuration_base(), m_recording,
+                                                  m_reorder_window, m_intern_values));
+  m_accumulated_draws.back().m_backend_time_ns = fastuidraw::monotonic_time_ns() - start;
 }
 
 unsigned int
@@ -719,6 +1700,19 @@ compute_room_needed_for_packing(const fastuidraw::PainterPackerData &draw_state)
   return R;
 }
 
+unsigned int
+PainterPackerPrivate::
+compute_interned_room_needed_for_packing(const fastuidraw::PainterPackerData &draw_state)
+{
+  unsigned int R(0);
+  R += compute_interned_room_needed_for_packing(draw_state.m_clip);
+  R += compute_interned_room_needed_for_packing(draw_state.m_matrix);
+  R += compute_interned_room_needed_for_packing(draw_state.m_brush);
+  R += compute_interned_room_needed_for_packing(draw_state.m_item_shader_data);
+  R += compute_interned_room_needed_for_packing(draw_state.m_blend_shader_data);
+  return R;
+}
+
 void
 PainterPackerPrivate::
 upload_draw_state(const fastuidraw::PainterPackerData &draw_state)
@@ -727,13 +1721,110 @@ upload_draw_state(const fastuidraw::PainterPackerData &draw_state)
 
   assert(!m_accumulated_draws.empty());
   needed_room = compute_room_needed_for_packing(draw_state);
-  if(needed_room > m_accumulated_draws.back().store_room())
+  if(needed_room > m_accumulated_draws.back().store_room()
+     && (!m_intern_values
+         || compute_interned_room_needed_for_packing(draw_state) > m_accumulated_draws.back().store_room()))
     {
       start_new_command();
     }
   m_accumulated_draws.back().pack_painter_state(draw_state, this, m_painter_state_location);
 }
 
+void
+PainterPackerPrivate::
+add_stats(per_draw_command &cmd)
+{
+  cmd.m_stats[fastuidraw::PainterPacker::packing_time_us] = cmd.m_packing_time_ns / 1000u;
+  cmd.m_stats[fastuidraw::PainterPacker::backend_time_us] = cmd.m_backend_time_ns / 1000u;
+  for(unsigned int i = 0; i < fastuidraw::PainterPacker::packing_time_us; ++i)
+    {
+      m_stats[i] += cmd.m_stats[i];
+    }
+  m_packing_time_ns += cmd.m_packing_time_ns;
+  m_backend_time_ns += cmd.m_backend_time_ns;
+
+  if(m_stats_call_back && !m_recording)
+    {
+      m_stats_call_back->draw_stats(cmd.m_draw_command,
+                                    fastuidraw::const_c_array<unsigned int>(cmd.m_stats.c_ptr(),
+                                                                            cmd.m_stats.size()));
+    }
+}
+
+void
+PainterPackerPrivate::
+splice_draws(const std::vector<per_draw_command> &draws,
+             splice_transformation *tr)
+{
+  uint64_t start(fastuidraw::monotonic_time_ns());
+
+  assert(!m_accumulated_draws.empty());
+  for(std::vector<per_draw_command>::const_iterator iter = draws.begin(),
+        end = draws.end(); iter != end; ++iter)
+    {
+      if(iter->m_attributes_written == 0 || iter->m_indices_written == 0)
+        {
+          continue;
+        }
+
+      if(!m_accumulated_draws.back().can_splice(*iter))
+        {
+          start_new_command();
+          if(!m_accumulated_draws.back().can_splice(*iter))
+            {
+              /* only possible if the PainterBackend does not give
+                 the sizes of its PainterDraw objects in its
+                 PerformanceHints, see the ctor.
+               */
+              std::cerr << "PainterPacker: recorded draw of "
+                        << iter->m_attributes_written << " attributes, "
+                        << iter->m_indices_written << " indices and "
+                        << iter->store_written() << " store elements does not fit "
+                        << "into a draw of the PainterBackend, RecordingParams too large; "
+                        << "the recorded draw is dropped\n";
+              continue;
+            }
+        }
+      m_accumulated_draws.back().splice(*iter, tr);
+    }
+  m_accumulated_draws.back().m_packing_time_ns += fastuidraw::monotonic_time_ns() - start;
+}
+
+/////////////////////////////////////////
+// fastuidraw::PainterPacker::RetainedDraws methods
+fastuidraw::PainterPacker::RetainedDraws::
+RetainedDraws(void)
+{
+  m_d = FASTUIDRAWnew RetainedDrawsPrivate();
+}
+
+fastuidraw::PainterPacker::RetainedDraws::
+~RetainedDraws()
+{
+  RetainedDrawsPrivate *d;
+  d = reinterpret_cast<RetainedDrawsPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+unsigned int
+fastuidraw::PainterPacker::RetainedDraws::
+number_attributes(void) const
+{
+  RetainedDrawsPrivate *d;
+  d = reinterpret_cast<RetainedDrawsPrivate*>(m_d);
+  return d->m_number_attributes;
+}
+
+unsigned int
+fastuidraw::PainterPacker::RetainedDraws::
+number_indices(void) const
+{
+  RetainedDrawsPrivate *d;
+  d = reinterpret_cast<RetainedDrawsPrivate*>(m_d);
+  return d->m_number_indices;
+}
+
 /////////////////////////////////////////
 // fastuidraw::PainterShaderGroup methods
 uint32_t
@@ -778,7 +1869,15 @@ fastuidraw::PainterPacker::
 PainterPacker(reference_counted_ptr<PainterBackend> backend)
 {
   assert(backend);
-  m_d = FASTUIDRAWnew PainterPackerPrivate(backend, this);
+  m_d = FASTUIDRAWnew PainterPackerPrivate(backend, this, false, RecordingParams());
+}
+
+fastuidraw::PainterPacker::
+PainterPacker(reference_counted_ptr<PainterBackend> backend,
+              const RecordingParams &params)
+{
+  assert(backend);
+  m_d = FASTUIDRAWnew PainterPackerPrivate(backend, this, true, params);
 }
 
 fastuidraw::PainterPacker::
@@ -798,6 +1897,10 @@ begin(void)
   d = reinterpret_cast<PainterPackerPrivate*>(m_d);
 
   assert(d->m_accumulated_draws.empty());
+  d->m_recorded_draws.clear();
+  d->m_stats = vecN<unsigned int, num_stats>(0u);
+  d->m_packing_time_ns = 0u;
+  d->m_backend_time_ns = 0u;
   d->start_new_command();
   ++d->m_number_begins;
 }
@@ -814,14 +1917,39 @@ flush(void)
       d->m_accumulated_draws.back().unmap();
     }
 
+  if(d->m_recording)
+    {
+      for(std::vector<per_draw_command>::iterator iter = d->m_accumulated_draws.begin(),
+            end = d->m_accumulated_draws.end(); iter != end; ++iter)
+        {
+          d->add_stats(*iter);
+        }
+      d->m_recorded_draws.insert(d->m_recorded_draws.end(),
+                                 d->m_accumulated_draws.begin(),
+                                 d->m_accumulated_draws.end());
+      d->m_accumulated_draws.clear();
+      return;
+    }
+
+  uint64_t start;
+
+  start = monotonic_time_ns();
   d->m_backend->on_pre_draw();
+  d->m_backend_time_ns += monotonic_time_ns() - start;
+
   for(std::vector<per_draw_command>::iterator iter = d->m_accumulated_draws.begin(),
         end = d->m_accumulated_draws.end(); iter != end; ++iter)
     {
       assert(iter->m_draw_command->unmapped());
+      start = monotonic_time_ns();
       iter->m_draw_command->draw();
+      iter->m_backend_time_ns += monotonic_time_ns() - start;
+      d->add_stats(*iter);
     }
+
+  start = monotonic_time_ns();
   d->m_backend->on_post_draw();
+  d->m_backend_time_ns += monotonic_time_ns() - start;
   d->m_accumulated_draws.clear();
 }
 
@@ -832,6 +1960,144 @@ end(void)
   flush();
 }
 
+bool
+fastuidraw::PainterPacker::
+recording(void) const
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  return d->m_recording;
+}
+
+unsigned int
+fastuidraw::PainterPacker::
+query_stat(enum stats_t st) const
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  assert(st < num_stats);
+  switch(st)
+    {
+    case packing_time_us:
+      return d->m_packing_time_ns / 1000u;
+    case backend_time_us:
+      return d->m_backend_time_ns / 1000u;
+    default:
+      return d->m_stats[st];
+    }
+}
+
+void
+fastuidraw::PainterPacker::
+stats_call_back(const reference_counted_ptr<StatsCallBack> &cb)
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  d->m_stats_call_back = cb;
+}
+
+const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::StatsCallBack>&
+fastuidraw::PainterPacker::
+stats_call_back(void) const
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  return d->m_stats_call_back;
+}
+
+void
+fastuidraw::PainterPacker::
+reorder_window(unsigned int N)
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  d->m_reorder_window = N;
+}
+
+unsigned int
+fastuidraw::PainterPacker::
+reorder_window(void) const
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  return d->m_reorder_window;
+}
+
+void
+fastuidraw::PainterPacker::
+intern_values(bool v)
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  d->m_intern_values = v;
+}
+
+bool
+fastuidraw::PainterPacker::
+intern_values(void) const
+{
+  PainterPackerPrivate *d;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  return d->m_intern_values;
+}
+
+void
+fastuidraw::PainterPacker::
+splice(const PainterPacker &recorded)
+{
+  PainterPackerPrivate *d, *src;
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  src = reinterpret_cast<PainterPackerPrivate*>(recorded.m_d);
+
+  assert(!d->m_recording);
+  assert(src->m_recording);
+  assert(src->m_accumulated_draws.empty());
+  assert(d->m_alignment == src->m_alignment);
+  d->splice_draws(src->m_recorded_draws, NULL);
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::PainterPacker::RetainedDraws>
+fastuidraw::PainterPacker::
+retain(void) const
+{
+  PainterPackerPrivate *d;
+  RetainedDraws *return_value;
+  RetainedDrawsPrivate *r;
+
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  assert(d->m_recording);
+  assert(d->m_accumulated_draws.empty());
+
+  return_value = FASTUIDRAWnew RetainedDraws();
+  r = reinterpret_cast<RetainedDrawsPrivate*>(return_value->m_d);
+  for(std::vector<per_draw_command>::const_iterator iter = d->m_recorded_draws.begin(),
+        end = d->m_recorded_draws.end(); iter != end; ++iter)
+    {
+      if(iter->m_attributes_written != 0 && iter->m_indices_written != 0)
+        {
+          r->m_draws.push_back(*iter);
+          r->m_number_attributes += iter->m_attributes_written;
+          r->m_number_indices += iter->m_indices_written;
+        }
+    }
+  return return_value;
+}
+
+void
+fastuidraw::PainterPacker::
+replay(const RetainedDraws &draws, const float3x3 &item_matrix, int z_offset)
+{
+  PainterPackerPrivate *d;
+  const RetainedDrawsPrivate *r;
+  splice_transformation tr(item_matrix, z_offset);
+
+  d = reinterpret_cast<PainterPackerPrivate*>(m_d);
+  r = reinterpret_cast<const RetainedDrawsPrivate*>(draws.m_d);
+
+  assert(!d->m_recording);
+  d->splice_draws(r->m_draws, &tr);
+}
+
 void
 fastuidraw::PainterPacker::
 draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
@@ -874,8 +2140,10 @@ draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
       return;
     }
 
+  uint64_t start(monotonic_time_ns());
+
   d->m_work_room.m_attribs_loaded.clear();
-  d->m_work_room.m_attribs_loaded.resize(attrib_chunk_selector.size(), NOT_LOADED);
+  d->m_work_room.m_attribs_loaded.resize(attrib_chunks.size(), NOT_LOADED);
 
   assert(shader);
 
@@ -989,13 +2257,14 @@ draw_generic(const reference_counted_ptr<PainterItemShader> &shader,
       const_c_array<PainterIndex> index_src_ptr;
 
       index_src_ptr = index_chunks[chunk];
-      index_dst_ptr = cmd.m_draw_command->m_indices.sub_array(cmd.m_indices_written, index_src_ptr.size());
+      index_dst_ptr = cmd.index_destination(index_src_ptr.size());
       for(unsigned int i = 0; i < index_dst_ptr.size(); ++i)
         {
           index_dst_ptr[i] = index_src_ptr[i] + attrib_offset;
         }
       cmd.m_indices_written += index_dst_ptr.size();
     }
+  d->m_accumulated_draws.back().m_packing_time_ns += monotonic_time_ns() - start;
 }
 
 const fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>&
@@ -1228,9 +2497,9 @@ raw_value(void) const
 /////////////////////////////////////////////////////
 // PainterPackedValuePool methods
 fastuidraw::PainterPackedValuePool::
-PainterPackedValuePool(int alignment)
+PainterPackedValuePool(int alignment, bool concurrent)
 {
-  m_d = FASTUIDRAWnew PainterPackedValuePoolPrivate(alignment);
+  m_d = FASTUIDRAWnew PainterPackedValuePoolPrivate(alignment, concurrent);
 }
 
 fastuidraw::PainterPackedValuePool::
@@ -1242,6 +2511,15 @@ fastuidraw::PainterPackedValuePool::
   m_d = NULL;
 }
 
+bool
+fastuidraw::PainterPackedValuePool::
+concurrent(void) const
+{
+  PainterPackedValuePoolPrivate *d;
+  d = reinterpret_cast<PainterPackedValuePoolPrivate*>(m_d);
+  return d->m_concurrent;
+}
+
 fastuidraw::PainterPackedValue<fastuidraw::PainterBrush>
 fastuidraw::PainterPackedValuePool::
 create_packed_value(const PainterBrush &value)
@@ -1250,7 +2528,7 @@ create_packed_value(const PainterBrush &value)
   Entry<PainterBrush> *e;
 
   d = reinterpret_cast<PainterPackedValuePoolPrivate*>(m_d);
-  e = d->m_brush_pool.allocate(value, d->m_alignment);
+  e = d->m_brush_pool.allocate(value, d->m_alignment, d->m_concurrent);
   return fastuidraw::PainterPackedValue<PainterBrush>(e);
 }
 
@@ -1262,7 +2540,7 @@ create_packed_value(const PainterClipEquations &value)
   Entry<PainterClipEquations> *e;
 
   d = reinterpret_cast<PainterPackedValuePoolPrivate*>(m_d);
-  e = d->m_clip_equations_pool.allocate(value, d->m_alignment);
+  e = d->m_clip_equations_pool.allocate(value, d->m_alignment, d->m_concurrent);
   return fastuidraw::PainterPackedValue<PainterClipEquations>(e);
 }
 
@@ -1274,7 +2552,7 @@ create_packed_value(const PainterItemMatrix &value)
   Entry<PainterItemMatrix> *e;
 
   d = reinterpret_cast<PainterPackedValuePoolPrivate*>(m_d);
-  e = d->m_item_matrix_pool.allocate(value, d->m_alignment);
+  e = d->m_item_matrix_pool.allocate(value, d->m_alignment, d->m_concurrent);
   return fastuidraw::PainterPackedValue<PainterItemMatrix>(e);
 }
 
@@ -1286,7 +2564,7 @@ create_packed_value(const PainterItemShaderData &value)
   Entry<PainterItemShaderData> *e;
 
   d = reinterpret_cast<PainterPackedValuePoolPrivate*>(m_d);
-  e = d->m_item_shader_data_pool.allocate(value, d->m_alignment);
+  e = d->m_item_shader_data_pool.allocate(value, d->m_alignment, d->m_concurrent);
   return fastuidraw::PainterPackedValue<PainterItemShaderData>(e);
 }
 
@@ -1298,6 +2576,6 @@ create_packed_value(const PainterBlendShaderData &value)
   Entry<PainterBlendShaderData> *e;
 
   d = reinterpret_cast<PainterPackedValuePoolPrivate*>(m_d);
-  e = d->m_blend_shader_data_pool.allocate(value, d->m_alignment);
+  e = d->m_blend_shader_data_pool.allocate(value, d->m_alignment, d->m_concurrent);
   return fastuidraw::PainterPackedValue<PainterBlendShaderData>(e);
 }
@@ -109,14 +109,23 @@ namespace
 
   bool
   all_pts_culled_by_one_half_plane(const fastuidraw::vecN<fastuidraw::vec3, 4> &pts,
-                                   const fastuidraw::PainterClipEquations &eq)
+                                   const fastuidraw::PainterClipEquations &eq,
+                                   const fastuidraw::vec2 &pad)
   {
+    /* each point is taken as the box of size 2 * pad,
+       in normalized device coordinates, centered at the
+       point; pad is scaled by |w| to be in clip coordinates.
+     */
     for(int i = 0; i < 4; ++i)
       {
-        if(fastuidraw::dot(pts[0], eq.m_clip_equations[i]) < 0.0f
-           && fastuidraw::dot(pts[1], eq.m_clip_equations[i]) < 0.0f
-           && fastuidraw::dot(pts[2], eq.m_clip_equations[i]) < 0.0f
-           && fastuidraw::dot(pts[3], eq.m_clip_equations[i]) < 0.0f)
+        const fastuidraw::vec3 &cl(eq.m_clip_equations[i]);
+        float d;
+
+        d = fastuidraw::t_abs(cl.x()) * pad.x() + fastuidraw::t_abs(cl.y()) * pad.y();
+        if(fastuidraw::dot(pts[0], cl) + d * fastuidraw::t_abs(pts[0].z()) < 0.0f
+           && fastuidraw::dot(pts[1], cl) + d * fastuidraw::t_abs(pts[1].z()) < 0.0f
+           && fastuidraw::dot(pts[2], cl) + d * fastuidraw::t_abs(pts[2].z()) < 0.0f
+           && fastuidraw::dot(pts[3], cl) + d * fastuidraw::t_abs(pts[3].z()) < 0.0f)
           {
             return true;
           }
@@ -332,6 +341,8 @@ namespace
   public:
     std::vector<unsigned int> m_selector;
     std::vector<fastuidraw::const_c_array<fastuidraw::PainterIndex> > m_index_chunks;
+    std::vector<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > m_attrib_chunks;
+    std::vector<unsigned int> m_subsets;
     std::vector<fastuidraw::vec2> m_pts_clip_against_planes;
     std::vector<fastuidraw::vec2> m_pts_draw_convex_polygon;
     std::vector<float> m_clipper_floats;
@@ -340,6 +351,58 @@ namespace
     std::vector<std::vector<fastuidraw::PainterAttribute> > m_cap_join_attribs;
   };
 
+  /* Add to work_room.m_index_chunks those index chunks of data
+     whose winding number passes fill_rule, with the chunks
+     selecting the attribute chunk attrib_chunk. Returns true
+     if any index chunks were added.
+   */
+  bool
+  add_custom_fill_chunks(const fastuidraw::PainterAttributeData &data,
+                         const fastuidraw::Painter::CustomFillRuleBase &fill_rule,
+                         unsigned int attrib_chunk,
+                         PainterWorkRoom &work_room)
+  {
+    using namespace fastuidraw;
+
+    bool return_value(false);
+
+    /* walk through what winding numbers are non-empty.
+     */
+    const_c_array<unsigned int> chks(data.non_empty_index_data_chunks());
+    for(unsigned int i = 0; i < chks.size(); ++i)
+      {
+        unsigned int k;
+        int winding_number;
+
+        k = chks[i];
+        if(k == PainterEnums::complement_nonzero_fill_rule || k >= PainterEnums::fill_rule_data_count)
+          {
+            winding_number = PainterAttributeDataFillerPathFill::winding_number_from_index_chunk(k);
+            if(fill_rule(winding_number))
+              {
+                const_c_array<PainterIndex> chunk;
+                assert(!data.index_data_chunk(k).empty());
+                chunk = data.index_data_chunk(k);
+                work_room.m_index_chunks.push_back(chunk);
+                work_room.m_selector.push_back(attrib_chunk);
+                return_value = true;
+              }
+          }
+      }
+    return return_value;
+  }
+
+  fastuidraw::PainterClipEquations
+  default_clip_equations(void)
+  {
+    fastuidraw::PainterClipEquations clip_eq;
+    clip_eq.m_clip_equations[0] = fastuidraw::vec3( 1.0f,  0.0f, 1.0f);
+    clip_eq.m_clip_equations[1] = fastuidraw::vec3(-1.0f,  0.0f, 1.0f);
+    clip_eq.m_clip_equations[2] = fastuidraw::vec3( 0.0f,  1.0f, 1.0f);
+    clip_eq.m_clip_equations[3] = fastuidraw::vec3( 0.0f, -1.0f, 1.0f);
+    return clip_eq;
+  }
+
   class AtrribIndex
   {
   public:
@@ -350,7 +413,7 @@ namespace
   class StrokingData
   {
   public:
-    AtrribIndex m_edges;
+    std::vector<AtrribIndex> m_edges;
     unsigned int m_edge_zinc;
 
     std::vector<AtrribIndex> m_joins;
@@ -363,11 +426,106 @@ namespace
   class PainterPrivate
   {
   public:
-    explicit
-    PainterPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend);
+    /* if recording_params is non-NULL, the PainterPacker
+       of the Painter records.
+     */
+    PainterPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend,
+                   const fastuidraw::PainterPacker::RecordingParams *recording_params);
+
+    /* returns true if the rectangle, with each side pushed
+       out by pixel_pad pixels, is entirely clipped.
+     */
+    bool
+    rect_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh,
+                   float pixel_pad = 0.0f);
+
+    /* returns true if damage is tracked and the box of
+       points in clip coordinates, with each side pushed out
+       by pad (in normalized device coordinates), does not
+       intersect the damaged region.
+     */
+    bool
+    pts_are_undamaged(const fastuidraw::vecN<fastuidraw::vec3, 4> &pts,
+                      const fastuidraw::vec2 &pad);
 
+    /* returns true if attribute data whose positions are
+       within the box [pmin, pmax], is entirely clipped
+       when stroked with shader.
+     */
     bool
-    rect_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh);
+    stroke_is_culled(const fastuidraw::PainterStrokeShader &shader,
+                     const fastuidraw::PainterData &draw,
+                     enum fastuidraw::PainterEnums::join_style js,
+                     fastuidraw::vec2 pmin, fastuidraw::vec2 pmax)
+    {
+      float pixel_pad, item_pad;
+      return stroking_pad(shader, draw, js, pixel_pad, item_pad)
+        && stroke_is_culled(pixel_pad, item_pad, pmin, pmax);
+    }
+
+    /* returns true if attribute data whose positions are within
+       the box [pmin, pmax] is entirely clipped when stroked
+       so that it extends pixel_pad pixels plus item_pad in item
+       coordinates from its positions.
+     */
+    bool
+    stroke_is_culled(float pixel_pad, float item_pad,
+                     fastuidraw::vec2 pmin, fastuidraw::vec2 pmax)
+    {
+      pmin -= fastuidraw::vec2(item_pad, item_pad);
+      pmax += fastuidraw::vec2(item_pad, item_pad);
+      return rect_is_culled(pmin, pmax - pmin, pixel_pad);
+    }
+
+    /* computes how far stroking with shader extends from the
+       positions of the attribute data, including anti-aliasing,
+       returns false if that is not known.
+     */
+    bool
+    stroking_pad(const fastuidraw::PainterStrokeShader &shader,
+                 const fastuidraw::PainterData &draw,
+                 enum fastuidraw::PainterEnums::join_style js,
+                 float &out_pixel_pad, float &out_item_pad);
+
+    /* adds to dst the attribute and index data of the pieces
+       (see PainterAttributeDataFillerPathStroked::pieces()) of
+       the named data of pdata that are not culled; if there are
+       no pieces, adds the data of the chunk tp.
+     */
+    void
+    add_stroking_pieces(const fastuidraw::PainterAttributeData &pdata,
+                        enum fastuidraw::PainterAttributeDataFillerPathStroked::stroking_data_t tp,
+                        bool pad_known, float pixel_pad, float item_pad,
+                        std::vector<AtrribIndex> &dst);
+
+    /* returns true if the attribute data is entirely
+       clipped when drawn without offsetting its positions;
+       data without a bounding box is never culled.
+     */
+    bool
+    data_is_culled(const fastuidraw::PainterAttributeData &data)
+    {
+      fastuidraw::vec2 pmin, pmax;
+      return data.bounding_box(pmin, pmax)
+        && rect_is_culled(pmin, pmax - pmin);
+    }
+
+    /* increments the counter of drawn or culled items,
+       returns culled.
+     */
+    bool
+    record_item(bool culled)
+    {
+      ++m_stats[culled ? fastuidraw::Painter::num_items_culled : fastuidraw::Painter::num_items_drawn];
+      return culled;
+    }
+
+    /* selects those subsets of path not culled, placing
+       the values in m_work_room.m_subsets; returns the
+       number of subsets selected.
+     */
+    unsigned int
+    select_subsets(const fastuidraw::FilledPath &path);
 
     void
     draw_generic_check(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
@@ -437,6 +595,34 @@ namespace
       m_current_clip = v.value();
     }
 
+    /* returns the operator norm of the transformation
+       from item coordinates to pixel coordinates, ignoring
+       the perspective part of the item matrix.
+     */
+    float
+    current_scale_factor(void);
+
+    fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+    tessellation(const fastuidraw::Path &path)
+    {
+      return path.tessellation(current_scale_factor());
+    }
+
+    /* returns the tessellation of a path to stroke or fill, or
+       NULL if drawing the path is entirely clipped (in which case
+       the item is recorded as culled); checking against the box
+       of the TessellatedPath avoids making the StrokedPath or
+       FilledPath of paths that are not visible.
+     */
+    fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+    tessellation_to_stroke(const fastuidraw::Path &path,
+                           const fastuidraw::PainterStrokeShader &shader,
+                           const fastuidraw::PainterData &draw,
+                           enum fastuidraw::PainterEnums::join_style js);
+
+    fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+    tessellation_to_fill(const fastuidraw::Path &path);
+
     void
     stroke_path_helper(const StrokingData &str,
                        const fastuidraw::PainterStrokeShader &shader,
@@ -444,13 +630,36 @@ namespace
                        bool with_anti_aliasing,
                        const fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker::DataCallBack> &call_back);
 
+    /* draws, as occluders, the complement of those of the
+       half planes of half_planes (in 3D API coordinates) for
+       which skip is false; the occluders are clipped by a
+       slightly larger region than the current clipping. The
+       actions to set the z-value of the occluders are added
+       to out_actions.
+     */
+    void
+    draw_half_plane_complement_occluders(fastuidraw::Painter *p,
+                                         const fastuidraw::PainterClipEquations &half_planes,
+                                         std::bitset<4> skip,
+                                         std::vector<fastuidraw::reference_counted_ptr<fastuidraw::PainterDraw::DelayedAction> > &out_actions);
+
     fastuidraw::vec2 m_one_pixel_width;
     unsigned int m_current_z;
+    /* value of m_current_z at begin() */
+    unsigned int m_begin_z;
+    /* damaged region (see Painter::add_damage()) as boxes in
+       normalized device coordinates together with their
+       union; if m_damage is empty, everything is damaged.
+     */
+    std::vector<fastuidraw::vecN<fastuidraw::vec2, 2> > m_damage;
+    fastuidraw::vecN<fastuidraw::vec2, 2> m_damage_bounds;
     clip_rect_state m_clip_rect_state;
     std::vector<occluder_stack_entry> m_occluder_stack;
     std::vector<state_stack_entry> m_state_stack;
     fastuidraw::reference_counted_ptr<fastuidraw::PainterPacker> m_core;
     fastuidraw::PainterPackedValuePool m_pool;
+    /* GlyphCache whose pending glyphs are uploaded at begin() */
+    fastuidraw::reference_counted_ptr<fastuidraw::GlyphCache> m_glyph_cache;
     fastuidraw::PainterPackedValue<fastuidraw::PainterBrush> m_reset_brush, m_black_brush;
     fastuidraw::PainterPackedValue<fastuidraw::PainterItemMatrix> m_identiy_matrix;
     fastuidraw::PainterItemMatrix m_current_item_matrix;
@@ -459,6 +668,7 @@ namespace
     fastuidraw::PainterPackedValue<fastuidraw::PainterClipEquations> m_current_clip_state;
     clip_rect m_clip_rect_in_item_coordinates;
     PainterWorkRoom m_work_room;
+    fastuidraw::vecN<unsigned int, fastuidraw::Painter::num_stats> m_stats;
   };
 
 }
@@ -626,16 +836,26 @@ set_painter_core_clip(const fastuidraw::PainterPackedValue<fastuidraw::PainterCl
 //////////////////////////////////
 // PainterPrivate methods
 PainterPrivate::
-PainterPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend):
+PainterPrivate(fastuidraw::reference_counted_ptr<fastuidraw::PainterBackend> backend,
+               const fastuidraw::PainterPacker::RecordingParams *recording_params):
   m_pool(backend->configuration_base().alignment())
 {
-  m_core = FASTUIDRAWnew fastuidraw::PainterPacker(backend);
+  if(recording_params != NULL)
+    {
+      m_core = FASTUIDRAWnew fastuidraw::PainterPacker(backend, *recording_params);
+    }
+  else
+    {
+      m_core = FASTUIDRAWnew fastuidraw::PainterPacker(backend);
+    }
   m_reset_brush = m_pool.create_packed_value(fastuidraw::PainterBrush());
   m_black_brush = m_pool.create_packed_value(fastuidraw::PainterBrush()
                                              .pen(0.0f, 0.0f, 0.0f, 0.0f));
   m_identiy_matrix = m_pool.create_packed_value(fastuidraw::PainterItemMatrix());
   m_current_z = 1;
+  m_begin_z = 1;
   m_one_pixel_width = fastuidraw::vec2(0.0f, 0.0f);
+  m_stats = fastuidraw::vecN<unsigned int, fastuidraw::Painter::num_stats>(0u);
 }
 
 void
@@ -815,7 +1035,8 @@ clip_against_plane(const fastuidraw::vec3 &clip_eq,
 
 bool
 PainterPrivate::
-rect_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh)
+rect_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh,
+               float pixel_pad)
 {
   /* apply the current transformation matrix to
      the corners of the clipping rectangle and check
@@ -824,6 +1045,19 @@ rect_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh)
    */
   fastuidraw::vec2 pmax(wh + pmin);
   fastuidraw::vecN<fastuidraw::vec3, 4> pts;
+  fastuidraw::vec2 pad(0.0f, 0.0f);
+
+  if(pixel_pad > 0.0f)
+    {
+      if(m_one_pixel_width.x() <= 0.0f || m_one_pixel_width.y() <= 0.0f)
+        {
+          /* resolution unknown, thus size of a pixel unknown */
+          return false;
+        }
+      /* normalized device coordinates go from -1 to 1 */
+      pad = 2.0f * pixel_pad * m_one_pixel_width;
+    }
+
   pts[0] = m_current_item_matrix.m_item_matrix * fastuidraw::vec3(pmin.x(), pmin.y(), 1.0f);
   pts[1] = m_current_item_matrix.m_item_matrix * fastuidraw::vec3(pmin.x(), pmax.y(), 1.0f);
   pts[2] = m_current_item_matrix.m_item_matrix * fastuidraw::vec3(pmax.x(), pmax.y(), 1.0f);
@@ -833,19 +1067,160 @@ rect_is_culled(const fastuidraw::vec2 &pmin, const fastuidraw::vec2 &wh)
     {
       /* use equations of from clip state
        */
-      return all_pts_culled_by_one_half_plane(pts, m_current_clip);
+      if(all_pts_culled_by_one_half_plane(pts, m_current_clip, pad))
+        {
+          return true;
+        }
     }
-  else
+  else if(all_pts_culled_by_one_half_plane(pts, default_clip_equations(), pad))
+    {
+      return true;
+    }
+
+  return pts_are_undamaged(pts, pad);
+}
+
+bool
+PainterPrivate::
+pts_are_undamaged(const fastuidraw::vecN<fastuidraw::vec3, 4> &pts,
+                  const fastuidraw::vec2 &pad)
+{
+  if(m_damage.empty())
+    {
+      return false;
+    }
+
+  /* compute the box of the points in normalized device
+     coordinates; if a point is not in front, the box is
+     not bounded, take it as damaged.
+   */
+  fastuidraw::vec2 bmin, bmax, pixel_pad;
+  for(int i = 0; i < 4; ++i)
+    {
+      fastuidraw::vec2 p;
+
+      if(pts[i].z() <= 0.0f)
+        {
+          return false;
+        }
+      p = fastuidraw::vec2(pts[i].x(), pts[i].y()) / pts[i].z();
+      if(i == 0)
+        {
+          bmin = bmax = p;
+        }
+      else
+        {
+          bmin.x() = fastuidraw::t_min(bmin.x(), p.x());
+          bmin.y() = fastuidraw::t_min(bmin.y(), p.y());
+          bmax.x() = fastuidraw::t_max(bmax.x(), p.x());
+          bmax.y() = fastuidraw::t_max(bmax.y(), p.y());
+        }
+    }
+
+  /* anti-aliasing can touch a pixel past the box */
+  pixel_pad = pad + 2.0f * m_one_pixel_width;
+  bmin -= pixel_pad;
+  bmax += pixel_pad;
+
+  if(bmax.x() < m_damage_bounds[0].x() || bmin.x() > m_damage_bounds[1].x()
+     || bmax.y() < m_damage_bounds[0].y() || bmin.y() > m_damage_bounds[1].y())
+    {
+      return true;
+    }
+
+  for(unsigned int i = 0, endi = m_damage.size(); i < endi; ++i)
+    {
+      const fastuidraw::vecN<fastuidraw::vec2, 2> &R(m_damage[i]);
+      if(bmax.x() >= R[0].x() && bmin.x() <= R[1].x()
+         && bmax.y() >= R[0].y() && bmin.y() <= R[1].y())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+bool
+PainterPrivate::
+stroking_pad(const fastuidraw::PainterStrokeShader &shader,
+             const fastuidraw::PainterData &draw,
+             enum fastuidraw::PainterEnums::join_style js,
+             float &out_pixel_pad, float &out_item_pad)
+{
+  /* anti-aliased stroking extends 1.5 pixels past the
+     stroke width, pad by a little more than that.
+   */
+  const float anti_alias_pad(2.0f);
+  const fastuidraw::PainterShaderData::DataBase *raw_data;
+  float pixel_distance(0.0f), item_distance(0.0f);
+
+  if(!shader.stroking_data_selector()
+     || (!draw.m_item_shader_data.m_packed_value && draw.m_item_shader_data.m_value == NULL))
+    {
+      return false;
+    }
+
+  raw_data = draw.m_item_shader_data.data().data_base();
+  if(raw_data == NULL
+     || !shader.stroking_data_selector()->stroking_distances(raw_data, js, pixel_distance, item_distance))
+    {
+      return false;
+    }
+
+  out_pixel_pad = pixel_distance + anti_alias_pad;
+  out_item_pad = item_distance;
+  return true;
+}
+
+void
+PainterPrivate::
+add_stroking_pieces(const fastuidraw::PainterAttributeData &pdata,
+                    enum fastuidraw::PainterAttributeDataFillerPathStroked::stroking_data_t tp,
+                    bool pad_known, float pixel_pad, float item_pad,
+                    std::vector<AtrribIndex> &dst)
+{
+  fastuidraw::range_type<unsigned int> R;
+
+  R = fastuidraw::PainterAttributeDataFillerPathStroked::pieces(pdata, tp);
+  if(R.m_begin == R.m_end)
+    {
+      dst.push_back(AtrribIndex());
+      dst.back().m_attribs = pdata.attribute_data_chunk(tp);
+      dst.back().m_indices = pdata.index_data_chunk(tp);
+      return;
+    }
+
+  for(unsigned int K = R.m_begin; K < R.m_end; ++K)
     {
-      fastuidraw::PainterClipEquations clip_eq;
-      clip_eq.m_clip_equations[0] = fastuidraw::vec3( 1.0f,  0.0f, 1.0f);
-      clip_eq.m_clip_equations[1] = fastuidraw::vec3(-1.0f,  0.0f, 1.0f);
-      clip_eq.m_clip_equations[2] = fastuidraw::vec3( 0.0f,  1.0f, 1.0f);
-      clip_eq.m_clip_equations[3] = fastuidraw::vec3( 0.0f, -1.0f, 1.0f);
-      return all_pts_culled_by_one_half_plane(pts, clip_eq);
+      fastuidraw::vec2 pmin, pmax;
+
+      if(!pad_known
+         || !pdata.attribute_data_chunk_bounding_box(K, pmin, pmax)
+         || !stroke_is_culled(pixel_pad, item_pad, pmin, pmax))
+        {
+          dst.push_back(AtrribIndex());
+          dst.back().m_attribs = pdata.attribute_data_chunk(K);
+          dst.back().m_indices = pdata.index_data_chunk(K);
+        }
     }
 }
 
+unsigned int
+PainterPrivate::
+select_subsets(const fastuidraw::FilledPath &path)
+{
+  fastuidraw::PainterClipEquations clip_eq;
+
+  clip_eq = (m_clip_rect_state.m_clip_rect.m_enabled) ?
+    m_current_clip :
+    default_clip_equations();
+
+  m_work_room.m_subsets.resize(path.number_subsets());
+  return path.select_subsets(clip_eq.m_clip_equations,
+                             m_current_item_matrix.m_item_matrix,
+                             fastuidraw::make_c_array(m_work_room.m_subsets));
+}
+
 void
 PainterPrivate::
 draw_generic_check(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> &shader,
@@ -865,6 +1240,85 @@ draw_generic_check(const fastuidraw::reference_counted_ptr<fastuidraw::PainterIt
     }
 }
 
+float
+PainterPrivate::
+current_scale_factor(void)
+{
+  const fastuidraw::float3x3 &m(m_current_item_matrix.m_item_matrix);
+  float a, b, c, d, w, e, det;
+
+  if(m_one_pixel_width.x() <= 0.0f || m_one_pixel_width.y() <= 0.0f || m(2, 2) == 0.0f)
+    {
+      return 1.0f;
+    }
+
+  /* the linear part of the transformation to pixel
+     coordinates is diag(0.5 / m_one_pixel_width) applied
+     to the upper-left 2x2 block of m divided by m(2, 2);
+     its operator norm is the largest singular value,
+     which for a 2x2 matrix has a closed form.
+   */
+  w = fastuidraw::t_abs(m(2, 2));
+  a = 0.5f * m(0, 0) / (m_one_pixel_width.x() * w);
+  b = 0.5f * m(0, 1) / (m_one_pixel_width.x() * w);
+  c = 0.5f * m(1, 0) / (m_one_pixel_width.y() * w);
+  d = 0.5f * m(1, 1) / (m_one_pixel_width.y() * w);
+  e = a * a + b * b + c * c + d * d;
+  det = a * d - b * c;
+  return fastuidraw::t_sqrt(0.5f * (e + fastuidraw::t_sqrt(fastuidraw::t_max(0.0f, e * e - 4.0f * det * det))));
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+PainterPrivate::
+tessellation_to_stroke(const fastuidraw::Path &path,
+                       const fastuidraw::PainterStrokeShader &shader,
+                       const fastuidraw::PainterData &draw,
+                       enum fastuidraw::PainterEnums::join_style js)
+{
+  fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> tess;
+
+  if(!m_clip_rect_state.m_all_content_culled)
+    {
+      tess = tessellation(path);
+      if(stroke_is_culled(shader, draw, js, tess->bounding_box_min(), tess->bounding_box_max()))
+        {
+          tess = fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>();
+        }
+    }
+
+  if(!tess)
+    {
+      record_item(true);
+    }
+  return tess;
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+PainterPrivate::
+tessellation_to_fill(const fastuidraw::Path &path)
+{
+  fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> tess;
+
+  if(!m_clip_rect_state.m_all_content_culled)
+    {
+      fastuidraw::vec2 pmin, pmax;
+
+      tess = tessellation(path);
+      pmin = tess->bounding_box_min();
+      pmax = tess->bounding_box_max();
+      if(rect_is_culled(pmin, pmax - pmin))
+        {
+          tess = fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>();
+        }
+    }
+
+  if(!tess)
+    {
+      record_item(true);
+    }
+  return tess;
+}
+
 void
 PainterPrivate::
 stroke_path_helper(const StrokingData &str,
@@ -875,11 +1329,11 @@ stroke_path_helper(const StrokingData &str,
 {
   using namespace fastuidraw;
 
-  unsigned int startz, zinc_sum(0), num_joins;
+  unsigned int startz, zinc_sum(0), num_joins, num_edges;
   bool modify_z;
   const reference_counted_ptr<PainterItemShader> *sh;
-  std::vector<const_c_array<PainterAttribute> > vattrib_chunks(str.m_joins.size() + 2);
-  std::vector<const_c_array<PainterIndex> > vindex_chunks(str.m_joins.size() + 2);
+  std::vector<const_c_array<PainterAttribute> > vattrib_chunks(str.m_joins.size() + str.m_edges.size() + 1);
+  std::vector<const_c_array<PainterIndex> > vindex_chunks(str.m_joins.size() + str.m_edges.size() + 1);
   c_array<const_c_array<PainterAttribute> > attrib_chunks;
   c_array<const_c_array<PainterIndex> > index_chunks;
 
@@ -892,10 +1346,15 @@ stroke_path_helper(const StrokingData &str,
       attrib_chunks[J] = str.m_joins[J].m_attribs;
       index_chunks [J] = str.m_joins[J].m_indices;
     }
-  attrib_chunks[num_joins + 0] = str.m_edges.m_attribs;
-  index_chunks [num_joins + 0] = str.m_edges.m_indices;
-  attrib_chunks[num_joins + 1] = str.m_caps.m_attribs;
-  index_chunks [num_joins + 1] = str.m_caps.m_indices;
+
+  num_edges = str.m_edges.size();
+  for(unsigned int E = 0; E < num_edges; ++E)
+    {
+      attrib_chunks[num_joins + E] = str.m_edges[E].m_attribs;
+      index_chunks [num_joins + E] = str.m_edges[E].m_indices;
+    }
+  attrib_chunks[num_joins + num_edges] = str.m_caps.m_attribs;
+  index_chunks [num_joins + num_edges] = str.m_caps.m_indices;
 
   startz = m_current_z;
   modify_z = !with_anti_aliasing || shader.aa_type() == PainterStrokeShader::draws_solid_then_fuzz;
@@ -920,15 +1379,15 @@ stroke_path_helper(const StrokingData &str,
 
       incr_z -= str.m_edge_zinc;
       draw_generic_check(*sh, draw,
-                         attrib_chunks.sub_array(num_joins, 1),
-                         index_chunks.sub_array(num_joins, 1),
+                         attrib_chunks.sub_array(num_joins, num_edges),
+                         index_chunks.sub_array(num_joins, num_edges),
                          fastuidraw::const_c_array<unsigned int>(),
                          startz + incr_z + 1, call_back);
 
       incr_z -= str.m_cap_zinc;
       draw_generic_check(*sh, draw,
-                         attrib_chunks.sub_array(num_joins + 1, 1),
-                         index_chunks.sub_array(num_joins + 1, 1),
+                         attrib_chunks.sub_array(num_joins + num_edges, 1),
+                         index_chunks.sub_array(num_joins + num_edges, 1),
                          fastuidraw::const_c_array<unsigned int>(),
                          startz + incr_z + 1, call_back);
     }
@@ -956,12 +1415,86 @@ stroke_path_helper(const StrokingData &str,
     }
 }
 
+void
+PainterPrivate::
+draw_half_plane_complement_occluders(fastuidraw::Painter *p,
+                                     const fastuidraw::PainterClipEquations &half_planes,
+                                     std::bitset<4> skip,
+                                     std::vector<fastuidraw::reference_counted_ptr<fastuidraw::PainterDraw::DelayedAction> > &out_actions)
+{
+  /* The half planes are in 3D api coordinates, so set the
+     matrix temporarily to identity. Note that we use the
+     interface directly in m_core because
+     Painter::transformation_state() sets
+     m_clip_rect_state.m_item_matrix_tricky to true.
+   */
+  fastuidraw::PainterPackedValue<fastuidraw::PainterItemMatrix> matrix_state;
+  matrix_state = current_item_marix_state();
+  assert(matrix_state);
+  current_item_matrix_state(m_identiy_matrix);
+
+  fastuidraw::PainterPackedValue<fastuidraw::PainterClipEquations> clip_state;
+  clip_state = current_clip_state();
+  assert(clip_state);
+
+  fastuidraw::reference_counted_ptr<ZDataCallBack> zdatacallback;
+  zdatacallback = FASTUIDRAWnew ZDataCallBack();
+
+  fastuidraw::reference_counted_ptr<fastuidraw::PainterBlendShader> old_blend;
+  fastuidraw::BlendMode::packed_value old_blend_mode;
+  old_blend = p->blend_shader();
+  old_blend_mode = p->blend_mode();
+  p->blend_shader(fastuidraw::PainterEnums::blend_porter_duff_dst);
+
+  /* we temporarily set the clipping to a slightly
+     larger rectangle when drawing the occluders.
+     We do this because round off error can have us
+     miss a few pixels when drawing the occluder
+   */
+  fastuidraw::PainterClipEquations slightly_bigger(clip_state.value());
+  for(unsigned int i = 0; i < 4; ++i)
+    {
+      float f;
+      fastuidraw::vec3 &eq(slightly_bigger.m_clip_equations[i]);
+
+      f = fastuidraw::t_abs(eq.x()) * m_one_pixel_width.x() + fastuidraw::t_abs(eq.y()) * m_one_pixel_width.y();
+      eq.z() += f;
+    }
+  set_current_clip(slightly_bigger);
+
+  /* draw the half plane occluders
+   */
+  for(unsigned int i = 0; i < 4; ++i)
+    {
+      if(!skip[i])
+        {
+          draw_half_plane_complement(fastuidraw::PainterData(m_black_brush), p,
+                                     half_planes.m_clip_equations[i], zdatacallback);
+        }
+    }
+
+  current_clip_state(clip_state);
+  current_item_matrix_state(matrix_state);
+  p->blend_shader(old_blend, old_blend_mode);
+
+  out_actions.insert(out_actions.end(),
+                     zdatacallback->m_actions.begin(),
+                     zdatacallback->m_actions.end());
+}
+
 //////////////////////////////////
 // fastuidraw::Painter methods
 fastuidraw::Painter::
 Painter(reference_counted_ptr<PainterBackend> backend)
 {
-  m_d = FASTUIDRAWnew PainterPrivate(backend);
+  m_d = FASTUIDRAWnew PainterPrivate(backend, NULL);
+}
+
+fastuidraw::Painter::
+Painter(reference_counted_ptr<PainterBackend> backend,
+        const PainterPacker::RecordingParams &params)
+{
+  m_d = FASTUIDRAWnew PainterPrivate(backend, &params);
 }
 
 fastuidraw::Painter::
@@ -996,6 +1529,71 @@ target_resolution(int w, int h)
   d->m_core->target_resolution(w, h);
 }
 
+void
+fastuidraw::Painter::
+add_damage(const vec2 &pmin, const vec2 &wh)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
+  if(d->m_one_pixel_width.x() <= 0.0f || d->m_one_pixel_width.y() <= 0.0f)
+    {
+      assert(!"Painter::add_damage() requires the target resolution to be set");
+      return;
+    }
+
+  if(wh.x() <= 0.0f || wh.y() <= 0.0f)
+    {
+      return;
+    }
+
+  /* pixel coordinates to normalized device coordinates, pixel
+     y = 0 is the top of the surface which is normalized device
+     y = 1 (see float_orthogonal_projection_params(0, w, h, 0)),
+     so the bottom of the rectangle gives its min-y.
+   */
+  vecN<vec2, 2> R;
+  R[0].x() = 2.0f * pmin.x() * d->m_one_pixel_width.x() - 1.0f;
+  R[0].y() = 1.0f - 2.0f * (pmin.y() + wh.y()) * d->m_one_pixel_width.y();
+  R[1].x() = 2.0f * (pmin.x() + wh.x()) * d->m_one_pixel_width.x() - 1.0f;
+  R[1].y() = 1.0f - 2.0f * pmin.y() * d->m_one_pixel_width.y();
+
+  if(d->m_damage.empty())
+    {
+      d->m_damage_bounds = R;
+    }
+  else
+    {
+      d->m_damage_bounds[0].x() = t_min(d->m_damage_bounds[0].x(), R[0].x());
+      d->m_damage_bounds[0].y() = t_min(d->m_damage_bounds[0].y(), R[0].y());
+      d->m_damage_bounds[1].x() = t_max(d->m_damage_bounds[1].x(), R[1].x());
+      d->m_damage_bounds[1].y() = t_max(d->m_damage_bounds[1].y(), R[1].y());
+    }
+  d->m_damage.push_back(R);
+}
+
+bool
+fastuidraw::Painter::
+damage_bounds(vec2 &out_min, vec2 &out_max) const
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
+  if(d->m_damage.empty())
+    {
+      return false;
+    }
+
+  /* normalized device coordinates to pixel coordinates,
+     the inverse of the conversion of add_damage().
+   */
+  out_min.x() = 0.5f * (d->m_damage_bounds[0].x() + 1.0f) / d->m_one_pixel_width.x();
+  out_min.y() = 0.5f * (1.0f - d->m_damage_bounds[1].y()) / d->m_one_pixel_width.y();
+  out_max.x() = 0.5f * (d->m_damage_bounds[1].x() + 1.0f) / d->m_one_pixel_width.x();
+  out_max.y() = 0.5f * (1.0f - d->m_damage_bounds[0].y()) / d->m_one_pixel_width.y();
+  return true;
+}
+
 void
 fastuidraw::Painter::
 begin(bool reset_z)
@@ -1003,12 +1601,20 @@ begin(bool reset_z)
   PainterPrivate *d;
   d = reinterpret_cast<PainterPrivate*>(m_d);
 
+  if(d->m_glyph_cache)
+    {
+      d->m_glyph_cache->upload_pending_glyphs();
+    }
+
   d->m_core->begin();
+  d->m_stats = vecN<unsigned int, num_stats>(0u);
 
   if(reset_z)
     {
       d->m_current_z = 1;
     }
+  d->m_begin_z = d->m_current_z;
+  d->m_damage.clear();
 
   d->m_clip_rect_state.m_item_matrix_tricky = false;
   d->m_clip_rect_state.m_inverse_transpose_not_ready = false;
@@ -1025,6 +1631,105 @@ begin(bool reset_z)
   blend_shader(PainterEnums::blend_porter_duff_src_over);
 }
 
+void
+fastuidraw::Painter::
+begin_at_z(unsigned int z)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
+  begin(false);
+  d->m_current_z = z;
+  d->m_begin_z = z;
+}
+
+void
+fastuidraw::Painter::
+splice(const Painter &recorded)
+{
+  PainterPrivate *d, *src;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  src = reinterpret_cast<PainterPrivate*>(recorded.m_d);
+
+  d->m_core->splice(*src->m_core);
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::Painter::DisplayList>
+fastuidraw::Painter::
+retain(void) const
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
+  assert(d->m_current_z >= d->m_begin_z);
+  return FASTUIDRAWnew DisplayList(d->m_core->retain(),
+                                   d->m_current_item_matrix.m_item_matrix,
+                                   d->m_begin_z, d->m_current_z - d->m_begin_z);
+}
+
+void
+fastuidraw::Painter::
+replay(const DisplayList &list)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
+  if(d->m_clip_rect_state.m_all_content_culled)
+    {
+      return;
+    }
+
+  /* the recorded items have their matrices in the 3D API
+     coordinates of the recording Painter; going from them
+     to those of this Painter is given by the current
+     transformation times the inverse of the transformation
+     of the recording Painter.
+   */
+  float3x3 inverse, tr;
+  list.m_transformation.inverse(inverse);
+  tr = d->m_current_item_matrix.m_item_matrix * inverse;
+
+  /* The clip equations of the recorded items are of their
+     own clipping, which is within the window of the recording
+     Painter. If there is a clipping rectangle, draw as
+     occluders the complement of those of its half planes
+     that do not contain that window after transformation.
+   */
+  std::vector<reference_counted_ptr<PainterDraw::DelayedAction> > actions;
+  if(d->m_clip_rect_state.m_clip_rect.m_enabled)
+    {
+      const PainterClipEquations &eq(d->m_current_clip);
+      vecN<vec3, 4> q;
+      std::bitset<4> skip_occluder;
+
+      q[0] = tr * vec3(-1.0f, -1.0f, 1.0f);
+      q[1] = tr * vec3( 1.0f, -1.0f, 1.0f);
+      q[2] = tr * vec3(-1.0f,  1.0f, 1.0f);
+      q[3] = tr * vec3( 1.0f,  1.0f, 1.0f);
+      for(int i = 0; i < 4; ++i)
+        {
+          skip_occluder[i] = dot(q[0], eq.m_clip_equations[i]) >= 0.0f
+            && dot(q[1], eq.m_clip_equations[i]) >= 0.0f
+            && dot(q[2], eq.m_clip_equations[i]) >= 0.0f
+            && dot(q[3], eq.m_clip_equations[i]) >= 0.0f;
+        }
+
+      if(!skip_occluder.all())
+        {
+          d->draw_half_plane_complement_occluders(this, eq, skip_occluder, actions);
+        }
+    }
+
+  d->m_core->replay(*list.m_draws, tr,
+                    static_cast<int>(d->m_current_z) - static_cast<int>(list.m_z_begin));
+  d->m_current_z += list.m_z_range;
+
+  if(!actions.empty())
+    {
+      occluder_stack_entry(actions).on_pop(this);
+    }
+}
+
 void
 fastuidraw::Painter::
 end(void)
@@ -1183,8 +1888,14 @@ stroke_path(const PainterStrokeShader &shader, const PainterData &draw,
 
   using namespace PainterEnums;
   enum PainterAttributeDataFillerPathStroked::stroking_data_t cap, join, edge;
+  bool pad_known;
+  float pixel_pad(0.0f), item_pad(0.0f);
+  vec2 pmin, pmax;
 
-  if(d->m_clip_rect_state.m_all_content_culled)
+  pad_known = d->stroking_pad(shader, draw, js, pixel_pad, item_pad);
+  if(d->record_item(d->m_clip_rect_state.m_all_content_culled
+                    || (pad_known && pdata.bounding_box(pmin, pmax)
+                        && d->stroke_is_culled(pixel_pad, item_pad, pmin, pmax))))
     {
       return;
     }
@@ -1225,17 +1936,19 @@ stroke_path(const PainterStrokeShader &shader, const PainterData &draw,
 
   StrokingData str;
 
-  str.m_edges.m_attribs = pdata.attribute_data_chunk(edge);
-  str.m_edges.m_indices = pdata.index_data_chunk(edge);
+  /* only the pieces of the edges and joins that are
+     not culled are sent; the z-increments are those
+     of all the edges and joins since each attribute
+     carries its own depth value.
+   */
+  d->add_stroking_pieces(pdata, edge, pad_known, pixel_pad, item_pad, str.m_edges);
   str.m_edge_zinc = pdata.increment_z_value(edge);
 
   str.m_caps.m_attribs = pdata.attribute_data_chunk(cap);
   str.m_caps.m_indices = pdata.index_data_chunk(cap);
   str.m_cap_zinc = pdata.increment_z_value(cap);
 
-  str.m_joins.resize(1);
-  str.m_joins[0].m_attribs = pdata.attribute_data_chunk(join);
-  str.m_joins[0].m_indices = pdata.index_data_chunk(join);
+  d->add_stroking_pieces(pdata, join, pad_known, pixel_pad, item_pad, str.m_joins);
   str.m_join_zinc = pdata.increment_z_value(join);
 
   d->stroke_path_helper(str, shader, draw, with_anti_aliasing, call_back);
@@ -1248,9 +1961,17 @@ stroke_path(const PainterData &draw, const Path &path,
             bool with_anti_aliasing,
             const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
-  stroke_path(default_shaders().stroke_shader(), draw,
-              path.tessellation()->stroked()->painter_data(),
-              cp, js, with_anti_aliasing, call_back);
+  PainterPrivate *d;
+  reference_counted_ptr<const TessellatedPath> tess;
+  const PainterStrokeShader &shader(default_shaders().stroke_shader());
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  tess = d->tessellation_to_stroke(path, shader, draw, js);
+  if(tess)
+    {
+      stroke_path(shader, draw, tess->stroked()->painter_data(),
+                  cp, js, with_anti_aliasing, call_back);
+    }
 }
 
 void
@@ -1260,9 +1981,17 @@ stroke_path_pixel_width(const PainterData &draw, const Path &path,
                         bool with_anti_aliasing,
                         const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
-  stroke_path(default_shaders().pixel_width_stroke_shader(), draw,
-              path.tessellation()->stroked()->painter_data(),
-              cp, js, with_anti_aliasing, call_back);
+  PainterPrivate *d;
+  reference_counted_ptr<const TessellatedPath> tess;
+  const PainterStrokeShader &shader(default_shaders().pixel_width_stroke_shader());
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  tess = d->tessellation_to_stroke(path, shader, draw, js);
+  if(tess)
+    {
+      stroke_path(shader, draw, tess->stroked()->painter_data(),
+                  cp, js, with_anti_aliasing, call_back);
+    }
 }
 
 void
@@ -1293,9 +2022,15 @@ stroke_dashed_path(const PainterDashedStrokeShaderSet &shader, const PainterData
   StrokingData str;
   bool have_caps(cp == rounded_caps || cp == square_caps);
   PainterPrivate *d;
+  bool pad_known;
+  float pixel_pad(0.0f), item_pad(0.0f);
+  vec2 pmin, pmax;
 
   d = reinterpret_cast<PainterPrivate*>(m_d);
-  if(d->m_clip_rect_state.m_all_content_culled)
+  pad_known = d->stroking_pad(shader.shader(cp), draw, js, pixel_pad, item_pad);
+  if(d->record_item(d->m_clip_rect_state.m_all_content_culled
+                    || (pad_known && pdata.bounding_box(pmin, pmax)
+                        && d->stroke_is_culled(pixel_pad, item_pad, pmin, pmax))))
     {
       return;
     }
@@ -1331,8 +2066,7 @@ stroke_dashed_path(const PainterDashedStrokeShaderSet &shader, const PainterData
         PainterAttributeDataFillerPathStroked::stroking_data_count;
     }
 
-  str.m_edges.m_attribs = pdata.attribute_data_chunk(edge);
-  str.m_edges.m_indices = pdata.index_data_chunk(edge);
+  d->add_stroking_pieces(pdata, edge, pad_known, pixel_pad, item_pad, str.m_edges);
   str.m_edge_zinc = pdata.increment_z_value(edge);
 
   //no caps
@@ -1421,9 +2155,17 @@ stroke_dashed_path(const PainterData &draw, const Path &path,
                    bool with_anti_aliasing,
                    const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
-  stroke_dashed_path(default_shaders().dashed_stroke_shader(), draw,
-                     path.tessellation()->stroked()->painter_data(),
-                     close_contour, cp, js, with_anti_aliasing, call_back);
+  PainterPrivate *d;
+  reference_counted_ptr<const TessellatedPath> tess;
+  const PainterDashedStrokeShaderSet &shader(default_shaders().dashed_stroke_shader());
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  tess = d->tessellation_to_stroke(path, shader.shader(cp), draw, js);
+  if(tess)
+    {
+      stroke_dashed_path(shader, draw, tess->stroked()->painter_data(),
+                         close_contour, cp, js, with_anti_aliasing, call_back);
+    }
 }
 
 void
@@ -1433,9 +2175,17 @@ stroke_dashed_path_pixel_width(const PainterData &draw, const Path &path,
                                bool with_anti_aliasing,
                                const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
-   stroke_dashed_path(default_shaders().pixel_width_dashed_stroke_shader(), draw,
-                      path.tessellation()->stroked()->painter_data(),
-                      close_contour, cp, js, with_anti_aliasing, call_back);
+  PainterPrivate *d;
+  reference_counted_ptr<const TessellatedPath> tess;
+  const PainterDashedStrokeShaderSet &shader(default_shaders().pixel_width_dashed_stroke_shader());
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  tess = d->tessellation_to_stroke(path, shader.shader(cp), draw, js);
+  if(tess)
+    {
+      stroke_dashed_path(shader, draw, tess->stroked()->painter_data(),
+                         close_contour, cp, js, with_anti_aliasing, call_back);
+    }
 }
 
 void
@@ -1444,18 +2194,81 @@ fill_path(const reference_counted_ptr<PainterItemShader> &shader, const PainterD
           const PainterAttributeData &data, enum PainterEnums::fill_rule_t fill_rule,
           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+
+  if(d->record_item(d->m_clip_rect_state.m_all_content_culled
+                    || d->data_is_culled(data)))
+    {
+      return;
+    }
+
   draw_generic(shader, draw, data.attribute_data_chunk(0),
                data.index_data_chunk(fill_rule),
                call_back);
 }
 
+void
+fastuidraw::Painter::
+fill_path(const reference_counted_ptr<PainterItemShader> &shader, const PainterData &draw,
+          const FilledPath &filled_path, enum PainterEnums::fill_rule_t fill_rule,
+          const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
+{
+  PainterPrivate *d;
+  unsigned int num_subsets;
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  if(d->m_clip_rect_state.m_all_content_culled)
+    {
+      d->record_item(true);
+      return;
+    }
+
+  num_subsets = d->select_subsets(filled_path);
+  if(d->record_item(num_subsets == 0))
+    {
+      return;
+    }
+
+  d->m_work_room.m_attrib_chunks.clear();
+  d->m_work_room.m_index_chunks.clear();
+  for(unsigned int i = 0; i < num_subsets; ++i)
+    {
+      FilledPath::Subset subset(filled_path.subset(d->m_work_room.m_subsets[i]));
+      const PainterAttributeData &data(subset.painter_data());
+      const_c_array<PainterIndex> chunk(data.index_data_chunk(fill_rule));
+
+      if(!chunk.empty())
+        {
+          d->m_work_room.m_attrib_chunks.push_back(data.attribute_data_chunk(0));
+          d->m_work_room.m_index_chunks.push_back(chunk);
+        }
+    }
+
+  if(!d->m_work_room.m_index_chunks.empty())
+    {
+      draw_generic(shader, draw,
+                   make_c_array(d->m_work_room.m_attrib_chunks),
+                   make_c_array(d->m_work_room.m_index_chunks),
+                   call_back);
+    }
+}
+
 void
 fastuidraw::Painter::
 fill_path(const reference_counted_ptr<PainterItemShader> &shader, const PainterData &draw,
           const Path &path, enum PainterEnums::fill_rule_t fill_rule,
           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
-  fill_path(shader, draw, path.tessellation()->filled()->painter_data(), fill_rule, call_back);
+  PainterPrivate *d;
+  reference_counted_ptr<const TessellatedPath> tess;
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  tess = d->tessellation_to_fill(path);
+  if(tess)
+    {
+      fill_path(shader, draw, *tess->filled(), fill_rule, call_back);
+    }
 }
 
 void
@@ -1475,44 +2288,70 @@ fill_path(const reference_counted_ptr<PainterItemShader> &shader, const PainterD
   PainterPrivate *d;
   d = reinterpret_cast<PainterPrivate*>(m_d);
 
-  if(d->m_clip_rect_state.m_all_content_culled)
+  if(d->record_item(d->m_clip_rect_state.m_all_content_culled
+                    || d->data_is_culled(data)))
     {
       return;
     }
 
   d->m_work_room.m_index_chunks.clear();
   d->m_work_room.m_selector.clear();
+  add_custom_fill_chunks(data, fill_rule, 0, d->m_work_room);
 
-  /* walk through what winding numbers are non-empty.
-   */
-  const_c_array<unsigned int> chks(data.non_empty_index_data_chunks());
-  for(unsigned int i = 0; i < chks.size(); ++i)
+  if(!d->m_work_room.m_selector.empty())
     {
-      unsigned int k;
-      int winding_number;
+      draw_generic(shader, draw, data.attribute_data_chunks(),
+                   make_c_array(d->m_work_room.m_index_chunks),
+                   make_c_array(d->m_work_room.m_selector), call_back);
+    }
 
-      k = chks[i];
-      if(k == PainterEnums::complement_nonzero_fill_rule || k >= PainterEnums::fill_rule_data_count)
+}
+
+void
+fastuidraw::Painter::
+fill_path(const reference_counted_ptr<PainterItemShader> &shader, const PainterData &draw,
+          const FilledPath &filled_path, const CustomFillRuleBase &fill_rule,
+          const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
+{
+  PainterPrivate *d;
+  unsigned int num_subsets;
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  if(d->m_clip_rect_state.m_all_content_culled)
+    {
+      d->record_item(true);
+      return;
+    }
+
+  num_subsets = d->select_subsets(filled_path);
+  if(d->record_item(num_subsets == 0))
+    {
+      return;
+    }
+
+  d->m_work_room.m_attrib_chunks.clear();
+  d->m_work_room.m_index_chunks.clear();
+  d->m_work_room.m_selector.clear();
+  for(unsigned int i = 0; i < num_subsets; ++i)
+    {
+      FilledPath::Subset subset(filled_path.subset(d->m_work_room.m_subsets[i]));
+      const PainterAttributeData &data(subset.painter_data());
+
+      if(add_custom_fill_chunks(data, fill_rule,
+                                d->m_work_room.m_attrib_chunks.size(),
+                                d->m_work_room))
         {
-          winding_number = PainterAttributeDataFillerPathFill::winding_number_from_index_chunk(k);
-          if(fill_rule(winding_number))
-            {
-              const_c_array<PainterIndex> chunk;
-              assert(!data.index_data_chunk(k).empty());
-              chunk = data.index_data_chunk(k);
-              d->m_work_room.m_index_chunks.push_back(chunk);
-              d->m_work_room.m_selector.push_back(0);
-            }
+          d->m_work_room.m_attrib_chunks.push_back(data.attribute_data_chunk(0));
         }
     }
 
   if(!d->m_work_room.m_selector.empty())
     {
-      draw_generic(shader, draw, data.attribute_data_chunks(),
+      draw_generic(shader, draw,
+                   make_c_array(d->m_work_room.m_attrib_chunks),
                    make_c_array(d->m_work_room.m_index_chunks),
                    make_c_array(d->m_work_room.m_selector), call_back);
     }
-
 }
 
 void
@@ -1521,7 +2360,15 @@ fill_path(const reference_counted_ptr<PainterItemShader> &shader,
           const PainterData &draw, const Path &path, const CustomFillRuleBase &fill_rule,
           const reference_counted_ptr<PainterPacker::DataCallBack> &call_back)
 {
-  fill_path(shader, draw, path.tessellation()->filled()->painter_data(), fill_rule, call_back);
+  PainterPrivate *d;
+  reference_counted_ptr<const TessellatedPath> tess;
+
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  tess = d->tessellation_to_fill(path);
+  if(tess)
+    {
+      fill_path(shader, draw, *tess->filled(), fill_rule, call_back);
+    }
 }
 
 void
@@ -1541,7 +2388,8 @@ draw_glyphs(const PainterGlyphShader &shader, const PainterData &draw,
   PainterPrivate *d;
   d = reinterpret_cast<PainterPrivate*>(m_d);
 
-  if(d->m_clip_rect_state.m_all_content_culled)
+  if(d->record_item(d->m_clip_rect_state.m_all_content_culled
+                    || d->data_is_culled(data)))
     {
       return;
     }
@@ -1935,7 +2783,7 @@ clipInRect(const vec2 &pmin, const vec2 &wh)
       2. we draw the -complement- of the half planes of each
          of the old clip equations as occluders
    */
-  PainterPackedValue<PainterClipEquations> prev_clip, current_clip;
+  PainterPackedValue<PainterClipEquations> prev_clip;
 
   prev_clip = d->current_clip_state();
   assert(prev_clip);
@@ -1944,7 +2792,6 @@ clipInRect(const vec2 &pmin, const vec2 &wh)
 
   std::bitset<4> skip_occluder;
   skip_occluder = d->m_clip_rect_state.set_painter_core_clip(prev_clip, d);
-  current_clip = d->current_clip_state();
 
   if(d->m_clip_rect_state.m_all_content_culled)
     {
@@ -1964,61 +2811,13 @@ clipInRect(const vec2 &pmin, const vec2 &wh)
       return;
     }
 
-  /* draw the complement of the half planes. The half planes
-     are in 3D api coordinates, so set the matrix temporarily
-     to identity. Note that we use the interface directly
-     in m_core because this->transformation_state() sets
-     m_clip_rect_state.m_item_matrix_tricky to true.
+  /* draw the complement of the half planes of the old
+     clip equations as occluders and add them to the
+     occluder stack.
    */
-  PainterPackedValue<PainterItemMatrix> matrix_state;
-  matrix_state = d->current_item_marix_state();
-  assert(matrix_state);
-  d->current_item_matrix_state(d->m_identiy_matrix);
-
-  reference_counted_ptr<ZDataCallBack> zdatacallback;
-  zdatacallback = FASTUIDRAWnew ZDataCallBack();
-
-  fastuidraw::reference_counted_ptr<PainterBlendShader> old_blend;
-  BlendMode::packed_value old_blend_mode;
-  old_blend = blend_shader();
-  old_blend_mode = blend_mode();
-  blend_shader(PainterEnums::blend_porter_duff_dst);
-
-  /* we temporarily set the clipping to a slightly
-     larger rectangle when drawing the occluders.
-     We do this because round off error can have us
-     miss a few pixels when drawing the occluder
-   */
-  PainterClipEquations slightly_bigger(current_clip.value());
-  for(unsigned int i = 0; i < 4; ++i)
-    {
-      float f;
-      vec3 &eq(slightly_bigger.m_clip_equations[i]);
-
-      f = fastuidraw::t_abs(eq.x()) * d->m_one_pixel_width.x() + fastuidraw::t_abs(eq.y()) * d->m_one_pixel_width.y();
-      eq.z() += f;
-    }
-  d->set_current_clip(slightly_bigger);
-
-  /* draw the half plane occluders
-   */
-  for(unsigned int i = 0; i < 4; ++i)
-    {
-      if(!skip_occluder[i])
-        {
-          draw_half_plane_complement(PainterData(d->m_black_brush), this,
-                                     prev_clip.value().m_clip_equations[i], zdatacallback);
-        }
-    }
-
-  d->current_clip_state(current_clip);
-
-  /* add to occluder stack.
-   */
-  d->m_occluder_stack.push_back(occluder_stack_entry(zdatacallback->m_actions));
-
-  d->current_item_matrix_state(matrix_state);
-  blend_shader(old_blend, old_blend_mode);
+  std::vector<reference_counted_ptr<PainterDraw::DelayedAction> > actions;
+  d->draw_half_plane_complement_occluders(this, prev_clip.value(), skip_occluder, actions);
+  d->m_occluder_stack.push_back(occluder_stack_entry(actions));
 }
 
 const fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas>&
@@ -2030,6 +2829,24 @@ glyph_atlas(void) const
   return d->m_core->glyph_atlas();
 }
 
+const fastuidraw::reference_counted_ptr<fastuidraw::GlyphCache>&
+fastuidraw::Painter::
+glyph_cache(void) const
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  return d->m_glyph_cache;
+}
+
+void
+fastuidraw::Painter::
+glyph_cache(const reference_counted_ptr<GlyphCache> &cache)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  d->m_glyph_cache = cache;
+}
+
 const fastuidraw::reference_counted_ptr<fastuidraw::ImageAtlas>&
 fastuidraw::Painter::
 image_atlas(void) const
@@ -2103,6 +2920,52 @@ increment_z(int amount)
   d->m_current_z += amount;
 }
 
+unsigned int
+fastuidraw::Painter::
+query_stat(enum query_stats_t st) const
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  assert(st < num_stats);
+  return d->m_stats[st];
+}
+
+unsigned int
+fastuidraw::Painter::
+query_packer_stat(enum PainterPacker::stats_t st) const
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  return d->m_core->query_stat(st);
+}
+
+void
+fastuidraw::Painter::
+packer_stats_call_back(const reference_counted_ptr<PainterPacker::StatsCallBack> &cb)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  d->m_core->stats_call_back(cb);
+}
+
+void
+fastuidraw::Painter::
+packer_reorder_window(unsigned int N)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  d->m_core->reorder_window(N);
+}
+
+void
+fastuidraw::Painter::
+packer_intern_values(bool v)
+{
+  PainterPrivate *d;
+  d = reinterpret_cast<PainterPrivate*>(m_d);
+  d->m_core->intern_values(v);
+}
+
 void
 fastuidraw::Painter::
 register_shader(const fastuidraw::reference_counted_ptr<PainterItemShader> &shader)
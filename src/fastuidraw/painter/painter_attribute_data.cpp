@@ -27,16 +27,54 @@ namespace
   class PainterAttributeDataPrivate
   {
   public:
+    /* bounding box of a chunk as [min-corner, max-corner],
+       a chunk without a bounding box has min-corner > max-corner
+     */
+    typedef fastuidraw::vecN<fastuidraw::vec2, 2> chunk_box;
+
+    PainterAttributeDataPrivate(void):
+      m_has_bounding_box(false)
+    {}
+
     void
     ready_non_empty_index_data_chunks(void);
 
+    void
+    clear(void);
+
+    template<typename T>
+    static
+    void
+    bake_chunks(fastuidraw::BakedDataWriter &dst,
+                fastuidraw::const_c_array<T> data,
+                const std::vector<fastuidraw::const_c_array<T> > &chunks);
+
+    template<typename T>
+    static
+    bool
+    load_chunks(fastuidraw::BakedDataReader &src,
+                fastuidraw::const_c_array<T> data,
+                std::vector<fastuidraw::const_c_array<T> > &chunks);
+
     std::vector<fastuidraw::PainterAttribute> m_attribute_data;
     std::vector<fastuidraw::PainterIndex> m_index_data;
 
+    /* all of the attribute and index data, points into
+       m_attribute_data and m_index_data or, when loaded
+       by load_baked(), into m_baked_data.
+     */
+    fastuidraw::const_c_array<fastuidraw::PainterAttribute> m_attributes;
+    fastuidraw::const_c_array<fastuidraw::PainterIndex> m_indices;
+    fastuidraw::reference_counted_ptr<const fastuidraw::DataBuffer> m_baked_data;
+
     std::vector<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > m_attribute_chunks;
     std::vector<fastuidraw::const_c_array<fastuidraw::PainterIndex> > m_index_chunks;
     std::vector<unsigned int> m_increment_z;
     std::vector<unsigned int> m_non_empty_index_data_chunks;
+
+    bool m_has_bounding_box;
+    fastuidraw::vec2 m_bounding_box_min, m_bounding_box_max;
+    std::vector<chunk_box> m_chunk_boxes;
   };
 }
 
@@ -54,6 +92,84 @@ ready_non_empty_index_data_chunks(void)
     }
 }
 
+void
+PainterAttributeDataPrivate::
+clear(void)
+{
+  m_attribute_data.clear();
+  m_index_data.clear();
+  m_attributes = fastuidraw::const_c_array<fastuidraw::PainterAttribute>();
+  m_indices = fastuidraw::const_c_array<fastuidraw::PainterIndex>();
+  m_baked_data.clear();
+  m_attribute_chunks.clear();
+  m_index_chunks.clear();
+  m_increment_z.clear();
+  m_non_empty_index_data_chunks.clear();
+  m_has_bounding_box = false;
+  m_chunk_boxes.clear();
+}
+
+/* A chunk is written as the range of data that it covers;
+   chunks made by a PainterAttributeDataFiller always point
+   into the attribute (or index) data given to it.
+ */
+template<typename T>
+void
+PainterAttributeDataPrivate::
+bake_chunks(fastuidraw::BakedDataWriter &dst,
+            fastuidraw::const_c_array<T> data,
+            const std::vector<fastuidraw::const_c_array<T> > &chunks)
+{
+  std::vector<fastuidraw::range_type<unsigned int> > ranges(chunks.size());
+
+  for(unsigned int i = 0, endi = chunks.size(); i < endi; ++i)
+    {
+      if(chunks[i].empty())
+        {
+          ranges[i] = fastuidraw::range_type<unsigned int>(0, 0);
+        }
+      else
+        {
+          unsigned int begin;
+
+          assert(chunks[i].c_ptr() >= data.c_ptr());
+          assert(chunks[i].c_ptr() + chunks[i].size() <= data.c_ptr() + data.size());
+          begin = chunks[i].c_ptr() - data.c_ptr();
+          ranges[i] = fastuidraw::range_type<unsigned int>(begin, begin + chunks[i].size());
+        }
+    }
+  dst.write_array(data);
+  dst.write_array(fastuidraw::make_c_array(ranges));
+}
+
+template<typename T>
+bool
+PainterAttributeDataPrivate::
+load_chunks(fastuidraw::BakedDataReader &src,
+            fastuidraw::const_c_array<T> data,
+            std::vector<fastuidraw::const_c_array<T> > &chunks)
+{
+  fastuidraw::const_c_array<fastuidraw::range_type<unsigned int> > ranges;
+
+  if(!src.read_array(ranges))
+    {
+      return false;
+    }
+
+  chunks.resize(ranges.size());
+  for(unsigned int i = 0, endi = ranges.size(); i < endi; ++i)
+    {
+      const fastuidraw::range_type<unsigned int> &R(ranges[i]);
+      if(R.m_begin > R.m_end || R.m_end > data.size())
+        {
+          src.set_error();
+          return false;
+        }
+      chunks[i] = data.sub_array(R);
+    }
+  return true;
+}
+
 //////////////////////////////////////////////
 // fastuidraw::PainterAttributeData methods
 fastuidraw::PainterAttributeData::
@@ -104,7 +220,80 @@ set_data(const PainterAttributeDataFiller &filler)
                    make_c_array(d->m_index_chunks),
                    make_c_array(d->m_increment_z));
 
+  d->m_attributes = make_c_array(d->m_attribute_data);
+  d->m_indices = make_c_array(d->m_index_data);
+  d->m_baked_data.clear();
   d->ready_non_empty_index_data_chunks();
+  d->m_has_bounding_box = filler.compute_bounding_box(d->m_attributes,
+                                                      d->m_bounding_box_min,
+                                                      d->m_bounding_box_max);
+
+  d->m_chunk_boxes.clear();
+  for(unsigned int i = 0; i < number_attribute_chunks; ++i)
+    {
+      PainterAttributeDataPrivate::chunk_box box;
+
+      if(filler.chunk_has_bounding_box(i)
+         && filler.compute_bounding_box(d->m_attribute_chunks[i], box[0], box[1]))
+        {
+          /* only allocate the boxes once a chunk has one */
+          d->m_chunk_boxes.resize(number_attribute_chunks,
+                                  PainterAttributeDataPrivate::chunk_box(vec2(1.0f, 1.0f),
+                                                                         vec2(-1.0f, -1.0f)));
+          d->m_chunk_boxes[i] = box;
+        }
+    }
+}
+
+void
+fastuidraw::PainterAttributeData::
+bake(BakedDataWriter &dst) const
+{
+  PainterAttributeDataPrivate *d;
+  d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
+
+  PainterAttributeDataPrivate::bake_chunks(dst, d->m_attributes, d->m_attribute_chunks);
+  PainterAttributeDataPrivate::bake_chunks(dst, d->m_indices, d->m_index_chunks);
+  dst.write_array(make_c_array(d->m_increment_z));
+  dst.write_value(uint32_t(d->m_has_bounding_box));
+  dst.write_value(d->m_bounding_box_min);
+  dst.write_value(d->m_bounding_box_max);
+  dst.write_array(make_c_array(d->m_chunk_boxes));
+}
+
+bool
+fastuidraw::PainterAttributeData::
+load_baked(BakedDataReader &src)
+{
+  PainterAttributeDataPrivate *d;
+  const_c_array<unsigned int> increment_z;
+  const_c_array<PainterAttributeDataPrivate::chunk_box> chunk_boxes;
+  uint32_t has_bounding_box;
+
+  d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
+  d->clear();
+
+  if(!src.read_array(d->m_attributes)
+     || !PainterAttributeDataPrivate::load_chunks(src, d->m_attributes, d->m_attribute_chunks)
+     || !src.read_array(d->m_indices)
+     || !PainterAttributeDataPrivate::load_chunks(src, d->m_indices, d->m_index_chunks)
+     || !src.read_array(increment_z)
+     || !src.read_value(has_bounding_box)
+     || !src.read_value(d->m_bounding_box_min)
+     || !src.read_value(d->m_bounding_box_max)
+     || !src.read_array(chunk_boxes)
+     || (!chunk_boxes.empty() && chunk_boxes.size() != d->m_attribute_chunks.size()))
+    {
+      d->clear();
+      return false;
+    }
+
+  d->m_increment_z.assign(increment_z.begin(), increment_z.end());
+  d->m_has_bounding_box = (has_bounding_box != 0);
+  d->m_chunk_boxes.assign(chunk_boxes.begin(), chunk_boxes.end());
+  d->m_baked_data = src.buffer();
+  d->ready_non_empty_index_data_chunks();
+  return true;
 }
 
 fastuidraw::const_c_array<fastuidraw::const_c_array<fastuidraw::PainterAttribute> >
@@ -175,3 +364,34 @@ non_empty_index_data_chunks(void) const
   d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
   return make_c_array(d->m_non_empty_index_data_chunks);
 }
+
+bool
+fastuidraw::PainterAttributeData::
+bounding_box(vec2 &out_min, vec2 &out_max) const
+{
+  PainterAttributeDataPrivate *d;
+  d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
+  if(d->m_has_bounding_box)
+    {
+      out_min = d->m_bounding_box_min;
+      out_max = d->m_bounding_box_max;
+    }
+  return d->m_has_bounding_box;
+}
+
+bool
+fastuidraw::PainterAttributeData::
+attribute_data_chunk_bounding_box(unsigned int i,
+                                  vec2 &out_min, vec2 &out_max) const
+{
+  PainterAttributeDataPrivate *d;
+  d = reinterpret_cast<PainterAttributeDataPrivate*>(m_d);
+  if(i >= d->m_chunk_boxes.size()
+     || d->m_chunk_boxes[i][0].x() > d->m_chunk_boxes[i][1].x())
+    {
+      return false;
+    }
+  out_min = d->m_chunk_boxes[i][0];
+  out_max = d->m_chunk_boxes[i][1];
+  return true;
+}
@@ -96,19 +96,19 @@ namespace
     uint_values.w() = filter_atlas_layer(secondary_atlas.layer());
 
     dst[0].m_attrib0 = fastuidraw::pack_vec4(t_bl.x(), t_bl.y(), t2_bl.x(), t2_bl.y());
-    dst[0].m_attrib1 = fastuidraw::pack_vec4(p_bl.x(), p_bl.y(), 0.0f, 0.0f);
+    dst[0].m_attrib1 = fastuidraw::pack_vec4(p_bl.x(), p_bl.y(), tex_size.x(), tex_size.y());
     dst[0].m_attrib2 = uint_values;
 
     dst[1].m_attrib0 = fastuidraw::pack_vec4(t_tr.x(), t_bl.y(), t2_tr.x(), t2_bl.y());
-    dst[1].m_attrib1 = fastuidraw::pack_vec4(p_tr.x(), p_bl.y(), 0.0f, 0.0f);
+    dst[1].m_attrib1 = fastuidraw::pack_vec4(p_tr.x(), p_bl.y(), tex_size.x(), tex_size.y());
     dst[1].m_attrib2 = uint_values;
 
     dst[2].m_attrib0 = fastuidraw::pack_vec4(t_tr.x(), t_tr.y(), t2_tr.x(), t2_tr.y());
-    dst[2].m_attrib1 = fastuidraw::pack_vec4(p_tr.x(), p_tr.y(), 0.0f, 0.0f);
+    dst[2].m_attrib1 = fastuidraw::pack_vec4(p_tr.x(), p_tr.y(), tex_size.x(), tex_size.y());
     dst[2].m_attrib2 = uint_values;
 
     dst[3].m_attrib0 = fastuidraw::pack_vec4(t_bl.x(), t_tr.y(), t2_bl.x(), t2_tr.y());
-    dst[3].m_attrib1 = fastuidraw::pack_vec4(p_bl.x(), p_tr.y(), 0.0f, 0.0f);
+    dst[3].m_attrib1 = fastuidraw::pack_vec4(p_bl.x(), p_tr.y(), tex_size.x(), tex_size.y());
     dst[3].m_attrib2 = uint_values;
   }
 
@@ -137,7 +137,12 @@ namespace
     fastuidraw::const_c_array<float> m_scale_factors;
     enum fastuidraw::PainterEnums::glyph_orientation m_orientation;
     std::pair<bool, float> m_render_pixel_size;
+    /* index of first glyph that failed to upload */
     unsigned int m_number_glyphs;
+    /* number of glyphs before m_number_glyphs that are drawn */
+    unsigned int m_number_drawn;
+    /* number of glyphs before m_number_glyphs that are pending */
+    unsigned int m_number_pending;
     std::vector<unsigned int> m_cnt_by_type;
   };
 }
@@ -154,7 +159,9 @@ FillGlyphsPrivate(fastuidraw::const_c_array<fastuidraw::vec2> glyph_positions,
   m_scale_factors(scale_factors),
   m_orientation(orientation),
   m_render_pixel_size(false, 1.0f),
-  m_number_glyphs(0)
+  m_number_glyphs(0),
+  m_number_drawn(0),
+  m_number_pending(0)
 {
   assert(glyph_positions.size() == glyphs.size());
   assert(scale_factors.empty() || scale_factors.size() == glyphs.size());
@@ -169,7 +176,9 @@ FillGlyphsPrivate(fastuidraw::const_c_array<fastuidraw::vec2> glyph_positions,
   m_glyphs(glyphs),
   m_orientation(orientation),
   m_render_pixel_size(true, render_pixel_size),
-  m_number_glyphs(0)
+  m_number_glyphs(0),
+  m_number_drawn(0),
+  m_number_pending(0)
 {
   assert(glyph_positions.size() == glyphs.size());
 }
@@ -182,7 +191,9 @@ FillGlyphsPrivate(fastuidraw::const_c_array<fastuidraw::vec2> glyph_positions,
   m_glyphs(glyphs),
   m_orientation(orientation),
   m_render_pixel_size(false, 1.0f),
-  m_number_glyphs(0)
+  m_number_glyphs(0),
+  m_number_drawn(0),
+  m_number_pending(0)
 {
   assert(glyph_positions.size() == glyphs.size());
 }
@@ -191,18 +202,23 @@ void
 FillGlyphsPrivate::
 compute_number_glyphs(void)
 {
-  for(unsigned int i = 0, endi = m_glyphs.size(); i < endi; ++i)
+  for(unsigned int i = 0, endi = m_glyphs.size(); i < endi; ++i, ++m_number_glyphs)
     {
       enum fastuidraw::return_code R;
 
-      if(m_glyphs[i].valid())
+      if(m_glyphs[i].valid() && m_glyphs[i].pending())
+        {
+          /* skip the glyph until its data is ready */
+          ++m_number_pending;
+        }
+      else if(m_glyphs[i].valid())
         {
           R = m_glyphs[i].upload_to_atlas();
           if(R != fastuidraw::routine_success)
             {
               return;
             }
-          ++m_number_glyphs;
+          ++m_number_drawn;
 
           if(m_cnt_by_type.size() <= m_glyphs[i].type())
             {
@@ -251,6 +267,24 @@ fastuidraw::PainterAttributeDataFillerGlyphs::
   m_d = NULL;
 }
 
+unsigned int
+fastuidraw::PainterAttributeDataFillerGlyphs::
+number_glyphs(void) const
+{
+  FillGlyphsPrivate *d;
+  d = reinterpret_cast<FillGlyphsPrivate*>(m_d);
+  return d->m_number_glyphs;
+}
+
+unsigned int
+fastuidraw::PainterAttributeDataFillerGlyphs::
+number_pending_glyphs(void) const
+{
+  FillGlyphsPrivate *d;
+  d = reinterpret_cast<FillGlyphsPrivate*>(m_d);
+  return d->m_number_pending;
+}
+
 void
 fastuidraw::PainterAttributeDataFillerGlyphs::
 compute_sizes(unsigned int &number_attributes,
@@ -263,8 +297,8 @@ compute_sizes(unsigned int &number_attributes,
   d = reinterpret_cast<FillGlyphsPrivate*>(m_d);
 
   d->compute_number_glyphs();
-  number_attributes = 4 * d->m_number_glyphs;
-  number_indices = 6 * d->m_number_glyphs;
+  number_attributes = 4 * d->m_number_drawn;
+  number_indices = 6 * d->m_number_drawn;
   number_attribute_chunks = d->m_cnt_by_type.size();
   number_index_chunks = d->m_cnt_by_type.size();
   number_z_increments = 0;
@@ -293,7 +327,7 @@ fill_data(c_array<PainterAttribute> attribute_data,
   std::vector<unsigned int> current(attrib_chunks.size(), 0);
   for(unsigned int g = 0; g < d->m_number_glyphs; ++g)
     {
-      if(d->m_glyphs[g].valid())
+      if(d->m_glyphs[g].valid() && !d->m_glyphs[g].pending())
         {
           float scale;
           unsigned int t;
@@ -311,3 +345,30 @@ fill_data(c_array<PainterAttribute> attribute_data,
         }
     }
 }
+
+bool
+fastuidraw::PainterAttributeDataFillerGlyphs::
+compute_bounding_box(const_c_array<PainterAttribute> attributes,
+                     vec2 &out_min, vec2 &out_max) const
+{
+  if(attributes.empty())
+    {
+      return false;
+    }
+
+  /* the corners of each glyph quad are packed in m_attrib1.xy
+   */
+  out_min = out_max = vec2(unpack_float(attributes[0].m_attrib1.x()),
+                           unpack_float(attributes[0].m_attrib1.y()));
+  for(unsigned int i = 1, endi = attributes.size(); i < endi; ++i)
+    {
+      vec2 p(unpack_float(attributes[i].m_attrib1.x()),
+             unpack_float(attributes[i].m_attrib1.y()));
+
+      out_min.x() = t_min(out_min.x(), p.x());
+      out_min.y() = t_min(out_min.y(), p.y());
+      out_max.x() = t_max(out_max.x(), p.x());
+      out_max.y() = t_max(out_max.y(), p.y());
+    }
+  return true;
+}
@@ -218,3 +218,30 @@ winding_number_from_index_chunk(unsigned int idx)
   abs_winding = 1 + idx / 2;
   return (idx & 1) ? -abs_winding : abs_winding;
 }
+
+bool
+fastuidraw::PainterAttributeDataFillerPathFill::
+compute_bounding_box(const_c_array<PainterAttribute> attributes,
+                     vec2 &out_min, vec2 &out_max) const
+{
+  if(attributes.empty())
+    {
+      return false;
+    }
+
+  /* the points of the fill are packed in m_attrib0.xy
+   */
+  out_min = out_max = vec2(unpack_float(attributes[0].m_attrib0.x()),
+                           unpack_float(attributes[0].m_attrib0.y()));
+  for(unsigned int i = 1, endi = attributes.size(); i < endi; ++i)
+    {
+      vec2 p(unpack_float(attributes[i].m_attrib0.x()),
+             unpack_float(attributes[i].m_attrib0.y()));
+
+      out_min.x() = t_min(out_min.x(), p.x());
+      out_min.y() = t_min(out_min.y(), p.y());
+      out_max.x() = t_max(out_max.x(), p.x());
+      out_max.y() = t_max(out_max.y(), p.y());
+    }
+  return true;
+}
@@ -24,15 +24,64 @@ namespace
   class PathStrokerPrivate
   {
   public:
-    enum { number_join_types = 4 };
+    enum
+      {
+        number_join_types = 4,
+
+        /* number of indices of each piece, a multiple of 3 so
+           that pieces do not split triangles; an edge of a path
+           makes 15 indices per segment of its tessellation, so
+           a piece of edge data covers 64 segments.
+         */
+        number_indices_per_piece = 15 * 64,
+      };
+
+    explicit
+    PathStrokerPrivate(const fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath> &p);
+
+    static
+    unsigned int
+    number_pieces(unsigned int num_indices)
+    {
+      return (num_indices + number_indices_per_piece - 1) / number_indices_per_piece;
+    }
 
-    PathStrokerPrivate(const fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath> &p):
-      m_path(p)
-    {}
+    static
+    unsigned int
+    number_pieces(unsigned int with_closing_edge, unsigned int without_closing_edge)
+    {
+      assert(with_closing_edge >= without_closing_edge);
+      return number_pieces(with_closing_edge - without_closing_edge)
+        + number_pieces(without_closing_edge);
+    }
 
     fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath> m_path;
+    unsigned int m_number_joins;
+    unsigned int m_number_pieces;
   };
 
+  /* the point sets of StrokedPath whose data is also split into
+     pieces, in the order in which the pieces are placed.
+   */
+  const enum fastuidraw::StrokedPath::point_set_t piece_point_sets[] =
+    {
+      fastuidraw::StrokedPath::rounded_join_point_set,
+      fastuidraw::StrokedPath::bevel_join_point_set,
+      fastuidraw::StrokedPath::miter_join_point_set,
+      fastuidraw::StrokedPath::edge_point_set,
+    };
+
+  /* the chunks with closing edge for each element of piece_point_sets */
+  const enum fastuidraw::PainterAttributeDataFillerPathStroked::stroking_data_t piece_types[] =
+    {
+      fastuidraw::PainterAttributeDataFillerPathStroked::rounded_joins_closing_edge,
+      fastuidraw::PainterAttributeDataFillerPathStroked::bevel_joins_closing_edge,
+      fastuidraw::PainterAttributeDataFillerPathStroked::miter_joins_closing_edge,
+      fastuidraw::PainterAttributeDataFillerPathStroked::edge_closing_edge,
+    };
+
+  const unsigned int number_piece_types = sizeof(piece_types) / sizeof(piece_types[0]);
+
   fastuidraw::PainterAttribute
   generate_attribute(const fastuidraw::StrokedPath::point &src)
   {
@@ -77,6 +126,69 @@ namespace
     attr_loc += attr_src.size();
     idx_loc += idx_src.size();
   }
+
+  /* split the triangles of idx_src into pieces; the attribute
+     chunk of each piece is the range of attrib_src used by the
+     piece and the indices of the piece are rebased to that
+     range.
+   */
+  void
+  grab_pieces(fastuidraw::const_c_array<fastuidraw::PainterAttribute> attrib_src,
+              fastuidraw::const_c_array<fastuidraw::PainterIndex> idx_src,
+              fastuidraw::c_array<fastuidraw::PainterIndex> idx_dst, unsigned int &idx_loc,
+              fastuidraw::c_array<fastuidraw::const_c_array<fastuidraw::PainterAttribute> > attrib_chunks,
+              fastuidraw::c_array<fastuidraw::const_c_array<fastuidraw::PainterIndex> > index_chunks,
+              unsigned int &K)
+  {
+    for(unsigned int start = 0; start < idx_src.size(); start += PathStrokerPrivate::number_indices_per_piece, ++K)
+      {
+        fastuidraw::const_c_array<fastuidraw::PainterIndex> src;
+        fastuidraw::c_array<fastuidraw::PainterIndex> dst;
+        fastuidraw::PainterIndex min_idx, max_idx;
+        unsigned int count;
+
+        count = idx_src.size() - start;
+        count = fastuidraw::t_min(count, static_cast<unsigned int>(PathStrokerPrivate::number_indices_per_piece));
+        src = idx_src.sub_array(start, count);
+        min_idx = *std::min_element(src.begin(), src.end());
+        max_idx = *std::max_element(src.begin(), src.end());
+
+        dst = idx_dst.sub_array(idx_loc, src.size());
+        for(unsigned int I = 0; I < src.size(); ++I)
+          {
+            dst[I] = src[I] - min_idx;
+          }
+        idx_loc += src.size();
+
+        attrib_chunks[K] = attrib_src.sub_array(min_idx, max_idx - min_idx + 1);
+        index_chunks[K] = dst;
+      }
+  }
+}
+
+////////////////////////////////////
+// PathStrokerPrivate methods
+PathStrokerPrivate::
+PathStrokerPrivate(const fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath> &p):
+  m_path(p),
+  m_number_joins(0),
+  m_number_pieces(0)
+{
+  if(!m_path)
+    {
+      return;
+    }
+
+  for(unsigned int C = 0, endC = m_path->number_contours(); C < endC; ++C)
+    {
+      m_number_joins += m_path->number_joins(C);
+    }
+
+  for(unsigned int i = 0; i < number_piece_types; ++i)
+    {
+      m_number_pieces += number_pieces(m_path->indices(piece_point_sets[i], true).size(),
+                                       m_path->indices(piece_point_sets[i], false).size());
+    }
 }
 
 
@@ -123,7 +235,9 @@ compute_sizes(unsigned int &num_attributes,
       return;
     }
 
-  unsigned int numJoins(0);
+  PathStrokerPrivate *d;
+  d = reinterpret_cast<PathStrokerPrivate*>(m_d);
+
   for(unsigned int i = 0; i < StrokedPath::number_point_set_types; ++i)
     {
       enum StrokedPath::point_set_t tp;
@@ -137,7 +251,6 @@ compute_sizes(unsigned int &num_attributes,
       unsigned int endJ;
 
       endJ = p->number_joins(C);
-      numJoins += endJ;
       for(unsigned int J = 0; J < endJ; ++J)
         {
           /* indices for joins appear twice, once all together
@@ -149,7 +262,18 @@ compute_sizes(unsigned int &num_attributes,
           num_indices += p->indices_range(StrokedPath::cap_join_point_set, C, J).difference();
         }
     }
-  num_attribute_chunks = stroking_data_count + 1 + PathStrokerPrivate::number_join_types * numJoins;
+
+  /* the indices of the data split into pieces appear again
+     for the pieces.
+   */
+  for(unsigned int i = 0; i < number_piece_types; ++i)
+    {
+      num_indices += p->indices(piece_point_sets[i], true).size();
+    }
+
+  num_attribute_chunks = stroking_data_count + 1
+    + PathStrokerPrivate::number_join_types * d->m_number_joins
+    + d->m_number_pieces;
   num_index_chunks = num_attribute_chunks;
   number_z_increments = stroking_data_count;
 }
@@ -287,6 +411,31 @@ fill_data(c_array<PainterAttribute> attribute_data,
   GRAB_JOIN_MACRO(bevel_joins, StrokedPath::bevel_join_point_set);
   GRAB_JOIN_MACRO(miter_joins, StrokedPath::miter_join_point_set);
   GRAB_JOIN_MACRO(cap_joins, StrokedPath::cap_join_point_set);
+
+  // and lastly split the edge and join data into pieces, first
+  // the pieces of the closing edge data and then those of the
+  // data without the closing edge.
+  PathStrokerPrivate *d;
+  unsigned int K;
+
+  d = reinterpret_cast<PathStrokerPrivate*>(m_d);
+  K = attribute_chunks.size() - d->m_number_pieces;
+  for(unsigned int i = 0; i < number_piece_types; ++i)
+    {
+      enum stroking_data_t closing_edge(piece_types[i]);
+      unsigned int with, without;
+
+      with = index_chunks[closing_edge].size();
+      without = index_chunks[without_closing_edge(closing_edge)].size();
+      grab_pieces(attribute_chunks[closing_edge],
+                  index_chunks[closing_edge].sub_array(0, with - without),
+                  index_data, idx_loc, attribute_chunks, index_chunks, K);
+      grab_pieces(attribute_chunks[closing_edge],
+                  index_chunks[closing_edge].sub_array(with - without),
+                  index_data, idx_loc, attribute_chunks, index_chunks, K);
+    }
+  assert(K == attribute_chunks.size());
+  assert(idx_loc == index_data.size());
 }
 
 unsigned int
@@ -343,3 +492,92 @@ without_closing_edge(enum stroking_data_t v)
     static_cast<enum stroking_data_t>(v + number_with_closing_edge) :
     v;
 }
+
+bool
+fastuidraw::PainterAttributeDataFillerPathStroked::
+compute_bounding_box(const_c_array<PainterAttribute> attributes,
+                     vec2 &out_min, vec2 &out_max) const
+{
+  if(attributes.empty())
+    {
+      return false;
+    }
+
+  /* the position of each point before it is offset by
+     the stroking is packed in m_attrib0.xy
+   */
+  out_min = out_max = vec2(unpack_float(attributes[0].m_attrib0.x()),
+                           unpack_float(attributes[0].m_attrib0.y()));
+  for(unsigned int i = 1, endi = attributes.size(); i < endi; ++i)
+    {
+      vec2 p(unpack_float(attributes[i].m_attrib0.x()),
+             unpack_float(attributes[i].m_attrib0.y()));
+
+      out_min.x() = t_min(out_min.x(), p.x());
+      out_min.y() = t_min(out_min.y(), p.y());
+      out_max.x() = t_max(out_max.x(), p.x());
+      out_max.y() = t_max(out_max.y(), p.y());
+    }
+  return true;
+}
+
+bool
+fastuidraw::PainterAttributeDataFillerPathStroked::
+chunk_has_bounding_box(unsigned int chunk) const
+{
+  PathStrokerPrivate *d;
+  d = reinterpret_cast<PathStrokerPrivate*>(m_d);
+
+  /* only the pieces, which are the last chunks, have a bounding box */
+  return chunk >= stroking_data_count + 1
+    + PathStrokerPrivate::number_join_types * d->m_number_joins;
+}
+
+fastuidraw::range_type<unsigned int>
+fastuidraw::PainterAttributeDataFillerPathStroked::
+pieces(const PainterAttributeData &data, enum stroking_data_t tp)
+{
+  unsigned int begin(0), end(0), total(0);
+
+  /* the pieces are the last chunks, thus where they start is
+     given by their number which is computed from the sizes
+     of the index chunks they split.
+   */
+  for(unsigned int i = 0; i < number_piece_types; ++i)
+    {
+      enum stroking_data_t closing_edge(piece_types[i]);
+      enum stroking_data_t no_closing_edge(without_closing_edge(closing_edge));
+      unsigned int with, without;
+
+      with = data.index_data_chunk(closing_edge).size();
+      without = data.index_data_chunk(no_closing_edge).size();
+      if(with < without)
+        {
+          return range_type<unsigned int>(0, 0);
+        }
+
+      if(tp == closing_edge)
+        {
+          begin = total;
+        }
+      else if(tp == no_closing_edge)
+        {
+          begin = total + PathStrokerPrivate::number_pieces(with - without);
+        }
+
+      total += PathStrokerPrivate::number_pieces(with, without);
+      if(tp == closing_edge || tp == no_closing_edge)
+        {
+          end = total;
+        }
+    }
+
+  if(begin == end || data.attribute_data_chunks().size() < stroking_data_count + 1 + total)
+    {
+      return range_type<unsigned int>(0, 0);
+    }
+
+  begin += data.attribute_data_chunks().size() - total;
+  end += data.attribute_data_chunks().size() - total;
+  return range_type<unsigned int>(begin, end);
+}
@@ -71,6 +71,25 @@ namespace
     repack_position_and_packed_data(fastuidraw::PainterAttribute &attrib,
                                     float distance_delta);
   };
+
+  class StrokingDataSelector:public fastuidraw::StrokingDataSelectorBase
+  {
+  public:
+    explicit
+    StrokingDataSelector(bool pixel_width):
+      m_pixel_width(pixel_width)
+    {}
+
+    virtual
+    bool
+    stroking_distances(const fastuidraw::PainterShaderData::DataBase *data,
+                       enum fastuidraw::PainterEnums::join_style js,
+                       float &out_pixel_distance,
+                       float &out_item_space_distance) const;
+
+  private:
+    bool m_pixel_width;
+  };
 }
 //////////////////////////////////////
 // PainterDashedStrokeParamsData methods
@@ -269,6 +288,43 @@ repack_position_and_packed_data(fastuidraw::PainterAttribute &attrib,
   attrib.m_attrib1.w() = fastuidraw::pack_float(0.0f);
 }
 
+///////////////////////////////////
+// StrokingDataSelector methods
+bool
+StrokingDataSelector::
+stroking_distances(const fastuidraw::PainterShaderData::DataBase *data,
+                   enum fastuidraw::PainterEnums::join_style js,
+                   float &out_pixel_distance,
+                   float &out_item_space_distance) const
+{
+  const PainterDashedStrokeParamsData *d;
+  float r;
+
+  d = dynamic_cast<const PainterDashedStrokeParamsData*>(data);
+  if(d == NULL)
+    {
+      return false;
+    }
+
+  /* same bounds as for PainterStrokeParams; the caps
+     of dashes are no larger than square caps.
+   */
+  r = 0.5f * fastuidraw::t_abs(d->m_width) * static_cast<float>(M_SQRT2);
+  if(js == fastuidraw::PainterEnums::miter_joins)
+    {
+      if(d->m_miter_limit < 0.0f)
+        {
+          return false;
+        }
+      r = fastuidraw::t_max(r, 0.5f * fastuidraw::t_abs(d->m_width)
+                            * fastuidraw::t_sqrt(1.0f + d->m_miter_limit * d->m_miter_limit));
+    }
+
+  out_pixel_distance = (m_pixel_width) ? r : 0.0f;
+  out_item_space_distance = (m_pixel_width) ? 0.0f : r;
+  return true;
+}
+
 ///////////////////////////////////
 // fastuidraw::PainterDashedStrokeParams methods
 fastuidraw::PainterDashedStrokeParams::
@@ -436,3 +492,10 @@ dash_evaluator(void)
 {
   return FASTUIDRAWnew DashEvaluator();
 }
+
+fastuidraw::reference_counted_ptr<const fastuidraw::StrokingDataSelectorBase>
+fastuidraw::PainterDashedStrokeParams::
+stroking_data_selector(bool pixel_width)
+{
+  return FASTUIDRAWnew StrokingDataSelector(pixel_width);
+}
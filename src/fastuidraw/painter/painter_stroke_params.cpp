@@ -56,6 +56,64 @@ namespace
     float m_miter_limit;
     float m_width;
   };
+
+  class StrokingDataSelector:public fastuidraw::StrokingDataSelectorBase
+  {
+  public:
+    explicit
+    StrokingDataSelector(bool pixel_width):
+      m_pixel_width(pixel_width)
+    {}
+
+    virtual
+    bool
+    stroking_distances(const fastuidraw::PainterShaderData::DataBase *data,
+                       enum fastuidraw::PainterEnums::join_style js,
+                       float &out_pixel_distance,
+                       float &out_item_space_distance) const;
+
+  private:
+    bool m_pixel_width;
+  };
+}
+
+///////////////////////////////////
+// StrokingDataSelector methods
+bool
+StrokingDataSelector::
+stroking_distances(const fastuidraw::PainterShaderData::DataBase *data,
+                   enum fastuidraw::PainterEnums::join_style js,
+                   float &out_pixel_distance,
+                   float &out_item_space_distance) const
+{
+  const PainterStrokeParamsData *d;
+  float r;
+
+  d = dynamic_cast<const PainterStrokeParamsData*>(data);
+  if(d == NULL)
+    {
+      return false;
+    }
+
+  /* the corners of square caps are sqrt(2) stroke radii
+     from the path, the miter of a miter join is at most
+     sqrt(1 + L * L) stroke radii from the path where L is
+     the miter-limit; a negative miter-limit is no limit.
+   */
+  r = 0.5f * fastuidraw::t_abs(d->m_width) * static_cast<float>(M_SQRT2);
+  if(js == fastuidraw::PainterEnums::miter_joins)
+    {
+      if(d->m_miter_limit < 0.0f)
+        {
+          return false;
+        }
+      r = fastuidraw::t_max(r, 0.5f * fastuidraw::t_abs(d->m_width)
+                            * fastuidraw::t_sqrt(1.0f + d->m_miter_limit * d->m_miter_limit));
+    }
+
+  out_pixel_distance = (m_pixel_width) ? r : 0.0f;
+  out_item_space_distance = (m_pixel_width) ? 0.0f : r;
+  return true;
 }
 
 ///////////////////////////////////
@@ -107,3 +165,10 @@ width(float f)
   d->m_width = f;
   return *this;
 }
+
+fastuidraw::reference_counted_ptr<const fastuidraw::StrokingDataSelectorBase>
+fastuidraw::PainterStrokeParams::
+stroking_data_selector(bool pixel_width)
+{
+  return FASTUIDRAWnew StrokingDataSelector(pixel_width);
+}
@@ -31,6 +31,7 @@ namespace
     fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> m_aa_shader_pass1;
     fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> m_aa_shader_pass2;
     fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader> m_non_aa_shader;
+    fastuidraw::reference_counted_ptr<const fastuidraw::StrokingDataSelectorBase> m_stroking_data_selector;
     enum fastuidraw::PainterStrokeShader::type_t m_aa_type;
   };
 }
@@ -97,6 +98,7 @@ operator=(const PainterStrokeShader &rhs)
 setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader>&, aa_shader_pass1)
 setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader>&, aa_shader_pass2)
 setget_implement(const fastuidraw::reference_counted_ptr<fastuidraw::PainterItemShader>&, non_aa_shader)
+setget_implement(const fastuidraw::reference_counted_ptr<const fastuidraw::StrokingDataSelectorBase>&, stroking_data_selector)
 setget_implement(enum fastuidraw::PainterStrokeShader::type_t, aa_type);
 
 #undef setget_implement
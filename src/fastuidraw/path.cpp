@@ -59,6 +59,35 @@ namespace
     std::vector< std::vector<float> > m_values;
   };
 
+  /* Evaluate a polynomial of degree Degree (2 or 3) given by
+     its coefficients c in the power basis, and its first and
+     second derivatives, at many times. The loop bodies are
+     free of branches and operate on separate x and y
+     coefficients so that the compiler can vectorize them.
+   */
+  template<unsigned int Degree>
+  void
+  compute_power_basis(const fastuidraw::vecN<fastuidraw::vec2, 4> &c,
+                      const float *in_t, unsigned int count,
+                      fastuidraw::vec2 *outp, fastuidraw::vec2 *outp_t,
+                      fastuidraw::vec2 *outp_tt)
+  {
+    const float x0(c[0].x()), x1(c[1].x()), x2(c[2].x()), x3(Degree == 3 ? c[3].x() : 0.0f);
+    const float y0(c[0].y()), y1(c[1].y()), y2(c[2].y()), y3(Degree == 3 ? c[3].y() : 0.0f);
+
+    for(unsigned int i = 0; i < count; ++i)
+      {
+        float t(in_t[i]);
+
+        outp[i].x() = x0 + t * (x1 + t * (x2 + t * x3));
+        outp[i].y() = y0 + t * (y1 + t * (y2 + t * y3));
+        outp_t[i].x() = x1 + t * (2.0f * x2 + 3.0f * t * x3);
+        outp_t[i].y() = y1 + t * (2.0f * y2 + 3.0f * t * y3);
+        outp_tt[i].x() = 2.0f * x2 + 6.0f * t * x3;
+        outp_tt[i].y() = 2.0f * y2 + 6.0f * t * y3;
+      }
+  }
+
   class analytic_point_data:public fastuidraw::TessellatedPath::point
   {
   public:
@@ -72,6 +101,7 @@ namespace
 
     float m_time;
     float m_K_times_speed;
+    float m_acceleration;
   };
 
 
@@ -89,6 +119,7 @@ namespace
     unsigned int m_max_recursion, m_max_size;
     const fastuidraw::PathContour::interpolator_generic *m_h;
     float m_thresh_times_six;
+    float m_max_distance_times_eight;
     std::vector<analytic_point_data> m_data;
 
     void
@@ -114,12 +145,49 @@ namespace
   class BezierPrivate
   {
   public:
+    /* quadratic and cubic curves are evaluated from their
+       coefficients in the power basis, chosen at construction.
+     */
+    enum kernel_t
+      {
+        generic_kernel,
+        quadratic_kernel,
+        cubic_kernel
+      };
+
     void
     init(void);
 
+    void
+    compute(float t, fastuidraw::vec2 &outp,
+            fastuidraw::vec2 &outp_t, fastuidraw::vec2 &outp_tt) const;
+
+    void
+    compute_batch(fastuidraw::const_c_array<float> in_t,
+                  fastuidraw::c_array<fastuidraw::vec2> outp,
+                  fastuidraw::c_array<fastuidraw::vec2> outp_t,
+                  fastuidraw::c_array<fastuidraw::vec2> outp_tt) const;
+
+    enum kernel_t m_kernel;
+
+    /* m_coeffs[k] is the coefficient of t^k, only
+       used by quadratic_kernel and cubic_kernel.
+     */
+    fastuidraw::vecN<fastuidraw::vec2, 4> m_coeffs;
+
+    /* the points of the curve as passed to the ctor, init()
+       scales m_poly by the binomial coefficients.
+     */
+    std::vector<fastuidraw::vec2> m_pts;
+
     std::vector<fastuidraw::vec2> m_poly;
     std::vector<fastuidraw::vec2> m_poly_prime;
     std::vector<fastuidraw::vec2> m_poly_prime_prime;
+
+    /* bound on the magnitude of the second derivative
+       over [0, 1], used for distance based tessellation.
+     */
+    float m_max_acceleration;
   };
 
   class ArcPrivate
@@ -139,11 +207,26 @@ namespace
     std::vector<fastuidraw::reference_counted_ptr<const fastuidraw::PathContour::interpolator_base> > m_interpolators;
   };
 
+  class PathLODEntry
+  {
+  public:
+    int m_lod;
+    uint64_t m_last_used;
+    fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> m_tessellation;
+
+    /* the tessellation of the level before the Path changed,
+       its unchanged contours are reused when the level is
+       tessellated again.
+     */
+    fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> m_stale_tessellation;
+  };
+
   class PathPrivate
   {
   public:
     PathPrivate(const fastuidraw::TessellatedPath::TessellationParams &tess_params):
-      m_tessellation_params(tess_params)
+      m_tessellation_params(tess_params),
+      m_lod_counter(0)
     {}
 
     PathPrivate(const PathPrivate &obj);
@@ -152,21 +235,78 @@ namespace
     current_contour(void)
     {
       assert(!m_contours.empty());
-      m_tessellation.clear();
+      clear_tessellation();
       return m_contours.back();
     }
 
     void
     move_common(const fastuidraw::vec2 &pt)
     {
-      m_tessellation.clear();
+      clear_tessellation();
       m_contours.push_back(FASTUIDRAWnew fastuidraw::PathContour());
       m_contours.back()->start(pt);
     }
 
+    /* called when the geometry of the Path changes; the current
+       tessellations are kept as stale so that the contours that
+       did not change are not tessellated again. A stale
+       tessellation may be shared with copies of the Path and
+       is dropped in Path::tessellation(), possibly on a
+       PathPreparer worker, which is why TessellatedPath has an
+       atomic reference count.
+     */
+    void
+    clear_tessellation(void)
+    {
+      if(m_tessellation)
+        {
+          m_stale_tessellation = m_tessellation;
+          m_tessellation.clear();
+        }
+
+      for(unsigned int i = 0, endi = m_lod_tessellations.size(); i < endi; ++i)
+        {
+          PathLODEntry &entry(m_lod_tessellations[i]);
+          if(entry.m_tessellation)
+            {
+              entry.m_stale_tessellation = entry.m_tessellation;
+              entry.m_tessellation.clear();
+            }
+        }
+    }
+
+    /* called when nothing of the current tessellations can be
+       reused, i.e. the tessellation parameters change or all
+       contours are removed.
+     */
+    void
+    drop_tessellation(void)
+    {
+      m_tessellation.clear();
+      m_stale_tessellation.clear();
+      m_lod_tessellations.clear();
+    }
+
+    fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+    lod_tessellation(const fastuidraw::Path &path, int lod);
+
     fastuidraw::TessellatedPath::TessellationParams m_tessellation_params;
     fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> m_tessellation;
+    fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath> m_stale_tessellation;
     std::vector<fastuidraw::reference_counted_ptr<fastuidraw::PathContour> > m_contours;
+
+    /* TessellatedPath objects of levels of detail other than 0,
+       at most Path::tessellation_lod_cache_size of them; an entry
+       is evicted by the smallest m_last_used.
+     */
+    std::vector<PathLODEntry> m_lod_tessellations;
+    uint64_t m_lod_counter;
+
+    /* guards the lazy creation of m_tessellation and of the
+       elements of m_lod_tessellations so that a PathPreparer
+       can build them from a worker thread.
+     */
+    boost::mutex m_tessellation_mutex;
   };
 }
 
@@ -338,6 +478,7 @@ analytic_point_data(float time, const fastuidraw::PathContour::interpolator_gene
   cross_mag = std::abs(m_p_t.x() * p_tt.y() - p_tt.x() * m_p_t.y());
   speed_sq = std::max(dot(m_p_t, m_p_t), epsilon_sq);
   m_K_times_speed= cross_mag / speed_sq;
+  m_acceleration = p_tt.magnitude();
 }
 
 /////////////////////////////////////
@@ -348,7 +489,8 @@ Tessellator(const fastuidraw::TessellatedPath::TessellationParams &tess_params,
   m_max_recursion(fastuidraw::uint32_log2(tess_params.m_max_segments)),
   m_max_size(tess_params.m_max_segments + 1),
   m_h(h),
-  m_thresh_times_six(tess_params.m_curve_tessellation * 6.0f)
+  m_thresh_times_six(tess_params.m_curve_tessellation * 6.0f),
+  m_max_distance_times_eight(tess_params.m_max_distance * 8.0f)
 {
   assert(m_h);
 
@@ -384,6 +526,21 @@ requires_recursion(float delta_t,
                    unsigned int idx_q)
 
 {
+  if(m_max_distance_times_eight > 0.0f)
+    {
+      /* the distance between a curve and its chord over
+         an interval of length delta_t is bounded by
+         A * delta_t^2 / 8 where A bounds the magnitude
+         of the second derivative over the interval; we
+         estimate A from the samples.
+       */
+      float A;
+
+      A = std::max(m_data[idx_mid].m_acceleration,
+                   std::max(m_data[idx_p].m_acceleration, m_data[idx_q].m_acceleration));
+      return A * delta_t * delta_t > m_max_distance_times_eight;
+    }
+
   /* Use simpson's Rule on the integral:
        integral_[t, t + delta_t] K_times_speed(t) dt
   */
@@ -454,14 +611,111 @@ init(void)
   unsigned int degree = m_poly.size() - 1;
   binomial_coeff BC(degree);
 
+  m_pts = m_poly;
+  m_coeffs = fastuidraw::vecN<fastuidraw::vec2, 4>(fastuidraw::vec2(0.0f, 0.0f));
+  switch(degree)
+    {
+    case 2:
+      m_kernel = quadratic_kernel;
+      m_coeffs[0] = m_poly[0];
+      m_coeffs[1] = 2.0f * (m_poly[1] - m_poly[0]);
+      m_coeffs[2] = m_poly[0] - 2.0f * m_poly[1] + m_poly[2];
+      break;
+
+    case 3:
+      m_kernel = cubic_kernel;
+      m_coeffs[0] = m_poly[0];
+      m_coeffs[1] = 3.0f * (m_poly[1] - m_poly[0]);
+      m_coeffs[2] = 3.0f * (m_poly[0] - 2.0f * m_poly[1] + m_poly[2]);
+      m_coeffs[3] = m_poly[3] - m_poly[0] + 3.0f * (m_poly[1] - m_poly[2]);
+      break;
+
+    default:
+      m_kernel = generic_kernel;
+    }
+
   poly::compute_bernstein_derivative(m_poly, m_poly_prime);
   poly::compute_bernstein_derivative(m_poly_prime, m_poly_prime_prime);
 
+  /* the second derivative is a Bezier curve whose control
+     points are m_poly_prime_prime (before the binomial
+     coefficients are applied), thus by the convex hull
+     property its magnitude is bounded by the largest
+     magnitude of those points.
+   */
+  m_max_acceleration = 0.0f;
+  for(unsigned int k = 0, endk = m_poly_prime_prime.size(); k < endk; ++k)
+    {
+      m_max_acceleration = std::max(m_max_acceleration, m_poly_prime_prime[k].magnitude());
+    }
+
   BC.prepare_bernstein(m_poly);
   BC.prepare_bernstein(m_poly_prime);
   BC.prepare_bernstein(m_poly_prime_prime);
 }
 
+void
+BezierPrivate::
+compute(float t, fastuidraw::vec2 &outp,
+        fastuidraw::vec2 &outp_t, fastuidraw::vec2 &outp_tt) const
+{
+  switch(m_kernel)
+    {
+    case quadratic_kernel:
+      outp = m_coeffs[0] + t * (m_coeffs[1] + t * m_coeffs[2]);
+      outp_t = m_coeffs[1] + (2.0f * t) * m_coeffs[2];
+      outp_tt = 2.0f * m_coeffs[2];
+      break;
+
+    case cubic_kernel:
+      outp = m_coeffs[0] + t * (m_coeffs[1] + t * (m_coeffs[2] + t * m_coeffs[3]));
+      outp_t = m_coeffs[1] + t * (2.0f * m_coeffs[2] + (3.0f * t) * m_coeffs[3]);
+      outp_tt = 2.0f * m_coeffs[2] + (6.0f * t) * m_coeffs[3];
+      break;
+
+    default:
+      outp = poly::compute_poly(t, fastuidraw::make_c_array(m_poly));
+      outp_t = poly::compute_poly(t, fastuidraw::make_c_array(m_poly_prime));
+      outp_tt = poly::compute_poly(t, fastuidraw::make_c_array(m_poly_prime_prime));
+    }
+}
+
+void
+BezierPrivate::
+compute_batch(fastuidraw::const_c_array<float> in_t,
+              fastuidraw::c_array<fastuidraw::vec2> outp,
+              fastuidraw::c_array<fastuidraw::vec2> outp_t,
+              fastuidraw::c_array<fastuidraw::vec2> outp_tt) const
+{
+  assert(outp.size() == in_t.size());
+  assert(outp_t.size() == in_t.size());
+  assert(outp_tt.size() == in_t.size());
+
+  if(in_t.empty())
+    {
+      return;
+    }
+
+  switch(m_kernel)
+    {
+    case quadratic_kernel:
+      compute_power_basis<2>(m_coeffs, in_t.c_ptr(), in_t.size(),
+                             outp.c_ptr(), outp_t.c_ptr(), outp_tt.c_ptr());
+      break;
+
+    case cubic_kernel:
+      compute_power_basis<3>(m_coeffs, in_t.c_ptr(), in_t.size(),
+                             outp.c_ptr(), outp_t.c_ptr(), outp_tt.c_ptr());
+      break;
+
+    default:
+      for(unsigned int i = 0; i < in_t.size(); ++i)
+        {
+          compute(in_t[i], outp[i], outp_t[i], outp_tt[i]);
+        }
+    }
+}
+
 ////////////////////////////////////////////
 // fastuidraw::PathContour::interpolator_base methods
 fastuidraw::PathContour::interpolator_base::
@@ -589,15 +843,85 @@ fastuidraw::PathContour::bezier::
 }
 
 
+fastuidraw::const_c_array<fastuidraw::vec2>
+fastuidraw::PathContour::bezier::
+pts(void) const
+{
+  BezierPrivate *d;
+  d = reinterpret_cast<BezierPrivate*>(m_d);
+  return make_c_array(d->m_pts);
+}
+
 void
 fastuidraw::PathContour::bezier::
 compute(float t, vec2 &outp, vec2 &outp_t, vec2 &outp_tt) const
 {
   BezierPrivate *d;
   d = reinterpret_cast<BezierPrivate*>(m_d);
-  outp = poly::compute_poly(t, make_c_array(d->m_poly));
-  outp_t = poly::compute_poly(t, make_c_array(d->m_poly_prime));
-  outp_tt = poly::compute_poly(t, make_c_array(d->m_poly_prime_prime));
+  d->compute(t, outp, outp_t, outp_tt);
+}
+
+unsigned int
+fastuidraw::PathContour::bezier::
+produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
+                     c_array<TessellatedPath::point> out_data) const
+{
+  if(tess_params.m_max_distance <= 0.0f)
+    {
+      return interpolator_generic::produce_tessellation(tess_params, out_data);
+    }
+
+  BezierPrivate *d;
+  d = reinterpret_cast<BezierPrivate*>(m_d);
+
+  /* Wang's formula: with N uniform segments, the distance
+     between the curve and each chord is no more than
+     A / (8 N^2) where A bounds the magnitude of the second
+     derivative.
+   */
+  unsigned int needed_size;
+  float needed_sizef, dt;
+  vecN<float, 32> times;
+  vecN<vec2, 32> p, p_t, p_tt;
+
+  needed_sizef = std::ceil(std::sqrt(d->m_max_acceleration / (8.0f * tess_params.m_max_distance)));
+  needed_size = static_cast<unsigned int>(std::min(needed_sizef, static_cast<float>(tess_params.m_max_segments)));
+  needed_size = std::max(needed_size, 1u);
+  dt = 1.0f / static_cast<float>(needed_size);
+
+  /* evaluate in chunks of fixed size to avoid allocating */
+  for(unsigned int start = 0; start <= needed_size; start += times.size())
+    {
+      unsigned int cnt;
+
+      cnt = std::min(static_cast<unsigned int>(times.size()), needed_size + 1 - start);
+      for(unsigned int i = 0; i < cnt; ++i)
+        {
+          times[i] = static_cast<float>(start + i) * dt;
+        }
+      d->compute_batch(const_c_array<float>(times.c_ptr(), cnt),
+                       c_array<vec2>(p.c_ptr(), cnt),
+                       c_array<vec2>(p_t.c_ptr(), cnt),
+                       c_array<vec2>(p_tt.c_ptr(), cnt));
+      for(unsigned int i = 0; i < cnt; ++i)
+        {
+          out_data[start + i].m_p = p[i];
+          out_data[start + i].m_p_t = p_t[i];
+        }
+    }
+  out_data[0].m_p = start_pt();
+  out_data[needed_size].m_p = end_pt();
+
+  out_data[0].m_distance_from_edge_start = 0.0f;
+  for(unsigned int i = 1; i <= needed_size; ++i)
+    {
+      vec2 delta;
+
+      delta = out_data[i].m_p - out_data[i-1].m_p;
+      out_data[i].m_distance_from_edge_start = delta.magnitude()
+        + out_data[i-1].m_distance_from_edge_start;
+    }
+  return needed_size + 1;
 }
 
 fastuidraw::PathContour::interpolator_base*
@@ -710,9 +1034,24 @@ produce_tessellation(const TessellatedPath::TessellationParams &tess_params,
   unsigned int needed_size;
   float needed_sizef, delta_angle, sgn, sgn_radius;
 
-  needed_sizef = std::abs(d->m_angle_speed) / tess_params.m_curve_tessellation;
-  needed_size = static_cast<unsigned int>(needed_sizef);
-  needed_size = std::min(needed_size, tess_params.m_max_segments);
+  if(tess_params.m_max_distance > 0.0f)
+    {
+      /* a chord spanning an angle theta is at distance
+         r * (1 - cos(theta / 2)) from the arc at its
+         middle, thus the largest angle a segment may
+         span is 2 * acos(1 - m_max_distance / r).
+       */
+      float max_angle;
+
+      max_angle = 2.0f * std::acos(std::max(-1.0f, 1.0f - tess_params.m_max_distance / d->m_radius));
+      needed_sizef = std::ceil(std::abs(d->m_angle_speed) / max_angle);
+    }
+  else
+    {
+      needed_sizef = std::abs(d->m_angle_speed) / tess_params.m_curve_tessellation;
+    }
+  needed_size = static_cast<unsigned int>(std::min(needed_sizef, static_cast<float>(tess_params.m_max_segments)));
+  needed_size = std::max(needed_size, 1u);
   delta_angle = d->m_angle_speed / static_cast<float>(needed_size);
   sgn = d->m_angle_speed > 0.0 ? 1.0 : -1.0;
   sgn_radius = sgn * d->m_radius;
@@ -1017,7 +1356,10 @@ PathPrivate::
 PathPrivate(const PathPrivate &obj):
   m_tessellation_params(obj.m_tessellation_params),
   m_tessellation(obj.m_tessellation),
-  m_contours(obj.m_contours)
+  m_stale_tessellation(obj.m_stale_tessellation),
+  m_contours(obj.m_contours),
+  m_lod_tessellations(obj.m_lod_tessellations),
+  m_lod_counter(obj.m_lod_counter)
 {
   /* if the last contour is not ended, we need to do a
      deep copy on it.
@@ -1028,6 +1370,51 @@ PathPrivate(const PathPrivate &obj):
     }
 }
 
+fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+PathPrivate::
+lod_tessellation(const fastuidraw::Path &path, int lod)
+{
+  fastuidraw::autolock_mutex m(m_tessellation_mutex);
+  unsigned int lru(0);
+
+  ++m_lod_counter;
+  for(unsigned int i = 0, endi = m_lod_tessellations.size(); i < endi; ++i)
+    {
+      PathLODEntry &entry(m_lod_tessellations[i]);
+      if(entry.m_lod == lod)
+        {
+          entry.m_last_used = m_lod_counter;
+          if(!entry.m_tessellation)
+            {
+              entry.m_tessellation = FASTUIDRAWnew fastuidraw::TessellatedPath(path,
+                                                                               m_tessellation_params.lod_params(lod),
+                                                                               entry.m_stale_tessellation.get());
+              entry.m_stale_tessellation.clear();
+            }
+          return entry.m_tessellation;
+        }
+
+      if(m_lod_tessellations[i].m_last_used < m_lod_tessellations[lru].m_last_used)
+        {
+          lru = i;
+        }
+    }
+
+  if(m_lod_tessellations.size() < fastuidraw::Path::tessellation_lod_cache_size)
+    {
+      lru = m_lod_tessellations.size();
+      m_lod_tessellations.push_back(PathLODEntry());
+    }
+
+  PathLODEntry &entry(m_lod_tessellations[lru]);
+  entry.m_lod = lod;
+  entry.m_last_used = m_lod_counter;
+  entry.m_stale_tessellation.clear();
+  entry.m_tessellation = FASTUIDRAWnew fastuidraw::TessellatedPath(path,
+                                                                   m_tessellation_params.lod_params(lod));
+  return entry.m_tessellation;
+}
+
 /////////////////////////////////////////
 // fastuidraw::Path methods
 fastuidraw::Path::
@@ -1084,7 +1471,7 @@ clear(void)
 {
   PathPrivate *d;
   d = reinterpret_cast<PathPrivate*>(m_d);
-  d->m_tessellation.clear();
+  d->drop_tessellation();
   d->m_contours.clear();
 }
 
@@ -1103,7 +1490,7 @@ add_contour(const reference_counted_ptr<const PathContour> &pcontour)
   reference_counted_ptr<PathContour> contour;
   contour = pcontour.const_cast_ptr<PathContour>();
 
-  d->m_tessellation.clear();
+  d->clear_tessellation();
   if(d->m_contours.empty() || d->m_contours.back()->ended())
     {
       d->m_contours.push_back(contour);
@@ -1129,7 +1516,7 @@ add_contours(const Path &path)
 
   if(d != pd && !pd->m_contours.empty())
     {
-      d->m_tessellation.clear();
+      d->clear_tessellation();
       d->m_contours.reserve(d->m_contours.size() + pd->m_contours.size());
 
       reference_counted_ptr<PathContour> r;
@@ -1210,7 +1597,7 @@ tessellation_params(const fastuidraw::TessellatedPath::TessellationParams &p)
    */
   if(p != d->m_tessellation_params)
     {
-      d->m_tessellation = reference_counted_ptr<const TessellatedPath>();
+      d->drop_tessellation();
     }
   d->m_tessellation_params = p;
 }
@@ -1221,14 +1608,51 @@ tessellation(void) const
 {
   PathPrivate *d;
   d = reinterpret_cast<PathPrivate*>(m_d);
+
+  autolock_mutex m(d->m_tessellation_mutex);
   if(!d->m_tessellation)
     {
       d->m_tessellation = FASTUIDRAWnew TessellatedPath(*this,
-                                                        d->m_tessellation_params);
+                                                        d->m_tessellation_params,
+                                                        d->m_stale_tessellation.get());
+      d->m_stale_tessellation.clear();
     }
   return d->m_tessellation;
 }
 
+fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+fastuidraw::Path::
+tessellation(float scale_factor) const
+{
+  PathPrivate *d;
+  int lod;
+
+  lod = lod_for_scale_factor(scale_factor);
+  if(lod == 0)
+    {
+      return tessellation();
+    }
+
+  d = reinterpret_cast<PathPrivate*>(m_d);
+  return d->lod_tessellation(*this, lod);
+}
+
+int
+fastuidraw::Path::
+lod_for_scale_factor(float scale_factor)
+{
+  int lod;
+
+  if(!(scale_factor > 0.0f))
+    {
+      return min_tessellation_lod;
+    }
+
+  lod = static_cast<int>(std::floor(std::log(scale_factor) * float(M_LOG2E) + 0.5f));
+  return t_min(static_cast<int>(max_tessellation_lod),
+               t_max(static_cast<int>(min_tessellation_lod), lod));
+}
+
 fastuidraw::Path&
 fastuidraw::Path::
 operator<<(const control_point &pt)
@@ -0,0 +1,344 @@
+/*!
+ * \file path_preparer.cpp
+ * \brief file path_preparer.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <vector>
+#include <deque>
+#include <boost/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+#include <fastuidraw/path_preparer.hpp>
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/tessellated_path.hpp>
+#include <fastuidraw/filled_path.hpp>
+#include <fastuidraw/stroked_path.hpp>
+#include "private/util_private.hpp"
+
+namespace
+{
+  class PathPreparerPrivate;
+
+  class PreparerJob
+  {
+  public:
+    enum job_t
+      {
+        build_filled_path,
+        build_stroked_path,
+        build_filled_path_subset
+      };
+
+    explicit
+    PreparerJob(const fastuidraw::Path *path = NULL,
+                enum job_t tp = build_filled_path):
+      m_type(tp),
+      m_path(path),
+      m_filled_path(NULL),
+      m_subset(0)
+    {}
+
+    PreparerJob(const fastuidraw::FilledPath *filled_path,
+                unsigned int subset):
+      m_type(build_filled_path_subset),
+      m_path(NULL),
+      m_filled_path(filled_path),
+      m_subset(subset)
+    {}
+
+    void
+    execute(PathPreparerPrivate *d) const;
+
+    enum job_t m_type;
+    const fastuidraw::Path *m_path;
+    const fastuidraw::FilledPath *m_filled_path;
+    unsigned int m_subset;
+  };
+
+  class PathPreparerPrivate
+  {
+  public:
+    explicit
+    PathPreparerPrivate(unsigned int number_threads);
+
+    ~PathPreparerPrivate();
+
+    void
+    add_path(const fastuidraw::Path *path, uint32_t what);
+
+    void
+    add_jobs(const PreparerJob *jobs, unsigned int count);
+
+    void
+    wait(void);
+
+    static
+    void
+    worker(PathPreparerPrivate *d);
+
+    boost::mutex m_mutex;
+    boost::condition_variable m_work_available;
+    boost::condition_variable m_work_done;
+    std::deque<PreparerJob> m_jobs;
+    unsigned int m_number_pending;
+    bool m_quit;
+    std::vector<boost::thread*> m_threads;
+  };
+}
+
+//////////////////////////////////////
+// PreparerJob methods
+void
+PreparerJob::
+execute(PathPreparerPrivate *d) const
+{
+  /* The different jobs of a single Path may execute
+     simultaneously, the lazy accessors of Path,
+     TessellatedPath and FilledPath::Subset make sure
+     that each of the objects is built exactly once.
+     We do not make handles to the TessellatedPath,
+     FilledPath and StrokedPath because their reference
+     counts are not thread safe; the PathContour handles
+     copied by the TessellatedPath ctor are fine since
+     those reference counts are atomic.
+   */
+  switch(m_type)
+    {
+    case build_filled_path:
+      {
+        const fastuidraw::FilledPath *filled;
+        std::vector<PreparerJob> jobs;
+
+        /* constructing the FilledPath only partitions the
+           path, the tessellation of each leaf Subset is
+           its own job so that a large path is spread
+           across the threads.
+         */
+        filled = m_path->tessellation()->filled().get();
+        for(unsigned int i = 0, endi = filled->number_subsets(); i < endi; ++i)
+          {
+            if(filled->subset(i).is_leaf())
+              {
+                jobs.push_back(PreparerJob(filled, i));
+              }
+          }
+
+        if(!jobs.empty())
+          {
+            d->add_jobs(&jobs[0], jobs.size());
+          }
+      }
+      break;
+
+    case build_stroked_path:
+      m_path->tessellation()->stroked();
+      break;
+
+    case build_filled_path_subset:
+      m_filled_path->subset(m_subset).winding_numbers();
+      break;
+    }
+}
+
+//////////////////////////////////////////
+// PathPreparerPrivate methods
+PathPreparerPrivate::
+PathPreparerPrivate(unsigned int number_threads):
+  m_number_pending(0),
+  m_quit(false)
+{
+  number_threads = fastuidraw::t_max(number_threads, 1u);
+  m_threads.resize(number_threads);
+  for(unsigned int i = 0; i < number_threads; ++i)
+    {
+      m_threads[i] = FASTUIDRAWnew boost::thread(&PathPreparerPrivate::worker, this);
+    }
+}
+
+PathPreparerPrivate::
+~PathPreparerPrivate()
+{
+  wait();
+
+  m_mutex.lock();
+  m_quit = true;
+  m_mutex.unlock();
+  m_work_available.notify_all();
+
+  for(unsigned int i = 0, endi = m_threads.size(); i < endi; ++i)
+    {
+      m_threads[i]->join();
+      FASTUIDRAWdelete(m_threads[i]);
+    }
+}
+
+void
+PathPreparerPrivate::
+add_path(const fastuidraw::Path *path, uint32_t what)
+{
+  fastuidraw::vecN<PreparerJob, 2> jobs;
+  unsigned int count(0);
+
+  if(what & fastuidraw::PathPreparer::prepare_filled_path)
+    {
+      jobs[count++] = PreparerJob(path, PreparerJob::build_filled_path);
+    }
+
+  if(what & fastuidraw::PathPreparer::prepare_stroked_path)
+    {
+      jobs[count++] = PreparerJob(path, PreparerJob::build_stroked_path);
+    }
+
+  add_jobs(jobs.c_ptr(), count);
+}
+
+void
+PathPreparerPrivate::
+add_jobs(const PreparerJob *jobs, unsigned int count)
+{
+  m_mutex.lock();
+  m_jobs.insert(m_jobs.end(), jobs, jobs + count);
+  m_number_pending += count;
+  m_mutex.unlock();
+
+  if(count > 1)
+    {
+      m_work_available.notify_all();
+    }
+  else if(count == 1)
+    {
+      m_work_available.notify_one();
+    }
+}
+
+void
+PathPreparerPrivate::
+wait(void)
+{
+  boost::unique_lock<boost::mutex> lock(m_mutex);
+  while(m_number_pending > 0)
+    {
+      m_work_done.wait(lock);
+    }
+}
+
+void
+PathPreparerPrivate::
+worker(PathPreparerPrivate *d)
+{
+  for(;;)
+    {
+      PreparerJob J;
+
+      {
+        boost::unique_lock<boost::mutex> lock(d->m_mutex);
+        while(d->m_jobs.empty() && !d->m_quit)
+          {
+            d->m_work_available.wait(lock);
+          }
+
+        if(d->m_jobs.empty())
+          {
+            return;
+          }
+
+        J = d->m_jobs.front();
+        d->m_jobs.pop_front();
+      }
+
+      J.execute(d);
+
+      bool all_done;
+      {
+        boost::unique_lock<boost::mutex> lock(d->m_mutex);
+        assert(d->m_number_pending > 0);
+        --d->m_number_pending;
+        all_done = (d->m_number_pending == 0);
+      }
+
+      if(all_done)
+        {
+          d->m_work_done.notify_all();
+        }
+    }
+}
+
+/////////////////////////////////////
+// fastuidraw::PathPreparer methods
+fastuidraw::PathPreparer::
+PathPreparer(unsigned int number_threads)
+{
+  m_d = FASTUIDRAWnew PathPreparerPrivate(number_threads);
+}
+
+fastuidraw::PathPreparer::
+~PathPreparer()
+{
+  PathPreparerPrivate *d;
+  d = reinterpret_cast<PathPreparerPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+unsigned int
+fastuidraw::PathPreparer::
+number_threads(void) const
+{
+  PathPreparerPrivate *d;
+  d = reinterpret_cast<PathPreparerPrivate*>(m_d);
+  return d->m_threads.size();
+}
+
+void
+fastuidraw::PathPreparer::
+add_path(const Path &path, uint32_t what)
+{
+  PathPreparerPrivate *d;
+  d = reinterpret_cast<PathPreparerPrivate*>(m_d);
+  d->add_path(&path, what);
+}
+
+void
+fastuidraw::PathPreparer::
+add_paths(const_c_array<const Path*> paths, uint32_t what)
+{
+  PathPreparerPrivate *d;
+  d = reinterpret_cast<PathPreparerPrivate*>(m_d);
+  for(unsigned int i = 0; i < paths.size(); ++i)
+    {
+      d->add_path(paths[i], what);
+    }
+}
+
+unsigned int
+fastuidraw::PathPreparer::
+number_jobs_pending(void) const
+{
+  PathPreparerPrivate *d;
+  d = reinterpret_cast<PathPreparerPrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  return d->m_number_pending;
+}
+
+void
+fastuidraw::PathPreparer::
+wait(void)
+{
+  PathPreparerPrivate *d;
+  d = reinterpret_cast<PathPreparerPrivate*>(m_d);
+  d->wait();
+}
@@ -20,6 +20,8 @@
 #pragma once
 
 #include <vector>
+#include <time.h>
+#include <stdint.h>
 #include <boost/thread.hpp>
 #include <fastuidraw/util/c_array.hpp>
 
@@ -46,6 +48,19 @@ namespace fastuidraw
     boost::mutex &m_mutex;
   };
 
+  /*!
+    Returns the time, in nanoseconds, of a monotonic
+    clock; only differences of values are meaningful.
+   */
+  inline
+  uint64_t
+  monotonic_time_ns(void)
+  {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return static_cast<uint64_t>(t.tv_sec) * 1000000000u + static_cast<uint64_t>(t.tv_nsec);
+  }
+
   template<typename T>
   c_array<T>
   make_c_array(std::vector<T> &p)
@@ -739,8 +739,18 @@ namespace
   public:
     explicit
     StrokedPathPrivate(const fastuidraw::TessellatedPath &P);
+
+    /* ctor for a StrokedPath that is loaded from baked data */
+    StrokedPathPrivate(void);
+
     ~StrokedPathPrivate();
 
+    void
+    bake_locations(fastuidraw::BakedDataWriter &dst) const;
+
+    bool
+    load_locations(fastuidraw::BakedDataReader &src);
+
     Data<fastuidraw::StrokedPath::point> m_edges;
     Data<fastuidraw::StrokedPath::point> m_rounded_joins;
     Data<fastuidraw::StrokedPath::point> m_bevel_joins;
@@ -753,8 +763,40 @@ namespace
 
     fastuidraw::vecN<DataAsCArraysPair, fastuidraw::StrokedPath::number_point_set_types> m_return_values;
     fastuidraw::PainterAttributeData *m_attribute_data;
+
+    /* for a StrokedPath loaded from baked data, the data that
+       m_return_values and m_attribute_data point into.
+     */
+    fastuidraw::reference_counted_ptr<const fastuidraw::DataBuffer> m_baked_data;
   };
 
+  /* returns the range of part within whole, part must be
+     empty or a sub-array of whole.
+   */
+  template<typename T>
+  fastuidraw::range_type<unsigned int>
+  range_within(fastuidraw::const_c_array<T> whole, fastuidraw::const_c_array<T> part)
+  {
+    unsigned int begin;
+
+    if(part.empty())
+      {
+        return fastuidraw::range_type<unsigned int>(0, 0);
+      }
+
+    assert(part.c_ptr() >= whole.c_ptr());
+    assert(part.c_ptr() + part.size() <= whole.c_ptr() + whole.size());
+    begin = part.c_ptr() - whole.c_ptr();
+    return fastuidraw::range_type<unsigned int>(begin, begin + part.size());
+  }
+
+  template<typename T>
+  bool
+  valid_range(fastuidraw::const_c_array<T> whole, fastuidraw::range_type<unsigned int> R)
+  {
+    return R.m_begin <= R.m_end && R.m_end <= whole.size();
+  }
+
 }
 
 //////////////////////////////////
@@ -2359,6 +2401,11 @@ StrokedPathPrivate(const fastuidraw::TessellatedPath &P):
   m_edges.compute_conveniance(m_return_values[fastuidraw::StrokedPath::edge_point_set]);
 }
 
+StrokedPathPrivate::
+StrokedPathPrivate(void):
+  m_attribute_data(NULL)
+{}
+
 StrokedPathPrivate::
 ~StrokedPathPrivate()
 {
@@ -2368,6 +2415,100 @@ StrokedPathPrivate::
     }
 }
 
+void
+StrokedPathPrivate::
+bake_locations(fastuidraw::BakedDataWriter &dst) const
+{
+  /* flatten the Location values of each contour: first
+     those of the caps, then those of each join.
+   */
+  std::vector<uint32_t> join_counts;
+  std::vector<fastuidraw::range_type<unsigned int> > ranges;
+
+  join_counts.reserve(m_locations.size());
+  for(unsigned int C = 0, endC = m_locations.size(); C < endC; ++C)
+    {
+      const LocationsOfCapsAndJoins &L(m_locations[C]);
+
+      join_counts.push_back(L.m_joins.size());
+      for(unsigned int c = 0; c < cap_type_count; ++c)
+        {
+          for(unsigned int v = 0; v < 2; ++v)
+            {
+              ranges.push_back(L.m_caps[c].m_values[v].m_attribs);
+              ranges.push_back(L.m_caps[c].m_values[v].m_indices);
+            }
+        }
+
+      for(unsigned int J = 0, endJ = L.m_joins.size(); J < endJ; ++J)
+        {
+          for(unsigned int v = 0; v < joint_type_count + 1; ++v)
+            {
+              ranges.push_back(L.m_joins[J].m_values[v].m_attribs);
+              ranges.push_back(L.m_joins[J].m_values[v].m_indices);
+            }
+        }
+    }
+  dst.write_array(fastuidraw::make_c_array(join_counts));
+  dst.write_array(fastuidraw::make_c_array(ranges));
+}
+
+bool
+StrokedPathPrivate::
+load_locations(fastuidraw::BakedDataReader &src)
+{
+  fastuidraw::const_c_array<uint32_t> join_counts;
+  fastuidraw::const_c_array<fastuidraw::range_type<unsigned int> > ranges;
+  unsigned int needed(0), current(0);
+
+  if(!src.read_array(join_counts) || !src.read_array(ranges))
+    {
+      return false;
+    }
+
+  for(unsigned int C = 0; C < join_counts.size(); ++C)
+    {
+      if(join_counts[C] > ranges.size())
+        {
+          src.set_error();
+          return false;
+        }
+      needed += 4 * cap_type_count + 2 * (joint_type_count + 1) * join_counts[C];
+    }
+
+  if(needed != ranges.size())
+    {
+      src.set_error();
+      return false;
+    }
+
+  m_locations.resize(join_counts.size());
+  for(unsigned int C = 0, endC = join_counts.size(); C < endC; ++C)
+    {
+      LocationsOfCapsAndJoins &L(m_locations[C]);
+
+      for(unsigned int c = 0; c < cap_type_count; ++c)
+        {
+          for(unsigned int v = 0; v < 2; ++v)
+            {
+              L.m_caps[c].m_values[v].m_attribs = ranges[current++];
+              L.m_caps[c].m_values[v].m_indices = ranges[current++];
+            }
+        }
+
+      L.m_joins.resize(join_counts[C]);
+      for(unsigned int J = 0, endJ = L.m_joins.size(); J < endJ; ++J)
+        {
+          for(unsigned int v = 0; v < joint_type_count + 1; ++v)
+            {
+              L.m_joins[J].m_values[v].m_attribs = ranges[current++];
+              L.m_joins[J].m_values[v].m_indices = ranges[current++];
+            }
+        }
+    }
+  return true;
+}
+
 //////////////////////////////////////
 // fastuidraw::StrokedPath::point methods
 fastuidraw::vec2
@@ -2456,6 +2597,12 @@ StrokedPath(const fastuidraw::TessellatedPath &P)
   m_d = FASTUIDRAWnew StrokedPathPrivate(P);
 }
 
+fastuidraw::StrokedPath::
+StrokedPath(void)
+{
+  m_d = FASTUIDRAWnew StrokedPathPrivate();
+}
+
 fastuidraw::StrokedPath::
 ~StrokedPath()
 {
@@ -2555,3 +2702,81 @@ indices_range(enum point_set_t tp, unsigned int contour, unsigned int N) const
   assert(contour < d->m_locations.size());
   return d->m_locations[contour].fetch(tp, N).m_indices;
 }
+
+void
+fastuidraw::StrokedPath::
+bake(BakedDataWriter &dst) const
+{
+  StrokedPathPrivate *d;
+  d = reinterpret_cast<StrokedPathPrivate*>(m_d);
+
+  /* for each point set, the data including the closing
+     edge followed by where within it the data without
+     the closing edge is.
+   */
+  for(unsigned int tp = 0; tp < number_point_set_types; ++tp)
+    {
+      const DataAsCArraysPair &V(d->m_return_values[tp]);
+
+      dst.write_array(V[true].m_points);
+      dst.write_array(V[true].m_indices);
+      dst.write_value(uint32_t(V[true].m_number_depth));
+      dst.write_value(range_within(V[true].m_points, V[false].m_points));
+      dst.write_value(range_within(V[true].m_indices, V[false].m_indices));
+      dst.write_value(uint32_t(V[false].m_number_depth));
+    }
+  d->bake_locations(dst);
+  painter_data().bake(dst);
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath>
+fastuidraw::StrokedPath::
+load_baked(BakedDataReader &src)
+{
+  StrokedPath *return_value;
+  StrokedPathPrivate *d;
+  bool ok(true);
+
+  return_value = FASTUIDRAWnew StrokedPath();
+  d = reinterpret_cast<StrokedPathPrivate*>(return_value->m_d);
+
+  for(unsigned int tp = 0; ok && tp < number_point_set_types; ++tp)
+    {
+      DataAsCArraysPair &V(d->m_return_values[tp]);
+      range_type<unsigned int> points_range, indices_range;
+      uint32_t depth, depth_without_closing;
+
+      ok = src.read_array(V[true].m_points)
+        && src.read_array(V[true].m_indices)
+        && src.read_value(depth)
+        && src.read_value(points_range)
+        && src.read_value(indices_range)
+        && src.read_value(depth_without_closing)
+        && valid_range(V[true].m_points, points_range)
+        && valid_range(V[true].m_indices, indices_range);
+
+      if(ok)
+        {
+          V[true].m_number_depth = depth;
+          V[false].m_points = V[true].m_points.sub_array(points_range);
+          V[false].m_indices = V[true].m_indices.sub_array(indices_range);
+          V[false].m_number_depth = depth_without_closing;
+        }
+    }
+
+  if(ok)
+    {
+      d->m_attribute_data = FASTUIDRAWnew PainterAttributeData();
+      ok = d->load_locations(src) && d->m_attribute_data->load_baked(src);
+    }
+
+  if(!ok)
+    {
+      src.set_error();
+      FASTUIDRAWdelete(return_value);
+      return reference_counted_ptr<const StrokedPath>();
+    }
+
+  d->m_baked_data = src.buffer();
+  return return_value;
+}
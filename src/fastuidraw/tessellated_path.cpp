@@ -17,26 +17,112 @@
  */
 
 
-#include <list>
 #include <vector>
+#include <map>
+#include <cmath>
 #include <fastuidraw/tessellated_path.hpp>
 #include <fastuidraw/path.hpp>
+#include <fastuidraw/painter/painter_attribute.hpp>
 #include "private/util_private.hpp"
 
 namespace
 {
+  /* header values of the data written by TessellatedPath::bake(),
+     baked_version is to be incremented whenever the format of
+     the data written by TessellatedPath, StrokedPath, FilledPath
+     or PainterAttributeData changes.
+   */
+  enum
+    {
+      baked_magic = 0x50495546, /* "FUIP" in little endian */
+      baked_version = 3,
+      baked_byte_order = 0x01020304
+    };
+
+  /* gives where the points of a contour are found
+     before they are copied to m_point_data
+   */
+  class ContourSource
+  {
+  public:
+    bool m_from_reuse;
+    unsigned int m_begin, m_end;
+  };
+
+  class ScratchContextPrivate
+  {
+  public:
+    /* only the size of m_points is used, never its
+       capacity; m_points is never shrunk so that
+       once it is large enough, constructing a
+       TessellatedPath does not allocate it.
+     */
+    std::vector<fastuidraw::TessellatedPath::point> m_points;
+    std::vector<ContourSource> m_sources;
+  };
+
   class TessellatedPathPrivate
   {
   public:
     TessellatedPathPrivate(const fastuidraw::Path &input,
-                           fastuidraw::TessellatedPath::TessellationParams TP);
-
-    std::vector<std::vector<fastuidraw::range_type<unsigned int> > > m_edge_ranges;
+                           fastuidraw::TessellatedPath::TessellationParams TP,
+                           const TessellatedPathPrivate *reuse,
+                           ScratchContextPrivate &scratch);
+
+    /* ctor for a TessellatedPath loaded from baked data */
+    TessellatedPathPrivate(void);
+
+    bool
+    load_baked(fastuidraw::BakedDataReader &src);
+
+    /* returns the contour of this TessellatedPathPrivate that
+       was made from the ended PathContour c, or -1 if there
+       is no such contour; map is filled on first use.
+     */
+    int
+    source_contour(const fastuidraw::PathContour *c, unsigned int hint,
+                   std::map<const fastuidraw::PathContour*, unsigned int> &map) const;
+
+    /* m_edge_ranges holds the ranges of all edges of
+       all contours, m_contours[c] gives the range into
+       m_edge_ranges of the edges of contour c.
+     */
+    std::vector<fastuidraw::range_type<unsigned int> > m_edge_ranges;
+    std::vector<fastuidraw::range_type<unsigned int> > m_contours;
     std::vector<fastuidraw::TessellatedPath::point> m_point_data;
+
+    /* the arrays read by the accessors, they point into the
+       above vectors or, for a TessellatedPath loaded from
+       baked data, into m_baked_data.
+     */
+    fastuidraw::const_c_array<fastuidraw::range_type<unsigned int> > m_edge_ranges_array;
+    fastuidraw::const_c_array<fastuidraw::range_type<unsigned int> > m_contours_array;
+    fastuidraw::const_c_array<fastuidraw::TessellatedPath::point> m_point_data_array;
+    fastuidraw::reference_counted_ptr<const fastuidraw::DataBuffer> m_baked_data;
+
+    /* the PathContour from which each contour was made, NULL
+       if the PathContour was not ended (and thus may still
+       change); only ended contours are reused by a later
+       TessellatedPath. The handles keep the PathContour
+       objects alive as long as this TessellatedPath; their
+       reference counts are atomic so this is safe even though
+       the copies of a Path share the contours across threads.
+     */
+    std::vector<fastuidraw::reference_counted_ptr<const fastuidraw::PathContour> > m_source_contours;
+
+    /* bounding box of each contour, [0] is min and [1] is max */
+    std::vector<fastuidraw::vecN<fastuidraw::vec2, 2> > m_contour_boxes;
+
     fastuidraw::vec2 m_box_min, m_box_max;
     fastuidraw::TessellatedPath::TessellationParams m_params;
     fastuidraw::reference_counted_ptr<const fastuidraw::StrokedPath> m_stroked;
     fastuidraw::reference_counted_ptr<const fastuidraw::FilledPath> m_filled;
+
+    /* guard the lazy creation of m_stroked and m_filled;
+       they are seperate so that a PathPreparer can build
+       the StrokedPath and FilledPath in parallel.
+     */
+    boost::mutex m_stroked_mutex, m_filled_mutex;
   };
 }
 
@@ -44,104 +130,310 @@ namespace
 // TessellatedPathPrivate methods
 TessellatedPathPrivate::
 TessellatedPathPrivate(const fastuidraw::Path &input,
-                       fastuidraw::TessellatedPath::TessellationParams TP):
-  m_edge_ranges(input.number_contours()),
+                       fastuidraw::TessellatedPath::TessellationParams TP,
+                       const TessellatedPathPrivate *reuse,
+                       ScratchContextPrivate &scratch):
+  m_contours(input.number_contours()),
+  m_source_contours(input.number_contours()),
+  m_contour_boxes(input.number_contours()),
   m_box_min(0.0f, 0.0f),
   m_box_max(0.0f, 0.0f),
   m_params(TP)
 {
-  if(input.number_contours() > 0)
+  unsigned int total_edges(0);
+
+  for(unsigned int o = 0, endo = input.number_contours(); o < endo; ++o)
+    {
+      unsigned int num_edges(input.contour(o)->number_points());
+
+      m_contours[o] = fastuidraw::range_type<unsigned int>(total_edges, total_edges + num_edges);
+      total_edges += num_edges;
+    }
+  m_edge_ranges.resize(total_edges);
+
+  if(reuse && reuse->m_params != m_params)
+    {
+      reuse = NULL;
+    }
+
+  /* First pass: tessellate each edge directly into the
+     scratch buffer, one edge after the other, and fill
+     the fields that depend on the contour. Every field of
+     TessellatedPath::point only depends on the contour of
+     the point, so a contour that reuse made from the same
+     ended PathContour is taken from reuse instead.
+   */
+  std::vector<fastuidraw::TessellatedPath::point> &points(scratch.m_points);
+  std::vector<ContourSource> &sources(scratch.m_sources);
+  std::map<const fastuidraw::PathContour*, unsigned int> reuse_map;
+  unsigned int loc(0), scratch_loc(0), max_needed(m_params.m_max_segments + 1);
+
+  sources.resize(input.number_contours());
+  for(unsigned int o = 0, endo = input.number_contours(); o < endo; ++o)
     {
-      std::list<std::vector<fastuidraw::TessellatedPath::point> > temp;
-      std::vector<fastuidraw::TessellatedPath::point> work_room(m_params.m_max_segments + 1);
-      std::list<std::vector<fastuidraw::TessellatedPath::point> >::const_iterator iter, end_iter;
+      fastuidraw::reference_counted_ptr<const fastuidraw::PathContour> contour(input.contour(o));
+      float contour_length(0.0f), open_contour_length(0.0f), closed_contour_length(0.0f);
+      fastuidraw::vecN<fastuidraw::vec2, 2> &box(m_contour_boxes[o]);
+      int reuse_contour(-1);
 
-      for(unsigned int loc = 0, o = 0, endo = input.number_contours(); o < endo; ++o)
+      if(contour->ended())
         {
-          fastuidraw::reference_counted_ptr<const fastuidraw::PathContour> contour(input.contour(o));
-          float contour_length(0.0f), open_contour_length, closed_contour_length;
-          std::list<std::vector<fastuidraw::TessellatedPath::point> >::iterator start_contour;
+          m_source_contours[o] = contour;
+          if(reuse)
+            {
+              reuse_contour = reuse->source_contour(contour.get(), o, reuse_map);
+            }
+        }
+
+      if(reuse_contour != -1)
+        {
+          fastuidraw::range_type<unsigned int> src_edges(reuse->m_contours[reuse_contour]);
+          unsigned int src_begin;
+
+          assert(src_edges.difference() == m_contours[o].difference());
+          src_begin = reuse->m_edge_ranges[src_edges.m_begin].m_begin;
+          sources[o].m_from_reuse = true;
+          sources[o].m_begin = src_begin;
+          sources[o].m_end = reuse->m_edge_ranges[src_edges.m_end - 1].m_end;
 
-          m_edge_ranges[o].resize(contour->number_points());
-          for(unsigned int e = 0, ende = contour->number_points(); e < ende; ++e)
+          for(unsigned int e = 0, ende = src_edges.difference(); e < ende; ++e)
             {
-              unsigned int needed;
+              fastuidraw::range_type<unsigned int> R(reuse->m_edge_ranges[src_edges.m_begin + e]);
+              m_edge_ranges[m_contours[o].m_begin + e] =
+                fastuidraw::range_type<unsigned int>(R.m_begin - src_begin + loc, R.m_end - src_begin + loc);
+            }
+          box = reuse->m_contour_boxes[reuse_contour];
+          loc += sources[o].m_end - sources[o].m_begin;
+          continue;
+        }
 
-              temp.push_back(std::vector<fastuidraw::TessellatedPath::point>());
-              needed = contour->interpolator(e)->produce_tessellation(m_params, fastuidraw::make_c_array(work_room));
-              m_edge_ranges[o][e] = fastuidraw::range_type<unsigned int>(loc, loc + needed);
-              loc += needed;
+      sources[o].m_from_reuse = false;
+      sources[o].m_begin = scratch_loc;
+      for(unsigned int e = 0, ende = contour->number_points(); e < ende; ++e)
+        {
+          unsigned int needed;
+          fastuidraw::c_array<fastuidraw::TessellatedPath::point> edge_pts;
 
-              for(unsigned int n = 0; n < needed; ++n)
-                {
-                  const fastuidraw::vec2 &pt(work_room[n].m_p);
-
-                  work_room[n].m_distance_from_contour_start = contour_length + work_room[n].m_distance_from_edge_start;
-
-                  if(o == 0 and e == 0 and n == 0)
-                    {
-                      m_box_min = pt;
-                      m_box_max = pt;
-                    }
-                  else
-                    {
-                      m_box_min.x() = std::min(m_box_min.x(), pt.x());
-                      m_box_min.y() = std::min(m_box_min.y(), pt.y());
-                      m_box_max.x() = std::max(m_box_max.x(), pt.x());
-                      m_box_max.y() = std::max(m_box_max.y(), pt.y());
-                    }
-                }
-              std::list<std::vector<fastuidraw::TessellatedPath::point> >::iterator t;
-              t = temp.insert(temp.end(),
-                              std::vector<fastuidraw::TessellatedPath::point>(work_room.begin(), work_room.begin() + needed));
-              if(e == 0)
-                {
-                  start_contour = t;
-                }
+          if(points.size() < scratch_loc + max_needed)
+            {
+              points.resize(2 * (scratch_loc + max_needed));
+            }
 
-              contour_length = temp.back().back().m_distance_from_contour_start;
+          edge_pts = fastuidraw::make_c_array(points).sub_array(scratch_loc, max_needed);
+          needed = contour->interpolator(e)->produce_tessellation(m_params, edge_pts);
+          assert(needed > 0 && needed <= max_needed);
 
-              if(e + 2 == ende)
-                {
-                  open_contour_length = contour_length;
-                }
-              else if(e + 1 == ende)
+          edge_pts = edge_pts.sub_array(0, needed);
+          m_edge_ranges[m_contours[o].m_begin + e] = fastuidraw::range_type<unsigned int>(loc, loc + needed);
+          loc += needed;
+          scratch_loc += needed;
+
+          for(unsigned int n = 0; n < needed; ++n)
+            {
+              const fastuidraw::vec2 &pt(edge_pts[n].m_p);
+
+              edge_pts[n].m_distance_from_contour_start = contour_length + edge_pts[n].m_distance_from_edge_start;
+              edge_pts[n].m_edge_length = edge_pts[needed - 1].m_distance_from_edge_start;
+              if(e == 0 && n == 0)
                 {
-                  closed_contour_length = contour_length;
+                  box[0] = box[1] = pt;
                 }
-
-              for(unsigned int n = 0; n < needed; ++n)
+              else
                 {
-                  (*t)[n].m_edge_length = (*t)[needed - 1].m_distance_from_edge_start;
+                  box[0].x() = std::min(box[0].x(), pt.x());
+                  box[0].y() = std::min(box[0].y(), pt.y());
+                  box[1].x() = std::max(box[1].x(), pt.x());
+                  box[1].y() = std::max(box[1].y(), pt.y());
                 }
             }
 
-          for(std::list<std::vector<fastuidraw::TessellatedPath::point> >::iterator
-                t = start_contour, endt = temp.end(); t != endt; ++t)
+          contour_length = edge_pts[needed - 1].m_distance_from_contour_start;
+          if(e + 2 == ende)
             {
-              for(unsigned int e = 0, ende = t->size(); e < ende; ++e)
-                {
-                  (*t)[e].m_open_contour_length = open_contour_length;
-                  (*t)[e].m_closed_contour_length = closed_contour_length;
-                }
+              open_contour_length = contour_length;
+            }
+          else if(e + 1 == ende)
+            {
+              closed_contour_length = contour_length;
             }
         }
+      sources[o].m_end = scratch_loc;
 
-      unsigned int total_needed;
+      /* a contour with a single edge has no closing edge to drop */
+      if(contour->number_points() == 1)
+        {
+          open_contour_length = closed_contour_length;
+        }
 
-      total_needed = m_edge_ranges.back().back().m_end;
-      m_point_data.reserve(total_needed);
-      for(iter = temp.begin(), end_iter = temp.end(); iter != end_iter; ++iter)
+      for(unsigned int n = sources[o].m_begin; n < scratch_loc; ++n)
         {
-          std::copy(iter->begin(), iter->end(),
-                    std::back_insert_iterator<std::vector<fastuidraw::TessellatedPath::point> >(m_point_data));
+          points[n].m_open_contour_length = open_contour_length;
+          points[n].m_closed_contour_length = closed_contour_length;
         }
-      assert(total_needed == m_point_data.size());
     }
-  else
+
+  /* Second pass: the total size is now known, copy the
+     points of each contour, from the scratch buffer or
+     from reuse, into an array of exactly that size.
+   */
+  bool have_box(false);
+
+  m_point_data.reserve(loc);
+  for(unsigned int o = 0, endo = input.number_contours(); o < endo; ++o)
     {
-      m_box_min = m_box_max = fastuidraw::vec2(0.0f, 0.0f);
+      const std::vector<fastuidraw::TessellatedPath::point> &src((sources[o].m_from_reuse) ? reuse->m_point_data : points);
+
+      if(sources[o].m_begin == sources[o].m_end)
+        {
+          continue;
+        }
+
+      m_point_data.insert(m_point_data.end(),
+                          src.begin() + sources[o].m_begin,
+                          src.begin() + sources[o].m_end);
+
+      const fastuidraw::vecN<fastuidraw::vec2, 2> &box(m_contour_boxes[o]);
+      if(!have_box)
+        {
+          have_box = true;
+          m_box_min = box[0];
+          m_box_max = box[1];
+        }
+      else
+        {
+          m_box_min.x() = std::min(m_box_min.x(), box[0].x());
+          m_box_min.y() = std::min(m_box_min.y(), box[0].y());
+          m_box_max.x() = std::max(m_box_max.x(), box[1].x());
+          m_box_max.y() = std::max(m_box_max.y(), box[1].y());
+        }
     }
+  assert(m_point_data.size() == loc);
+
+  m_edge_ranges_array = fastuidraw::make_c_array(m_edge_ranges);
+  m_contours_array = fastuidraw::make_c_array(m_contours);
+  m_point_data_array = fastuidraw::make_c_array(m_point_data);
+}
+
+TessellatedPathPrivate::
+TessellatedPathPrivate(void):
+  m_box_min(0.0f, 0.0f),
+  m_box_max(0.0f, 0.0f)
+{}
+
+bool
+TessellatedPathPrivate::
+load_baked(fastuidraw::BakedDataReader &src)
+{
+  bool ok;
+
+  ok = src.read_value(m_params.m_curve_tessellation)
+    && src.read_value(m_params.m_max_segments)
+    && src.read_value(m_params.m_max_distance)
+    && src.read_value(m_box_min)
+    && src.read_value(m_box_max)
+    && src.read_array(m_contours_array)
+    && src.read_array(m_edge_ranges_array)
+    && src.read_array(m_point_data_array);
+
+  /* the accessors expect that each contour has at least one
+     edge and that the edges of a contour are consecutive.
+   */
+  for(unsigned int c = 0; ok && c < m_contours_array.size(); ++c)
+    {
+      fastuidraw::range_type<unsigned int> R(m_contours_array[c]);
+      ok = R.m_begin < R.m_end && R.m_end <= m_edge_ranges_array.size();
+    }
+
+  for(unsigned int e = 0; ok && e < m_edge_ranges_array.size(); ++e)
+    {
+      fastuidraw::range_type<unsigned int> R(m_edge_ranges_array[e]);
+      ok = R.m_begin <= R.m_end && R.m_end <= m_point_data_array.size();
+    }
+
+  if(!ok)
+    {
+      src.set_error();
+      return false;
+    }
+
+  m_baked_data = src.buffer();
+  return true;
+}
+
+int
+TessellatedPathPrivate::
+source_contour(const fastuidraw::PathContour *c, unsigned int hint,
+               std::map<const fastuidraw::PathContour*, unsigned int> &map) const
+{
+  /* contours are typically only appended to a Path,
+     so the same contour is usually at the same index.
+   */
+  if(hint < m_source_contours.size() && m_source_contours[hint].get() == c)
+    {
+      return hint;
+    }
+
+  if(map.empty())
+    {
+      for(unsigned int i = 0, endi = m_source_contours.size(); i < endi; ++i)
+        {
+          if(m_source_contours[i])
+            {
+              map[m_source_contours[i].get()] = i;
+            }
+        }
+    }
+
+  std::map<const fastuidraw::PathContour*, unsigned int>::const_iterator iter;
+  iter = map.find(c);
+  return (iter != map.end()) ? static_cast<int>(iter->second) : -1;
+}
+
+////////////////////////////////////////////////////
+// fastuidraw::TessellatedPath::ScratchContext methods
+fastuidraw::TessellatedPath::ScratchContext::
+ScratchContext(void)
+{
+  m_d = FASTUIDRAWnew ScratchContextPrivate();
+}
+
+fastuidraw::TessellatedPath::ScratchContext::
+~ScratchContext()
+{
+  ScratchContextPrivate *d;
+  d = reinterpret_cast<ScratchContextPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+//////////////////////////////////////////////////////////
+// fastuidraw::TessellatedPath::TessellationParams methods
+fastuidraw::TessellatedPath::TessellationParams
+fastuidraw::TessellatedPath::TessellationParams::
+lod_params(int lod) const
+{
+  TessellationParams return_value(*this);
+
+  if(lod == 0)
+    {
+      return return_value;
+    }
+
+  /* never let coarser levels take more than a quarter
+     circle per segment.
+   */
+  return_value.m_curve_tessellation *= std::pow(2.0f, -0.5f * static_cast<float>(lod));
+  return_value.m_curve_tessellation = t_min(return_value.m_curve_tessellation, float(M_PI) * 0.5f);
+  if(lod > 0)
+    {
+      return_value.m_max_segments <<= (lod + 1) / 2;
+    }
+
+  if(return_value.m_max_distance > 0.0f)
+    {
+      return_value.m_max_distance *= std::pow(2.0f, -static_cast<float>(lod));
+    }
+  return return_value;
 }
 
 //////////////////////////////////////
@@ -150,7 +442,50 @@ fastuidraw::TessellatedPath::
 TessellatedPath(const Path &input,
                 fastuidraw::TessellatedPath::TessellationParams TP)
 {
-  m_d = FASTUIDRAWnew TessellatedPathPrivate(input, TP);
+  ScratchContextPrivate scratch;
+  m_d = FASTUIDRAWnew TessellatedPathPrivate(input, TP, NULL, scratch);
+}
+
+fastuidraw::TessellatedPath::
+TessellatedPath(const Path &input,
+                fastuidraw::TessellatedPath::TessellationParams TP,
+                ScratchContext &ctx)
+{
+  ScratchContextPrivate *scratch;
+  scratch = reinterpret_cast<ScratchContextPrivate*>(ctx.m_d);
+  m_d = FASTUIDRAWnew TessellatedPathPrivate(input, TP, NULL, *scratch);
+}
+
+fastuidraw::TessellatedPath::
+TessellatedPath(const Path &input,
+                fastuidraw::TessellatedPath::TessellationParams TP,
+                const TessellatedPath *reuse)
+{
+  ScratchContextPrivate scratch;
+  TessellatedPathPrivate *reuse_d;
+
+  reuse_d = (reuse) ? reinterpret_cast<TessellatedPathPrivate*>(reuse->m_d) : NULL;
+  m_d = FASTUIDRAWnew TessellatedPathPrivate(input, TP, reuse_d, scratch);
+}
+
+fastuidraw::TessellatedPath::
+TessellatedPath(const Path &input,
+                fastuidraw::TessellatedPath::TessellationParams TP,
+                const TessellatedPath *reuse,
+                ScratchContext &ctx)
+{
+  ScratchContextPrivate *scratch;
+  TessellatedPathPrivate *reuse_d;
+
+  scratch = reinterpret_cast<ScratchContextPrivate*>(ctx.m_d);
+  reuse_d = (reuse) ? reinterpret_cast<TessellatedPathPrivate*>(reuse->m_d) : NULL;
+  m_d = FASTUIDRAWnew TessellatedPathPrivate(input, TP, reuse_d, *scratch);
+}
+
+fastuidraw::TessellatedPath::
+TessellatedPath(void)
+{
+  m_d = FASTUIDRAWnew TessellatedPathPrivate();
 }
 
 fastuidraw::TessellatedPath::
@@ -168,6 +503,8 @@ stroked(void) const
 {
   TessellatedPathPrivate *d;
   d = reinterpret_cast<TessellatedPathPrivate*>(m_d);
+
+  autolock_mutex m(d->m_stroked_mutex);
   if(!d->m_stroked)
     {
       d->m_stroked = FASTUIDRAWnew StrokedPath(*this);
@@ -181,6 +518,8 @@ filled(void) const
 {
   TessellatedPathPrivate *d;
   d = reinterpret_cast<TessellatedPathPrivate*>(m_d);
+
+  autolock_mutex m(d->m_filled_mutex);
   if(!d->m_filled)
     {
       d->m_filled = FASTUIDRAWnew FilledPath(*this);
@@ -205,7 +544,7 @@ point_data(void) const
   TessellatedPathPrivate *d;
   d = reinterpret_cast<TessellatedPathPrivate*>(m_d);
 
-  return make_c_array(d->m_point_data);
+  return d->m_point_data_array;
 }
 
 unsigned int
@@ -215,7 +554,7 @@ number_contours(void) const
   TessellatedPathPrivate *d;
   d = reinterpret_cast<TessellatedPathPrivate*>(m_d);
 
-  return d->m_edge_ranges.size();
+  return d->m_contours_array.size();
 }
 
 fastuidraw::range_type<unsigned int>
@@ -225,8 +564,8 @@ contour_range(unsigned int contour) const
   TessellatedPathPrivate *d;
   d = reinterpret_cast<TessellatedPathPrivate*>(m_d);
 
-  return range_type<unsigned int>(d->m_edge_ranges[contour].front().m_begin,
-                                  d->m_edge_ranges[contour].back().m_end);
+  return range_type<unsigned int>(d->m_edge_ranges_array[d->m_contours_array[contour].m_begin].m_begin,
+                                  d->m_edge_ranges_array[d->m_contours_array[contour].m_end - 1].m_end);
 }
 
 fastuidraw::range_type<unsigned int>
@@ -239,10 +578,13 @@ unclosed_contour_range(unsigned int contour) const
   range_type<unsigned int> return_value;
   unsigned int num_edges(number_edges(contour));
 
-  return_value.m_begin = d->m_edge_ranges[contour].front().m_begin;
+  const range_type<unsigned int> *edges;
+
+  edges = &d->m_edge_ranges_array[d->m_contours_array[contour].m_begin];
+  return_value.m_begin = edges[0].m_begin;
   return_value.m_end = (num_edges > 1) ?
-    d->m_edge_ranges[contour][num_edges - 2].m_end:
-    d->m_edge_ranges[contour][num_edges - 1].m_end;
+    edges[num_edges - 2].m_end:
+    edges[num_edges - 1].m_end;
 
   return return_value;
 }
@@ -254,7 +596,7 @@ contour_point_data(unsigned int contour) const
   TessellatedPathPrivate *d;
   d = reinterpret_cast<TessellatedPathPrivate*>(m_d);
 
-  return make_c_array(d->m_point_data).sub_array(contour_range(contour));
+  return d->m_point_data_array.sub_array(contour_range(contour));
 }
 
 fastuidraw::const_c_array<fastuidraw::TessellatedPath::point>
@@ -264,7 +606,7 @@ unclosed_contour_point_data(unsigned int contour) const
   TessellatedPathPrivate *d;
   d = reinterpret_cast<TessellatedPathPrivate*>(m_d);
 
-  return make_c_array(d->m_point_data).sub_array(unclosed_contour_range(contour));
+  return d->m_point_data_array.sub_array(unclosed_contour_range(contour));
 }
 
 unsigned int
@@ -274,7 +616,7 @@ number_edges(unsigned int contour) const
   TessellatedPathPrivate *d;
   d = reinterpret_cast<TessellatedPathPrivate*>(m_d);
 
-  return d->m_edge_ranges[contour].size();
+  return d->m_contours_array[contour].difference();
 }
 
 fastuidraw::range_type<unsigned int>
@@ -284,7 +626,8 @@ edge_range(unsigned int contour, unsigned int edge) const
   TessellatedPathPrivate *d;
   d = reinterpret_cast<TessellatedPathPrivate*>(m_d);
 
-  return d->m_edge_ranges[contour][edge];
+  assert(edge < d->m_contours_array[contour].difference());
+  return d->m_edge_ranges_array[d->m_contours_array[contour].m_begin + edge];
 }
 
 fastuidraw::const_c_array<fastuidraw::TessellatedPath::point>
@@ -294,7 +637,7 @@ edge_point_data(unsigned int contour, unsigned int edge) const
   TessellatedPathPrivate *d;
   d = reinterpret_cast<TessellatedPathPrivate*>(m_d);
 
-  return make_c_array(d->m_point_data).sub_array(edge_range(contour, edge));
+  return d->m_point_data_array.sub_array(edge_range(contour, edge));
 }
 
 fastuidraw::vec2
@@ -326,3 +669,90 @@ bounding_box_size(void) const
 
   return d->m_box_max - d->m_box_min;
 }
+
+void
+fastuidraw::TessellatedPath::
+bake(BakedDataWriter &dst, uint32_t what) const
+{
+  TessellatedPathPrivate *d;
+  d = reinterpret_cast<TessellatedPathPrivate*>(m_d);
+
+  /* header: enough to reject data from a different version
+     or from a build whose byte order or struct layout differs
+   */
+  dst.write_value(uint32_t(baked_magic));
+  dst.write_value(uint32_t(baked_version));
+  dst.write_value(uint32_t(baked_byte_order));
+  dst.write_value(uint32_t(sizeof(point)));
+  dst.write_value(uint32_t(sizeof(StrokedPath::point)));
+  dst.write_value(uint32_t(sizeof(PainterAttribute)));
+  dst.write_value(uint32_t(sizeof(PainterIndex)));
+  dst.write_value(what & uint32_t(bake_all));
+
+  dst.write_value(d->m_params.m_curve_tessellation);
+  dst.write_value(d->m_params.m_max_segments);
+  dst.write_value(d->m_params.m_max_distance);
+  dst.write_value(d->m_box_min);
+  dst.write_value(d->m_box_max);
+  dst.write_array(d->m_contours_array);
+  dst.write_array(d->m_edge_ranges_array);
+  dst.write_array(d->m_point_data_array);
+
+  if(what & bake_stroked_path)
+    {
+      stroked()->bake(dst);
+    }
+
+  if(what & bake_filled_path)
+    {
+      filled()->bake(dst);
+    }
+}
+
+fastuidraw::reference_counted_ptr<const fastuidraw::TessellatedPath>
+fastuidraw::TessellatedPath::
+load_baked(BakedDataReader &src)
+{
+  vecN<uint32_t, 8> header;
+  TessellatedPath *return_value;
+  TessellatedPathPrivate *d;
+  bool ok;
+
+  ok = src.read_value(header)
+    && header[0] == uint32_t(baked_magic)
+    && header[1] == uint32_t(baked_version)
+    && header[2] == uint32_t(baked_byte_order)
+    && header[3] == sizeof(point)
+    && header[4] == sizeof(StrokedPath::point)
+    && header[5] == sizeof(PainterAttribute)
+    && header[6] == sizeof(PainterIndex);
+
+  if(!ok)
+    {
+      src.set_error();
+      return reference_counted_ptr<const TessellatedPath>();
+    }
+
+  return_value = FASTUIDRAWnew TessellatedPath();
+  d = reinterpret_cast<TessellatedPathPrivate*>(return_value->m_d);
+  ok = d->load_baked(src);
+
+  if(ok && (header[7] & bake_stroked_path))
+    {
+      d->m_stroked = StrokedPath::load_baked(src);
+      ok = d->m_stroked;
+    }
+
+  if(ok && (header[7] & bake_filled_path))
+    {
+      d->m_filled = FilledPath::load_baked(src);
+      ok = d->m_filled;
+    }
+
+  if(!ok)
+    {
+      FASTUIDRAWdelete(return_value);
+      return reference_counted_ptr<const TessellatedPath>();
+    }
+  return return_value;
+}
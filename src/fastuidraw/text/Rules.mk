@@ -12,6 +12,7 @@ LIBRARY_SOURCES += $(call filelist, glyph_atlas.cpp \
 	glyph_render_data_curve_pair.cpp \
 	glyph_render_data_distance_field.cpp \
 	glyph_render_data_coverage.cpp \
+	glyph_render_data_msdf.cpp \
 	glyph_cache.cpp glyph_selector.cpp \
 	freetype_font.cpp freetype_lib.cpp \
 	font_properties.cpp)
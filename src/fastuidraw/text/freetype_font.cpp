@@ -18,17 +18,24 @@
 
 
 
+#include <string>
+#include <vector>
 #include <boost/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
 
+#include <fastuidraw/util/data_buffer.hpp>
 #include <fastuidraw/text/freetype_font.hpp>
 #include <fastuidraw/text/glyph_layout_data.hpp>
 #include <fastuidraw/text/glyph_render_data.hpp>
 #include <fastuidraw/text/glyph_render_data_curve_pair.hpp>
 #include <fastuidraw/text/glyph_render_data_distance_field.hpp>
+#include <fastuidraw/text/glyph_render_data_msdf.hpp>
 #include <fastuidraw/text/glyph_render_data_coverage.hpp>
 
 #include "private/freetype_util.hpp"
 #include "private/freetype_curvepair_util.hpp"
+#include "private/distance_field_sweep.hpp"
+#include "private/freetype_msdf_util.hpp"
 #include "../private/util_private.hpp"
 
 #include <ft2build.h>
@@ -42,6 +49,32 @@ namespace
     return static_cast<float>(p) / static_cast<float>(1<<6);
   }
 
+  /* computes the size and offset of the bitmap that
+     FT_Render_Glyph(FT_RENDER_MODE_NORMAL) would produce
+     for the outline without rasterizing it: the smooth
+     rasterizer takes the control box of the outline with
+     its min-corner rounded down and its max-corner rounded
+     up to whole pixels.
+   */
+  void
+  compute_bitmap_box(FT_Outline *outline,
+                     fastuidraw::ivec2 &bitmap_sz,
+                     fastuidraw::ivec2 &bitmap_offset)
+  {
+    FT_BBox cbox;
+
+    FT_Outline_Get_CBox(outline, &cbox);
+    cbox.xMin = cbox.xMin & ~63;
+    cbox.yMin = cbox.yMin & ~63;
+    cbox.xMax = (cbox.xMax + 63) & ~63;
+    cbox.yMax = (cbox.yMax + 63) & ~63;
+
+    bitmap_sz.x() = (cbox.xMax - cbox.xMin) >> 6;
+    bitmap_sz.y() = (cbox.yMax - cbox.yMin) >> 6;
+    bitmap_offset.x() = cbox.xMin >> 6;
+    bitmap_offset.y() = cbox.yMin >> 6;
+  }
+
   inline
   uint8_t
   pixel_value_from_distance(float dist, bool outside)
@@ -58,18 +91,35 @@ namespace
     return v;
   }
 
+  /* header values of the key returned by FontFreeType::persistent_key(),
+     persistent_key_version is to be incremented whenever the glyph
+     data generated by FontFreeType from the same font data, face
+     and RenderParams changes.
+   */
+  enum
+    {
+      persistent_key_magic = 0x54465546, /* "FUFT" in little endian */
+      persistent_key_version = 1
+    };
+
   class RenderParamsPrivate
   {
   public:
     RenderParamsPrivate(void):
       m_distance_field_pixel_size(48),
       m_distance_field_max_distance(96.0f),
-      m_curve_pair_pixel_size(32)
+      m_distance_field_generator(fastuidraw::FontFreeType::RenderParams::distance_field_solver),
+      m_curve_pair_pixel_size(32),
+      m_msdf_pixel_size(24),
+      m_msdf_max_distance(128.0f)
     {}
 
     unsigned int m_distance_field_pixel_size;
     float m_distance_field_max_distance;
+    enum fastuidraw::FontFreeType::RenderParams::distance_field_generator_t m_distance_field_generator;
     unsigned int m_curve_pair_pixel_size;
+    unsigned int m_msdf_pixel_size;
+    float m_msdf_max_distance;
   };
 
   class PathCreator
@@ -130,10 +180,29 @@ namespace
     ~FontFreeTypePrivate();
 
     void
-    common_init(void);
+    common_init(FT_Face face);
+
+    /* Returns an FT_Face to use to generate glyph data, a
+       face is used by only one thread at a time. If all
+       faces are in use, a new face is opened if the source
+       of the font is known, otherwise waits until a face
+       is released.
+     */
+    FT_Face
+    acquire_face(void);
+
+    void
+    release_face(FT_Face face);
+
+    FT_Face
+    open_face(void);
+
+    void
+    compute_persistent_key(void);
 
     void
-    common_compute_rendering_data(int pixel_size, FT_Int32 load_flags,
+    common_compute_rendering_data(FT_Face face,
+                                  int pixel_size, FT_Int32 load_flags,
                                   fastuidraw::GlyphLayoutData &layout,
                                   uint32_t glyph_code);
 
@@ -149,17 +218,79 @@ namespace
                            fastuidraw::GlyphRenderDataDistanceField &output,
                            fastuidraw::Path &path);
 
+    void
+    compute_rendering_data_sweep(uint32_t glyph_code,
+                                 fastuidraw::GlyphLayoutData &layout,
+                                 fastuidraw::GlyphRenderDataDistanceField &output,
+                                 fastuidraw::Path &path);
+
     void
     compute_rendering_data(uint32_t glyph_code,
                            fastuidraw::GlyphLayoutData &layout,
                            fastuidraw::GlyphRenderDataCurvePair &output,
                            fastuidraw::Path &path);
 
-    boost::mutex m_mutex;
+    void
+    compute_rendering_data(uint32_t glyph_code,
+                           fastuidraw::GlyphLayoutData &layout,
+                           fastuidraw::GlyphRenderDataMSDF &output,
+                           fastuidraw::Path &path);
+
     FT_Face m_face;
     fastuidraw::FontFreeType::RenderParams m_render_params;
     fastuidraw::reference_counted_ptr<fastuidraw::FreetypeLib> m_lib;
     fastuidraw::FontFreeType *m_p;
+
+    /* source of the font from which to open more faces;
+       only set by FontFreeType::create().
+     */
+    bool m_source_known;
+    std::string m_filename;
+    std::vector<uint8_t> *m_memory;
+    int m_face_index;
+
+    /* pool of faces, m_face is the first face of the pool
+       and m_extra_faces are those faces opened from the
+       font source.
+     */
+    boost::mutex m_mutex;
+    boost::condition_variable m_face_released;
+    std::vector<FT_Face> m_free_faces;
+    std::vector<FT_Face> m_extra_faces;
+
+    /* key returned by FontFreeType::persistent_key(),
+       computed on the first call with m_mutex locked.
+     */
+    bool m_persistent_key_ready;
+    std::vector<uint8_t> m_persistent_key;
+  };
+
+  /* Acquires a face of a FontFreeTypePrivate on ctor,
+     and releases it on dtor.
+   */
+  class ScopedFace:fastuidraw::noncopyable
+  {
+  public:
+    explicit
+    ScopedFace(FontFreeTypePrivate *d):
+      m_d(d),
+      m_face(d->acquire_face())
+    {}
+
+    ~ScopedFace()
+    {
+      m_d->release_face(m_face);
+    }
+
+    FT_Face
+    face(void) const
+    {
+      return m_face;
+    }
+
+  private:
+    FontFreeTypePrivate *m_d;
+    FT_Face m_face;
   };
 }
 
@@ -289,9 +420,14 @@ FontFreeTypePrivate(fastuidraw::FontFreeType *p, FT_Face pface,
                     const fastuidraw::FontFreeType::RenderParams &render_params):
   m_face(pface),
   m_render_params(render_params),
-  m_p(p)
+  m_p(p),
+  m_source_known(false),
+  m_memory(NULL),
+  m_face_index(0),
+  m_persistent_key_ready(false)
 {
-  common_init();
+  common_init(m_face);
+  m_free_faces.push_back(m_face);
 }
 
 FontFreeTypePrivate::
@@ -301,48 +437,209 @@ FontFreeTypePrivate(fastuidraw::FontFreeType *p, FT_Face pface,
   m_face(pface),
   m_render_params(render_params),
   m_lib(lib),
-  m_p(p)
+  m_p(p),
+  m_source_known(false),
+  m_memory(NULL),
+  m_face_index(0),
+  m_persistent_key_ready(false)
 {
-  common_init();
+  common_init(m_face);
+  m_free_faces.push_back(m_face);
 }
 
 FontFreeTypePrivate::
 ~FontFreeTypePrivate()
 {
+  assert(m_free_faces.size() == m_extra_faces.size() + 1);
   if(m_lib)
     {
+      m_lib->lock();
       FT_Done_Face(m_face);
+      for(unsigned int i = 0, endi = m_extra_faces.size(); i < endi; ++i)
+        {
+          FT_Done_Face(m_extra_faces[i]);
+        }
+      m_lib->unlock();
+    }
+
+  if(m_memory)
+    {
+      FASTUIDRAWdelete(m_memory);
+    }
+}
+
+void
+FontFreeTypePrivate::
+common_init(FT_Face face)
+{
+  assert(face != NULL);
+  assert(face->face_flags & FT_FACE_FLAG_SCALABLE);
+  FT_Set_Transform(face, NULL, NULL);
+}
+
+FT_Face
+FontFreeTypePrivate::
+open_face(void)
+{
+  FT_Face face(NULL);
+  int error_code;
+
+  assert(m_source_known && m_lib);
+  m_lib->lock();
+  if(m_memory)
+    {
+      error_code = FT_New_Memory_Face(m_lib->lib(), &(*m_memory)[0], m_memory->size(),
+                                      m_face_index, &face);
+    }
+  else
+    {
+      error_code = FT_New_Face(m_lib->lib(), m_filename.c_str(), m_face_index, &face);
+    }
+
+  if(error_code != 0 && face != NULL)
+    {
+      FT_Done_Face(face);
+      face = NULL;
+    }
+  m_lib->unlock();
+
+  if(face != NULL)
+    {
+      common_init(face);
+    }
+  return face;
+}
+
+FT_Face
+FontFreeTypePrivate::
+acquire_face(void)
+{
+  FT_Face return_value;
+  bool can_open;
+
+  {
+    boost::unique_lock<boost::mutex> lock(m_mutex);
+    if(!m_free_faces.empty())
+      {
+        return_value = m_free_faces.back();
+        m_free_faces.pop_back();
+        return return_value;
+      }
+    can_open = m_source_known;
+  }
+
+  if(can_open)
+    {
+      /* open the new face without holding m_mutex so that
+         other threads can continue to acquire and release
+         faces.
+       */
+      return_value = open_face();
+      if(return_value != NULL)
+        {
+          fastuidraw::autolock_mutex m(m_mutex);
+          m_extra_faces.push_back(return_value);
+          return return_value;
+        }
+    }
+
+  boost::unique_lock<boost::mutex> lock(m_mutex);
+  while(m_free_faces.empty())
+    {
+      m_face_released.wait(lock);
     }
+  return_value = m_free_faces.back();
+  m_free_faces.pop_back();
+  return return_value;
 }
 
 void
 FontFreeTypePrivate::
-common_init(void)
+release_face(FT_Face face)
 {
-  assert(m_face != NULL);
-  assert(m_face->face_flags & FT_FACE_FLAG_SCALABLE);
-  FT_Set_Transform(m_face, NULL, NULL);
+  m_mutex.lock();
+  m_free_faces.push_back(face);
+  m_mutex.unlock();
+  m_face_released.notify_one();
 }
 
 void
 FontFreeTypePrivate::
-common_compute_rendering_data(int pixel_size, FT_Int32 load_flags,
+compute_persistent_key(void)
+{
+  fastuidraw::reference_counted_ptr<const fastuidraw::DataBuffer> file;
+  fastuidraw::const_c_array<uint8_t> font_data;
+  fastuidraw::BakedDataWriter dst;
+  fastuidraw::const_c_array<uint8_t> key;
+  FT_Int major(0), minor(0), patch(0);
+  uint64_t hash(14695981039346656037ull);
+
+  if(!m_source_known)
+    {
+      return;
+    }
+
+  if(m_memory)
+    {
+      font_data = fastuidraw::make_c_array(*m_memory);
+    }
+  else
+    {
+      file = FASTUIDRAWnew fastuidraw::DataBuffer(m_filename.c_str());
+      font_data = file->data();
+    }
+
+  if(font_data.empty())
+    {
+      return;
+    }
+
+  /* FNV-1a of the font data */
+  for(unsigned int i = 0, endi = font_data.size(); i < endi; ++i)
+    {
+      hash ^= font_data[i];
+      hash *= 1099511628211ull;
+    }
+
+  FT_Library_Version(m_lib->lib(), &major, &minor, &patch);
+
+  dst.write_value(uint32_t(persistent_key_magic));
+  dst.write_value(uint32_t(persistent_key_version));
+  dst.write_value(hash);
+  dst.write_value(uint64_t(font_data.size()));
+  dst.write_value(int32_t(m_face_index));
+  dst.write_value(fastuidraw::vecN<int32_t, 3>(major, minor, patch));
+  dst.write_value(uint32_t(m_render_params.distance_field_pixel_size()));
+  dst.write_value(m_render_params.distance_field_max_distance());
+  dst.write_value(uint32_t(m_render_params.distance_field_generator()));
+  dst.write_value(uint32_t(m_render_params.curve_pair_pixel_size()));
+  dst.write_value(uint32_t(m_render_params.msdf_pixel_size()));
+  dst.write_value(m_render_params.msdf_max_distance());
+
+  key = dst.data();
+  m_persistent_key.assign(key.begin(), key.end());
+}
+
+void
+FontFreeTypePrivate::
+common_compute_rendering_data(FT_Face face,
+                              int pixel_size, FT_Int32 load_flags,
                               fastuidraw::GlyphLayoutData &output,
                               uint32_t glyph_code)
 {
   fastuidraw::ivec2 bitmap_sz, bitmap_offset, iadvance;
 
-  FT_Set_Pixel_Sizes(m_face, pixel_size, pixel_size);
-  FT_Load_Glyph(m_face, glyph_code, load_flags);
-
-  output.m_size.x() = to_pixel_sizes(m_face->glyph->metrics.width);
-  output.m_size.y() = to_pixel_sizes(m_face->glyph->metrics.height);
-  output.m_horizontal_layout_offset.x() = to_pixel_sizes(m_face->glyph->metrics.horiBearingX);
-  output.m_horizontal_layout_offset.y() = to_pixel_sizes(m_face->glyph->metrics.horiBearingY) - output.m_size.y();
-  output.m_vertical_layout_offset.x() = to_pixel_sizes(m_face->glyph->metrics.vertBearingX);
-  output.m_vertical_layout_offset.y() = to_pixel_sizes(m_face->glyph->metrics.vertBearingY) - output.m_size.y();
-  output.m_advance.x() = to_pixel_sizes(m_face->glyph->metrics.horiAdvance);
-  output.m_advance.y() = to_pixel_sizes(m_face->glyph->metrics.vertAdvance);
+  FT_Set_Pixel_Sizes(face, pixel_size, pixel_size);
+  FT_Load_Glyph(face, glyph_code, load_flags);
+
+  output.m_size.x() = to_pixel_sizes(face->glyph->metrics.width);
+  output.m_size.y() = to_pixel_sizes(face->glyph->metrics.height);
+  output.m_horizontal_layout_offset.x() = to_pixel_sizes(face->glyph->metrics.horiBearingX);
+  output.m_horizontal_layout_offset.y() = to_pixel_sizes(face->glyph->metrics.horiBearingY) - output.m_size.y();
+  output.m_vertical_layout_offset.x() = to_pixel_sizes(face->glyph->metrics.vertBearingX);
+  output.m_vertical_layout_offset.y() = to_pixel_sizes(face->glyph->metrics.vertBearingY) - output.m_size.y();
+  output.m_advance.x() = to_pixel_sizes(face->glyph->metrics.horiAdvance);
+  output.m_advance.y() = to_pixel_sizes(face->glyph->metrics.vertAdvance);
   output.m_glyph_code = glyph_code;
   output.m_pixel_size = pixel_size;
   output.m_font = m_p;
@@ -356,14 +653,15 @@ compute_rendering_data(int pixel_size, uint32_t glyph_code,
                        fastuidraw::Path &path)
 {
   fastuidraw::ivec2 bitmap_sz;
-  fastuidraw::autolock_mutex m(m_mutex);
+  ScopedFace scoped_face(this);
+  FT_Face face(scoped_face.face());
 
-  common_compute_rendering_data(pixel_size, FT_LOAD_DEFAULT, layout, glyph_code);
-  PathCreator::decompose_to_path(&m_face->glyph->outline, path);
-  FT_Render_Glyph(m_face->glyph, FT_RENDER_MODE_NORMAL);
+  common_compute_rendering_data(face, pixel_size, FT_LOAD_DEFAULT, layout, glyph_code);
+  PathCreator::decompose_to_path(&face->glyph->outline, path);
+  FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL);
 
-  bitmap_sz.x() = m_face->glyph->bitmap.width;
-  bitmap_sz.y() = m_face->glyph->bitmap.rows;
+  bitmap_sz.x() = face->glyph->bitmap.width;
+  bitmap_sz.y() = face->glyph->bitmap.rows;
 
   /* add one pixel slack on glyph
    */
@@ -371,7 +669,7 @@ compute_rendering_data(int pixel_size, uint32_t glyph_code,
     {
       int pitch;
 
-      pitch = m_face->glyph->bitmap.pitch;
+      pitch = face->glyph->bitmap.pitch;
       output.resize(bitmap_sz + fastuidraw::ivec2(1, 1));
       std::fill(output.coverage_values().begin(), output.coverage_values().end(), 0);
       for(int y = 0; y < bitmap_sz.y(); ++y)
@@ -382,7 +680,7 @@ compute_rendering_data(int pixel_size, uint32_t glyph_code,
 
               write_location = x + y * output.resolution().x();
               read_location = x + (bitmap_sz.y() - 1 - y) * pitch;
-              output.coverage_values()[write_location] = m_face->glyph->bitmap.buffer[read_location];
+              output.coverage_values()[write_location] = face->glyph->bitmap.buffer[read_location];
             }
         }
     }
@@ -403,23 +701,26 @@ compute_rendering_data(uint32_t glyph_code,
   float max_distance(m_render_params.distance_field_max_distance());
   fastuidraw::ivec2 bitmap_sz, bitmap_offset;
 
+  if(m_render_params.distance_field_generator() == fastuidraw::FontFreeType::RenderParams::distance_field_sweep)
+    {
+      compute_rendering_data_sweep(glyph_code, layout, output, path);
+      return;
+    }
+
   std::vector<fastuidraw::detail::point_type> pts;
   std::ostream *stream_ptr(NULL);
   fastuidraw::detail::geometry_data dbg(stream_ptr, pts);
 
-  m_mutex.lock();
+  FT_Face face;
 
-    common_compute_rendering_data(pixel_size, FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING, layout, glyph_code);
-    FT_Render_Glyph(m_face->glyph, FT_RENDER_MODE_NORMAL);
+  face = acquire_face();
 
-    bitmap_sz.x() = m_face->glyph->bitmap.width;
-    bitmap_sz.y() = m_face->glyph->bitmap.rows;
-    bitmap_offset.x() = m_face->glyph->bitmap_left;
-    bitmap_offset.y() = m_face->glyph->bitmap_top - m_face->glyph->bitmap.rows;
+    common_compute_rendering_data(face, pixel_size, FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING, layout, glyph_code);
+    compute_bitmap_box(&face->glyph->outline, bitmap_sz, bitmap_offset);
 
-    fastuidraw::detail::OutlineData outline_data(m_face->glyph->outline, bitmap_sz, bitmap_offset, dbg);
+    fastuidraw::detail::OutlineData outline_data(face->glyph->outline, bitmap_sz, bitmap_offset, dbg);
 
-  m_mutex.unlock();
+  release_face(face);
 
   outline_data.extract_path(path);
   if(bitmap_sz.x() != 0 && bitmap_sz.y() != 0)
@@ -455,6 +756,56 @@ compute_rendering_data(uint32_t glyph_code,
     }
 }
 
+void
+FontFreeTypePrivate::
+compute_rendering_data_sweep(uint32_t glyph_code,
+                             fastuidraw::GlyphLayoutData &layout,
+                             fastuidraw::GlyphRenderDataDistanceField &output,
+                             fastuidraw::Path &path)
+{
+  int pixel_size(m_render_params.distance_field_pixel_size());
+  float max_distance(m_render_params.distance_field_max_distance());
+  fastuidraw::ivec2 bitmap_sz, bitmap_offset;
+
+  FT_Face face;
+
+  face = acquire_face();
+
+    common_compute_rendering_data(face, pixel_size, FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING, layout, glyph_code);
+    compute_bitmap_box(&face->glyph->outline, bitmap_sz, bitmap_offset);
+
+    fastuidraw::detail::DistanceFieldSweep sweep(face->glyph->outline, bitmap_sz, bitmap_offset);
+    PathCreator::decompose_to_path(&face->glyph->outline, path);
+
+  release_face(face);
+
+  if(bitmap_sz.x() != 0 && bitmap_sz.y() != 0)
+    {
+      /* add one pixel slack on glyph
+       */
+      output.resize(bitmap_sz + fastuidraw::ivec2(1, 1));
+      std::fill(output.distance_values().begin(), output.distance_values().end(), 0);
+
+      sweep.compute_distance_values(max_distance);
+      for(int y = 0; y < bitmap_sz.y(); ++y)
+        {
+          for(int x = 0; x < bitmap_sz.x(); ++x)
+            {
+              int location;
+              float v0;
+
+              location = x + y * output.resolution().x();
+              v0 = sweep.distance(x, y) / max_distance;
+              output.distance_values()[location] = pixel_value_from_distance(v0, !sweep.inside(x, y));
+            }
+        }
+    }
+  else
+    {
+      output.resize(fastuidraw::ivec2(0, 0));
+    }
+}
+
 void
 FontFreeTypePrivate::
 compute_rendering_data(uint32_t glyph_code,
@@ -465,20 +816,54 @@ compute_rendering_data(uint32_t glyph_code,
   int pixel_size(m_render_params.curve_pair_pixel_size());
   fastuidraw::ivec2 bitmap_offset, bitmap_sz;
 
-  m_mutex.lock();
-    common_compute_rendering_data(pixel_size, FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING, layout, glyph_code);
-    FT_Render_Glyph(m_face->glyph, FT_RENDER_MODE_NORMAL);
-    bitmap_sz.x() = m_face->glyph->bitmap.width;
-    bitmap_sz.y() = m_face->glyph->bitmap.rows;
-    bitmap_offset.x() = m_face->glyph->bitmap_left;
-    bitmap_offset.y() = m_face->glyph->bitmap_top - m_face->glyph->bitmap.rows;
-    fastuidraw::detail::CurvePairGenerator gen(m_face->glyph->outline, bitmap_sz, bitmap_offset, output);
-  m_mutex.unlock();
+  FT_Face face;
+
+  face = acquire_face();
+    common_compute_rendering_data(face, pixel_size, FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING, layout, glyph_code);
+    compute_bitmap_box(&face->glyph->outline, bitmap_sz, bitmap_offset);
+    fastuidraw::detail::CurvePairGenerator gen(face->glyph->outline, bitmap_sz, bitmap_offset, output);
+  release_face(face);
 
   gen.extract_data(output);
   gen.extract_path(path);
 }
 
+void
+FontFreeTypePrivate::
+compute_rendering_data(uint32_t glyph_code,
+                       fastuidraw::GlyphLayoutData &layout,
+                       fastuidraw::GlyphRenderDataMSDF &output,
+                       fastuidraw::Path &path)
+{
+  int pixel_size(m_render_params.msdf_pixel_size());
+  float max_distance(m_render_params.msdf_max_distance());
+  fastuidraw::ivec2 bitmap_sz, bitmap_offset;
+
+  FT_Face face;
+
+  face = acquire_face();
+
+    common_compute_rendering_data(face, pixel_size, FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING, layout, glyph_code);
+    compute_bitmap_box(&face->glyph->outline, bitmap_sz, bitmap_offset);
+
+    fastuidraw::detail::MSDFGenerator gen(face->glyph->outline, bitmap_sz, bitmap_offset);
+    PathCreator::decompose_to_path(&face->glyph->outline, path);
+
+  release_face(face);
+
+  if(bitmap_sz.x() != 0 && bitmap_sz.y() != 0)
+    {
+      /* add one pixel slack on glyph
+       */
+      output.resize(bitmap_sz + fastuidraw::ivec2(1, 1));
+      gen.compute_distance_values(max_distance, output);
+    }
+  else
+    {
+      output.resize(fastuidraw::ivec2(0, 0));
+    }
+}
+
 /////////////////////////////////////////////
 // fastuidraw::FontFreeType::RenderParams methods
 fastuidraw::FontFreeType::RenderParams::
@@ -553,6 +938,25 @@ distance_field_max_distance(void) const
   return d->m_distance_field_max_distance;
 }
 
+fastuidraw::FontFreeType::RenderParams&
+fastuidraw::FontFreeType::RenderParams::
+distance_field_generator(enum distance_field_generator_t v)
+{
+  RenderParamsPrivate *d;
+  d = reinterpret_cast<RenderParamsPrivate*>(m_d);
+  d->m_distance_field_generator = v;
+  return *this;
+}
+
+enum fastuidraw::FontFreeType::RenderParams::distance_field_generator_t
+fastuidraw::FontFreeType::RenderParams::
+distance_field_generator(void) const
+{
+  RenderParamsPrivate *d;
+  d = reinterpret_cast<RenderParamsPrivate*>(m_d);
+  return d->m_distance_field_generator;
+}
+
 fastuidraw::FontFreeType::RenderParams&
 fastuidraw::FontFreeType::RenderParams::
 curve_pair_pixel_size(unsigned int v)
@@ -572,6 +976,44 @@ curve_pair_pixel_size(void) const
   return d->m_curve_pair_pixel_size;
 }
 
+fastuidraw::FontFreeType::RenderParams&
+fastuidraw::FontFreeType::RenderParams::
+msdf_pixel_size(unsigned int v)
+{
+  RenderParamsPrivate *d;
+  d = reinterpret_cast<RenderParamsPrivate*>(m_d);
+  d->m_msdf_pixel_size = v;
+  return *this;
+}
+
+unsigned int
+fastuidraw::FontFreeType::RenderParams::
+msdf_pixel_size(void) const
+{
+  RenderParamsPrivate *d;
+  d = reinterpret_cast<RenderParamsPrivate*>(m_d);
+  return d->m_msdf_pixel_size;
+}
+
+fastuidraw::FontFreeType::RenderParams&
+fastuidraw::FontFreeType::RenderParams::
+msdf_max_distance(float v)
+{
+  RenderParamsPrivate *d;
+  d = reinterpret_cast<RenderParamsPrivate*>(m_d);
+  d->m_msdf_max_distance = v;
+  return *this;
+}
+
+float
+fastuidraw::FontFreeType::RenderParams::
+msdf_max_distance(void) const
+{
+  RenderParamsPrivate *d;
+  d = reinterpret_cast<RenderParamsPrivate*>(m_d);
+  return d->m_msdf_max_distance;
+}
+
 ///////////////////////////////////////////////////
 // fastuidraw::FontFreeType methods
 fastuidraw::FontFreeType::
@@ -633,7 +1075,8 @@ can_create_rendering_data(enum glyph_type tp) const
 {
   return tp == coverage_glyph
     || tp == distance_field_glyph
-    || tp == curve_pair_glyph;
+    || tp == curve_pair_glyph
+    || tp == msdf_glyph;
 }
 
 fastuidraw::GlyphRenderData*
@@ -673,12 +1116,81 @@ compute_rendering_data(GlyphRender render, uint32_t glyph_code,
       }
       break;
 
+    case msdf_glyph:
+      {
+        GlyphRenderDataMSDF *data;
+        data = FASTUIDRAWnew GlyphRenderDataMSDF();
+        d->compute_rendering_data(glyph_code, layout, *data, path);
+        return data;
+      }
+      break;
+
     default:
       assert(!"Invalid glyph type");
       return NULL;
     }
 }
 
+void
+fastuidraw::FontFreeType::
+compute_layout_data(GlyphRender render, uint32_t glyph_code,
+                    GlyphLayoutData &layout) const
+{
+  FontFreeTypePrivate *d;
+  d = reinterpret_cast<FontFreeTypePrivate*>(m_d);
+
+  /* the pixel size and load flags must match those used
+     by the compute_rendering_data() methods of
+     FontFreeTypePrivate.
+   */
+  int pixel_size;
+  FT_Int32 load_flags;
+  switch(render.m_type)
+    {
+    case coverage_glyph:
+      pixel_size = render.m_pixel_size;
+      load_flags = FT_LOAD_DEFAULT;
+      break;
+
+    case distance_field_glyph:
+      pixel_size = d->m_render_params.distance_field_pixel_size();
+      load_flags = FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING;
+      break;
+
+    case curve_pair_glyph:
+      pixel_size = d->m_render_params.curve_pair_pixel_size();
+      load_flags = FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING;
+      break;
+
+    case msdf_glyph:
+      pixel_size = d->m_render_params.msdf_pixel_size();
+      load_flags = FT_LOAD_NO_BITMAP | FT_LOAD_NO_HINTING;
+      break;
+
+    default:
+      assert(!"Invalid glyph type");
+      return;
+    }
+
+  ScopedFace scoped_face(d);
+  d->common_compute_rendering_data(scoped_face.face(), pixel_size, load_flags, layout, glyph_code);
+}
+
+fastuidraw::const_c_array<uint8_t>
+fastuidraw::FontFreeType::
+persistent_key(void) const
+{
+  FontFreeTypePrivate *d;
+  d = reinterpret_cast<FontFreeTypePrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  if(!d->m_persistent_key_ready)
+    {
+      d->compute_persistent_key();
+      d->m_persistent_key_ready = true;
+    }
+  return make_c_array(d->m_persistent_key);
+}
 
 const fastuidraw::FontFreeType::RenderParams&
 fastuidraw::FontFreeType::
@@ -698,6 +1210,17 @@ face(void) const
   return d->m_face;
 }
 
+unsigned int
+fastuidraw::FontFreeType::
+number_faces(void) const
+{
+  FontFreeTypePrivate *d;
+  d = reinterpret_cast<FontFreeTypePrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  return d->m_extra_faces.size() + 1;
+}
+
 int
 fastuidraw::FontFreeType::
 create(c_array<reference_counted_ptr<FontFreeType> > fonts, const char *filename,
@@ -713,7 +1236,9 @@ create(c_array<reference_counted_ptr<FontFreeType> > fonts, const char *filename
   int error_code;
   unsigned int num(0);
 
+  lib->lock();
   error_code = FT_New_Face(lib->lib(), filename, -1, &face);
+  lib->unlock();
   if(error_code == 0 && face != NULL && (face->face_flags & FT_FACE_FLAG_SCALABLE) == 0)
     {
       reference_counted_ptr<fastuidraw::FontFreeType> f;
@@ -727,7 +1252,9 @@ create(c_array<reference_counted_ptr<FontFreeType> > fonts, const char *filename
 
   if(face != NULL)
     {
+      lib->lock();
       FT_Done_Face(face);
+      lib->unlock();
     }
 
   return num;
@@ -745,6 +1272,8 @@ create(const char *filename, reference_counted_ptr<FreetypeLib> lib,
 
   int error_code;
   FT_Face face(NULL);
+
+  lib->lock();
   error_code = FT_New_Face(lib->lib(), filename, face_index, &face);
   if(error_code != 0 || face == NULL || (face->face_flags & FT_FACE_FLAG_SCALABLE) == 0)
     {
@@ -752,17 +1281,78 @@ create(const char *filename, reference_counted_ptr<FreetypeLib> lib,
         {
           FT_Done_Face(face);
         }
+      lib->unlock();
       return reference_counted_ptr<FontFreeType>();
     }
+  lib->unlock();
 
   FontProperties p;
   std::ostringstream str;
+  FontFreeType *font;
+  FontFreeTypePrivate *d;
 
   str << filename << ":" << face_index;
   compute_font_propertes_from_face(face, p);
   p.source_label(str.str().c_str());
 
-  return FASTUIDRAWnew FontFreeType(face, lib, p, render_params);
+  font = FASTUIDRAWnew FontFreeType(face, lib, p, render_params);
+  d = reinterpret_cast<FontFreeTypePrivate*>(font->m_d);
+  d->m_source_known = true;
+  d->m_filename = filename;
+  d->m_face_index = face_index;
+
+  return font;
+}
+
+fastuidraw::reference_counted_ptr<fastuidraw::FontFreeType>
+fastuidraw::FontFreeType::
+create(const_c_array<uint8_t> data, reference_counted_ptr<FreetypeLib> lib,
+       const RenderParams &render_params, int face_index)
+{
+  if(!lib || !lib->valid() || data.empty())
+    {
+      return reference_counted_ptr<FontFreeType>();
+    }
+
+  int error_code;
+  FT_Face face(NULL);
+  std::vector<uint8_t> *memory;
+
+  /* FT_New_Memory_Face() does not copy the data, the faces
+     of the font read from memory owned by the font.
+   */
+  memory = FASTUIDRAWnew std::vector<uint8_t>(data.begin(), data.end());
+
+  lib->lock();
+  error_code = FT_New_Memory_Face(lib->lib(), &(*memory)[0], memory->size(), face_index, &face);
+  if(error_code != 0 || face == NULL || (face->face_flags & FT_FACE_FLAG_SCALABLE) == 0)
+    {
+      if(face != NULL)
+        {
+          FT_Done_Face(face);
+        }
+      lib->unlock();
+      FASTUIDRAWdelete(memory);
+      return reference_counted_ptr<FontFreeType>();
+    }
+  lib->unlock();
+
+  FontProperties p;
+  std::ostringstream str;
+  FontFreeType *font;
+  FontFreeTypePrivate *d;
+
+  str << "memory:" << face_index;
+  compute_font_propertes_from_face(face, p);
+  p.source_label(str.str().c_str());
+
+  font = FASTUIDRAWnew FontFreeType(face, lib, p, render_params);
+  d = reinterpret_cast<FontFreeTypePrivate*>(font->m_d);
+  d->m_source_known = true;
+  d->m_memory = memory;
+  d->m_face_index = face_index;
+
+  return font;
 }
 
 fastuidraw::reference_counted_ptr<fastuidraw::FontFreeType>
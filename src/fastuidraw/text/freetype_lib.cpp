@@ -17,6 +17,7 @@
  */
 
 
+#include <boost/thread.hpp>
 #include <fastuidraw/text/freetype_lib.hpp>
 
 fastuidraw::FreetypeLib::
@@ -29,6 +30,7 @@ FreetypeLib(void)
     {
       m_lib = NULL;
     }
+  m_d = FASTUIDRAWnew boost::mutex();
 }
 
 fastuidraw::FreetypeLib::
@@ -38,4 +40,27 @@ fastuidraw::FreetypeLib::
     {
       FT_Done_FreeType(m_lib);
     }
+
+  boost::mutex *d;
+  d = reinterpret_cast<boost::mutex*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+void
+fastuidraw::FreetypeLib::
+lock(void)
+{
+  boost::mutex *d;
+  d = reinterpret_cast<boost::mutex*>(m_d);
+  d->lock();
+}
+
+void
+fastuidraw::FreetypeLib::
+unlock(void)
+{
+  boost::mutex *d;
+  d = reinterpret_cast<boost::mutex*>(m_d);
+  d->unlock();
 }
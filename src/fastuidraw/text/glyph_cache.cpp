@@ -19,8 +19,12 @@
 
 #include <map>
 #include <vector>
+#include <deque>
+#include <boost/thread.hpp>
+#include <boost/thread/condition_variable.hpp>
 #include <fastuidraw/text/glyph_cache.hpp>
 #include <fastuidraw/text/glyph_render_data.hpp>
+#include "private/glyph_cache_file.hpp"
 #include "../private/util_private.hpp"
 
 
@@ -28,6 +32,90 @@ namespace
 {
 
   class GlyphCachePrivate;
+  class GlyphDataPrivate;
+
+  /* A GlyphGenerationJob is the generation of the data of
+     a glyph of an asynchronous GlyphCache. The worker thread
+     only writes to m_glyph_data, m_path and m_layout; the
+     glyph takes the data when the job is finished from
+     GlyphCache::upload_pending_glyphs().
+   */
+  class GlyphGenerationJob:fastuidraw::noncopyable
+  {
+  public:
+    GlyphGenerationJob(GlyphDataPrivate *glyph,
+                       const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+                       uint32_t glyph_code, fastuidraw::GlyphRender render):
+      m_glyph(glyph),
+      m_font(font),
+      m_glyph_code(glyph_code),
+      m_render(render),
+      m_glyph_data(NULL)
+    {}
+
+    ~GlyphGenerationJob()
+    {
+      if(m_glyph_data)
+        {
+          FASTUIDRAWdelete(m_glyph_data);
+        }
+    }
+
+    void
+    execute(void)
+    {
+      m_glyph_data = m_font->compute_rendering_data(m_render, m_glyph_code, m_layout, m_path);
+    }
+
+    /* glyph to receive the data, NULL if the glyph
+       was removed before the job finished; only
+       accessed from the thread of the GlyphCache.
+     */
+    GlyphDataPrivate *m_glyph;
+
+    fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> m_font;
+    uint32_t m_glyph_code;
+    fastuidraw::GlyphRender m_render;
+
+    fastuidraw::GlyphRenderData *m_glyph_data;
+    fastuidraw::Path m_path;
+    fastuidraw::GlyphLayoutData m_layout;
+  };
+
+  /* Pool of threads executing GlyphGenerationJob objects
+     for an asynchronous GlyphCache.
+   */
+  class GlyphGenerator:fastuidraw::noncopyable
+  {
+  public:
+    explicit
+    GlyphGenerator(unsigned int number_threads);
+
+    ~GlyphGenerator();
+
+    void
+    add_job(GlyphGenerationJob *job);
+
+    /* take the finished jobs */
+    void
+    take_finished(std::vector<GlyphGenerationJob*> &out_jobs);
+
+    void
+    wait(void);
+
+    static
+    void
+    worker(GlyphGenerator *d);
+
+    boost::mutex m_mutex;
+    boost::condition_variable m_work_available;
+    boost::condition_variable m_work_done;
+    std::deque<GlyphGenerationJob*> m_jobs;
+    std::vector<GlyphGenerationJob*> m_finished;
+    unsigned int m_number_pending;
+    bool m_quit;
+    std::vector<boost::thread*> m_threads;
+  };
 
   class GlyphDataPrivate
   {
@@ -38,7 +126,8 @@ namespace
       m_geometry_offset(-1),
       m_geometry_length(0),
       m_uploaded_to_atlas(false),
-      m_glyph_data(NULL)
+      m_glyph_data(NULL),
+      m_pending_job(NULL)
     {}
 
     void
@@ -70,9 +159,20 @@ namespace
      */
     fastuidraw::Path m_path;
 
+    /* if non-NULL, the Path of the glyph as read from the
+       persistent cache file, read into m_path on the first
+       call to Glyph::path().
+     */
+    fastuidraw::reference_counted_ptr<const fastuidraw::DataBuffer> m_path_data;
+
     /* data to generate glyph data
      */
     fastuidraw::GlyphRenderData *m_glyph_data;
+
+    /* if non-NULL, the glyph is pending and
+       its data is generated by the job.
+     */
+    GlyphGenerationJob *m_pending_job;
   };
 
   class GlyphSource
@@ -102,12 +202,38 @@ namespace
     fastuidraw::GlyphRender m_render;
   };
 
+  /* The glyphs whose data is generated by
+     GlyphCache::fetch_glyphs(); the threads
+     take the glyphs of m_jobs in order.
+   */
+  class GenerateGlyphJobs:fastuidraw::noncopyable
+  {
+  public:
+    GenerateGlyphJobs(void):
+      m_next(0)
+    {}
+
+    void
+    execute(unsigned int number_threads);
+
+    static
+    void
+    worker(GenerateGlyphJobs *jobs);
+
+    std::vector<GlyphDataPrivate*> m_jobs;
+    std::vector<const fastuidraw::FontBase*> m_fonts;
+    std::vector<uint32_t> m_glyph_codes;
+
+    boost::mutex m_mutex;
+    unsigned int m_next;
+  };
+
   class GlyphCachePrivate
   {
   public:
-    explicit
     GlyphCachePrivate(fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> patlas,
-                      fastuidraw::GlyphCache *p);
+                      fastuidraw::GlyphCache *p, unsigned int number_generation_threads,
+                      const char *persistent_cache_file);
 
     ~GlyphCachePrivate();
 
@@ -120,11 +246,40 @@ namespace
     GlyphDataPrivate*
     fetch_or_allocate_glyph(GlyphSource src);
 
+    unsigned int
+    upload_pending_glyphs(void);
+
+    /* give a glyph its data from m_file, returns
+       false if the glyph is not in m_file.
+     */
+    bool
+    load_glyph(GlyphDataPrivate *q,
+               const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+               uint32_t glyph_code);
+
+    /* add the data of a glyph just generated to m_file */
+    void
+    store_glyph(const GlyphDataPrivate *q, const fastuidraw::FontBase *font,
+                uint32_t glyph_code);
+
     fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> m_atlas;
     std::map<GlyphSource, GlyphDataPrivate*> m_glyph_map;
     std::vector<GlyphDataPrivate*> m_glyphs;
     std::vector<unsigned int> m_free_slots;
     fastuidraw::GlyphCache *m_p;
+
+    /* NULL if the GlyphCache is synchronous */
+    GlyphGenerator *m_generator;
+    unsigned int m_number_pending;
+    std::vector<GlyphGenerationJob*> m_finished_jobs;
+
+    /* NULL if the GlyphCache has no persistent cache file */
+    fastuidraw::detail::GlyphCacheFile *m_file;
+
+    /* locked by Glyph::path() when reading the Path of
+       a glyph from its GlyphDataPrivate::m_path_data.
+     */
+    boost::mutex m_path_mutex;
   };
 }
 
@@ -163,6 +318,17 @@ clear(void)
       m_glyph_data = NULL;
     }
   m_path.clear();
+  m_path_data.clear();
+
+  if(m_pending_job)
+    {
+      /* the job is still owned by the GlyphGenerator,
+         it discards its data when it finishes.
+       */
+      m_pending_job->m_glyph = NULL;
+      m_pending_job = NULL;
+      --m_cache->m_number_pending;
+    }
 }
 
 enum fastuidraw::return_code
@@ -187,6 +353,11 @@ upload_to_atlas(void)
       return fastuidraw::routine_success;
     }
 
+  if(m_pending_job)
+    {
+      return fastuidraw::routine_fail;
+    }
+
   assert(m_glyph_data);
   return_value = m_glyph_data->upload_to_atlas(m_cache->m_atlas,
                                                m_atlas_location[0],
@@ -203,23 +374,303 @@ upload_to_atlas(void)
 
 
 
+/////////////////////////////////////////////////
+// GenerateGlyphJobs methods
+void
+GenerateGlyphJobs::
+execute(unsigned int number_threads)
+{
+  std::vector<boost::thread*> threads;
+
+  if(number_threads == 0)
+    {
+      number_threads = boost::thread::hardware_concurrency();
+    }
+  number_threads = fastuidraw::t_min(number_threads, static_cast<unsigned int>(m_jobs.size()));
+
+  /* the calling thread is one of the threads
+     generating glyph data.
+   */
+  for(unsigned int i = 1; i < number_threads; ++i)
+    {
+      threads.push_back(FASTUIDRAWnew boost::thread(&GenerateGlyphJobs::worker, this));
+    }
+
+  worker(this);
+
+  for(unsigned int i = 0, endi = threads.size(); i < endi; ++i)
+    {
+      threads[i]->join();
+      FASTUIDRAWdelete(threads[i]);
+    }
+}
+
+void
+GenerateGlyphJobs::
+worker(GenerateGlyphJobs *jobs)
+{
+  for(;;)
+    {
+      unsigned int J;
+      GlyphDataPrivate *q;
+
+      jobs->m_mutex.lock();
+      J = jobs->m_next++;
+      jobs->m_mutex.unlock();
+
+      if(J >= jobs->m_jobs.size())
+        {
+          return;
+        }
+
+      /* each job writes only to its own GlyphDataPrivate,
+         and FontBase::compute_rendering_data() is thread
+         safe.
+       */
+      q = jobs->m_jobs[J];
+      assert(!q->m_glyph_data);
+      q->m_glyph_data = jobs->m_fonts[J]->compute_rendering_data(q->m_render,
+                                                                  jobs->m_glyph_codes[J],
+                                                                  q->m_layout,
+                                                                  q->m_path);
+    }
+}
+
+/////////////////////////////////////////////////
+// GlyphGenerator methods
+GlyphGenerator::
+GlyphGenerator(unsigned int number_threads):
+  m_number_pending(0),
+  m_quit(false)
+{
+  m_threads.resize(number_threads);
+  for(unsigned int i = 0; i < number_threads; ++i)
+    {
+      m_threads[i] = FASTUIDRAWnew boost::thread(&GlyphGenerator::worker, this);
+    }
+}
+
+GlyphGenerator::
+~GlyphGenerator()
+{
+  /* jobs not yet started are dropped */
+  m_mutex.lock();
+  m_quit = true;
+  m_mutex.unlock();
+  m_work_available.notify_all();
+
+  for(unsigned int i = 0, endi = m_threads.size(); i < endi; ++i)
+    {
+      m_threads[i]->join();
+      FASTUIDRAWdelete(m_threads[i]);
+    }
+
+  for(unsigned int i = 0, endi = m_jobs.size(); i < endi; ++i)
+    {
+      FASTUIDRAWdelete(m_jobs[i]);
+    }
+
+  for(unsigned int i = 0, endi = m_finished.size(); i < endi; ++i)
+    {
+      FASTUIDRAWdelete(m_finished[i]);
+    }
+}
+
+void
+GlyphGenerator::
+add_job(GlyphGenerationJob *job)
+{
+  m_mutex.lock();
+  m_jobs.push_back(job);
+  ++m_number_pending;
+  m_mutex.unlock();
+  m_work_available.notify_one();
+}
+
+void
+GlyphGenerator::
+take_finished(std::vector<GlyphGenerationJob*> &out_jobs)
+{
+  fastuidraw::autolock_mutex m(m_mutex);
+  out_jobs.swap(m_finished);
+}
+
+void
+GlyphGenerator::
+wait(void)
+{
+  boost::unique_lock<boost::mutex> lock(m_mutex);
+  while(m_number_pending > 0)
+    {
+      m_work_done.wait(lock);
+    }
+}
+
+void
+GlyphGenerator::
+worker(GlyphGenerator *d)
+{
+  for(;;)
+    {
+      GlyphGenerationJob *J;
+
+      {
+        boost::unique_lock<boost::mutex> lock(d->m_mutex);
+        while(d->m_jobs.empty() && !d->m_quit)
+          {
+            d->m_work_available.wait(lock);
+          }
+
+        if(d->m_quit)
+          {
+            return;
+          }
+
+        J = d->m_jobs.front();
+        d->m_jobs.pop_front();
+      }
+
+      J->execute();
+
+      bool all_done;
+      {
+        boost::unique_lock<boost::mutex> lock(d->m_mutex);
+        assert(d->m_number_pending > 0);
+        d->m_finished.push_back(J);
+        --d->m_number_pending;
+        all_done = (d->m_number_pending == 0);
+      }
+
+      if(all_done)
+        {
+          d->m_work_done.notify_all();
+        }
+    }
+}
+
 /////////////////////////////////////////////////
 // GlyphCachePrivate methods
 GlyphCachePrivate::
 GlyphCachePrivate(fastuidraw::reference_counted_ptr<fastuidraw::GlyphAtlas> patlas,
-                  fastuidraw::GlyphCache *p):
+                  fastuidraw::GlyphCache *p, unsigned int number_generation_threads,
+                  const char *persistent_cache_file):
   m_atlas(patlas),
-  m_p(p)
-{}
+  m_p(p),
+  m_generator(NULL),
+  m_number_pending(0),
+  m_file(NULL)
+{
+  if(number_generation_threads > 0)
+    {
+      m_generator = FASTUIDRAWnew GlyphGenerator(number_generation_threads);
+    }
+
+  if(persistent_cache_file)
+    {
+      m_file = FASTUIDRAWnew fastuidraw::detail::GlyphCacheFile(persistent_cache_file);
+      if(!m_file->valid())
+        {
+          FASTUIDRAWdelete(m_file);
+          m_file = NULL;
+        }
+    }
+}
 
 GlyphCachePrivate::
 ~GlyphCachePrivate()
 {
+  /* stop generation first; the jobs are deleted
+     with the generator, so the glyphs must forget
+     them before they are cleared.
+   */
+  if(m_generator)
+    {
+      for(unsigned int i = 0, endi = m_glyphs.size(); i < endi; ++i)
+        {
+          m_glyphs[i]->m_pending_job = NULL;
+        }
+      FASTUIDRAWdelete(m_generator);
+    }
+
   for(unsigned int i = 0, endi = m_glyphs.size(); i < endi; ++i)
     {
       m_glyphs[i]->clear();
       FASTUIDRAWdelete(m_glyphs[i]);
     }
+
+  if(m_file)
+    {
+      FASTUIDRAWdelete(m_file);
+    }
+}
+
+bool
+GlyphCachePrivate::
+load_glyph(GlyphDataPrivate *q,
+           const fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> &font,
+           uint32_t glyph_code)
+{
+  if(!m_file)
+    {
+      return false;
+    }
+
+  assert(!q->m_glyph_data);
+  q->m_glyph_data = m_file->fetch(font, q->m_render, glyph_code, q->m_layout, q->m_path_data);
+  return q->m_glyph_data != NULL;
+}
+
+void
+GlyphCachePrivate::
+store_glyph(const GlyphDataPrivate *q, const fastuidraw::FontBase *font,
+            uint32_t glyph_code)
+{
+  if(m_file)
+    {
+      m_file->store(font, q->m_render, glyph_code, q->m_layout, q->m_path, q->m_glyph_data);
+    }
+}
+
+unsigned int
+GlyphCachePrivate::
+upload_pending_glyphs(void)
+{
+  unsigned int return_value(0);
+
+  if(!m_generator)
+    {
+      return return_value;
+    }
+
+  m_generator->take_finished(m_finished_jobs);
+  for(unsigned int i = 0, endi = m_finished_jobs.size(); i < endi; ++i)
+    {
+      GlyphGenerationJob *J(m_finished_jobs[i]);
+      GlyphDataPrivate *G(J->m_glyph);
+
+      if(G)
+        {
+          assert(G->m_pending_job == J);
+          assert(!G->m_glyph_data);
+
+          G->m_glyph_data = J->m_glyph_data;
+          J->m_glyph_data = NULL;
+          G->m_path.swap(J->m_path);
+          G->m_pending_job = NULL;
+          --m_number_pending;
+          ++return_value;
+          store_glyph(G, J->m_font.get(), J->m_glyph_code);
+
+          /* a failure to upload is handled as for any
+             glyph not uploaded, see Glyph::upload_to_atlas().
+           */
+          G->upload_to_atlas();
+        }
+      FASTUIDRAWdelete(J);
+    }
+  m_finished_jobs.clear();
+
+  return return_value;
 }
 
 
@@ -336,6 +787,16 @@ upload_to_atlas(void) const
   return p->upload_to_atlas();
 }
 
+bool
+fastuidraw::Glyph::
+pending(void) const
+{
+  GlyphDataPrivate *p;
+  p = reinterpret_cast<GlyphDataPrivate*>(m_opaque);
+  assert(p != NULL && p->m_render.valid());
+  return p->m_pending_job != NULL;
+}
+
 const fastuidraw::Path&
 fastuidraw::Glyph::
 path(void) const
@@ -343,6 +804,15 @@ path(void) const
   GlyphDataPrivate *p;
   p = reinterpret_cast<GlyphDataPrivate*>(m_opaque);
   assert(p != NULL && p->m_render.valid());
+  if(p->m_cache->m_file)
+    {
+      autolock_mutex m(p->m_cache->m_path_mutex);
+      if(p->m_path_data)
+        {
+          detail::GlyphCacheFile::load_path(p->m_path_data, p->m_path);
+          p->m_path_data.clear();
+        }
+    }
   return p->m_path;
 }
 
@@ -350,9 +820,12 @@ path(void) const
 //////////////////////////////////////////////////////////
 // fastuidraw::GlyphCache methods
 fastuidraw::GlyphCache::
-GlyphCache(reference_counted_ptr<GlyphAtlas> patlas)
+GlyphCache(reference_counted_ptr<GlyphAtlas> patlas,
+           unsigned int number_generation_threads,
+           const char *persistent_cache_file)
 {
-  m_d = FASTUIDRAWnew GlyphCachePrivate(patlas, this);
+  m_d = FASTUIDRAWnew GlyphCachePrivate(patlas, this, number_generation_threads,
+                                        persistent_cache_file);
 }
 
 fastuidraw::GlyphCache::
@@ -388,12 +861,167 @@ fetch_glyph(GlyphRender render,
     {
       q->m_render = render;
       assert(!q->m_glyph_data);
-      q->m_glyph_data = font->compute_rendering_data(q->m_render, glyph_code, q->m_layout, q->m_path);
+      /* a glyph read from the persistent cache
+         file is never pending.
+       */
+      if(!d->load_glyph(q, font, glyph_code))
+        {
+          if(d->m_generator)
+            {
+              font->compute_layout_data(q->m_render, glyph_code, q->m_layout);
+              q->m_pending_job = FASTUIDRAWnew GlyphGenerationJob(q, font, glyph_code, render);
+              ++d->m_number_pending;
+              d->m_generator->add_job(q->m_pending_job);
+            }
+          else
+            {
+              q->m_glyph_data = font->compute_rendering_data(q->m_render, glyph_code, q->m_layout, q->m_path);
+              d->store_glyph(q, font.get(), glyph_code);
+            }
+        }
     }
 
   return Glyph(q);
 }
 
+void
+fastuidraw::GlyphCache::
+fetch_glyphs(GlyphRender render,
+             const reference_counted_ptr<const FontBase> &font,
+             const_c_array<uint32_t> glyph_codes,
+             c_array<Glyph> out_glyphs,
+             unsigned int number_threads)
+{
+  std::vector<reference_counted_ptr<const FontBase> > fonts(glyph_codes.size(), font);
+  fetch_glyphs(render, make_c_array(fonts), glyph_codes, out_glyphs, number_threads);
+}
+
+void
+fastuidraw::GlyphCache::
+fetch_glyphs(GlyphRender render,
+             const_c_array<reference_counted_ptr<const FontBase> > fonts,
+             const_c_array<uint32_t> glyph_codes,
+             c_array<Glyph> out_glyphs,
+             unsigned int number_threads)
+{
+  GlyphCachePrivate *d;
+  GenerateGlyphJobs jobs;
+  std::vector<GlyphDataPrivate*> loaded;
+
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+  assert(fonts.size() == glyph_codes.size());
+  assert(out_glyphs.size() == glyph_codes.size());
+
+  /* allocate the glyphs serially, a glyph repeated in
+     glyph_codes is generated only once since its
+     m_render is made valid on the first occurence.
+   */
+  for(unsigned int i = 0, endi = glyph_codes.size(); i < endi; ++i)
+    {
+      const reference_counted_ptr<const FontBase> &font(fonts[i]);
+      GlyphDataPrivate *q;
+
+      if(!font || !font->can_create_rendering_data(render.m_type))
+        {
+          out_glyphs[i] = Glyph();
+          continue;
+        }
+
+      q = d->fetch_or_allocate_glyph(GlyphSource(font, glyph_codes[i], render));
+      if(!q->m_render.valid())
+        {
+          q->m_render = render;
+          if(d->load_glyph(q, font, glyph_codes[i]))
+            {
+              loaded.push_back(q);
+            }
+          else
+            {
+              jobs.m_jobs.push_back(q);
+              jobs.m_fonts.push_back(font.get());
+              jobs.m_glyph_codes.push_back(glyph_codes[i]);
+            }
+        }
+      out_glyphs[i] = Glyph(q);
+    }
+
+  /* glyphs read from the persistent cache file
+     are uploaded as the glyphs generated below.
+   */
+  for(unsigned int i = 0, endi = loaded.size(); i < endi; ++i)
+    {
+      loaded[i]->upload_to_atlas();
+    }
+
+  if(jobs.m_jobs.empty())
+    {
+      return;
+    }
+
+  /* generate the glyph data concurrently */
+  jobs.execute(number_threads);
+
+  /* upload the new glyphs to the atlas in one pass from this
+     thread; a glyph that fails to upload, i.e. the atlas is
+     full, is uploaded later by Glyph::upload_to_atlas() as
+     for a glyph from fetch_glyph().
+   */
+  for(unsigned int i = 0, endi = jobs.m_jobs.size(); i < endi; ++i)
+    {
+      jobs.m_jobs[i]->upload_to_atlas();
+      d->store_glyph(jobs.m_jobs[i], jobs.m_fonts[i], jobs.m_glyph_codes[i]);
+    }
+}
+
+
+bool
+fastuidraw::GlyphCache::
+asynchronous(void) const
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+  return d->m_generator != NULL;
+}
+
+bool
+fastuidraw::GlyphCache::
+persistent(void) const
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+  return d->m_file != NULL;
+}
+
+unsigned int
+fastuidraw::GlyphCache::
+number_pending_glyphs(void) const
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+  return d->m_number_pending;
+}
+
+unsigned int
+fastuidraw::GlyphCache::
+upload_pending_glyphs(void)
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+  return d->upload_pending_glyphs();
+}
+
+unsigned int
+fastuidraw::GlyphCache::
+wait_pending_glyphs(void)
+{
+  GlyphCachePrivate *d;
+  d = reinterpret_cast<GlyphCachePrivate*>(m_d);
+  if(d->m_generator)
+    {
+      d->m_generator->wait();
+    }
+  return d->upload_pending_glyphs();
+}
 
 void
 fastuidraw::GlyphCache::
@@ -440,9 +1068,12 @@ clear_cache(void)
   GlyphCachePrivate *d;
   d = reinterpret_cast<GlyphCachePrivate*>(m_d);
 
-  d->m_atlas->clear();
   d->m_glyph_map.clear();
 
+  /* clear the glyphs before the atlas so that
+     they deallocate from the atlas what they
+     allocated.
+   */
   for(unsigned int i = 0, endi = d->m_glyphs.size(); i < endi; ++i)
     {
       GlyphDataPrivate *p;
@@ -453,4 +1084,5 @@ clear_cache(void)
           d->m_free_slots.push_back(p->m_cache_location);
         }
     }
+  d->m_atlas->clear();
 }
@@ -0,0 +1,150 @@
+/*!
+ * \file glyph_render_data_msdf.cpp
+ * \brief file glyph_render_data_msdf.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <vector>
+#include <algorithm>
+#include <fastuidraw/text/glyph_render_data_msdf.hpp>
+#include "../private/util_private.hpp"
+
+namespace
+{
+  class GlyphDataPrivate
+  {
+  public:
+    GlyphDataPrivate(void):
+      m_resolution(0, 0)
+    {}
+
+    void
+    resize(fastuidraw::ivec2 sz)
+    {
+      assert(sz.x() >= 0);
+      assert(sz.y() >= 0);
+      for(unsigned int c = 0; c < fastuidraw::GlyphRenderDataMSDF::number_channels; ++c)
+        {
+          m_texels[c].resize(sz.x() * sz.y());
+        }
+      m_resolution = sz;
+    }
+
+    fastuidraw::ivec2 m_resolution;
+    fastuidraw::vecN<std::vector<uint8_t>, fastuidraw::GlyphRenderDataMSDF::number_channels> m_texels;
+  };
+}
+
+/////////////////////////////////////////////
+// fastuidraw::GlyphRenderDataMSDF methods
+fastuidraw::GlyphRenderDataMSDF::
+GlyphRenderDataMSDF(void)
+{
+  m_d = FASTUIDRAWnew GlyphDataPrivate();
+}
+
+fastuidraw::GlyphRenderDataMSDF::
+~GlyphRenderDataMSDF(void)
+{
+  GlyphDataPrivate *d;
+  d = reinterpret_cast<GlyphDataPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+fastuidraw::ivec2
+fastuidraw::GlyphRenderDataMSDF::
+resolution(void) const
+{
+  GlyphDataPrivate *d;
+  d = reinterpret_cast<GlyphDataPrivate*>(m_d);
+  return d->m_resolution;
+}
+
+fastuidraw::const_c_array<uint8_t>
+fastuidraw::GlyphRenderDataMSDF::
+distance_values(enum channel_t c) const
+{
+  GlyphDataPrivate *d;
+  d = reinterpret_cast<GlyphDataPrivate*>(m_d);
+  assert(c < number_channels);
+  return make_c_array(d->m_texels[c]);
+}
+
+fastuidraw::c_array<uint8_t>
+fastuidraw::GlyphRenderDataMSDF::
+distance_values(enum channel_t c)
+{
+  GlyphDataPrivate *d;
+  d = reinterpret_cast<GlyphDataPrivate*>(m_d);
+  assert(c < number_channels);
+  return make_c_array(d->m_texels[c]);
+}
+
+void
+fastuidraw::GlyphRenderDataMSDF::
+resize(fastuidraw::ivec2 sz)
+{
+  GlyphDataPrivate *d;
+  d = reinterpret_cast<GlyphDataPrivate*>(m_d);
+  d->resize(sz);
+}
+
+enum fastuidraw::return_code
+fastuidraw::GlyphRenderDataMSDF::
+upload_to_atlas(const reference_counted_ptr<GlyphAtlas> &atlas,
+                GlyphLocation &atlas_location,
+                GlyphLocation &secondary_atlas_location,
+                int &geometry_offset,
+                int &geometry_length) const
+{
+  GlyphDataPrivate *d;
+  d = reinterpret_cast<GlyphDataPrivate*>(m_d);
+
+  GlyphAtlas::Padding padding;
+  padding.m_right = 1;
+  padding.m_bottom = 1;
+
+  secondary_atlas_location = GlyphLocation();
+  geometry_offset = -1;
+  geometry_length = 0;
+
+  atlas_location = atlas->allocate(d->m_resolution, make_c_array(d->m_texels[red_channel]), padding);
+  if(atlas_location.valid())
+    {
+      /* the green channel with its padding row followed by
+         the blue channel with its padding row; the padding
+         row of the green channel keeps bilinear filtering
+         of the green channel from reading the blue channel.
+       */
+      std::vector<uint8_t> secondary;
+      ivec2 secondary_resolution(d->m_resolution.x(), 2 * d->m_resolution.y());
+
+      secondary.reserve(secondary_resolution.x() * secondary_resolution.y());
+      secondary.insert(secondary.end(), d->m_texels[green_channel].begin(), d->m_texels[green_channel].end());
+      secondary.insert(secondary.end(), d->m_texels[blue_channel].begin(), d->m_texels[blue_channel].end());
+
+      secondary_atlas_location = atlas->allocate(secondary_resolution, make_c_array(secondary), padding);
+      if(!secondary_atlas_location.valid())
+        {
+          atlas->deallocate(atlas_location);
+          atlas_location = GlyphLocation();
+        }
+    }
+
+  return atlas_location.valid() ?
+    routine_success :
+    routine_fail;
+}
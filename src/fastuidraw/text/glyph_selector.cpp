@@ -19,6 +19,7 @@
 
 #include <set>
 #include <map>
+#include <vector>
 
 #include <boost/thread.hpp>
 #include <boost/tuple/tuple.hpp>
@@ -165,6 +166,15 @@ namespace
                                    fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> h,
                                    uint32_t character_code);
 
+    /* fetch the glyphs of m_batch_sources from m_cache with
+       GlyphCache::fetch_glyphs(), an entry with a NULL font
+       gives an invalid Glyph.
+     */
+    void
+    fetch_batch_no_lock(fastuidraw::GlyphRender tp,
+                        fastuidraw::c_array<fastuidraw::Glyph> out_glyphs,
+                        unsigned int number_threads);
+
     boost::mutex m_mutex;
     fastuidraw::reference_counted_ptr<font_group> m_master_group;
     font_group_map<bold_italic_key> m_bold_italic_groups;
@@ -173,6 +183,10 @@ namespace
     font_group_map<foundry_style_family_bold_italic_key> m_foundry_style_family_bold_italic_groups;
 
     fastuidraw::reference_counted_ptr<fastuidraw::GlyphCache> m_cache;
+
+    /* work room for the fetch_glyphs() methods */
+    std::vector<fastuidraw::reference_counted_ptr<const fastuidraw::FontBase> > m_batch_fonts;
+    std::vector<uint32_t> m_batch_glyph_codes;
   };
 }
 
@@ -374,6 +388,24 @@ fetch_glyph_no_lock(fastuidraw::GlyphRender tp,
     }
 }
 
+void
+GlyphSelectorPrivate::
+fetch_batch_no_lock(fastuidraw::GlyphRender tp,
+                    fastuidraw::c_array<fastuidraw::Glyph> out_glyphs,
+                    unsigned int number_threads)
+{
+  assert(m_batch_fonts.size() == out_glyphs.size());
+  assert(m_batch_glyph_codes.size() == out_glyphs.size());
+  m_cache->fetch_glyphs(tp,
+                        fastuidraw::make_c_array(m_batch_fonts),
+                        fastuidraw::make_c_array(m_batch_glyph_codes),
+                        out_glyphs, number_threads);
+
+  /* do not keep the fonts alive from the work room */
+  m_batch_fonts.clear();
+  m_batch_glyph_codes.clear();
+}
+
 ////////////////////////////////////////////////
 // fastuidraw::GlyphSelector methods
 fastuidraw::GlyphSelector::
@@ -553,3 +585,83 @@ fetch_glyph_no_merging(GlyphRender tp, reference_counted_ptr<const FontBase> h,
   unlock_mutex();
   return G;
 }
+
+void
+fastuidraw::GlyphSelector::
+fetch_glyphs(GlyphRender tp, FontGroup group,
+             const_c_array<uint32_t> character_codes,
+             c_array<Glyph> out_glyphs,
+             unsigned int number_threads)
+{
+  GlyphSelectorPrivate *d;
+  d = reinterpret_cast<GlyphSelectorPrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  reference_counted_ptr<font_group> p;
+
+  p = reference_counted_ptr<font_group>(reinterpret_cast<font_group*>(group.m_d));
+  if(!p)
+    {
+      p = d->m_master_group;
+    }
+
+  for(unsigned int i = 0, endi = character_codes.size(); i < endi; ++i)
+    {
+      glyph_source src;
+
+      src = p->fetch_glyph(character_codes[i], tp.m_type);
+      d->m_batch_fonts.push_back(src.first);
+      d->m_batch_glyph_codes.push_back(src.second);
+    }
+  d->fetch_batch_no_lock(tp, out_glyphs, number_threads);
+}
+
+void
+fastuidraw::GlyphSelector::
+fetch_glyphs(GlyphRender tp, reference_counted_ptr<const FontBase> h,
+             const_c_array<uint32_t> character_codes,
+             c_array<Glyph> out_glyphs,
+             unsigned int number_threads)
+{
+  GlyphSelectorPrivate *d;
+  d = reinterpret_cast<GlyphSelectorPrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  for(unsigned int i = 0, endi = character_codes.size(); i < endi; ++i)
+    {
+      glyph_source src;
+
+      if(h && h->can_create_rendering_data(tp.m_type))
+        {
+          src = d->fetch_glyph_helper(h, character_codes[i], tp.m_type);
+        }
+      d->m_batch_fonts.push_back(src.first);
+      d->m_batch_glyph_codes.push_back(src.second);
+    }
+  d->fetch_batch_no_lock(tp, out_glyphs, number_threads);
+}
+
+void
+fastuidraw::GlyphSelector::
+fetch_glyphs_no_merging(GlyphRender tp, reference_counted_ptr<const FontBase> h,
+                        const_c_array<uint32_t> character_codes,
+                        c_array<Glyph> out_glyphs,
+                        unsigned int number_threads)
+{
+  GlyphSelectorPrivate *d;
+  d = reinterpret_cast<GlyphSelectorPrivate*>(m_d);
+
+  autolock_mutex m(d->m_mutex);
+  for(unsigned int i = 0, endi = character_codes.size(); i < endi; ++i)
+    {
+      uint32_t glyph_code(0);
+
+      if(h && tp.valid() && h->can_create_rendering_data(tp.m_type))
+        {
+          glyph_code = h->glyph_code(character_codes[i]);
+        }
+      d->m_batch_fonts.push_back(glyph_code ? h : reference_counted_ptr<const FontBase>());
+      d->m_batch_glyph_codes.push_back(glyph_code);
+    }
+  d->fetch_batch_no_lock(tp, out_glyphs, number_threads);
+}
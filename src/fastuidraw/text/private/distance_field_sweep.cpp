@@ -0,0 +1,517 @@
+/*!
+ * \file distance_field_sweep.cpp
+ * \brief file distance_field_sweep.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "distance_field_sweep.hpp"
+
+namespace
+{
+  /* tolerance, in texels, when flattening curves to line segments */
+  const float flatten_tolerance = 0.01f;
+
+  /* maximum radius, in texels, of the band about the outline
+     in which distances are computed exactly.
+   */
+  const float max_band_radius = 2.0f;
+
+  /* maximum number of line segments a single curve is flattened to */
+  const int max_curve_segments = 64;
+
+  int
+  number_segments_from_deviation(float deviation)
+  {
+    int n;
+
+    n = static_cast<int>(std::ceil(std::sqrt(deviation / flatten_tolerance)));
+    return std::max(1, std::min(max_curve_segments, n));
+  }
+
+  class crossing
+  {
+  public:
+    bool
+    operator<(const crossing &rhs) const
+    {
+      return m_x < rhs.m_x;
+    }
+
+    float m_x;
+    int m_winding;
+  };
+
+  /* range [begin, end) of the rows whose centers c
+     satisfy min(y0, y1) <= c < max(y0, y1)
+   */
+  fastuidraw::range_type<int>
+  crossing_rows(float y0, float y1, int height)
+  {
+    fastuidraw::range_type<int> R;
+
+    R.m_begin = std::max(0, static_cast<int>(std::ceil(std::min(y0, y1) - 0.5f)));
+    R.m_end = std::min(height, static_cast<int>(std::ceil(std::max(y0, y1) - 0.5f)));
+    return R;
+  }
+}
+
+////////////////////////////////////////
+// fastuidraw::detail::DistanceFieldSweep methods
+fastuidraw::detail::DistanceFieldSweep::
+DistanceFieldSweep(const FT_Outline &outline,
+                   const ivec2 &bitmap_size,
+                   const ivec2 &bitmap_offset):
+  m_bitmap_size(bitmap_size),
+  m_bitmap_offset(bitmap_offset),
+  m_even_odd_fill((outline.flags & FT_OUTLINE_EVEN_ODD_FILL) != 0),
+  m_current_pt(0.0f, 0.0f)
+{
+  FT_Outline_Funcs funcs;
+
+  funcs.move_to = &ft_outline_move_to;
+  funcs.line_to = &ft_outline_line_to;
+  funcs.conic_to = &ft_outline_conic_to;
+  funcs.cubic_to = &ft_outline_cubic_to;
+  funcs.shift = 0;
+  funcs.delta = 0;
+  FT_Outline_Decompose(const_cast<FT_Outline*>(&outline), &funcs, this);
+}
+
+fastuidraw::vec2
+fastuidraw::detail::DistanceFieldSweep::
+texel_coordinate(const FT_Vector &pt) const
+{
+  /* FT_Outline is in 26.6 fixed point; texel (x, y) covers
+     [x, x + 1] x [y, y + 1] of the returned coordinate.
+   */
+  vec2 r;
+  r.x() = static_cast<float>(pt.x) / 64.0f - static_cast<float>(m_bitmap_offset.x());
+  r.y() = static_cast<float>(pt.y) / 64.0f - static_cast<float>(m_bitmap_offset.y());
+  return r;
+}
+
+void
+fastuidraw::detail::DistanceFieldSweep::
+add_segment(const vec2 &p)
+{
+  m_x0.push_back(m_current_pt.x());
+  m_y0.push_back(m_current_pt.y());
+  m_x1.push_back(p.x());
+  m_y1.push_back(p.y());
+  m_current_pt = p;
+}
+
+int
+fastuidraw::detail::DistanceFieldSweep::
+ft_outline_move_to(const FT_Vector *pt, void *user)
+{
+  DistanceFieldSweep *p;
+  p = reinterpret_cast<DistanceFieldSweep*>(user);
+  p->m_current_pt = p->texel_coordinate(*pt);
+  return 0;
+}
+
+int
+fastuidraw::detail::DistanceFieldSweep::
+ft_outline_line_to(const FT_Vector *pt, void *user)
+{
+  DistanceFieldSweep *p;
+  p = reinterpret_cast<DistanceFieldSweep*>(user);
+  p->add_segment(p->texel_coordinate(*pt));
+  return 0;
+}
+
+int
+fastuidraw::detail::DistanceFieldSweep::
+ft_outline_conic_to(const FT_Vector *control_pt,
+                    const FT_Vector *pt, void *user)
+{
+  DistanceFieldSweep *p;
+  vec2 p0, c, p1, d;
+  int n;
+
+  p = reinterpret_cast<DistanceFieldSweep*>(user);
+  p0 = p->m_current_pt;
+  c = p->texel_coordinate(*control_pt);
+  p1 = p->texel_coordinate(*pt);
+
+  /* the distance between a quadratic and the chords of n
+     uniform steps is at most |p0 - 2c + p1| / (4 n^2)
+   */
+  d = p0 - 2.0f * c + p1;
+  n = number_segments_from_deviation(0.25f * std::sqrt(dot(d, d)));
+  for(int i = 1; i < n; ++i)
+    {
+      float t, s;
+
+      t = static_cast<float>(i) / static_cast<float>(n);
+      s = 1.0f - t;
+      p->add_segment(s * s * p0 + 2.0f * s * t * c + t * t * p1);
+    }
+  p->add_segment(p1);
+  return 0;
+}
+
+int
+fastuidraw::detail::DistanceFieldSweep::
+ft_outline_cubic_to(const FT_Vector *control_pt1,
+                    const FT_Vector *control_pt2,
+                    const FT_Vector *pt, void *user)
+{
+  DistanceFieldSweep *p;
+  vec2 p0, c0, c1, p1, d0, d1;
+  float m;
+  int n;
+
+  p = reinterpret_cast<DistanceFieldSweep*>(user);
+  p0 = p->m_current_pt;
+  c0 = p->texel_coordinate(*control_pt1);
+  c1 = p->texel_coordinate(*control_pt2);
+  p1 = p->texel_coordinate(*pt);
+
+  /* the second derivative of a cubic is bounded by 6 M where
+     M is the largest second difference of the control points,
+     giving a distance to the chords of at most 6 M / (8 n^2)
+   */
+  d0 = p0 - 2.0f * c0 + c1;
+  d1 = c0 - 2.0f * c1 + p1;
+  m = std::sqrt(std::max(dot(d0, d0), dot(d1, d1)));
+  n = number_segments_from_deviation(0.75f * m);
+  for(int i = 1; i < n; ++i)
+    {
+      float t, s;
+
+      t = static_cast<float>(i) / static_cast<float>(n);
+      s = 1.0f - t;
+      p->add_segment(s * s * s * p0 + 3.0f * s * s * t * c0
+                     + 3.0f * s * t * t * c1 + t * t * t * p1);
+    }
+  p->add_segment(p1);
+  return 0;
+}
+
+void
+fastuidraw::detail::DistanceFieldSweep::
+compute_distance_values(float max_distance)
+{
+  unsigned int num_texels;
+  float max_distance_texels;
+
+  num_texels = std::max(0, m_bitmap_size.x() * m_bitmap_size.y());
+  m_distance_sq.assign(num_texels, std::numeric_limits<float>::max());
+  m_closest_x.assign(num_texels, 0.0f);
+  m_closest_y.assign(num_texels, 0.0f);
+  m_distance.resize(num_texels);
+  m_inside.assign(num_texels, 0);
+
+  if(num_texels == 0)
+    {
+      return;
+    }
+
+  /* distances are computed in texels and returned
+     in units of 1/64'th of a pixel.
+   */
+  max_distance_texels = max_distance / 64.0f;
+  compute_band_values(std::min(max_distance_texels, max_band_radius));
+  if(max_distance_texels > max_band_radius)
+    {
+      propagate_band_values();
+    }
+  compute_inside_values();
+
+  for(unsigned int i = 0; i < num_texels; ++i)
+    {
+      float d;
+
+      d = (m_distance_sq[i] < std::numeric_limits<float>::max()) ?
+        64.0f * std::sqrt(m_distance_sq[i]) :
+        max_distance;
+      m_distance[i] = std::min(d, max_distance);
+    }
+}
+
+void
+fastuidraw::detail::DistanceFieldSweep::
+compute_band_values(float band)
+{
+  int width(m_bitmap_size.x()), height(m_bitmap_size.y());
+
+  for(unsigned int s = 0, ends = m_x0.size(); s < ends; ++s)
+    {
+      float ax(m_x0[s]), ay(m_y0[s]);
+      float dx(m_x1[s] - ax), dy(m_y1[s] - ay);
+      float len_sq(dx * dx + dy * dy);
+      float inv_len_sq((len_sq > 0.0f) ? 1.0f / len_sq : 0.0f);
+      int min_x, max_x, min_y, max_y;
+
+      /* texels whose centers are within band of the
+         bounding box of the segment
+       */
+      min_x = std::max(0, static_cast<int>(std::ceil(std::min(ax, m_x1[s]) - band - 0.5f)));
+      max_x = std::min(width - 1, static_cast<int>(std::floor(std::max(ax, m_x1[s]) + band - 0.5f)));
+      min_y = std::max(0, static_cast<int>(std::ceil(std::min(ay, m_y1[s]) - band - 0.5f)));
+      max_y = std::min(height - 1, static_cast<int>(std::floor(std::max(ay, m_y1[s]) + band - 0.5f)));
+
+      for(int y = min_y; y <= max_y; ++y)
+        {
+          float py(static_cast<float>(y) + 0.5f - ay);
+          float *row_distance_sq(&m_distance_sq[y * width]);
+          float *row_closest_x(&m_closest_x[y * width]);
+          float *row_closest_y(&m_closest_y[y * width]);
+          int x(min_x);
+
+#ifdef __SSE2__
+          {
+            const __m128 zero(_mm_setzero_ps()), one(_mm_set1_ps(1.0f));
+            const __m128 vdx(_mm_set1_ps(dx)), vdy(_mm_set1_ps(dy));
+            const __m128 vax(_mm_set1_ps(ax)), vay(_mm_set1_ps(ay));
+            const __m128 vpy(_mm_set1_ps(py));
+            const __m128 vinv_len_sq(_mm_set1_ps(inv_len_sq));
+            const __m128 step(_mm_set1_ps(4.0f));
+            __m128 vpx;
+
+            vpx = _mm_add_ps(_mm_set1_ps(static_cast<float>(x) + 0.5f - ax),
+                             _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f));
+            for(; x + 3 <= max_x; x += 4, vpx = _mm_add_ps(vpx, step))
+              {
+                __m128 t, qx, qy, ex, ey, dist_sq, old_dist_sq, closer;
+
+                t = _mm_add_ps(_mm_mul_ps(vpx, vdx), _mm_mul_ps(vpy, vdy));
+                t = _mm_mul_ps(t, vinv_len_sq);
+                t = _mm_min_ps(one, _mm_max_ps(zero, t));
+                qx = _mm_mul_ps(t, vdx);
+                qy = _mm_mul_ps(t, vdy);
+                ex = _mm_sub_ps(vpx, qx);
+                ey = _mm_sub_ps(vpy, qy);
+                dist_sq = _mm_add_ps(_mm_mul_ps(ex, ex), _mm_mul_ps(ey, ey));
+
+                old_dist_sq = _mm_loadu_ps(row_distance_sq + x);
+                closer = _mm_cmplt_ps(dist_sq, old_dist_sq);
+                if(_mm_movemask_ps(closer) == 0)
+                  {
+                    continue;
+                  }
+
+                qx = _mm_add_ps(qx, vax);
+                qy = _mm_add_ps(qy, vay);
+                _mm_storeu_ps(row_distance_sq + x, _mm_or_ps(_mm_and_ps(closer, dist_sq),
+                                                             _mm_andnot_ps(closer, old_dist_sq)));
+                _mm_storeu_ps(row_closest_x + x, _mm_or_ps(_mm_and_ps(closer, qx),
+                                                           _mm_andnot_ps(closer, _mm_loadu_ps(row_closest_x + x))));
+                _mm_storeu_ps(row_closest_y + x, _mm_or_ps(_mm_and_ps(closer, qy),
+                                                           _mm_andnot_ps(closer, _mm_loadu_ps(row_closest_y + x))));
+              }
+          }
+#endif
+
+          for(; x <= max_x; ++x)
+            {
+              float px, t, qx, qy, dist_sq;
+
+              px = static_cast<float>(x) + 0.5f - ax;
+              t = (px * dx + py * dy) * inv_len_sq;
+              t = std::min(1.0f, std::max(0.0f, t));
+              qx = t * dx;
+              qy = t * dy;
+              dist_sq = (px - qx) * (px - qx) + (py - qy) * (py - qy);
+              if(dist_sq < row_distance_sq[x])
+                {
+                  row_distance_sq[x] = dist_sq;
+                  row_closest_x[x] = qx + ax;
+                  row_closest_y[x] = qy + ay;
+                }
+            }
+        }
+    }
+}
+
+void
+fastuidraw::detail::DistanceFieldSweep::
+propagate_from(int x, int y, int nx, int ny)
+{
+  int width(m_bitmap_size.x());
+  int src(nx + ny * width), dst(x + y * width);
+  float ex, ey, dist_sq;
+
+  if(m_distance_sq[src] == std::numeric_limits<float>::max())
+    {
+      return;
+    }
+
+  ex = static_cast<float>(x) + 0.5f - m_closest_x[src];
+  ey = static_cast<float>(y) + 0.5f - m_closest_y[src];
+  dist_sq = ex * ex + ey * ey;
+  if(dist_sq < m_distance_sq[dst])
+    {
+      m_distance_sq[dst] = dist_sq;
+      m_closest_x[dst] = m_closest_x[src];
+      m_closest_y[dst] = m_closest_y[src];
+    }
+}
+
+void
+fastuidraw::detail::DistanceFieldSweep::
+propagate_band_values(void)
+{
+  /* 8SSEDT: two raster passes each of which take the closest
+     point from the already visited neighbors of a texel; the
+     closest point (instead of the offset to it) is propagated
+     so that the distance is measured to the outline itself.
+   */
+  int width(m_bitmap_size.x()), height(m_bitmap_size.y());
+
+  for(int y = 0; y < height; ++y)
+    {
+      for(int x = 0; x < width; ++x)
+        {
+          if(x > 0)
+            {
+              propagate_from(x, y, x - 1, y);
+            }
+          if(y > 0)
+            {
+              if(x > 0)
+                {
+                  propagate_from(x, y, x - 1, y - 1);
+                }
+              propagate_from(x, y, x, y - 1);
+              if(x + 1 < width)
+                {
+                  propagate_from(x, y, x + 1, y - 1);
+                }
+            }
+        }
+      for(int x = width - 2; x >= 0; --x)
+        {
+          propagate_from(x, y, x + 1, y);
+        }
+    }
+
+  for(int y = height - 1; y >= 0; --y)
+    {
+      for(int x = width - 1; x >= 0; --x)
+        {
+          if(x + 1 < width)
+            {
+              propagate_from(x, y, x + 1, y);
+            }
+          if(y + 1 < height)
+            {
+              if(x + 1 < width)
+                {
+                  propagate_from(x, y, x + 1, y + 1);
+                }
+              propagate_from(x, y, x, y + 1);
+              if(x > 0)
+                {
+                  propagate_from(x, y, x - 1, y + 1);
+                }
+            }
+        }
+      for(int x = 1; x < width; ++x)
+        {
+          propagate_from(x, y, x - 1, y);
+        }
+    }
+}
+
+void
+fastuidraw::detail::DistanceFieldSweep::
+compute_inside_values(void)
+{
+  /* a texel is inside if the winding number of the outline
+     about its center is non-zero (or odd for even-odd fill);
+     the winding numbers of a row are computed from the
+     crossings of the outline with the line through the
+     centers of the texels of the row. The crossings are
+     bucketed by row with a counting sort.
+   */
+  int width(m_bitmap_size.x()), height(m_bitmap_size.y());
+  std::vector<unsigned int> row_start(height + 1, 0);
+  std::vector<crossing> crossings;
+
+  for(unsigned int s = 0, ends = m_x0.size(); s < ends; ++s)
+    {
+      range_type<int> R;
+
+      R = crossing_rows(m_y0[s], m_y1[s], height);
+      for(int y = R.m_begin; y < R.m_end; ++y)
+        {
+          ++row_start[y + 1];
+        }
+    }
+
+  for(int y = 0; y < height; ++y)
+    {
+      row_start[y + 1] += row_start[y];
+    }
+
+  crossings.resize(row_start[height]);
+  for(unsigned int s = 0, ends = m_x0.size(); s < ends; ++s)
+    {
+      float x0(m_x0[s]), y0(m_y0[s]), x1(m_x1[s]), y1(m_y1[s]);
+      range_type<int> R;
+      float slope;
+      int winding;
+
+      R = crossing_rows(y0, y1, height);
+      if(R.m_begin >= R.m_end)
+        {
+          continue;
+        }
+
+      winding = (y1 > y0) ? 1 : -1;
+      slope = (x1 - x0) / (y1 - y0);
+      for(int y = R.m_begin; y < R.m_end; ++y)
+        {
+          crossing &C(crossings[row_start[y]++]);
+          C.m_x = x0 + (static_cast<float>(y) + 0.5f - y0) * slope;
+          C.m_winding = winding;
+        }
+    }
+
+  for(int y = 0, begin = 0; y < height; ++y)
+    {
+      int end(row_start[y]), c(begin);
+      uint8_t *inside(&m_inside[y * width]);
+      int winding(0);
+
+      /* the fill pass advanced row_start[y] to the end of row y */
+      std::sort(crossings.begin() + begin, crossings.begin() + end);
+      for(int x = 0; x < width; ++x)
+        {
+          float px(static_cast<float>(x) + 0.5f);
+
+          for(; c < end && crossings[c].m_x < px; ++c)
+            {
+              winding += crossings[c].m_winding;
+            }
+          inside[x] = m_even_odd_fill ?
+            ((winding & 1) != 0) :
+            (winding != 0);
+        }
+      begin = end;
+    }
+}
@@ -0,0 +1,757 @@
+/*!
+ * \file freetype_msdf_util.cpp
+ * \brief file freetype_msdf_util.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+#include "freetype_msdf_util.hpp"
+
+namespace
+{
+  /* tolerance, in texels, when flattening curves to line segments */
+  const float flatten_tolerance = 0.01f;
+
+  /* maximum number of line segments a single curve is flattened to */
+  const int max_curve_segments = 64;
+
+  /* two edges meet at a corner if the angle between their
+     directions exceeds 3 radians from straight, i.e. if
+     the sine of the angle exceeds sin(3) or the cosine
+     is not positive.
+   */
+  const float corner_cross_threshold = 0.14112f;
+
+  int
+  number_segments_from_deviation(float deviation)
+  {
+    int n;
+
+    n = static_cast<int>(std::ceil(std::sqrt(deviation / flatten_tolerance)));
+    return std::max(1, std::min(max_curve_segments, n));
+  }
+
+  float
+  cross(const fastuidraw::vec2 &a, const fastuidraw::vec2 &b)
+  {
+    return a.x() * b.y() - a.y() * b.x();
+  }
+
+  fastuidraw::vec2
+  normalized(const fastuidraw::vec2 &v)
+  {
+    float m;
+
+    m = std::sqrt(fastuidraw::dot(v, v));
+    return (m > 0.0f) ? v / m : v;
+  }
+
+  float
+  median(const fastuidraw::vec3 &v)
+  {
+    return std::max(std::min(v[0], v[1]), std::min(std::max(v[0], v[1]), v[2]));
+  }
+
+  bool
+  is_corner(const fastuidraw::vec2 &a, const fastuidraw::vec2 &b)
+  {
+    fastuidraw::vec2 na(normalized(a)), nb(normalized(b));
+    return fastuidraw::dot(na, nb) <= 0.0f
+      || std::abs(cross(na, nb)) > corner_cross_threshold;
+  }
+
+  /* maps i in [0, m) to -1, 0 or 1 so that the ends of the
+     range map to -1 and 1 and the middle third to 0.
+   */
+  int
+  symmetrical_trichotomy(int i, int m)
+  {
+    float f;
+
+    f = 3.0f + 2.875f * static_cast<float>(i) / static_cast<float>(m - 1) - 1.4375f + 0.5f;
+    return static_cast<int>(f) - 3;
+  }
+
+  /* returns true if the values of two neighboring texels
+     would interpolate to a false edge, i.e. exactly two of
+     their channels change from inside to outside and both by
+     more than threshold; only the texel farther from the
+     outline is flagged.
+   */
+  bool
+  texels_clash(const fastuidraw::vec3 &a, const fastuidraw::vec3 &b, float threshold)
+  {
+    int a_inside(0), b_inside(0);
+    int changing[3], num_changing(0), remaining(0);
+
+    for(int c = 0; c < 3; ++c)
+      {
+        a_inside += (a[c] > 0.5f) ? 1 : 0;
+        b_inside += (b[c] > 0.5f) ? 1 : 0;
+      }
+
+    /* the median of a and b must agree, and a change of
+       0 <-> 1 or 2 <-> 3 channels is not a clash.
+     */
+    if((a_inside >= 2) != (b_inside >= 2)
+       || a_inside == 0 || a_inside == 3
+       || b_inside == 0 || b_inside == 3)
+      {
+        return false;
+      }
+
+    for(int c = 0; c < 3; ++c)
+      {
+        if((a[c] > 0.5f) != (b[c] > 0.5f) && (a[c] < 0.5f) != (b[c] < 0.5f))
+          {
+            changing[num_changing++] = c;
+          }
+        else
+          {
+            remaining = c;
+          }
+      }
+
+    if(num_changing != 2)
+      {
+        return false;
+      }
+
+    return std::abs(a[changing[0]] - b[changing[0]]) >= threshold
+      && std::abs(a[changing[1]] - b[changing[1]]) >= threshold
+      && std::abs(a[remaining] - 0.5f) >= std::abs(b[remaining] - 0.5f);
+  }
+
+  uint8_t
+  pixel_value(float v)
+  {
+    v = std::max(0.0f, std::min(1.0f, v));
+    return static_cast<uint8_t>(255.0f * v);
+  }
+}
+
+////////////////////////////////////////
+// fastuidraw::detail::MSDFGenerator::nearest_edge methods
+fastuidraw::detail::MSDFGenerator::nearest_edge::
+nearest_edge(void):
+  m_distance(std::numeric_limits<float>::max()),
+  m_dot(1.0f),
+  m_edge(NULL),
+  m_segment(0),
+  m_t(0.0f)
+{}
+
+////////////////////////////////////////
+// fastuidraw::detail::MSDFGenerator methods
+fastuidraw::detail::MSDFGenerator::
+MSDFGenerator(const FT_Outline &outline,
+              const ivec2 &bitmap_size,
+              const ivec2 &bitmap_offset):
+  m_bitmap_size(bitmap_size),
+  m_bitmap_offset(bitmap_offset),
+  m_sweep(outline, bitmap_size, bitmap_offset)
+{
+  FT_Outline_Funcs funcs;
+
+  /* texel coordinates are not flipped from those of
+     FT_Outline, so the fill side is as FreeType reports.
+   */
+  m_orientation = (FT_Outline_Get_Orientation(const_cast<FT_Outline*>(&outline)) == FT_ORIENTATION_POSTSCRIPT) ?
+    1.0f : -1.0f;
+
+  funcs.move_to = &ft_outline_move_to;
+  funcs.line_to = &ft_outline_line_to;
+  funcs.conic_to = &ft_outline_conic_to;
+  funcs.cubic_to = &ft_outline_cubic_to;
+  funcs.shift = 0;
+  funcs.delta = 0;
+  FT_Outline_Decompose(const_cast<FT_Outline*>(&outline), &funcs, this);
+  end_contour();
+}
+
+fastuidraw::vec2
+fastuidraw::detail::MSDFGenerator::
+texel_coordinate(const FT_Vector &pt) const
+{
+  vec2 r;
+  r.x() = static_cast<float>(pt.x) / 64.0f - static_cast<float>(m_bitmap_offset.x());
+  r.y() = static_cast<float>(pt.y) / 64.0f - static_cast<float>(m_bitmap_offset.y());
+  return r;
+}
+
+void
+fastuidraw::detail::MSDFGenerator::
+add_edge(unsigned int begin, vec2 start_direction, vec2 end_direction)
+{
+  edge E;
+
+  E.m_begin = begin;
+  E.m_end = m_points.size() - 1;
+  if(E.m_begin == E.m_end)
+    {
+      return;
+    }
+
+  /* degenerate control points give a zero tangent,
+     fall back to the directions of the end segments
+   */
+  if(dot(start_direction, start_direction) <= 0.0f)
+    {
+      start_direction = m_points[E.m_begin + 1] - m_points[E.m_begin];
+    }
+  if(dot(end_direction, end_direction) <= 0.0f)
+    {
+      end_direction = m_points[E.m_end] - m_points[E.m_end - 1];
+    }
+  E.m_start_direction = start_direction;
+  E.m_end_direction = end_direction;
+  E.m_color = white;
+  compute_bounds(E);
+  m_contour.push_back(E);
+}
+
+void
+fastuidraw::detail::MSDFGenerator::
+compute_bounds(edge &E) const
+{
+  E.m_min = E.m_max = m_points[E.m_begin];
+  for(unsigned int i = E.m_begin + 1; i <= E.m_end; ++i)
+    {
+      for(unsigned int c = 0; c < 2; ++c)
+        {
+          E.m_min[c] = std::min(E.m_min[c], m_points[i][c]);
+          E.m_max[c] = std::max(E.m_max[c], m_points[i][c]);
+        }
+    }
+}
+
+int
+fastuidraw::detail::MSDFGenerator::
+ft_outline_move_to(const FT_Vector *pt, void *user)
+{
+  MSDFGenerator *p;
+  p = reinterpret_cast<MSDFGenerator*>(user);
+  p->end_contour();
+  p->m_points.push_back(p->texel_coordinate(*pt));
+  return 0;
+}
+
+int
+fastuidraw::detail::MSDFGenerator::
+ft_outline_line_to(const FT_Vector *pt, void *user)
+{
+  MSDFGenerator *p;
+  vec2 p0, p1;
+  unsigned int begin;
+
+  p = reinterpret_cast<MSDFGenerator*>(user);
+  p0 = p->m_points.back();
+  p1 = p->texel_coordinate(*pt);
+  if(p0 == p1)
+    {
+      return 0;
+    }
+
+  begin = p->m_points.size() - 1;
+  p->m_points.push_back(p1);
+  p->add_edge(begin, p1 - p0, p1 - p0);
+  return 0;
+}
+
+int
+fastuidraw::detail::MSDFGenerator::
+ft_outline_conic_to(const FT_Vector *control_pt,
+                    const FT_Vector *pt, void *user)
+{
+  MSDFGenerator *p;
+  vec2 p0, c, p1, d;
+  unsigned int begin;
+  int n;
+
+  p = reinterpret_cast<MSDFGenerator*>(user);
+  p0 = p->m_points.back();
+  c = p->texel_coordinate(*control_pt);
+  p1 = p->texel_coordinate(*pt);
+  if(p0 == p1 && p0 == c)
+    {
+      return 0;
+    }
+
+  /* the distance between a quadratic and the chords of n
+     uniform steps is at most |p0 - 2c + p1| / (4 n^2)
+   */
+  begin = p->m_points.size() - 1;
+  d = p0 - 2.0f * c + p1;
+  n = number_segments_from_deviation(0.25f * std::sqrt(dot(d, d)));
+  for(int i = 1; i < n; ++i)
+    {
+      float t, s;
+
+      t = static_cast<float>(i) / static_cast<float>(n);
+      s = 1.0f - t;
+      p->m_points.push_back(s * s * p0 + 2.0f * s * t * c + t * t * p1);
+    }
+  p->m_points.push_back(p1);
+  p->add_edge(begin, c - p0, p1 - c);
+  return 0;
+}
+
+int
+fastuidraw::detail::MSDFGenerator::
+ft_outline_cubic_to(const FT_Vector *control_pt1,
+                    const FT_Vector *control_pt2,
+                    const FT_Vector *pt, void *user)
+{
+  MSDFGenerator *p;
+  vec2 p0, c0, c1, p1, d0, d1, start_direction, end_direction;
+  unsigned int begin;
+  float m;
+  int n;
+
+  p = reinterpret_cast<MSDFGenerator*>(user);
+  p0 = p->m_points.back();
+  c0 = p->texel_coordinate(*control_pt1);
+  c1 = p->texel_coordinate(*control_pt2);
+  p1 = p->texel_coordinate(*pt);
+  if(p0 == p1 && p0 == c0 && p0 == c1)
+    {
+      return 0;
+    }
+
+  /* the second derivative of a cubic is bounded by 6 M where
+     M is the largest second difference of the control points,
+     giving a distance to the chords of at most 6 M / (8 n^2)
+   */
+  begin = p->m_points.size() - 1;
+  d0 = p0 - 2.0f * c0 + c1;
+  d1 = c0 - 2.0f * c1 + p1;
+  m = std::sqrt(std::max(dot(d0, d0), dot(d1, d1)));
+  n = number_segments_from_deviation(0.75f * m);
+  for(int i = 1; i < n; ++i)
+    {
+      float t, s;
+
+      t = static_cast<float>(i) / static_cast<float>(n);
+      s = 1.0f - t;
+      p->m_points.push_back(s * s * s * p0 + 3.0f * s * s * t * c0
+                            + 3.0f * s * t * t * c1 + t * t * t * p1);
+    }
+  p->m_points.push_back(p1);
+
+  start_direction = !(c0 == p0) ? c0 - p0 : c1 - p0;
+  end_direction = !(c1 == p1) ? p1 - c1 : p1 - c0;
+  p->add_edge(begin, start_direction, end_direction);
+  return 0;
+}
+
+void
+fastuidraw::detail::MSDFGenerator::
+end_contour(void)
+{
+  if(!m_contour.empty())
+    {
+      color_contour(m_contour);
+      m_edges.insert(m_edges.end(), m_contour.begin(), m_contour.end());
+      m_contour.clear();
+    }
+}
+
+void
+fastuidraw::detail::MSDFGenerator::
+switch_color(uint32_t &color, uint32_t banned)
+{
+  /* Edge coloring of msdfgen with a seed of 0: the colors
+     cycle through cyan, magenta and yellow by rotating the
+     bits of the color, avoiding the banned color.
+   */
+  uint32_t combined, shifted;
+
+  combined = color & banned;
+  if(combined == red || combined == green || combined == blue)
+    {
+      color = combined ^ white;
+      return;
+    }
+
+  if(color == black || color == white)
+    {
+      color = cyan;
+      return;
+    }
+
+  shifted = color << 1;
+  color = (shifted | (shifted >> 3)) & white;
+}
+
+void
+fastuidraw::detail::MSDFGenerator::
+split_edge(std::vector<edge> &edges, unsigned int e)
+{
+  edge first, second;
+  unsigned int mid;
+
+  first = edges[e];
+  second = edges[e];
+  mid = (first.m_begin + first.m_end) / 2;
+  assert(first.m_begin < mid && mid < first.m_end);
+
+  first.m_end = mid;
+  first.m_end_direction = m_points[mid] - m_points[mid - 1];
+  second.m_begin = mid;
+  second.m_start_direction = m_points[mid + 1] - m_points[mid];
+  compute_bounds(first);
+  compute_bounds(second);
+
+  edges[e] = first;
+  edges.insert(edges.begin() + e + 1, second);
+}
+
+void
+fastuidraw::detail::MSDFGenerator::
+color_contour(std::vector<edge> &edges)
+{
+  std::vector<unsigned int> corners;
+  vec2 prev_direction;
+
+  prev_direction = edges.back().m_end_direction;
+  for(unsigned int i = 0; i < edges.size(); ++i)
+    {
+      if(is_corner(prev_direction, edges[i].m_start_direction))
+        {
+          corners.push_back(i);
+        }
+      prev_direction = edges[i].m_end_direction;
+    }
+
+  if(corners.empty())
+    {
+      /* smooth contour, every channel sees every edge */
+      for(unsigned int i = 0; i < edges.size(); ++i)
+        {
+          edges[i].m_color = white;
+        }
+    }
+  else if(corners.size() == 1)
+    {
+      /* a teardrop: color the edges cyan, white, magenta from
+         the corner so that the two sides of the corner share
+         only the blue channel; needs at least three edges,
+         so split the longest edges at their middle point.
+       */
+      uint32_t colors[3] = { cyan, white, magenta };
+      unsigned int corner(corners[0]);
+      int m;
+
+      while(edges.size() < 3)
+        {
+          unsigned int longest(0);
+
+          for(unsigned int i = 1; i < edges.size(); ++i)
+            {
+              if(edges[i].m_end - edges[i].m_begin > edges[longest].m_end - edges[longest].m_begin)
+                {
+                  longest = i;
+                }
+            }
+
+          if(edges[longest].m_end - edges[longest].m_begin < 2)
+            {
+              break;
+            }
+
+          split_edge(edges, longest);
+          if(longest < corner)
+            {
+              ++corner;
+            }
+        }
+
+      m = edges.size();
+      if(m >= 3)
+        {
+          for(int i = 0; i < m; ++i)
+            {
+              edges[(corner + i) % m].m_color = colors[1 + symmetrical_trichotomy(i, m)];
+            }
+        }
+    }
+  else
+    {
+      /* change color at each corner, the color of the last
+         spline must differ from that of the first.
+       */
+      unsigned int spline(0), start(corners[0]), m(edges.size());
+      uint32_t color(white), initial_color;
+
+      switch_color(color);
+      initial_color = color;
+      for(unsigned int i = 0; i < m; ++i)
+        {
+          unsigned int index;
+
+          index = (start + i) % m;
+          if(spline + 1 < corners.size() && corners[spline + 1] == index)
+            {
+              ++spline;
+              switch_color(color, (spline + 1 == corners.size()) ? initial_color : uint32_t(black));
+            }
+          edges[index].m_color = color;
+        }
+    }
+}
+
+float
+fastuidraw::detail::MSDFGenerator::
+signed_pseudo_distance(const vec2 &p, const nearest_edge &E) const
+{
+  const edge &e(*E.m_edge);
+  vec2 a, b, q, d;
+  float s, sd, pd;
+
+  a = m_points[E.m_segment];
+  b = m_points[E.m_segment + 1];
+  d = b - a;
+  q = (E.m_t <= 0.0f) ? a : ((E.m_t >= 1.0f) ? b : a + E.m_t * d);
+
+  s = m_orientation * cross(d, p - q);
+  sd = (s >= 0.0f) ? E.m_distance : -E.m_distance;
+
+  /* beyond the ends of the edge, take the distance to the
+     tangent line at the end if it is no larger.
+   */
+  if(E.m_segment == e.m_begin && E.m_t < 0.0f)
+    {
+      vec2 dir(normalized(e.m_start_direction)), ap(p - a);
+      if(dot(ap, dir) < 0.0f)
+        {
+          pd = m_orientation * cross(dir, ap);
+          if(std::abs(pd) <= std::abs(sd))
+            {
+              sd = pd;
+            }
+        }
+    }
+
+  if(E.m_segment + 1 == e.m_end && E.m_t > 1.0f)
+    {
+      vec2 dir(normalized(e.m_end_direction)), bp(p - b);
+      if(dot(bp, dir) > 0.0f)
+        {
+          pd = m_orientation * cross(dir, bp);
+          if(std::abs(pd) <= std::abs(sd))
+            {
+              sd = pd;
+            }
+        }
+    }
+
+  return sd;
+}
+
+void
+fastuidraw::detail::MSDFGenerator::
+correct_signs(float max_distance, std::vector<vec3> &values)
+{
+  /* texels whose median is on the wrong side of the outline,
+     for example where contours overlap, take the true signed
+     distance in all three channels.
+   */
+  for(int y = 0; y < m_bitmap_size.y(); ++y)
+    {
+      for(int x = 0; x < m_bitmap_size.x(); ++x)
+        {
+          vec3 &v(values[x + y * m_bitmap_size.x()]);
+          bool inside;
+
+          inside = m_sweep.inside(x, y);
+          if((median(v) > 0.5f) != inside)
+            {
+              float d;
+
+              d = std::min(m_sweep.distance(x, y) / max_distance, 1.0f);
+              d = inside ? d : -d;
+              v = vec3(0.5f + 0.5f * d);
+            }
+        }
+    }
+}
+
+void
+fastuidraw::detail::MSDFGenerator::
+correct_clashes(float max_distance_texels, std::vector<vec3> &values)
+{
+  std::vector<unsigned int> clashes;
+  float threshold;
+  int w(m_bitmap_size.x()), h(m_bitmap_size.y());
+
+  /* a channel changing by more than a texel's worth of
+     distance between neighbors is discontinuous.
+   */
+  threshold = 1.001f / (2.0f * max_distance_texels);
+  for(int y = 0; y < h; ++y)
+    {
+      for(int x = 0; x < w; ++x)
+        {
+          unsigned int I(x + y * w);
+
+          if((x > 0 && texels_clash(values[I], values[I - 1], threshold))
+             || (x + 1 < w && texels_clash(values[I], values[I + 1], threshold))
+             || (y > 0 && texels_clash(values[I], values[I - w], threshold))
+             || (y + 1 < h && texels_clash(values[I], values[I + w], threshold)))
+            {
+              clashes.push_back(I);
+            }
+        }
+    }
+
+  for(unsigned int i = 0; i < clashes.size(); ++i)
+    {
+      vec3 &v(values[clashes[i]]);
+      v = vec3(median(v));
+    }
+}
+
+void
+fastuidraw::detail::MSDFGenerator::
+compute_distance_values(float max_distance, GlyphRenderDataMSDF &output)
+{
+  std::vector<vec3> values(m_bitmap_size.x() * m_bitmap_size.y());
+  float max_distance_texels(max_distance / 64.0f);
+  int out_width(output.resolution().x());
+
+  assert(output.resolution().x() >= m_bitmap_size.x());
+  assert(output.resolution().y() >= m_bitmap_size.y());
+
+  m_sweep.compute_distance_values(max_distance);
+  for(int y = 0; y < m_bitmap_size.y(); ++y)
+    {
+      for(int x = 0; x < m_bitmap_size.x(); ++x)
+        {
+          vecN<nearest_edge, 3> nearest;
+          vec2 p(static_cast<float>(x) + 0.5f, static_cast<float>(y) + 0.5f);
+          vec3 &v(values[x + y * m_bitmap_size.x()]);
+
+          for(unsigned int e = 0; e < m_edges.size(); ++e)
+            {
+              const edge &E(m_edges[e]);
+              float best_dist_sq(std::numeric_limits<float>::max()), best_t(0.0f);
+              float dist, dot_value, bound_x, bound_y, farthest(0.0f);
+              unsigned int best_segment(E.m_begin);
+              vec2 q;
+
+              /* skip the edge if its bounding box is farther
+                 than the nearest edge of each of its channels;
+                 the slack keeps edges sharing the closest point
+                 so that ties are broken by angle.
+               */
+              for(unsigned int c = 0; c < 3; ++c)
+                {
+                  if((E.m_color & (1u << c)) != 0)
+                    {
+                      farthest = std::max(farthest, nearest[c].m_distance);
+                    }
+                }
+              bound_x = std::max(0.0f, std::max(E.m_min.x() - p.x(), p.x() - E.m_max.x()));
+              bound_y = std::max(0.0f, std::max(E.m_min.y() - p.y(), p.y() - E.m_max.y()));
+              if(bound_x * bound_x + bound_y * bound_y > 1.001f * farthest * farthest)
+                {
+                  continue;
+                }
+
+              for(unsigned int s = E.m_begin; s < E.m_end; ++s)
+                {
+                  vec2 a(m_points[s]), d(m_points[s + 1] - a), ap(p - a), qp;
+                  float t, dd, dist_sq;
+
+                  dd = dot(d, d);
+                  t = (dd > 0.0f) ? dot(ap, d) / dd : 0.0f;
+                  qp = ap - std::max(0.0f, std::min(1.0f, t)) * d;
+                  dist_sq = dot(qp, qp);
+                  if(dist_sq < best_dist_sq)
+                    {
+                      best_dist_sq = dist_sq;
+                      best_segment = s;
+                      best_t = t;
+                    }
+                }
+
+              /* compute the closest point exactly at the end points
+                 so that edges sharing a point give equal distances
+                 there and the tie is broken by the angle.
+               */
+              if(best_t <= 0.0f)
+                {
+                  q = m_points[best_segment];
+                }
+              else if(best_t >= 1.0f)
+                {
+                  q = m_points[best_segment + 1];
+                }
+              else
+                {
+                  q = m_points[best_segment] + best_t * (m_points[best_segment + 1] - m_points[best_segment]);
+                }
+              dist = std::sqrt(dot(p - q, p - q));
+              dot_value = std::abs(dot(normalized(m_points[best_segment + 1] - m_points[best_segment]),
+                                       normalized(p - q)));
+
+              for(unsigned int c = 0; c < 3; ++c)
+                {
+                  if((E.m_color & (1u << c)) != 0
+                     && (dist < nearest[c].m_distance
+                         || (dist == nearest[c].m_distance && dot_value < nearest[c].m_dot)))
+                    {
+                      nearest[c].m_distance = dist;
+                      nearest[c].m_dot = dot_value;
+                      nearest[c].m_edge = &E;
+                      nearest[c].m_segment = best_segment;
+                      nearest[c].m_t = best_t;
+                    }
+                }
+            }
+
+          for(unsigned int c = 0; c < 3; ++c)
+            {
+              float d;
+
+              d = (nearest[c].m_edge != NULL) ?
+                signed_pseudo_distance(p, nearest[c]) :
+                -max_distance_texels;
+              d = std::max(-1.0f, std::min(1.0f, d / max_distance_texels));
+              v[c] = 0.5f + 0.5f * d;
+            }
+        }
+    }
+
+  correct_signs(max_distance, values);
+  correct_clashes(max_distance_texels, values);
+
+  for(int y = 0; y < m_bitmap_size.y(); ++y)
+    {
+      for(int x = 0; x < m_bitmap_size.x(); ++x)
+        {
+          const vec3 &v(values[x + y * m_bitmap_size.x()]);
+          int location(x + y * out_width);
+
+          output.distance_values(GlyphRenderDataMSDF::red_channel)[location] = pixel_value(v[0]);
+          output.distance_values(GlyphRenderDataMSDF::green_channel)[location] = pixel_value(v[1]);
+          output.distance_values(GlyphRenderDataMSDF::blue_channel)[location] = pixel_value(v[2]);
+        }
+    }
+}
@@ -0,0 +1,193 @@
+/*!
+ * \file freetype_msdf_util.hpp
+ * \brief file freetype_msdf_util.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <vector>
+
+#include <ft2build.h>
+#include FT_OUTLINE_H
+
+#include <fastuidraw/util/vecN.hpp>
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/text/glyph_render_data_msdf.hpp>
+#include "distance_field_sweep.hpp"
+
+namespace fastuidraw
+{
+namespace detail
+{
+  /*!\class MSDFGenerator
+    An MSDFGenerator computes the multi-channel signed
+    distance field of an FT_Outline:
+     - each curve of the outline is an edge, flattened to
+       line segments but keeping the tangents at its end
+       points,
+     - the edges are colored so that the two edges meeting
+       at a corner of the outline do not share all channels
+       (the simple edge coloring of Chlumsky's msdfgen),
+     - each channel of a texel is the signed pseudo-distance
+       to the closest edge of that channel, i.e. beyond the
+       end of the closest edge the distance is to the line
+       tangent to the edge at its end,
+     - texels where neighboring texels would interpolate to
+       a false edge and texels whose median has the wrong sign
+       (for example from overlapping contours) are replaced by
+       single channel values.
+    Texels are sampled at the same locations as OutlineData
+    and DistanceFieldSweep.
+   */
+  class MSDFGenerator
+  {
+  public:
+    /*!\fn MSDFGenerator(const FT_Outline&, const ivec2&, const ivec2&)
+      Ctor.
+      \param outline FT_Outline of a glyph, in 26.6 fixed point
+      \param bitmap_size size of the distance field in texels
+      \param bitmap_offset offset of the distance field in pixels,
+                           i.e. as the bitmap_left and bitmap_top
+                           of the glyph rendered by FreeType
+     */
+    MSDFGenerator(const FT_Outline &outline,
+                  const ivec2 &bitmap_size,
+                  const ivec2 &bitmap_offset);
+
+    /*!\fn void compute_distance_values
+      Compute the distance values of the texels (x, y) with
+      0 <= x < bitmap_size.x() and 0 <= y < bitmap_size.y();
+      the resolution of output must be at least bitmap_size.
+      \param max_distance distance at which to saturate the
+                          distance values in units of 1/64'th
+                          of a pixel
+      \param output location to which to write the values
+     */
+    void
+    compute_distance_values(float max_distance, GlyphRenderDataMSDF &output);
+
+  private:
+    enum edge_color_t
+      {
+        black = 0,
+        red = 1,
+        green = 2,
+        yellow = red | green,
+        blue = 4,
+        magenta = red | blue,
+        cyan = green | blue,
+        white = red | green | blue,
+      };
+
+    class edge
+    {
+    public:
+      /* the edge is the line segments between
+         m_points[i] and m_points[i + 1] for
+         m_begin <= i < m_end.
+       */
+      unsigned int m_begin, m_end;
+      vec2 m_start_direction, m_end_direction;
+      uint32_t m_color;
+
+      /* bounding box of the points of the edge */
+      vec2 m_min, m_max;
+    };
+
+    class nearest_edge
+    {
+    public:
+      nearest_edge(void);
+
+      float m_distance, m_dot;
+      const edge *m_edge;
+      unsigned int m_segment;
+      float m_t;
+    };
+
+    static
+    int
+    ft_outline_move_to(const FT_Vector *pt, void *user);
+
+    static
+    int
+    ft_outline_line_to(const FT_Vector *pt, void *user);
+
+    static
+    int
+    ft_outline_conic_to(const FT_Vector *control_pt,
+                        const FT_Vector *pt, void *user);
+
+    static
+    int
+    ft_outline_cubic_to(const FT_Vector *control_pt1,
+                        const FT_Vector *control_pt2,
+                        const FT_Vector *pt, void *user);
+
+    static
+    void
+    switch_color(uint32_t &color, uint32_t banned = black);
+
+    vec2
+    texel_coordinate(const FT_Vector &pt) const;
+
+    void
+    add_edge(unsigned int begin, vec2 start_direction, vec2 end_direction);
+
+    void
+    end_contour(void);
+
+    void
+    compute_bounds(edge &E) const;
+
+    void
+    split_edge(std::vector<edge> &edges, unsigned int e);
+
+    void
+    color_contour(std::vector<edge> &edges);
+
+    float
+    signed_pseudo_distance(const vec2 &p, const nearest_edge &E) const;
+
+    void
+    correct_signs(float max_distance, std::vector<vec3> &values);
+
+    void
+    correct_clashes(float max_distance_texels, std::vector<vec3> &values);
+
+    ivec2 m_bitmap_size;
+    ivec2 m_bitmap_offset;
+
+    /* 1 if the outline is filled to the left of the direction
+       of its contours, -1 if filled to the right.
+     */
+    float m_orientation;
+
+    /* points of the flattened outline in texel coordinates,
+       where the center of texel (x, y) is at (x + 0.5, y + 0.5).
+     */
+    std::vector<vec2> m_points;
+    std::vector<edge> m_edges, m_contour;
+
+    /* provides the inside/outside test and true distance
+       with which to correct texels.
+     */
+    DistanceFieldSweep m_sweep;
+  };
+
+} //namespace detail
+} //namespace fastuidraw
@@ -0,0 +1,924 @@
+/*!
+ * \file glyph_cache_file.cpp
+ * \brief file glyph_cache_file.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+#include <vector>
+#include <sstream>
+#include <cstring>
+#include <cstdio>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <fastuidraw/text/glyph_render_data_coverage.hpp>
+#include <fastuidraw/text/glyph_render_data_distance_field.hpp>
+#include <fastuidraw/text/glyph_render_data_msdf.hpp>
+#include <fastuidraw/text/glyph_render_data_curve_pair.hpp>
+#include "glyph_cache_file.hpp"
+#include "../../private/util_private.hpp"
+
+namespace
+{
+  /* header values of a glyph cache file and of its records,
+     cache_file_version is to be incremented whenever the
+     format of the file or of a record changes.
+   */
+  enum
+    {
+      cache_file_magic = 0x47495546, /* "FUIG" in little endian */
+      cache_file_version = 1,
+      cache_file_byte_order = 0x01020304,
+      record_magic = 0x52495546, /* "FUIR" in little endian */
+
+      number_header_values = 4,
+      header_size = number_header_values * sizeof(uint32_t),
+
+      /* a record is its magic, size of its key, size of
+         its data and checksum of its key and data,
+         followed by the key and then the data.
+       */
+      number_record_header_values = 4,
+      record_header_size = number_record_header_values * sizeof(uint32_t)
+    };
+
+  /* FNV-1a of bytes */
+  uint32_t
+  checksum(const uint8_t *bytes, size_t num_bytes, uint32_t return_value = 2166136261u)
+  {
+    for(size_t i = 0; i < num_bytes; ++i)
+      {
+        return_value ^= bytes[i];
+        return_value *= 16777619u;
+      }
+    return return_value;
+  }
+
+  bool
+  write_all(int fd, const uint8_t *bytes, size_t num_bytes)
+  {
+    while(num_bytes > 0)
+      {
+        ssize_t written;
+
+        written = write(fd, bytes, num_bytes);
+        if(written < 0)
+          {
+            if(errno == EINTR)
+              {
+                continue;
+              }
+            return false;
+          }
+        bytes += written;
+        num_bytes -= written;
+      }
+    return true;
+  }
+
+  bool
+  write_header(int fd)
+  {
+    uint32_t header[number_header_values] =
+      {
+        cache_file_magic,
+        cache_file_version,
+        cache_file_byte_order,
+        sizeof(fastuidraw::GlyphRenderDataCurvePair::entry)
+      };
+
+    return write_all(fd, reinterpret_cast<const uint8_t*>(header), header_size);
+  }
+
+  /* returns the offset of the end of the record at offset
+     or 0 if there is no complete record at offset; when
+     check_sum is true the checksum of the record must also
+     be correct.
+   */
+  uint64_t
+  record_end(fastuidraw::const_c_array<uint8_t> data, uint64_t offset, bool check_sum)
+  {
+    uint32_t record[number_record_header_values];
+    uint64_t end;
+
+    if(offset + record_header_size > data.size())
+      {
+        return 0;
+      }
+
+    std::memcpy(record, data.c_ptr() + offset, record_header_size);
+    end = offset + record_header_size + uint64_t(record[1]) + uint64_t(record[2]);
+    if(record[0] != uint32_t(record_magic)
+       || end > data.size()
+       || (check_sum && record[3] != checksum(data.c_ptr() + offset + record_header_size,
+                                               record[1] + record[2])))
+      {
+        return 0;
+      }
+    return end;
+  }
+
+  std::string
+  record_key(fastuidraw::const_c_array<uint8_t> data, uint64_t offset)
+  {
+    uint32_t key_size;
+
+    std::memcpy(&key_size, data.c_ptr() + offset + sizeof(uint32_t), sizeof(uint32_t));
+    return std::string(reinterpret_cast<const char*>(data.c_ptr() + offset + record_header_size),
+                       key_size);
+  }
+
+  /* returns the offset of the first occurrence at or after
+     offset of the magic of a record, or data.size() if there
+     is none.
+   */
+  uint64_t
+  find_record_magic(fastuidraw::const_c_array<uint8_t> data, uint64_t offset)
+  {
+    for(; offset + sizeof(uint32_t) <= data.size(); ++offset)
+      {
+        uint32_t v;
+
+        std::memcpy(&v, data.c_ptr() + offset, sizeof(uint32_t));
+        if(v == uint32_t(record_magic))
+          {
+            return offset;
+          }
+      }
+    return data.size();
+  }
+
+  /* BakedDataWriter::write_array() is for elements whose
+     size is a multiple of 4 bytes, the arrays of texels
+     are written as bytes instead.
+   */
+  template<typename T>
+  void
+  write_texels(fastuidraw::BakedDataWriter &dst, fastuidraw::const_c_array<T> values)
+  {
+    dst.write_value(uint32_t(values.size()));
+    dst.write_bytes(values.c_ptr(), values.size() * sizeof(T), sizeof(uint32_t));
+  }
+
+  template<typename T>
+  bool
+  read_texels(fastuidraw::BakedDataReader &src, fastuidraw::c_array<T> values)
+  {
+    uint32_t count;
+    fastuidraw::const_c_array<uint8_t> bytes;
+
+    if(!src.read_value(count) || count != values.size())
+      {
+        src.set_error();
+        return false;
+      }
+
+    bytes = src.read_bytes(count * sizeof(T), sizeof(uint32_t));
+    if(src.error())
+      {
+        return false;
+      }
+
+    if(count > 0)
+      {
+        std::memcpy(values.c_ptr(), bytes.c_ptr(), bytes.size());
+      }
+    return true;
+  }
+
+  /* reads a resolution and checks that the texels of
+     the resolution can be in what remains of src.
+   */
+  bool
+  read_resolution(fastuidraw::BakedDataReader &src, fastuidraw::ivec2 &resolution)
+  {
+    if(!src.read_value(resolution)
+       || resolution.x() < 0 || resolution.y() < 0
+       || static_cast<uint64_t>(resolution.x()) * static_cast<uint64_t>(resolution.y()) > src.remaining())
+      {
+        src.set_error();
+        return false;
+      }
+    return true;
+  }
+
+  void
+  write_layout(fastuidraw::BakedDataWriter &dst, const fastuidraw::GlyphLayoutData &layout)
+  {
+    dst.write_value(layout.m_horizontal_layout_offset);
+    dst.write_value(layout.m_vertical_layout_offset);
+    dst.write_value(layout.m_size);
+    dst.write_value(layout.m_advance);
+    dst.write_value(int32_t(layout.m_pixel_size));
+  }
+
+  bool
+  read_layout(fastuidraw::BakedDataReader &src, fastuidraw::GlyphLayoutData &layout)
+  {
+    int32_t pixel_size(0);
+
+    src.read_value(layout.m_horizontal_layout_offset);
+    src.read_value(layout.m_vertical_layout_offset);
+    src.read_value(layout.m_size);
+    src.read_value(layout.m_advance);
+    src.read_value(pixel_size);
+    layout.m_pixel_size = pixel_size;
+
+    return !src.error();
+  }
+
+  /* A contour is written as its number of points, whether
+     it is ended, its points and then the control points of
+     each of its interpolators; a flat interpolator has no
+     control points.
+   */
+  bool
+  write_path(fastuidraw::BakedDataWriter &dst, const fastuidraw::Path &path)
+  {
+    using namespace fastuidraw;
+
+    dst.write_value(uint32_t(path.number_contours()));
+    for(unsigned int c = 0, endc = path.number_contours(); c < endc; ++c)
+      {
+        reference_counted_ptr<const PathContour> contour(path.contour(c));
+        unsigned int num_points, num_interpolators;
+
+        num_points = contour->number_points();
+        num_interpolators = (contour->ended() || num_points == 0) ? num_points : num_points - 1;
+
+        dst.write_value(uint32_t(num_points));
+        dst.write_value(uint32_t(contour->ended()));
+        for(unsigned int p = 0; p < num_points; ++p)
+          {
+            dst.write_value(contour->point(p));
+          }
+
+        for(unsigned int i = 0; i < num_interpolators; ++i)
+          {
+            const PathContour::interpolator_base *h;
+            const PathContour::bezier *b;
+
+            h = contour->interpolator(i).get();
+            b = dynamic_cast<const PathContour::bezier*>(h);
+            if(b)
+              {
+                const_c_array<vec2> pts(b->pts());
+
+                assert(pts.size() >= 2);
+                dst.write_value(uint32_t(pts.size() - 2));
+                for(unsigned int k = 1, endk = pts.size() - 1; k < endk; ++k)
+                  {
+                    dst.write_value(pts[k]);
+                  }
+              }
+            else if(dynamic_cast<const PathContour::flat*>(h))
+              {
+                dst.write_value(uint32_t(0));
+              }
+            else
+              {
+                return false;
+              }
+          }
+      }
+    return true;
+  }
+
+  bool
+  read_path(fastuidraw::BakedDataReader &src, fastuidraw::Path &path)
+  {
+    using namespace fastuidraw;
+
+    uint32_t num_contours(0);
+    std::vector<vec2> points;
+
+    src.read_value(num_contours);
+    for(uint32_t c = 0; c < num_contours && !src.error(); ++c)
+      {
+        uint32_t num_points(0), ended(0), num_interpolators;
+
+        if(!src.read_value(num_points) || !src.read_value(ended)
+           || num_points == 0 || num_points > src.remaining() / sizeof(vec2))
+          {
+            src.set_error();
+            return false;
+          }
+
+        points.resize(num_points);
+        for(uint32_t p = 0; p < num_points; ++p)
+          {
+            if(!src.read_value(points[p]))
+              {
+                return false;
+              }
+          }
+
+        path << points[0];
+        num_interpolators = (ended) ? num_points : num_points - 1;
+        for(uint32_t i = 0; i < num_interpolators && !src.error(); ++i)
+          {
+            uint32_t num_control_points(0);
+
+            if(!src.read_value(num_control_points)
+               || num_control_points > src.remaining() / sizeof(vec2))
+              {
+                src.set_error();
+                return false;
+              }
+
+            for(uint32_t k = 0; k < num_control_points; ++k)
+              {
+                vec2 pt(0.0f, 0.0f);
+
+                if(!src.read_value(pt))
+                  {
+                    return false;
+                  }
+                path << Path::control_point(pt);
+              }
+
+            if(i + 1 < num_points)
+              {
+                path << points[i + 1];
+              }
+            else
+              {
+                path << Path::contour_end();
+              }
+          }
+      }
+    return !src.error();
+  }
+
+  void
+  write_curve(fastuidraw::BakedDataWriter &dst,
+              const fastuidraw::GlyphRenderDataCurvePair::per_curve &curve)
+  {
+    dst.write_value(curve.m_m0);
+    dst.write_value(curve.m_m1);
+    dst.write_value(curve.m_q);
+    dst.write_value(curve.m_quad_coeff);
+  }
+
+  void
+  read_curve(fastuidraw::BakedDataReader &src,
+             fastuidraw::GlyphRenderDataCurvePair::per_curve &curve)
+  {
+    src.read_value(curve.m_m0);
+    src.read_value(curve.m_m1);
+    src.read_value(curve.m_q);
+    src.read_value(curve.m_quad_coeff);
+  }
+
+  bool
+  write_render_data(fastuidraw::BakedDataWriter &dst, enum fastuidraw::glyph_type tp,
+                    const fastuidraw::GlyphRenderData *data)
+  {
+    using namespace fastuidraw;
+
+    switch(tp)
+      {
+      case coverage_glyph:
+        {
+          const GlyphRenderDataCoverage *p;
+
+          p = dynamic_cast<const GlyphRenderDataCoverage*>(data);
+          if(!p)
+            {
+              return false;
+            }
+          dst.write_value(p->resolution());
+          write_texels(dst, p->coverage_values());
+        }
+        return true;
+
+      case distance_field_glyph:
+        {
+          const GlyphRenderDataDistanceField *p;
+
+          p = dynamic_cast<const GlyphRenderDataDistanceField*>(data);
+          if(!p)
+            {
+              return false;
+            }
+          dst.write_value(p->resolution());
+          write_texels(dst, p->distance_values());
+        }
+        return true;
+
+      case msdf_glyph:
+        {
+          const GlyphRenderDataMSDF *p;
+
+          p = dynamic_cast<const GlyphRenderDataMSDF*>(data);
+          if(!p)
+            {
+              return false;
+            }
+          dst.write_value(p->resolution());
+          for(unsigned int c = 0; c < GlyphRenderDataMSDF::number_channels; ++c)
+            {
+              write_texels(dst, p->distance_values(static_cast<enum GlyphRenderDataMSDF::channel_t>(c)));
+            }
+        }
+        return true;
+
+      case curve_pair_glyph:
+        {
+          const GlyphRenderDataCurvePair *p;
+          const_c_array<GlyphRenderDataCurvePair::entry> entries;
+
+          p = dynamic_cast<const GlyphRenderDataCurvePair*>(data);
+          if(!p)
+            {
+              return false;
+            }
+          dst.write_value(p->resolution());
+          write_texels(dst, p->active_curve_pair());
+
+          entries = p->geometry_data();
+          dst.write_value(uint32_t(entries.size()));
+          for(unsigned int i = 0; i < entries.size(); ++i)
+            {
+              dst.write_value(entries[i].m_p);
+              write_curve(dst, entries[i].m_curve0);
+              write_curve(dst, entries[i].m_curve1);
+              dst.write_value(uint32_t(entries[i].m_use_min));
+              dst.write_value(entries[i].m_zeta);
+              dst.write_value(uint32_t(entries[i].m_type));
+            }
+        }
+        return true;
+
+      default:
+        return false;
+      }
+  }
+
+  fastuidraw::GlyphRenderData*
+  read_render_data(fastuidraw::BakedDataReader &src, enum fastuidraw::glyph_type tp)
+  {
+    using namespace fastuidraw;
+
+    ivec2 resolution;
+
+    if(!read_resolution(src, resolution))
+      {
+        return NULL;
+      }
+
+    switch(tp)
+      {
+      case coverage_glyph:
+        {
+          GlyphRenderDataCoverage *p;
+
+          p = FASTUIDRAWnew GlyphRenderDataCoverage();
+          p->resize(resolution);
+          read_texels(src, p->coverage_values());
+          return p;
+        }
+
+      case distance_field_glyph:
+        {
+          GlyphRenderDataDistanceField *p;
+
+          p = FASTUIDRAWnew GlyphRenderDataDistanceField();
+          p->resize(resolution);
+          read_texels(src, p->distance_values());
+          return p;
+        }
+
+      case msdf_glyph:
+        {
+          GlyphRenderDataMSDF *p;
+
+          p = FASTUIDRAWnew GlyphRenderDataMSDF();
+          p->resize(resolution);
+          for(unsigned int c = 0; c < GlyphRenderDataMSDF::number_channels; ++c)
+            {
+              read_texels(src, p->distance_values(static_cast<enum GlyphRenderDataMSDF::channel_t>(c)));
+            }
+          return p;
+        }
+
+      case curve_pair_glyph:
+        {
+          GlyphRenderDataCurvePair *p;
+          c_array<GlyphRenderDataCurvePair::entry> entries;
+          uint32_t num_entries(0);
+
+          p = FASTUIDRAWnew GlyphRenderDataCurvePair();
+          p->resize_active_curve_pair(resolution);
+          read_texels(src, p->active_curve_pair());
+
+          /* each entry is at least 4 bytes in src */
+          if(!src.read_value(num_entries) || num_entries > src.remaining() / sizeof(uint32_t))
+            {
+              src.set_error();
+              return p;
+            }
+
+          p->resize_geometry_data(num_entries);
+          entries = p->geometry_data();
+          for(unsigned int i = 0; i < entries.size() && !src.error(); ++i)
+            {
+              uint32_t use_min(0), entry_type(0);
+
+              src.read_value(entries[i].m_p);
+              read_curve(src, entries[i].m_curve0);
+              read_curve(src, entries[i].m_curve1);
+              src.read_value(use_min);
+              src.read_value(entries[i].m_zeta);
+              src.read_value(entry_type);
+              if(entry_type > GlyphRenderDataCurvePair::entry_completely_uncovered)
+                {
+                  src.set_error();
+                }
+              entries[i].m_use_min = (use_min != 0);
+              entries[i].m_type = static_cast<enum GlyphRenderDataCurvePair::entry_type>(entry_type);
+            }
+          return p;
+        }
+
+      default:
+        src.set_error();
+        return NULL;
+      }
+  }
+}
+
+//////////////////////////////////////
+// fastuidraw::detail::GlyphCacheFile methods
+fastuidraw::detail::GlyphCacheFile::
+GlyphCacheFile(const char *filename):
+  m_filename(filename)
+{
+  m_fd = open(filename, O_WRONLY | O_CREAT | O_APPEND, 0644);
+  m_mapped = FASTUIDRAWnew DataBuffer(filename);
+  read_index();
+}
+
+fastuidraw::detail::GlyphCacheFile::
+~GlyphCacheFile()
+{
+  if(m_fd != -1)
+    {
+      close(m_fd);
+    }
+}
+
+bool
+fastuidraw::detail::GlyphCacheFile::
+valid(void) const
+{
+  return m_fd != -1 || !m_index.empty();
+}
+
+unsigned int
+fastuidraw::detail::GlyphCacheFile::
+number_glyphs(void) const
+{
+  return m_index.size();
+}
+
+void
+fastuidraw::detail::GlyphCacheFile::
+reset_file(void)
+{
+  std::ostringstream tmp_name;
+  int fd;
+
+  m_index.clear();
+  m_mapped.clear();
+  if(m_fd == -1)
+    {
+      return;
+    }
+
+  /* other processes may have the file mapped, so it is never
+     shrunk; instead a file having only the header is written
+     under a temporary name and renamed over the file. The old
+     file stays as it is for those that have it open.
+   */
+  close(m_fd);
+  m_fd = -1;
+
+  tmp_name << m_filename << ".tmp." << getpid();
+  fd = open(tmp_name.str().c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+  if(fd == -1)
+    {
+      return;
+    }
+
+  if(!write_header(fd) || rename(tmp_name.str().c_str(), m_filename.c_str()) != 0)
+    {
+      close(fd);
+      unlink(tmp_name.str().c_str());
+      return;
+    }
+  m_fd = fd;
+}
+
+void
+fastuidraw::detail::GlyphCacheFile::
+read_index(void)
+{
+  const_c_array<uint8_t> data;
+  uint32_t header[number_header_values];
+  uint64_t offset, pending;
+  bool have_pending, resync;
+
+  data = m_mapped->data();
+  if(data.empty())
+    {
+      /* a new file; the header is appended like any record */
+      if(m_fd != -1 && !write_header(m_fd))
+        {
+          close(m_fd);
+          m_fd = -1;
+        }
+      return;
+    }
+
+  if(data.size() < header_size)
+    {
+      reset_file();
+      return;
+    }
+
+  std::memcpy(header, data.c_ptr(), header_size);
+  if(header[0] != uint32_t(cache_file_magic)
+     || header[1] != uint32_t(cache_file_version)
+     || header[2] != uint32_t(cache_file_byte_order)
+     || header[3] != sizeof(GlyphRenderDataCurvePair::entry))
+    {
+      reset_file();
+      return;
+    }
+
+  /* only the headers of the records are read. The file is never
+     shrunk, so the bytes of a record cut short (for example by a
+     process that exited while writing it) stay in the file with
+     the records appended after them. Past such bytes, the scan
+     looks for the magic of a record and takes the first one whose
+     checksum is correct. A record is added to the index only once
+     what follows it is known to be a record, since the sizes in
+     the header of a record cut short can swallow the records after
+     it; such a record fails its checksum and the scan restarts
+     from just after its start.
+   */
+  offset = header_size;
+  pending = 0;
+  have_pending = false;
+  resync = false;
+  while(offset + record_header_size <= data.size())
+    {
+      uint64_t end;
+
+      end = record_end(data, offset, resync);
+      if(end != 0)
+        {
+          if(have_pending)
+            {
+              /* a glyph stored again, for example by another process,
+                 replaces the earlier record of the glyph.
+               */
+              m_index[record_key(data, pending)] = pending;
+            }
+          pending = offset;
+          have_pending = true;
+          resync = false;
+          offset = end;
+        }
+      else
+        {
+          if(have_pending)
+            {
+              if(record_end(data, pending, true) != 0)
+                {
+                  m_index[record_key(data, pending)] = pending;
+                }
+              else
+                {
+                  offset = pending;
+                }
+              have_pending = false;
+            }
+          resync = true;
+          offset = find_record_magic(data, offset + 1);
+        }
+    }
+
+  /* fetch() checks the checksum of the last record */
+  if(have_pending)
+    {
+      m_index[record_key(data, pending)] = pending;
+    }
+}
+
+bool
+fastuidraw::detail::GlyphCacheFile::
+make_key(const FontBase *font, GlyphRender render,
+         uint32_t glyph_code, std::string &out_key) const
+{
+  const_c_array<uint8_t> font_key;
+  uint32_t values[3];
+
+  font_key = font->persistent_key();
+  if(font_key.empty())
+    {
+      return false;
+    }
+
+  values[0] = glyph_code;
+  values[1] = render.m_type;
+  values[2] = render.m_pixel_size;
+
+  out_key.assign(reinterpret_cast<const char*>(font_key.c_ptr()), font_key.size());
+  out_key.append(reinterpret_cast<const char*>(values), sizeof(values));
+  return true;
+}
+
+fastuidraw::GlyphRenderData*
+fastuidraw::detail::GlyphCacheFile::
+fetch(const reference_counted_ptr<const FontBase> &font,
+      GlyphRender render, uint32_t glyph_code,
+      GlyphLayoutData &layout,
+      reference_counted_ptr<const DataBuffer> &path_data)
+{
+  std::string key;
+  std::map<std::string, uint64_t>::iterator iter;
+  const_c_array<uint8_t> data, payload;
+  uint32_t record[number_record_header_values];
+  uint64_t offset, end;
+  GlyphRenderData *return_value;
+
+  if(!make_key(font.get(), render, glyph_code, key))
+    {
+      return NULL;
+    }
+
+  iter = m_index.find(key);
+  if(iter == m_index.end())
+    {
+      return NULL;
+    }
+  offset = iter->second;
+
+  /* the record was written after the file was mapped */
+  if(!m_mapped || offset + record_header_size > m_mapped->data().size())
+    {
+      m_mapped = FASTUIDRAWnew DataBuffer(m_filename.c_str());
+    }
+
+  data = m_mapped->data();
+  if(offset + record_header_size > data.size())
+    {
+      m_index.erase(iter);
+      return NULL;
+    }
+
+  std::memcpy(record, data.c_ptr() + offset, record_header_size);
+  end = offset + record_header_size + uint64_t(record[1]) + uint64_t(record[2]);
+  if(record[0] != uint32_t(record_magic)
+     || end > data.size()
+     || record[1] != key.size()
+     || std::memcmp(data.c_ptr() + offset + record_header_size, key.data(), key.size()) != 0
+     || record[3] != checksum(data.c_ptr() + offset + record_header_size, record[1] + record[2]))
+    {
+      m_index.erase(iter);
+      return NULL;
+    }
+
+  /* BakedDataReader aligns reads relative to the start of
+     its DataBuffer, so the data of the record is read from
+     a copy that starts where the BakedDataWriter did.
+   */
+  payload = data.sub_array(offset + record_header_size + record[1], record[2]);
+  reference_counted_ptr<const DataBuffer> buffer(FASTUIDRAWnew DataBuffer(payload));
+  BakedDataReader src(buffer);
+
+  return_value = NULL;
+  if(read_layout(src, layout))
+    {
+      return_value = read_render_data(src, render.m_type);
+    }
+
+  /* the Path is the last value of the data of the record,
+     read only when load_path() is called as building a
+     Path costs more than reading the rest of the record.
+   */
+  if(!src.error())
+    {
+      uint32_t num_bytes(0);
+
+      src.read_value(num_bytes);
+      path_data = FASTUIDRAWnew DataBuffer(src.read_bytes(num_bytes, sizeof(uint32_t)));
+    }
+
+  if(src.error())
+    {
+      if(return_value)
+        {
+          FASTUIDRAWdelete(return_value);
+        }
+      path_data.clear();
+      m_index.erase(iter);
+      return NULL;
+    }
+
+  layout.m_font = font;
+  layout.m_glyph_code = glyph_code;
+  return return_value;
+}
+
+void
+fastuidraw::detail::GlyphCacheFile::
+store(const FontBase *font,
+      GlyphRender render, uint32_t glyph_code,
+      const GlyphLayoutData &layout, const Path &path,
+      const GlyphRenderData *data)
+{
+  std::string key;
+  BakedDataWriter dst, path_dst;
+  const_c_array<uint8_t> payload;
+  std::vector<uint8_t> record;
+  uint32_t record_header[number_record_header_values];
+  off_t end;
+
+  if(m_fd == -1 || !data || !make_key(font, render, glyph_code, key)
+     || m_index.find(key) != m_index.end())
+    {
+      return;
+    }
+
+  write_layout(dst, layout);
+  if(!write_render_data(dst, render.m_type, data) || !write_path(path_dst, path))
+    {
+      return;
+    }
+  write_texels(dst, path_dst.data());
+  payload = dst.data();
+
+  record.resize(record_header_size + key.size() + payload.size());
+  std::memcpy(&record[record_header_size], key.data(), key.size());
+  if(!payload.empty())
+    {
+      std::memcpy(&record[record_header_size + key.size()], payload.c_ptr(), payload.size());
+    }
+
+  record_header[0] = record_magic;
+  record_header[1] = key.size();
+  record_header[2] = payload.size();
+  record_header[3] = checksum(&record[record_header_size], key.size() + payload.size());
+  std::memcpy(&record[0], record_header, record_header_size);
+
+  /* the file is opened with O_APPEND and the record is written
+     with a single write() when possible, so that processes
+     sharing the file append whole records; on failure nothing
+     more is written, a record cut short is skipped when the
+     file is next opened.
+   */
+  if(!write_all(m_fd, &record[0], record.size()))
+    {
+      close(m_fd);
+      m_fd = -1;
+      return;
+    }
+
+  end = lseek(m_fd, 0, SEEK_CUR);
+  if(end >= static_cast<off_t>(record.size()))
+    {
+      m_index[key] = end - record.size();
+    }
+}
+
+bool
+fastuidraw::detail::GlyphCacheFile::
+load_path(const reference_counted_ptr<const DataBuffer> &path_data, Path &path)
+{
+  BakedDataReader src(path_data);
+
+  if(!read_path(src, path))
+    {
+      path.clear();
+      return false;
+    }
+  return true;
+}
@@ -0,0 +1,165 @@
+/*!
+ * \file glyph_cache_file.hpp
+ * \brief file glyph_cache_file.hpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#pragma once
+
+#include <map>
+#include <string>
+
+#include <fastuidraw/util/util.hpp>
+#include <fastuidraw/util/data_buffer.hpp>
+#include <fastuidraw/path.hpp>
+#include <fastuidraw/text/font.hpp>
+#include <fastuidraw/text/glyph_layout_data.hpp>
+#include <fastuidraw/text/glyph_render_data.hpp>
+
+namespace fastuidraw
+{
+namespace detail
+{
+  /*!\class GlyphCacheFile
+    A GlyphCacheFile stores the GlyphLayoutData, Path and
+    GlyphRenderData of glyphs in a file so that a later
+    process can load the glyph data instead of generating
+    it. A glyph is identified by FontBase::persistent_key()
+    of its font, its glyph code and its GlyphRender; the
+    glyphs of a font whose key is empty are not stored.
+
+    The file is a header followed by records, one per glyph,
+    that are only ever appended to the file. On open, the
+    file is memory mapped and only the headers of the records
+    are read to build an index from key to record; the data
+    of a glyph is read from its record on fetch(). Each
+    record has a checksum that fetch() checks before reading
+    it. The Path of a glyph is returned by fetch() still as
+    bytes to read with load_path(), since building a Path
+    takes longer than reading all the other data of a glyph
+    and few glyphs have their Path used. The file is never
+    shrunk, since other processes may have it mapped: a file
+    whose header does not match the version, byte order or
+    layout of the reader is replaced by renaming a new file
+    over it, and the bytes of a record that is cut short (for
+    example by a process that exited while writing it) are
+    skipped, not removed.
+   */
+  class GlyphCacheFile:noncopyable
+  {
+  public:
+    /*!\fn GlyphCacheFile(const char*)
+      Ctor.
+      \param filename name of the file, created if it does
+                      not exist
+     */
+    explicit
+    GlyphCacheFile(const char *filename);
+
+    ~GlyphCacheFile();
+
+    /*!\fn bool valid
+      Returns true if glyphs can be written to the file
+      or if the file has glyphs to read.
+     */
+    bool
+    valid(void) const;
+
+    /*!\fn unsigned int number_glyphs
+      Returns the number of glyphs of the file.
+     */
+    unsigned int
+    number_glyphs(void) const;
+
+    /*!\fn GlyphRenderData* fetch
+      Read the data of a glyph from the file, returns NULL
+      if the glyph is not in the file or if its record is
+      corrupt, in which case the record is forgotten.
+      \param font font of the glyph
+      \param render GlyphRender of the glyph
+      \param glyph_code glyph code of the glyph
+      \param[out] layout location to which to write the
+                         GlyphLayoutData of the glyph
+      \param[out] path_data location to which to write the
+                            bytes of the Path of the glyph,
+                            see load_path()
+     */
+    GlyphRenderData*
+    fetch(const reference_counted_ptr<const FontBase> &font,
+          GlyphRender render, uint32_t glyph_code,
+          GlyphLayoutData &layout,
+          reference_counted_ptr<const DataBuffer> &path_data);
+
+    /*!\fn bool load_path
+      Read the Path of a glyph from the bytes returned by
+      fetch(), returns false and leaves path empty if the
+      bytes are not a Path.
+      \param path_data bytes of the Path as returned by fetch()
+      \param[out] path location to which to write the Path,
+                       must be empty
+     */
+    static
+    bool
+    load_path(const reference_counted_ptr<const DataBuffer> &path_data, Path &path);
+
+    /*!\fn void store
+      Append the data of a glyph to the file. Does nothing if
+      the key of the font is empty, if the glyph is already
+      in the file or if the Path of the glyph has a contour
+      with an interpolator that is neither flat nor a Bezier
+      curve.
+      \param font font of the glyph
+      \param render GlyphRender of the glyph
+      \param glyph_code glyph code of the glyph
+      \param layout GlyphLayoutData of the glyph
+      \param path Path of the glyph
+      \param data GlyphRenderData of the glyph, must be of the
+                  type given by render.m_type
+     */
+    void
+    store(const FontBase *font,
+          GlyphRender render, uint32_t glyph_code,
+          const GlyphLayoutData &layout, const Path &path,
+          const GlyphRenderData *data);
+
+  private:
+    bool
+    make_key(const FontBase *font, GlyphRender render,
+             uint32_t glyph_code, std::string &out_key) const;
+
+    void
+    read_index(void);
+
+    /* replaces the file with a file having only a header */
+    void
+    reset_file(void);
+
+    std::string m_filename;
+    int m_fd;
+
+    /* mapping of the file, made again when fetching
+       a record written after the file was mapped.
+     */
+    reference_counted_ptr<const DataBuffer> m_mapped;
+
+    /* offset of each record of the file, keyed by
+       the key of the glyph of the record.
+     */
+    std::map<std::string, uint64_t> m_index;
+  };
+
+} //namespace detail
+} //namespace fastuidraw
@@ -6,7 +6,8 @@ d		:= $(dir)
 
 LIBRARY_SOURCES += $(call filelist, static_resource.cpp \
 	fastuidraw_memory.cpp util.cpp math.cpp blend_mode.cpp \
-	reference_count_mutex.cpp reference_count_atomic.cpp)
+	reference_count_mutex.cpp reference_count_atomic.cpp \
+	data_buffer.cpp)
 
 # Begin standard footer
 d		:= $(dirstack_$(sp))
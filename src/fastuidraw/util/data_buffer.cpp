@@ -0,0 +1,347 @@
+/*!
+ * \file data_buffer.cpp
+ * \brief file data_buffer.cpp
+ *
+ * Copyright 2016 by Intel.
+ *
+ * Contact: kevin.rogovin@intel.com
+ *
+ * This Source Code Form is subject to the
+ * terms of the Mozilla Public License, v. 2.0.
+ * If a copy of the MPL was not distributed with
+ * this file, You can obtain one at
+ * http://mozilla.org/MPL/2.0/.
+ *
+ * \author Kevin Rogovin <kevin.rogovin@intel.com>
+ *
+ */
+
+
+#include <vector>
+#include <fstream>
+#include <iterator>
+#include <cstring>
+#include <stdlib.h>
+
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <fastuidraw/util/data_buffer.hpp>
+#include "../private/util_private.hpp"
+
+namespace
+{
+  class DataBufferPrivate
+  {
+  public:
+    DataBufferPrivate(void):
+      m_mapped(NULL),
+      m_mapped_size(0)
+    {}
+
+    ~DataBufferPrivate();
+
+    void
+    load_file(const char *filename);
+
+    void
+    copy_bytes(fastuidraw::const_c_array<uint8_t> bytes);
+
+    /* Storage when the bytes are copied or when the file
+       cannot be memory mapped; storing as uint32_t makes
+       the bytes aligned to at least 4 bytes.
+     */
+    std::vector<uint32_t> m_storage;
+
+    void *m_mapped;
+    size_t m_mapped_size;
+
+    fastuidraw::const_c_array<uint8_t> m_data;
+  };
+
+  class BakedDataWriterPrivate
+  {
+  public:
+    std::vector<uint8_t> m_bytes;
+  };
+
+  class BakedDataReaderPrivate
+  {
+  public:
+    explicit
+    BakedDataReaderPrivate(const fastuidraw::reference_counted_ptr<const fastuidraw::DataBuffer> &buffer):
+      m_buffer(buffer),
+      m_location(0),
+      m_error(!buffer)
+    {
+      if(m_buffer)
+        {
+          m_data = m_buffer->data();
+          /* arrays are returned as pointers into the buffer,
+             whose elements are made of 4-byte values.
+           */
+          m_error = (reinterpret_cast<uintptr_t>(m_data.c_ptr()) % sizeof(uint32_t)) != 0;
+        }
+    }
+
+    fastuidraw::reference_counted_ptr<const fastuidraw::DataBuffer> m_buffer;
+    fastuidraw::const_c_array<uint8_t> m_data;
+    unsigned int m_location;
+    bool m_error;
+  };
+}
+
+///////////////////////////////////////
+// DataBufferPrivate methods
+DataBufferPrivate::
+~DataBufferPrivate()
+{
+#ifndef _WIN32
+  if(m_mapped != NULL)
+    {
+      munmap(m_mapped, m_mapped_size);
+    }
+#endif
+}
+
+void
+DataBufferPrivate::
+copy_bytes(fastuidraw::const_c_array<uint8_t> bytes)
+{
+  m_storage.resize((bytes.size() + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+  if(!bytes.empty())
+    {
+      std::memcpy(&m_storage[0], bytes.c_ptr(), bytes.size());
+      m_data = fastuidraw::const_c_array<uint8_t>(reinterpret_cast<const uint8_t*>(&m_storage[0]),
+                                                 bytes.size());
+    }
+}
+
+void
+DataBufferPrivate::
+load_file(const char *filename)
+{
+#ifndef _WIN32
+  int fd;
+
+  fd = open(filename, O_RDONLY);
+  if(fd != -1)
+    {
+      struct stat st;
+
+      if(fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+          void *p;
+
+          p = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+          if(p != MAP_FAILED)
+            {
+              m_mapped = p;
+              m_mapped_size = st.st_size;
+              m_data = fastuidraw::const_c_array<uint8_t>(static_cast<const uint8_t*>(p), st.st_size);
+            }
+        }
+      close(fd);
+    }
+
+  if(m_mapped != NULL)
+    {
+      return;
+    }
+#endif
+
+  std::ifstream file(filename, std::ios::binary);
+  if(file)
+    {
+      std::vector<uint8_t> bytes;
+
+      bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+      copy_bytes(fastuidraw::make_c_array(bytes));
+    }
+}
+
+/////////////////////////////////////
+// fastuidraw::DataBuffer methods
+fastuidraw::DataBuffer::
+DataBuffer(const char *filename)
+{
+  DataBufferPrivate *d;
+  d = FASTUIDRAWnew DataBufferPrivate();
+  d->load_file(filename);
+  m_d = d;
+}
+
+fastuidraw::DataBuffer::
+DataBuffer(const_c_array<uint8_t> bytes)
+{
+  DataBufferPrivate *d;
+  d = FASTUIDRAWnew DataBufferPrivate();
+  d->copy_bytes(bytes);
+  m_d = d;
+}
+
+fastuidraw::DataBuffer::
+~DataBuffer()
+{
+  DataBufferPrivate *d;
+  d = reinterpret_cast<DataBufferPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+fastuidraw::const_c_array<uint8_t>
+fastuidraw::DataBuffer::
+data(void) const
+{
+  DataBufferPrivate *d;
+  d = reinterpret_cast<DataBufferPrivate*>(m_d);
+  return d->m_data;
+}
+
+///////////////////////////////////////////
+// fastuidraw::BakedDataWriter methods
+fastuidraw::BakedDataWriter::
+BakedDataWriter(void)
+{
+  m_d = FASTUIDRAWnew BakedDataWriterPrivate();
+}
+
+fastuidraw::BakedDataWriter::
+~BakedDataWriter()
+{
+  BakedDataWriterPrivate *d;
+  d = reinterpret_cast<BakedDataWriterPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+void
+fastuidraw::BakedDataWriter::
+write_bytes(const void *bytes, unsigned int num_bytes, unsigned int alignment)
+{
+  BakedDataWriterPrivate *d;
+  unsigned int start;
+
+  d = reinterpret_cast<BakedDataWriterPrivate*>(m_d);
+  assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+  start = (d->m_bytes.size() + alignment - 1) & ~(alignment - 1);
+  d->m_bytes.resize(start + num_bytes, 0);
+  if(num_bytes > 0)
+    {
+      std::memcpy(&d->m_bytes[start], bytes, num_bytes);
+    }
+}
+
+fastuidraw::const_c_array<uint8_t>
+fastuidraw::BakedDataWriter::
+data(void) const
+{
+  BakedDataWriterPrivate *d;
+  d = reinterpret_cast<BakedDataWriterPrivate*>(m_d);
+  return make_c_array(d->m_bytes);
+}
+
+bool
+fastuidraw::BakedDataWriter::
+save(const char *filename) const
+{
+  BakedDataWriterPrivate *d;
+  d = reinterpret_cast<BakedDataWriterPrivate*>(m_d);
+
+  std::ofstream file(filename, std::ios::binary);
+  if(!file)
+    {
+      return false;
+    }
+
+  if(!d->m_bytes.empty())
+    {
+      file.write(reinterpret_cast<const char*>(&d->m_bytes[0]), d->m_bytes.size());
+    }
+  return file.good();
+}
+
+///////////////////////////////////////////
+// fastuidraw::BakedDataReader methods
+fastuidraw::BakedDataReader::
+BakedDataReader(const reference_counted_ptr<const DataBuffer> &buffer)
+{
+  m_d = FASTUIDRAWnew BakedDataReaderPrivate(buffer);
+}
+
+fastuidraw::BakedDataReader::
+~BakedDataReader()
+{
+  BakedDataReaderPrivate *d;
+  d = reinterpret_cast<BakedDataReaderPrivate*>(m_d);
+  FASTUIDRAWdelete(d);
+  m_d = NULL;
+}
+
+fastuidraw::const_c_array<uint8_t>
+fastuidraw::BakedDataReader::
+read_bytes(unsigned int num_bytes, unsigned int alignment)
+{
+  BakedDataReaderPrivate *d;
+  unsigned int start;
+
+  d = reinterpret_cast<BakedDataReaderPrivate*>(m_d);
+  assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+
+  if(d->m_error)
+    {
+      return const_c_array<uint8_t>();
+    }
+
+  start = (d->m_location + alignment - 1) & ~(alignment - 1);
+  if(start > d->m_data.size() || num_bytes > d->m_data.size() - start)
+    {
+      d->m_error = true;
+      return const_c_array<uint8_t>();
+    }
+
+  d->m_location = start + num_bytes;
+  return d->m_data.sub_array(start, num_bytes);
+}
+
+unsigned int
+fastuidraw::BakedDataReader::
+remaining(void) const
+{
+  BakedDataReaderPrivate *d;
+  d = reinterpret_cast<BakedDataReaderPrivate*>(m_d);
+  return (d->m_error) ? 0 : d->m_data.size() - d->m_location;
+}
+
+bool
+fastuidraw::BakedDataReader::
+error(void) const
+{
+  BakedDataReaderPrivate *d;
+  d = reinterpret_cast<BakedDataReaderPrivate*>(m_d);
+  return d->m_error;
+}
+
+void
+fastuidraw::BakedDataReader::
+set_error(void)
+{
+  BakedDataReaderPrivate *d;
+  d = reinterpret_cast<BakedDataReaderPrivate*>(m_d);
+  d->m_error = true;
+}
+
+const fastuidraw::reference_counted_ptr<const fastuidraw::DataBuffer>&
+fastuidraw::BakedDataReader::
+buffer(void) const
+{
+  BakedDataReaderPrivate *d;
+  d = reinterpret_cast<BakedDataReaderPrivate*>(m_d);
+  return d->m_buffer;
+}
@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+102,108,111,97,116,10,102,97,115,116,117,105,100,114,97,119,95,97,110,105,115,111,116,114,111,112,105,99,95,99,111,118,101,114,97,103,101,40,102,108,111,97,116,32,100,44,32,102,108,111,97,116,32,100,120,44,32,102,108,111,97,116,32,100,121,41,10,123,10,32,32,102,108,111,97,116,32,109,97,103,95,115,113,59,10,32,32,109,97,103,95,115,113,32,61,32,40,100,120,32,42,32,100,120,32,43,32,100,121,32,42,32,100,121,41,59,10,32,32,114,101,116,117,114,110,32,99,108,97,109,112,40,48,46,53,32,43,32,100,32,42,32,105,110,118,101,114,115,101,115,113,114,116,40,109,97,103,95,115,113,41,44,32,48,46,48,44,32,49,46,48,41,59,10,125,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_anisotropic.frag.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+
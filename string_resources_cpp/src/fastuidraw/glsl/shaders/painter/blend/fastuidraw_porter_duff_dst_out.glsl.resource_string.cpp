@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+118,111,105,100,10,102,97,115,116,117,105,100,114,97,119,95,103,108,95,99,111,109,112,117,116,101,95,98,108,101,110,100,95,102,97,99,116,111,114,115,40,105,110,32,117,105,110,116,32,115,117,98,95,115,104,97,100,101,114,44,32,105,110,32,117,105,110,116,32,98,108,101,110,100,95,115,104,97,100,101,114,95,100,97,116,97,95,108,111,99,97,116,105,111,110,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,118,101,99,52,32,105,110,95,115,114,99,44,32,111,117,116,32,118,101,99,52,32,111,117,116,95,115,114,99,48,44,32,111,117,116,32,118,101,99,52,32,111,117,116,95,115,114,99,49,41,10,123,10,32,32,111,117,116,95,115,114,99,48,32,61,32,118,101,99,52,40,48,46,48,41,59,10,32,32,111,117,116,95,115,114,99,49,32,61,32,118,101,99,52,40,49,46,48,32,45,32,105,110,95,115,114,99,46,97,41,59,10,125,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_porter_duff_dst_out.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+
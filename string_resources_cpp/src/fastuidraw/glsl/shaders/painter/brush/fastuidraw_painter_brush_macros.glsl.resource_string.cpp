@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,98,114,117,115,104,95,115,104,97,100,101,114,95,104,97,115,95,105,109,97,103,101,40,115,104,97,100,101,114,41,32,40,115,104,97,100,101,114,32,38,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,104,97,100,101,114,95,105,109,97,103,101,95,109,97,115,107,41,41,32,33,61,32,117,105,110,116,40,48,41,10,35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,98,114,117,115,104,95,115,104,97,100,101,114,95,104,97,115,95,114,97,100,105,97,108,95,103,114,97,100,105,101,110,116,40,115,104,97,100,101,114,41,32,40,115,104,97,100,101,114,32,38,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,104,97,100,101,114,95,114,97,100,105,97,108,95,103,114,97,100,105,101,110,116,95,109,97,115,107,41,41,32,33,61,32,117,105,110,116,40,48,41,10,35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,98,114,117,115,104,95,115,104,97,100,101,114,95,104,97,115,95,108,105,110,101,97,114,95,103,114,97,100,105,101,110,116,40,115,104,97,100,101,114,41,32,40,115,104,97,100,101,114,32,38,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,104,97,100,101,114,95,108,105,110,101,97,114,95,103,114,97,100,105,101,110,116,95,109,97,115,107,41,41,32,33,61,32,117,105,110,116,40,48,41,10,35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,98,114,117,115,104,95,115,104,97,100,101,114,95,104,97,115,95,103,114,97,100,105,101,110,116,95,114,101,112,101,97,116,40,115,104,97,100,101,114,41,32,40,115,104,97,100,101,114,32,38,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,104,97,100,101,114,95,103,114,97,100,105,101,110,116,95,114,101,112,101,97,116,95,109,97,115,107,41,41,32,33,61,32,117,105,110,116,40,48,41,10,35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,98,114,117,115,104,95,115,104,97,100,101,114,95,104,97,115,95,114,101,112,101,97,116,95,119,105,110,100,111,119,40,115,104,97,100,101,114,41,32,40,115,104,97,100,101,114,32,38,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,104,97,100,101,114,95,114,101,112,101,97,116,95,119,105,110,100,111,119,95,109,97,115,107,41,41,32,33,61,32,117,105,110,116,40,48,41,10,35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,98,114,117,115,104,95,115,104,97,100,101,114,95,104,97,115,95,116,114,97,110,115,102,111,114,109,97,116,105,111,110,95,109,97,116,114,105,120,40,115,104,97,100,101,114,41,32,40,115,104,97,100,101,114,32,38,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,104,97,100,101,114,95,116,114,97,110,115,102,111,114,109,97,116,105,111,110,95,109,97,116,114,105,120,95,109,97,115,107,41,41,32,33,61,32,117,105,110,116,40,48,41,10,35,100,101,102,105,110,101,32,102,97,115,116,117,105,100,114,97,119,95,98,114,117,115,104,95,115,104,97,100,101,114,95,104,97,115,95,116,114,97,110,115,102,111,114,109,97,116,105,111,110,95,116,114,97,110,115,108,97,116,105,111,110,40,115,104,97,100,101,114,41,32,40,115,104,97,100,101,114,32,38,32,117,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,115,104,97,100,101,114,95,116,114,97,110,115,102,111,114,109,97,116,105,111,110,95,116,114,97,110,115,108,97,116,105,111,110,95,109,97,115,107,41,41,32,33,61,32,117,105,110,116,40,48,41,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_painter_brush_macros.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+
@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+102,108,111,97,116,10,102,97,115,116,117,105,100,114,97,119,95,112,97,105,110,116,101,114,95,108,111,99,97,108,95,100,105,115,116,97,110,99,101,95,102,114,111,109,95,112,105,120,101,108,95,100,105,115,116,97,110,99,101,40,105,110,32,102,108,111,97,116,32,112,112,105,120,101,108,95,100,105,115,116,97,110,99,101,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,118,101,99,51,32,112,99,108,105,112,95,112,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,118,101,99,51,32,112,99,108,105,112,95,111,102,102,115,101,116,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,98,111,111,108,32,97,100,106,117,115,116,95,119,105,100,116,104,95,102,114,111,109,95,111,114,105,101,110,116,97,116,105,111,110,41,10,123,10,32,32,118,101,99,50,32,122,101,116,97,59,10,32,32,118,101,99,51,32,99,108,105,112,95,112,44,32,99,108,105,112,95,111,102,102,115,101,116,59,10,32,32,102,108,111,97,116,32,114,101,116,117,114,110,95,118,97,108,117,101,44,32,108,101,110,103,116,104,95,122,101,116,97,44,32,112,105,120,101,108,95,100,105,115,116,97,110,99,101,59,10,10,32,32,47,42,32,99,111,110,118,101,114,116,32,99,108,105,112,45,99,111,111,114,100,105,110,97,116,101,115,32,115,111,32,116,104,97,116,32,97,102,116,101,114,32,100,105,118,105,100,105,110,103,32,98,121,32,46,122,44,10,32,32,32,32,32,116,104,101,32,99,111,111,114,100,105,110,97,116,101,115,32,97,114,101,32,105,110,32,45,112,105,120,101,108,45,32,117,110,105,116,115,46,10,32,32,32,42,47,10,32,32,99,108,105,112,95,112,32,61,32,118,101,99,51,40,48,46,53,32,42,32,102,97,115,116,117,105,100,114,97,119,95,118,105,101,119,112,111,114,116,95,112,105,120,101,108,115,46,120,121,44,32,49,46,48,41,32,42,32,112,99,108,105,112,95,112,59,10,32,32,99,108,105,112,95,111,102,102,115,101,116,32,61,32,118,101,99,51,40,48,46,53,32,42,32,102,97,115,116,117,105,100,114,97,119,95,118,105,101,119,112,111,114,116,95,112,105,120,101,108,115,46,120,121,44,32,49,46,48,41,32,42,32,112,99,108,105,112,95,111,102,102,115,101,116,59,10,32,32,112,105,120,101,108,95,100,105,115,116,97,110,99,101,32,61,32,112,112,105,120,101,108,95,100,105,115,116,97,110,99,101,59,10,10,32,32,47,42,32,70,114,111,109,32,119,104,101,114,101,32,116,104,105,115,32,102,111,114,109,117,108,97,32,99,111,109,101,115,46,32,79,117,114,32,99,104,97,108,108,101,110,103,101,32,105,115,32,116,111,32,103,105,118,101,32,97,32,115,116,114,111,107,105,110,103,32,119,105,100,116,104,10,32,32,32,32,32,105,110,32,108,111,99,97,108,32,40,112,114,101,45,112,114,111,106,101,99,116,105,111,110,41,32,99,111,111,114,100,105,97,110,116,101,115,32,102,114,111,109,32,97,32,115,116,114,111,107,105,110,103,32,119,105,100,116,104,32,111,102,32,112,105,120,101,108,115,46,10,32,32,32,32,32,87,101,32,104,97,118,101,32,97,32,112,111,105,110,116,32,112,32,40,103,105,118,101,110,32,98,121,32,112,111,115,105,116,105,111,110,41,32,97,110,100,32,97,32,100,105,114,101,99,116,105,111,110,32,118,32,40,103,105,118,101,110,32,98,121,32,111,102,102,115,101,116,41,10,32,32,32,32,32,97,110,100,32,119,101,32,119,105,115,104,32,116,111,32,102,105,110,100,32,97,110,32,76,32,115,111,32,116,104,97,116,32,97,102,116,101,114,32,112,114,111,106,101,99,116,105,111,110,32,112,32,43,32,76,42,118,32,105,115,32,87,32,112,105,120,101,108,115,10,32,32,32,32,32,102,114,111,109,32,112,46,32,78,111,119,32,102,111,114,32,115,111,109,101,32,109,97,116,104,46,10,10,32,32,32,32,32,76,101,116,32,109,62,48,44,32,97,110,100,32,108,101,116,32,113,40,109,41,32,61,32,97,32,43,32,109,42,118,46,32,79,110,99,101,32,109,62,48,32,105,115,32,108,97,114,103,101,32,101,110,111,117,103,104,44,32,119,101,32,99,97,110,10,32,32,32,32,32,112,114,111,106,101,99,116,32,113,40,109,41,32,97,110,100,32,112,32,116,111,32,116,104,101,32,115,99,114,101,101,110,44,32,102,105,110,100,32,116,104,101,32,115,99,114,101,101,110,32,115,112,97,99,101,32,98,97,114,121,99,101,110,116,114,105,99,10,32,32,32,32,32,87,32,112,105,120,101,108,115,32,102,114,111,109,32,112,46,10,10,32,32,32,32,32,76,101,116,32,80,32,61,32,112,114,111,106,101,99,116,105,111,110,40,84,40,112,44,49,41,41,10,32,32,32,32,32,76,101,116,32,81,40,109,41,32,61,32,112,114,111,106,101,99,116,105,111,110,40,84,40,113,40,109,41,44,49,41,41,10,10,32,32,32,32,32,119,104,101,114,101,10,10,32,32,32,32,32,84,32,61,32,75,32,42,32,102,97,115,116,117,105,100,114,97,119,95,105,116,101,109,95,109,97,116,114,105,120,10,32,32,32,32,32,75,32,61,32,40,48,46,53,32,42,32,102,97,115,116,117,105,100,114,97,119,95,118,105,101,119,112,111,114,116,95,112,105,120,101,108,115,46,120,44,32,48,46,53,32,42,32,102,97,115,116,117,105,100,114,97,119,95,118,105,101,119,112,111,114,116,95,112,105,120,101,108,115,46,121,44,32,49,41,10,32,32,32,32,32,112,114,111,106,101,99,116,105,111,110,40,120,44,121,44,122,41,32,61,32,40,120,47,122,44,32,121,47,122,41,10,10,32,32,32,32,32,76,101,116,32,82,32,61,32,80,32,43,32,87,32,42,32,68,69,76,84,65,32,119,104,101,114,101,32,68,69,76,84,65,32,61,32,40,81,40,109,41,32,45,32,80,41,47,124,124,81,40,109,41,45,80,124,124,10,32,32,32,32,32,76,101,116,32,115,32,61,32,87,32,47,32,124,124,81,40,109,41,32,45,32,80,124,124,32,103,105,118,101,115,32,116,104,97,116,32,80,32,43,32,115,32,42,32,40,81,40,109,41,32,45,32,80,41,32,61,32,82,46,10,32,32,32,32,32,76,101,116,32,116,32,61,32,40,32,115,47,81,40,109,41,95,122,32,41,32,47,32,40,32,40,49,45,115,41,47,80,95,122,32,43,32,115,47,81,40,109,41,95,122,41,46,32,84,104,101,110,10,32,32,32,32,32,112,114,111,106,101,99,116,105,111,110,40,32,84,40,112,44,49,41,32,43,32,116,32,42,32,40,84,40,113,40,109,41,44,49,41,32,45,32,84,40,112,44,49,41,41,32,41,32,61,32,82,10,10,32,32,32,32,32,116,32,42,32,40,84,40,113,40,109,41,44,49,41,32,45,32,84,40,112,44,49,41,41,32,61,32,116,32,42,32,40,84,40,112,44,49,41,32,43,32,109,42,84,40,118,44,48,41,32,45,32,84,40,112,44,49,41,41,32,61,32,116,32,42,32,109,32,42,32,84,40,118,44,32,48,41,10,10,32,32,32,32,32,84,104,117,115,32,116,104,101,32,99,111,101,102,102,105,99,105,101,110,116,32,119,101,32,119,97,110,116,32,105,115,32,103,105,118,101,110,32,98,121,32,40,116,42,109,41,46,10,10,32,32,32,32,32,116,32,42,32,109,32,61,32,40,32,109,32,42,32,115,32,42,32,80,95,122,41,32,47,32,40,32,40,49,45,115,41,81,40,109,41,95,122,32,43,32,115,32,42,32,80,95,122,41,10,10,32,32,32,32,32,119,104,105,99,104,32,115,105,109,112,108,105,102,105,101,115,32,116,111,32,40,97,102,116,101,114,32,108,111,116,115,32,111,102,32,97,108,103,101,98,114,97,41,32,116,111,10,10,32,32,32,32,32,116,32,42,32,109,32,61,32,40,87,32,42,32,80,95,122,32,42,32,80,95,122,41,32,47,32,40,45,32,87,32,42,32,80,95,122,32,42,32,124,84,40,118,44,48,41,95,122,124,32,43,32,124,124,122,101,116,97,124,124,41,10,10,32,32,32,32,32,119,104,101,114,101,32,122,101,116,97,32,61,32,40,84,40,118,44,48,41,95,120,32,42,32,84,40,112,44,49,41,95,122,32,45,32,84,40,118,44,48,41,95,122,32,42,32,84,40,112,44,49,41,95,120,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,84,40,118,44,48,41,95,121,32,42,32,84,40,112,44,49,41,95,122,32,45,32,84,40,118,44,48,41,95,122,32,42,32,84,40,112,44,49,41,95,121,41,10,32,32,42,47,10,32,32,122,101,116,97,32,61,32,118,101,99,50,40,99,108,105,112,95,111,102,102,115,101,116,46,120,32,42,32,99,108,105,112,95,112,46,122,32,45,32,99,108,105,112,95,111,102,102,115,101,116,46,122,32,42,32,99,108,105,112,95,112,46,120,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,99,108,105,112,95,111,102,102,115,101,116,46,121,32,42,32,99,108,105,112,95,112,46,122,32,45,32,99,108,105,112,95,111,102,102,115,101,116,46,122,32,42,32,99,108,105,112,95,112,46,121,41,59,10,32,32,108,101,110,103,116,104,95,122,101,116,97,32,61,32,108,101,110,103,116,104,40,122,101,116,97,41,59,10,10,32,32,105,102,40,97,100,106,117,115,116,95,119,105,100,116,104,95,102,114,111,109,95,111,114,105,101,110,116,97,116,105,111,110,41,10,32,32,32,32,123,10,32,32,32,32,32,32,47,42,32,84,104,101,32,100,105,114,101,99,116,105,111,110,32,105,110,32,115,99,114,101,101,110,32,99,111,111,114,100,105,110,97,116,101,115,32,105,115,32,103,105,118,101,110,32,98,121,32,40,117,112,32,116,111,32,109,97,103,110,105,116,117,100,101,41,32,122,101,116,97,44,10,32,32,32,32,32,32,32,32,32,116,104,101,32,109,117,108,116,105,112,108,121,32,98,121,32,112,112,105,120,101,108,95,100,105,115,116,97,110,99,101,32,42,32,109,97,120,40,97,98,115,40,122,101,116,97,46,120,41,44,32,97,98,115,40,122,101,116,97,46,121,41,41,32,47,32,108,101,110,103,116,104,95,122,101,116,97,10,32,32,32,32,32,32,32,32,32,109,97,107,101,115,32,115,111,32,116,104,97,116,32,110,111,110,45,118,101,114,116,105,99,97,108,32,97,110,100,32,110,111,110,45,104,111,114,105,122,111,110,116,97,108,32,108,105,110,101,115,32,104,97,118,101,32,116,104,97,116,32,116,104,101,105,114,10,32,32,32,32,32,32,32,32,32,116,104,105,99,107,110,101,115,115,32,105,110,32,97,32,100,105,114,101,99,116,105,111,110,32,105,115,32,116,104,101,32,112,105,120,101,108,32,100,105,115,116,97,110,99,101,32,114,101,113,117,101,115,116,101,100,10,32,32,32,32,32,32,42,47,10,32,32,32,32,32,32,112,105,120,101,108,95,100,105,115,116,97,110,99,101,32,42,61,32,109,97,120,40,97,98,115,40,122,101,116,97,46,120,41,44,32,97,98,115,40,122,101,116,97,46,121,41,41,32,47,32,108,101,110,103,116,104,95,122,101,116,97,59,10,32,32,32,32,125,10,10,32,32,114,101,116,117,114,110,95,118,97,108,117,101,32,61,32,112,105,120,101,108,95,100,105,115,116,97,110,99,101,32,42,32,99,108,105,112,95,112,46,122,32,42,32,99,108,105,112,95,112,46,122,59,10,32,32,114,101,116,117,114,110,95,118,97,108,117,101,32,47,61,32,40,45,112,105,120,101,108,95,100,105,115,116,97,110,99,101,32,42,32,97,98,115,40,99,108,105,112,95,112,46,122,32,42,32,99,108,105,112,95,111,102,102,115,101,116,46,122,41,32,43,32,108,101,110,103,116,104,95,122,101,116,97,41,59,10,10,32,32,114,101,116,117,114,110,32,114,101,116,117,114,110,95,118,97,108,117,101,59,10,125,10,10,102,108,111,97,116,10,102,97,115,116,117,105,100,114,97,119,95,112,97,105,110,116,101,114,95,108,111,99,97,108,95,100,105,115,116,97,110,99,101,95,102,114,111,109,95,112,105,120,101,108,95,100,105,115,116,97,110,99,101,40,105,110,32,102,108,111,97,116,32,112,112,105,120,101,108,95,100,105,115,116,97,110,99,101,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,118,101,99,51,32,112,99,108,105,112,95,112,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,118,101,99,51,32,112,99,108,105,112,95,111,102,102,115,101,116,41,10,123,10,32,32,114,101,116,117,114,110,32,102,97,115,116,117,105,100,114,97,119,95,112,97,105,110,116,101,114,95,108,111,99,97,108,95,100,105,115,116,97,110,99,101,95,102,114,111,109,95,112,105,120,101,108,95,100,105,115,116,97,110,99,101,40,112,112,105,120,101,108,95,100,105,115,116,97,110,99,101,44,32,112,99,108,105,112,95,112,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,112,99,108,105,112,95,111,102,102,115,101,116,44,32,102,97,108,115,101,41,59,10,125,10,10,118,101,99,50,10,102,97,115,116,117,105,100,114,97,119,95,117,110,112,97,99,107,95,117,110,105,116,95,118,101,99,116,111,114,40,102,108,111,97,116,32,120,44,32,117,105,110,116,32,98,41,10,123,10,32,32,118,101,99,50,32,114,101,116,117,114,110,95,118,97,108,117,101,59,10,32,32,114,101,116,117,114,110,95,118,97,108,117,101,46,120,32,61,32,120,59,10,32,32,114,101,116,117,114,110,95,118,97,108,117,101,46,121,32,61,32,115,113,114,116,40,109,97,120,40,48,46,48,44,32,49,46,48,32,45,32,120,32,42,32,120,41,41,59,10,32,32,105,102,40,98,32,33,61,32,48,117,41,10,32,32,32,32,123,10,32,32,32,32,32,32,114,101,116,117,114,110,95,118,97,108,117,101,46,121,32,61,32,45,114,101,116,117,114,110,95,118,97,108,117,101,46,121,59,10,32,32,32,32,125,10,32,32,114,101,116,117,114,110,32,114,101,116,117,114,110,95,118,97,108,117,101,59,10,125,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_painter_compute_local_distance_from_pixel_distance.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+
@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+118,101,99,52,10,102,97,115,116,117,105,100,114,97,119,95,103,108,95,102,114,97,103,95,109,97,105,110,40,105,110,32,117,105,110,116,32,115,117,98,95,115,104,97,100,101,114,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,117,105,110,116,32,115,104,97,100,101,114,95,100,97,116,97,95,111,102,102,115,101,116,41,10,123,10,32,32,114,101,116,117,114,110,32,118,101,99,52,40,49,46,48,44,32,49,46,48,44,32,49,46,48,44,32,49,46,48,41,59,10,125,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_painter_fill.frag.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+
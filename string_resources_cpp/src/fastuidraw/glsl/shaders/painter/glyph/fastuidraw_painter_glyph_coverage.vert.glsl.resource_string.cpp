@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+118,101,99,52,10,102,97,115,116,117,105,100,114,97,119,95,103,108,95,118,101,114,116,95,109,97,105,110,40,105,110,32,117,105,110,116,32,115,117,98,95,115,104,97,100,101,114,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,117,118,101,99,52,32,117,112,114,105,109,97,114,121,95,97,116,116,114,105,98,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,117,118,101,99,52,32,117,115,101,99,111,110,100,97,114,121,95,97,116,116,114,105,98,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,117,118,101,99,52,32,117,105,110,116,95,97,116,116,114,105,98,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,117,105,110,116,32,115,104,97,100,101,114,95,100,97,116,97,95,111,102,102,115,101,116,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,111,117,116,32,117,105,110,116,32,122,95,97,100,100,41,10,123,10,32,32,118,101,99,52,32,112,114,105,109,97,114,121,95,97,116,116,114,105,98,44,32,115,101,99,111,110,100,97,114,121,95,97,116,116,114,105,98,59,10,10,32,32,112,114,105,109,97,114,121,95,97,116,116,114,105,98,32,61,32,117,105,110,116,66,105,116,115,84,111,70,108,111,97,116,40,117,112,114,105,109,97,114,121,95,97,116,116,114,105,98,41,59,10,32,32,115,101,99,111,110,100,97,114,121,95,97,116,116,114,105,98,32,61,32,117,105,110,116,66,105,116,115,84,111,70,108,111,97,116,40,117,115,101,99,111,110,100,97,114,121,95,97,116,116,114,105,98,41,59,10,32,32,47,42,10,32,32,32,32,118,97,114,121,105,110,103,115,58,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,120,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,121,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,120,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,121,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,108,97,121,101,114,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,108,97,121,101,114,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,103,101,111,109,101,116,114,121,95,100,97,116,97,95,108,111,99,97,116,105,111,110,10,10,32,32,112,97,99,107,105,110,103,58,10,32,32,32,32,32,45,32,112,114,105,109,97,114,121,95,97,116,116,114,105,98,46,120,121,32,45,62,32,120,121,45,116,101,120,101,108,32,108,111,99,97,116,105,111,110,32,105,110,32,112,114,105,109,97,114,121,32,97,116,108,97,115,10,32,32,32,32,32,45,32,112,114,105,109,97,114,121,95,97,116,116,114,105,98,46,122,119,32,32,45,62,32,120,121,45,116,101,120,101,108,32,108,111,99,97,116,105,111,110,32,105,110,32,115,101,99,111,110,100,97,114,121,32,97,116,108,97,115,10,32,32,32,32,32,45,32,115,101,99,111,110,100,97,114,121,95,97,116,116,114,105,98,46,120,121,32,45,62,32,112,111,115,105,116,105,111,110,32,105,110,32,105,116,101,109,32,99,111,111,114,100,105,110,97,116,101,115,10,32,32,32,32,32,45,32,115,101,99,111,110,100,97,114,121,95,97,116,116,114,105,98,46,122,119,32,45,62,32,115,105,122,101,32,111,102,32,103,108,121,112,104,32,105,110,32,112,114,105,109,97,114,121,32,97,116,108,97,115,10,32,32,32,32,32,45,32,117,105,110,116,95,97,116,116,114,105,98,46,120,32,45,62,32,48,10,32,32,32,32,32,45,32,117,105,110,116,95,97,116,116,114,105,98,46,121,32,45,62,32,103,108,121,112,104,32,111,102,102,115,101,116,10,32,32,32,32,32,45,32,117,105,110,116,95,97,116,116,114,105,98,46,122,32,45,62,32,108,97,121,101,114,32,105,110,32,112,114,105,109,97,114,121,32,97,116,108,97,115,10,32,32,32,32,32,45,32,117,105,110,116,95,97,116,116,114,105,98,46,119,32,45,62,32,108,97,121,101,114,32,105,110,32,115,101,99,111,110,100,97,114,121,32,97,116,108,97,115,10,32,32,42,47,10,32,32,35,105,102,110,100,101,102,32,70,65,83,84,85,73,68,82,65,87,95,80,65,73,78,84,69,82,95,69,77,85,76,65,84,69,95,71,76,89,80,72,95,84,69,88,69,76,95,83,84,79,82,69,95,70,76,79,65,84,10,32,32,32,32,123,10,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,120,32,61,32,112,114,105,109,97,114,121,95,97,116,116,114,105,98,46,120,32,42,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,84,101,120,101,108,83,116,111,114,101,95,115,105,122,101,95,114,101,99,105,112,114,111,99,97,108,95,120,59,10,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,121,32,61,32,112,114,105,109,97,114,121,95,97,116,116,114,105,98,46,121,32,42,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,84,101,120,101,108,83,116,111,114,101,95,115,105,122,101,95,114,101,99,105,112,114,111,99,97,108,95,121,59,10,32,32,32,32,125,10,32,32,35,101,108,115,101,10,32,32,32,32,123,10,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,120,32,61,32,112,114,105,109,97,114,121,95,97,116,116,114,105,98,46,120,59,10,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,121,32,61,32,112,114,105,109,97,114,121,95,97,116,116,114,105,98,46,121,59,10,32,32,32,32,125,10,32,32,35,101,110,100,105,102,10,10,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,108,97,121,101,114,32,61,32,117,105,110,116,95,97,116,116,114,105,98,46,122,59,10,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,108,97,121,101,114,32,61,32,117,105,110,116,95,97,116,116,114,105,98,46,119,59,10,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,120,32,61,32,112,114,105,109,97,114,121,95,97,116,116,114,105,98,46,120,59,10,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,121,32,61,32,112,114,105,109,97,114,121,95,97,116,116,114,105,98,46,121,59,10,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,103,101,111,109,101,116,114,121,95,100,97,116,97,95,108,111,99,97,116,105,111,110,32,61,32,117,105,110,116,95,97,116,116,114,105,98,46,121,59,10,32,32,122,95,97,100,100,32,61,32,48,117,59,10,32,32,114,101,116,117,114,110,32,115,101,99,111,110,100,97,114,121,95,97,116,116,114,105,98,46,120,121,120,121,59,10,125,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_painter_glyph_coverage.vert.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+
@@ -0,0 +1,11 @@
+#include <fastuidraw/util/static_resource.hpp>
+
+namespace { 
+	const uint8_t values[]={ 
+35,105,102,100,101,102,32,70,65,83,84,85,73,68,82,65,87,95,80,65,73,78,84,69,82,95,69,77,85,76,65,84,69,95,71,76,89,80,72,95,84,69,88,69,76,95,83,84,79,82,69,95,70,76,79,65,84,10,102,108,111,97,116,10,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,109,115,100,102,95,97,110,105,115,111,116,114,111,112,105,99,95,102,101,116,99,104,95,99,104,97,110,110,101,108,40,105,110,32,118,101,99,50,32,99,111,111,114,100,44,32,105,110,32,105,110,116,32,108,97,121,101,114,41,10,123,10,32,32,105,118,101,99,50,32,99,111,111,114,100,48,48,44,32,99,111,111,114,100,48,49,44,32,99,111,111,114,100,49,48,44,32,99,111,111,114,100,49,49,59,10,32,32,118,101,99,50,32,109,105,120,101,114,59,10,32,32,117,105,110,116,32,118,48,48,44,32,118,48,49,44,32,118,49,48,44,32,118,49,49,59,10,32,32,102,108,111,97,116,32,102,48,44,32,102,49,59,10,10,32,32,99,111,111,114,100,48,48,32,61,32,105,118,101,99,50,40,99,111,111,114,100,41,59,10,32,32,99,111,111,114,100,49,48,32,61,32,99,111,111,114,100,48,48,32,43,32,105,118,101,99,50,40,49,44,32,48,41,59,10,32,32,99,111,111,114,100,48,49,32,61,32,99,111,111,114,100,48,48,32,43,32,105,118,101,99,50,40,48,44,32,49,41,59,10,32,32,99,111,111,114,100,49,49,32,61,32,99,111,111,114,100,48,48,32,43,32,105,118,101,99,50,40,49,44,32,49,41,59,10,32,32,109,105,120,101,114,32,61,32,99,111,111,114,100,32,45,32,118,101,99,50,40,99,111,111,114,100,48,48,41,59,10,10,32,32,118,48,48,32,61,32,116,101,120,101,108,70,101,116,99,104,40,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,84,101,120,101,108,83,116,111,114,101,85,73,78,84,44,32,105,118,101,99,51,40,99,111,111,114,100,48,48,44,32,108,97,121,101,114,41,44,32,48,41,46,114,59,10,32,32,118,48,49,32,61,32,116,101,120,101,108,70,101,116,99,104,40,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,84,101,120,101,108,83,116,111,114,101,85,73,78,84,44,32,105,118,101,99,51,40,99,111,111,114,100,48,49,44,32,108,97,121,101,114,41,44,32,48,41,46,114,59,10,32,32,118,49,48,32,61,32,116,101,120,101,108,70,101,116,99,104,40,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,84,101,120,101,108,83,116,111,114,101,85,73,78,84,44,32,105,118,101,99,51,40,99,111,111,114,100,49,48,44,32,108,97,121,101,114,41,44,32,48,41,46,114,59,10,32,32,118,49,49,32,61,32,116,101,120,101,108,70,101,116,99,104,40,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,84,101,120,101,108,83,116,111,114,101,85,73,78,84,44,32,105,118,101,99,51,40,99,111,111,114,100,49,49,44,32,108,97,121,101,114,41,44,32,48,41,46,114,59,10,10,32,32,102,48,32,61,32,109,105,120,40,102,108,111,97,116,40,118,48,48,41,44,32,102,108,111,97,116,40,118,48,49,41,44,32,109,105,120,101,114,46,121,41,59,10,32,32,102,49,32,61,32,109,105,120,40,102,108,111,97,116,40,118,49,48,41,44,32,102,108,111,97,116,40,118,49,49,41,44,32,109,105,120,101,114,46,121,41,59,10,32,32,114,101,116,117,114,110,32,109,105,120,40,102,48,44,32,102,49,44,32,109,105,120,101,114,46,120,41,32,47,32,50,53,53,46,48,59,10,125,10,35,101,110,100,105,102,10,10,118,101,99,52,10,102,97,115,116,117,105,100,114,97,119,95,103,108,95,102,114,97,103,95,109,97,105,110,40,105,110,32,117,105,110,116,32,115,117,98,95,115,104,97,100,101,114,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,32,117,105,110,116,32,115,104,97,100,101,114,95,100,97,116,97,95,111,102,102,115,101,116,41,10,123,10,32,32,47,42,10,32,32,32,32,118,97,114,121,105,110,103,115,58,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,120,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,121,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,120,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,121,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,108,97,121,101,114,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,108,97,121,101,114,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,103,101,111,109,101,116,114,121,95,100,97,116,97,95,108,111,99,97,116,105,111,110,10,10,32,32,32,32,103,108,121,112,104,32,116,101,120,101,108,32,115,116,111,114,101,32,97,116,58,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,84,101,120,101,108,83,116,111,114,101,85,73,78,84,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,84,101,120,101,108,83,116,111,114,101,70,76,79,65,84,10,10,32,32,32,32,103,108,121,112,104,32,103,101,111,109,101,116,114,121,32,115,116,111,114,101,32,97,116,58,10,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,102,101,116,99,104,95,103,108,121,112,104,95,100,97,116,97,32,40,109,97,99,114,111,41,10,32,32,32,42,47,10,10,32,32,102,108,111,97,116,32,114,101,100,44,32,103,114,101,101,110,44,32,98,108,117,101,44,32,100,105,115,116,44,32,99,111,118,101,114,97,103,101,59,10,32,32,118,101,99,50,32,103,114,101,101,110,95,99,111,111,114,100,44,32,98,108,117,101,95,99,111,111,114,100,59,10,10,32,32,103,114,101,101,110,95,99,111,111,114,100,32,61,32,118,101,99,50,40,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,120,44,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,121,41,59,10,32,32,98,108,117,101,95,99,111,111,114,100,32,61,32,103,114,101,101,110,95,99,111,111,114,100,32,43,32,118,101,99,50,40,48,46,48,44,32,102,108,111,97,116,40,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,103,101,111,109,101,116,114,121,95,100,97,116,97,95,108,111,99,97,116,105,111,110,41,41,59,10,10,32,32,35,105,102,110,100,101,102,32,70,65,83,84,85,73,68,82,65,87,95,80,65,73,78,84,69,82,95,69,77,85,76,65,84,69,95,71,76,89,80,72,95,84,69,88,69,76,95,83,84,79,82,69,95,70,76,79,65,84,10,32,32,32,32,123,10,32,32,32,32,32,32,114,101,100,32,61,32,116,101,120,116,117,114,101,40,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,84,101,120,101,108,83,116,111,114,101,70,76,79,65,84,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,40,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,120,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,121,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,108,97,121,101,114,41,41,46,114,59,10,32,32,32,32,32,32,103,114,101,101,110,32,61,32,116,101,120,116,117,114,101,40,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,84,101,120,101,108,83,116,111,114,101,70,76,79,65,84,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,40,103,114,101,101,110,95,99,111,111,114,100,32,42,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,84,101,120,101,108,83,116,111,114,101,95,115,105,122,101,95,114,101,99,105,112,114,111,99,97,108,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,108,97,121,101,114,41,41,46,114,59,10,32,32,32,32,32,32,98,108,117,101,32,61,32,116,101,120,116,117,114,101,40,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,84,101,120,101,108,83,116,111,114,101,70,76,79,65,84,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,118,101,99,51,40,98,108,117,101,95,99,111,111,114,100,32,42,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,84,101,120,101,108,83,116,111,114,101,95,115,105,122,101,95,114,101,99,105,112,114,111,99,97,108,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,108,97,121,101,114,41,41,46,114,59,10,32,32,32,32,125,10,32,32,35,101,108,115,101,10,32,32,32,32,123,10,32,32,32,32,32,32,114,101,100,32,61,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,109,115,100,102,95,97,110,105,115,111,116,114,111,112,105,99,95,102,101,116,99,104,95,99,104,97,110,110,101,108,40,118,101,99,50,40,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,120,44,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,121,41,44,10,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,32,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,116,101,120,95,99,111,111,114,100,95,108,97,121,101,114,41,41,59,10,32,32,32,32,32,32,103,114,101,101,110,32,61,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,109,115,100,102,95,97,110,105,115,111,116,114,111,112,105,99,95,102,101,116,99,104,95,99,104,97,110,110,101,108,40,103,114,101,101,110,95,99,111,111,114,100,44,32,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,108,97,121,101,114,41,41,59,10,32,32,32,32,32,32,98,108,117,101,32,61,32,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,109,115,100,102,95,97,110,105,115,111,116,114,111,112,105,99,95,102,101,116,99,104,95,99,104,97,110,110,101,108,40,98,108,117,101,95,99,111,111,114,100,44,32,105,110,116,40,102,97,115,116,117,105,100,114,97,119,95,103,108,121,112,104,95,115,101,99,111,110,100,97,114,121,95,116,101,120,95,99,111,111,114,100,95,108,97,121,101,114,41,41,59,10,32,32,32,32,125,10,32,32,35,101,110,100,105,102,10,10,32,32,47,42,32,116,104,101,32,109,101,100,105,97,110,32,111,102,32,116,104,101,32,116,104,114,101,101,32,99,104,97,110,110,101,108,115,32,105,115,32,116,104,101,32,115,105,103,110,101,100,10,32,32,32,32,32,100,105,115,116,97,110,99,101,32,116,111,32,116,104,101,32,111,117,116,108,105,110,101,46,10,32,32,32,42,47,10,32,32,100,105,115,116,32,61,32,50,46,48,32,42,32,109,97,120,40,109,105,110,40,114,101,100,44,32,103,114,101,101,110,41,44,32,109,105,110,40,109,97,120,40,114,101,100,44,32,103,114,101,101,110,41,44,32,98,108,117,101,41,41,32,45,32,49,46,48,59,10,32,32,99,111,118,101,114,97,103,101,32,61,32,102,97,115,116,117,105,100,114,97,119,95,97,110,105,115,111,116,114,111,112,105,99,95,99,111,118,101,114,97,103,101,40,100,105,115,116,44,32,100,70,100,120,40,100,105,115,116,41,44,32,100,70,100,121,40,100,105,115,116,41,41,59,10,10,32,32,114,101,116,117,114,110,32,118,101,99,52,40,49,46,48,44,32,49,46,48,44,32,49,46,48,44,32,99,111,118,101,114,97,103,101,41,59,10,125,10, 0 };
+
+ fastuidraw::static_resource R("fastuidraw_painter_glyph_msdf_anisotropic.frag.glsl.resource_string", fastuidraw::const_c_array<uint8_t>(values, sizeof(values)));
+ 
+
+}
+